@@ -157,6 +157,8 @@ typedef struct _st_stack {
     char *stk_bottom;           /* Lowest address of stack's usable portion */
     char *stk_top;              /* Highest address of stack's usable portion */
     void *sp;                   /* Stack pointer from C's point of view */
+    int guarded;                /* Whether the redzone is protected */
+    int painted;                /* Whether painted to measure the high-water mark */
     /* merge from https://github.com/toffaletti/state-threads/commit/7f57fc9acc05e657bca1223f1e5b9b1a45ed929b */
 #ifndef NVALGRIND
     /* id returned by VALGRIND_STACK_REGISTER */
@@ -460,6 +462,10 @@ void _st_del_sleep_q(_st_thread_t *thread);
 _st_stack_t *_st_stack_new(int stack_size);
 void _st_stack_free(_st_stack_t *ts);
 int _st_io_init(void);
+#ifdef MD_HAVE_IO_URING
+int _st_io_uring_enabled(int op);
+int _st_io_uring_io(int op, int osfd, void *addr, unsigned int len, unsigned long long off, int flags, st_utime_t timeout);
+#endif
 
 st_utime_t st_utime(void);
 _st_cond_t *st_cond_new(void);
@@ -48,6 +48,12 @@
 #ifdef MD_HAVE_EPOLL
 #include <sys/epoll.h>
 #endif
+#ifdef MD_HAVE_IO_URING
+#include <stdint.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/io_uring.h>
+#endif
 
 // Global stat.
 #if defined(DEBUG) && defined(DEBUG_STATS)
@@ -57,6 +63,10 @@ __thread unsigned long long _st_stat_epoll_shake = 0;
 __thread unsigned long long _st_stat_epoll_spin = 0;
 #endif
 
+#if defined(MD_HAVE_IO_URING) && !defined(MD_HAVE_EPOLL)
+    #error The io_uring requires epoll as fallback
+#endif
+
 #if !defined(MD_HAVE_KQUEUE) && !defined(MD_HAVE_EPOLL) && !defined(MD_HAVE_SELECT)
     #error Only support epoll(for Linux), kqueue(for Darwin) or select(for Cygwin)
 #endif
@@ -147,6 +157,87 @@ static __thread struct _st_epolldata {
 
 #endif  /* MD_HAVE_EPOLL */
 
+
+#ifdef MD_HAVE_IO_URING
+#ifndef __NR_io_uring_setup
+    #define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+    #define __NR_io_uring_enter 426
+#endif
+
+typedef struct _uring_fd_data {
+    int rd_ref_cnt;
+    int wr_ref_cnt;
+    int ex_ref_cnt;
+    int revents;
+    int armed;          /* The events of the one-shot poll in kernel */
+    int io_cnt;         /* The completion requests in flight */
+    unsigned int gen;   /* Bumped when poll removed, to ignore the stale CQE */
+} _uring_fd_data_t;
+
+/* The completion request, lives on the stack of the waiting thread. */
+typedef struct _st_uring_req {
+    _st_thread_t *thread;
+    int res;
+    int done;
+} _st_uring_req_t;
+
+static __thread struct _st_uringdata {
+    _uring_fd_data_t *fd_data;
+    int *fired;
+    int fd_data_size;
+    int fired_size;
+    int ring_fd;
+    /* The submission queue, the tail is published to kernel when enter. */
+    unsigned int *sq_head;
+    unsigned int *sq_tail;
+    unsigned int *sq_mask;
+    unsigned int *sq_entries;
+    unsigned int *sq_array;
+    unsigned int sq_local_tail;
+    struct io_uring_sqe *sqes;
+    /* The completion queue. */
+    unsigned int *cq_head;
+    unsigned int *cq_tail;
+    unsigned int *cq_mask;
+    struct io_uring_cqe *cqes;
+    /* The mmap regions. */
+    void *sq_ring;
+    void *cq_ring;
+    size_t sq_ring_size;
+    size_t cq_ring_size;
+    size_t sqes_size;
+    /* The opcodes that kernel refuses to wait for, so we fallback to poll. */
+    unsigned char nowait[IORING_OP_LAST];
+} *_st_uring_data;
+
+#ifndef ST_IO_URING_ENTRIES
+    /* The size of SQ, while CQ is 4x of it */
+    #define ST_IO_URING_ENTRIES 1024
+#endif
+
+/* The user data of poll is odd, while the completion request is an aligned pointer. */
+#define _ST_URING_POLL_KEY(fd)      (((unsigned long long)(fd) << 32) | ((_ST_URING_GEN(fd) & 0x7fffffff) << 1) | 1)
+#define _ST_URING_KEY_FD(key)       ((int)((key) >> 32))
+#define _ST_URING_KEY_GEN(key)      ((unsigned int)(((key) >> 1) & 0x7fffffff))
+
+#define _ST_URING_READ_CNT(fd)   (_st_uring_data->fd_data[fd].rd_ref_cnt)
+#define _ST_URING_WRITE_CNT(fd)  (_st_uring_data->fd_data[fd].wr_ref_cnt)
+#define _ST_URING_EXCEP_CNT(fd)  (_st_uring_data->fd_data[fd].ex_ref_cnt)
+#define _ST_URING_REVENTS(fd)    (_st_uring_data->fd_data[fd].revents)
+#define _ST_URING_ARMED(fd)      (_st_uring_data->fd_data[fd].armed)
+#define _ST_URING_IO_CNT(fd)     (_st_uring_data->fd_data[fd].io_cnt)
+#define _ST_URING_GEN(fd)        (_st_uring_data->fd_data[fd].gen)
+
+#define _ST_URING_READ_BIT(fd)   (_ST_URING_READ_CNT(fd) ? POLLIN : 0)
+#define _ST_URING_WRITE_BIT(fd)  (_ST_URING_WRITE_CNT(fd) ? POLLOUT : 0)
+#define _ST_URING_EXCEP_BIT(fd)  (_ST_URING_EXCEP_CNT(fd) ? POLLPRI : 0)
+#define _ST_URING_EVENTS(fd) \
+    (_ST_URING_READ_BIT(fd)|_ST_URING_WRITE_BIT(fd)|_ST_URING_EXCEP_BIT(fd))
+
+#endif  /* MD_HAVE_IO_URING */
+
 __thread _st_eventsys_t *_st_eventsys = NULL;
 
 
@@ -1230,6 +1321,642 @@ static _st_eventsys_t _st_epoll_eventsys = {
 #endif  /* MD_HAVE_EPOLL */
 
 
+#ifdef MD_HAVE_IO_URING
+/*****************************************
+ * io_uring event system
+ *
+ * The readiness is one-shot POLL_ADD, which is batched in the SQ and
+ * submitted with the wait in one io_uring_enter, so there is no syscall
+ * like epoll_ctl for each wait. The completion requests are also queued
+ * to the same ring by _st_io_uring_io(), see io.c.
+ */
+ST_HIDDEN int _st_uring_setup(unsigned int entries, struct io_uring_params *p)
+{
+    memset(p, 0, sizeof(*p));
+    p->flags = IORING_SETUP_CQSIZE;
+    p->cq_entries = entries * 4;
+    return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+ST_HIDDEN int _st_uring_init(void)
+{
+    struct io_uring_params p;
+    int fdlim;
+    int err = 0;
+    int rv = 0;
+
+    _st_uring_data = (struct _st_uringdata *) calloc(1, sizeof(*_st_uring_data));
+    if (!_st_uring_data)
+        return -1;
+
+    if ((_st_uring_data->ring_fd = _st_uring_setup(ST_IO_URING_ENTRIES, &p)) < 0) {
+        err = errno;
+        rv = -1;
+        goto cleanup_uring;
+    }
+    fcntl(_st_uring_data->ring_fd, F_SETFD, FD_CLOEXEC);
+
+    /* Map the rings, the CQ shares the SQ region if single mmap. */
+    _st_uring_data->sq_ring_size = p.sq_off.array + p.sq_entries * sizeof(unsigned int);
+    _st_uring_data->cq_ring_size = p.cq_off.cqes + p.cq_entries * sizeof(struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (_st_uring_data->cq_ring_size > _st_uring_data->sq_ring_size)
+            _st_uring_data->sq_ring_size = _st_uring_data->cq_ring_size;
+        _st_uring_data->cq_ring_size = 0;
+    }
+
+    _st_uring_data->sq_ring = mmap(NULL, _st_uring_data->sq_ring_size, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, _st_uring_data->ring_fd, IORING_OFF_SQ_RING);
+    if (_st_uring_data->sq_ring == MAP_FAILED) {
+        _st_uring_data->sq_ring = NULL;
+        err = errno;
+        rv = -1;
+        goto cleanup_uring;
+    }
+
+    if (_st_uring_data->cq_ring_size) {
+        _st_uring_data->cq_ring = mmap(NULL, _st_uring_data->cq_ring_size, PROT_READ | PROT_WRITE,
+            MAP_SHARED | MAP_POPULATE, _st_uring_data->ring_fd, IORING_OFF_CQ_RING);
+        if (_st_uring_data->cq_ring == MAP_FAILED) {
+            _st_uring_data->cq_ring = NULL;
+            err = errno;
+            rv = -1;
+            goto cleanup_uring;
+        }
+    } else {
+        _st_uring_data->cq_ring = _st_uring_data->sq_ring;
+    }
+
+    _st_uring_data->sqes_size = p.sq_entries * sizeof(struct io_uring_sqe);
+    _st_uring_data->sqes = (struct io_uring_sqe *)mmap(NULL, _st_uring_data->sqes_size, PROT_READ | PROT_WRITE,
+        MAP_SHARED | MAP_POPULATE, _st_uring_data->ring_fd, IORING_OFF_SQES);
+    if (_st_uring_data->sqes == MAP_FAILED) {
+        _st_uring_data->sqes = NULL;
+        err = errno;
+        rv = -1;
+        goto cleanup_uring;
+    }
+
+    _st_uring_data->sq_head = (unsigned int *)((char *)_st_uring_data->sq_ring + p.sq_off.head);
+    _st_uring_data->sq_tail = (unsigned int *)((char *)_st_uring_data->sq_ring + p.sq_off.tail);
+    _st_uring_data->sq_mask = (unsigned int *)((char *)_st_uring_data->sq_ring + p.sq_off.ring_mask);
+    _st_uring_data->sq_entries = (unsigned int *)((char *)_st_uring_data->sq_ring + p.sq_off.ring_entries);
+    _st_uring_data->sq_array = (unsigned int *)((char *)_st_uring_data->sq_ring + p.sq_off.array);
+    _st_uring_data->sq_local_tail = *_st_uring_data->sq_tail;
+    _st_uring_data->cq_head = (unsigned int *)((char *)_st_uring_data->cq_ring + p.cq_off.head);
+    _st_uring_data->cq_tail = (unsigned int *)((char *)_st_uring_data->cq_ring + p.cq_off.tail);
+    _st_uring_data->cq_mask = (unsigned int *)((char *)_st_uring_data->cq_ring + p.cq_off.ring_mask);
+    _st_uring_data->cqes = (struct io_uring_cqe *)((char *)_st_uring_data->cq_ring + p.cq_off.cqes);
+
+    /* Allocate file descriptor data array */
+    fdlim = st_getfdlimit();
+    _st_uring_data->fd_data_size = (fdlim > 0 && fdlim < ST_EPOLL_EVTLIST_SIZE) ? fdlim : ST_EPOLL_EVTLIST_SIZE;
+    _st_uring_data->fd_data = (_uring_fd_data_t *)calloc(_st_uring_data->fd_data_size, sizeof(_uring_fd_data_t));
+    if (!_st_uring_data->fd_data) {
+        err = errno;
+        rv = -1;
+        goto cleanup_uring;
+    }
+
+    /* Allocate the fired list, at most one poll CQE for each descriptor in a dispatch */
+    _st_uring_data->fired_size = _st_uring_data->fd_data_size;
+    _st_uring_data->fired = (int *)malloc(_st_uring_data->fired_size * sizeof(int));
+    if (!_st_uring_data->fired) {
+        err = errno;
+        rv = -1;
+    }
+
+ cleanup_uring:
+    if (rv < 0) {
+        if (_st_uring_data->sqes)
+            munmap(_st_uring_data->sqes, _st_uring_data->sqes_size);
+        if (_st_uring_data->cq_ring && _st_uring_data->cq_ring != _st_uring_data->sq_ring)
+            munmap(_st_uring_data->cq_ring, _st_uring_data->cq_ring_size);
+        if (_st_uring_data->sq_ring)
+            munmap(_st_uring_data->sq_ring, _st_uring_data->sq_ring_size);
+        if (_st_uring_data->ring_fd >= 0)
+            close(_st_uring_data->ring_fd);
+        free(_st_uring_data->fd_data);
+        free(_st_uring_data->fired);
+        free(_st_uring_data);
+        _st_uring_data = NULL;
+        errno = err;
+    }
+
+    return rv;
+}
+
+ST_HIDDEN int _st_uring_fd_data_expand(int maxfd)
+{
+    _uring_fd_data_t *ptr;
+    int *fired;
+    int n = _st_uring_data->fd_data_size;
+
+    while (maxfd >= n)
+        n <<= 1;
+
+    ptr = (_uring_fd_data_t *)realloc(_st_uring_data->fd_data, n * sizeof(_uring_fd_data_t));
+    if (!ptr)
+        return -1;
+
+    memset(ptr + _st_uring_data->fd_data_size, 0, (n - _st_uring_data->fd_data_size) * sizeof(_uring_fd_data_t));
+
+    _st_uring_data->fd_data = ptr;
+    _st_uring_data->fd_data_size = n;
+
+    fired = (int *)realloc(_st_uring_data->fired, n * sizeof(int));
+    if (!fired)
+        return -1;
+
+    _st_uring_data->fired = fired;
+    _st_uring_data->fired_size = n;
+
+    return 0;
+}
+
+/*
+ * Publish the SQ tail, submit the pending SQEs and optionally wait for CQEs.
+ */
+ST_HIDDEN int _st_uring_enter(unsigned int min_complete, unsigned int flags, struct __kernel_timespec *ts)
+{
+    struct io_uring_getevents_arg arg;
+    unsigned int to_submit;
+    void *argp = NULL;
+    size_t argsz = 0;
+
+    __atomic_store_n(_st_uring_data->sq_tail, _st_uring_data->sq_local_tail, __ATOMIC_RELEASE);
+    to_submit = _st_uring_data->sq_local_tail - __atomic_load_n(_st_uring_data->sq_head, __ATOMIC_ACQUIRE);
+
+    if (ts) {
+        memset(&arg, 0, sizeof(arg));
+        arg.ts = (unsigned long long)(uintptr_t)ts;
+        argp = &arg;
+        argsz = sizeof(arg);
+        flags |= IORING_ENTER_EXT_ARG;
+    }
+
+    if (!to_submit && !(flags & IORING_ENTER_GETEVENTS))
+        return 0;
+
+    return (int)syscall(__NR_io_uring_enter, _st_uring_data->ring_fd, to_submit, min_complete, flags, argp, argsz);
+}
+
+/*
+ * Get a free SQE, flush the SQ to kernel when it's full.
+ */
+ST_HIDDEN struct io_uring_sqe *_st_uring_get_sqe(void)
+{
+    struct io_uring_sqe *sqe;
+    unsigned int head, idx;
+
+    head = __atomic_load_n(_st_uring_data->sq_head, __ATOMIC_ACQUIRE);
+    if (_st_uring_data->sq_local_tail - head >= *_st_uring_data->sq_entries) {
+        if (_st_uring_enter(0, 0, NULL) < 0)
+            return NULL;
+        head = __atomic_load_n(_st_uring_data->sq_head, __ATOMIC_ACQUIRE);
+        if (_st_uring_data->sq_local_tail - head >= *_st_uring_data->sq_entries) {
+            errno = EBUSY;
+            return NULL;
+        }
+    }
+
+    idx = _st_uring_data->sq_local_tail & *_st_uring_data->sq_mask;
+    _st_uring_data->sq_array[idx] = idx;
+    _st_uring_data->sq_local_tail++;
+
+    sqe = &_st_uring_data->sqes[idx];
+    memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+ST_HIDDEN int _st_uring_poll_add(int osfd, int events)
+{
+    struct io_uring_sqe *sqe;
+
+    if ((sqe = _st_uring_get_sqe()) == NULL)
+        return -1;
+
+    sqe->opcode = IORING_OP_POLL_ADD;
+    sqe->fd = osfd;
+    sqe->poll32_events = (unsigned int)events;
+    sqe->user_data = _ST_URING_POLL_KEY(osfd);
+    _ST_URING_ARMED(osfd) = events;
+
+    return 0;
+}
+
+ST_HIDDEN void _st_uring_poll_remove(int osfd)
+{
+    struct io_uring_sqe *sqe;
+
+    /* Even if failed, the CQE of the poll is ignored by the generation. */
+    if ((sqe = _st_uring_get_sqe()) != NULL) {
+        sqe->opcode = IORING_OP_POLL_REMOVE;
+        sqe->fd = -1;
+        sqe->addr = _ST_URING_POLL_KEY(osfd);
+        sqe->user_data = 0;
+    }
+
+    _ST_URING_ARMED(osfd) = 0;
+    _ST_URING_GEN(osfd)++;
+}
+
+ST_HIDDEN void _st_uring_pollset_del(struct pollfd *pds, int npds)
+{
+    struct pollfd *pd;
+    struct pollfd *epd = pds + npds;
+
+    /*
+     * The poll is one-shot, so we only remove it when nobody waits on the
+     * descriptor. Those fired in dispatch are not armed and re-armed later.
+     */
+    for (pd = pds; pd < epd; pd++) {
+        if (pd->events & POLLIN)
+            _ST_URING_READ_CNT(pd->fd)--;
+        if (pd->events & POLLOUT)
+            _ST_URING_WRITE_CNT(pd->fd)--;
+        if (pd->events & POLLPRI)
+            _ST_URING_EXCEP_CNT(pd->fd)--;
+
+        if (_ST_URING_EVENTS(pd->fd) == 0 && _ST_URING_ARMED(pd->fd))
+            _st_uring_poll_remove(pd->fd);
+    }
+}
+
+ST_HIDDEN int _st_uring_pollset_add(struct pollfd *pds, int npds)
+{
+    int i, fd;
+    int events;
+
+    /* Do as many checks as possible up front */
+    for (i = 0; i < npds; i++) {
+        fd = pds[i].fd;
+        if (fd < 0 || !pds[i].events ||
+            (pds[i].events & ~(POLLIN | POLLOUT | POLLPRI))) {
+            errno = EINVAL;
+            return -1;
+        }
+        if (fd >= _st_uring_data->fd_data_size && _st_uring_fd_data_expand(fd) < 0)
+            return -1;
+    }
+
+    for (i = 0; i < npds; i++) {
+        fd = pds[i].fd;
+
+        if (pds[i].events & POLLIN)
+            _ST_URING_READ_CNT(fd)++;
+        if (pds[i].events & POLLOUT)
+            _ST_URING_WRITE_CNT(fd)++;
+        if (pds[i].events & POLLPRI)
+            _ST_URING_EXCEP_CNT(fd)++;
+
+        /* Re-arm when new events are required, a superset armed is fine. */
+        events = _ST_URING_EVENTS(fd);
+        if ((events & ~_ST_URING_ARMED(fd)) != 0) {
+            if (_ST_URING_ARMED(fd))
+                _st_uring_poll_remove(fd);
+            if (_st_uring_poll_add(fd, events) < 0)
+                break;
+        }
+    }
+
+    if (i < npds) {
+        /* Error */
+        int err = errno;
+        /* Unroll the state */
+        _st_uring_pollset_del(pds, i + 1);
+        errno = err;
+        return -1;
+    }
+
+    return 0;
+}
+
+/*
+ * Reap the CQEs, wakeup the completion requests and collect the fired descriptors.
+ * Return the number of fired descriptors, while the ncqe is the number of CQEs.
+ */
+ST_HIDDEN int _st_uring_reap(int *ncqe)
+{
+    struct io_uring_cqe *cqe;
+    _st_uring_req_t *req;
+    unsigned int head, tail;
+    unsigned long long key;
+    int nfd = 0, n = 0;
+    int osfd;
+
+    head = *_st_uring_data->cq_head;
+    tail = __atomic_load_n(_st_uring_data->cq_tail, __ATOMIC_ACQUIRE);
+
+    for (; head != tail; head++, n++) {
+        cqe = &_st_uring_data->cqes[head & *_st_uring_data->cq_mask];
+        key = cqe->user_data;
+
+        /* The poll remove and cancel requests. */
+        if (key == 0)
+            continue;
+
+        if ((key & 1) == 0) {
+            req = (_st_uring_req_t *)(uintptr_t)key;
+            req->res = cqe->res;
+            req->done = 1;
+            if (req->thread->state == _ST_ST_IO_WAIT) {
+                if (req->thread->flags & _ST_FL_ON_SLEEPQ)
+                    _ST_DEL_SLEEPQ(req->thread);
+                req->thread->state = _ST_ST_RUNNABLE;
+                _ST_ADD_RUNQ(req->thread);
+            }
+            continue;
+        }
+
+        osfd = _ST_URING_KEY_FD(key);
+        if (osfd >= _st_uring_data->fd_data_size || !_ST_URING_ARMED(osfd) ||
+            _ST_URING_KEY_GEN(key) != (_ST_URING_GEN(osfd) & 0x7fffffff)) {
+            continue;
+        }
+
+        /* The one-shot poll is done, also set I/O bits on error */
+        _ST_URING_ARMED(osfd) = 0;
+        _ST_URING_REVENTS(osfd) = (cqe->res < 0) ? POLLERR : cqe->res;
+        if (_ST_URING_REVENTS(osfd) & (POLLERR | POLLHUP))
+            _ST_URING_REVENTS(osfd) |= _ST_URING_EVENTS(osfd);
+        if (_ST_URING_REVENTS(osfd) == 0)
+            _ST_URING_REVENTS(osfd) = _ST_URING_EVENTS(osfd);
+        _st_uring_data->fired[nfd++] = osfd;
+    }
+
+    __atomic_store_n(_st_uring_data->cq_head, head, __ATOMIC_RELEASE);
+
+    *ncqe = n;
+    return nfd;
+}
+
+ST_HIDDEN void _st_uring_dispatch(void)
+{
+    st_utime_t min_timeout;
+    _st_clist_t *q;
+    _st_pollq_t *pq;
+    struct pollfd *pds, *epds;
+    struct __kernel_timespec ts;
+    int timeout, nfd, ncqe, i, osfd, notify;
+    int events;
+    short revents;
+
+    #if defined(DEBUG) && defined(DEBUG_STATS)
+    ++_st_stat_epoll;
+    #endif
+
+    if (_ST_SLEEPQ == NULL) {
+        timeout = -1;
+    } else {
+        min_timeout = (_ST_SLEEPQ->due <= _ST_LAST_CLOCK) ? 0 : (_ST_SLEEPQ->due - _ST_LAST_CLOCK);
+        timeout = (int) (min_timeout / 1000);
+
+        // At least wait 1ms when <1ms, to avoid spin loop, same to epoll.
+        if (timeout == 0) {
+            #if defined(DEBUG) && defined(DEBUG_STATS)
+            ++_st_stat_epoll_zero;
+            #endif
+
+            if (min_timeout > 0) {
+                #if defined(DEBUG) && defined(DEBUG_STATS)
+                ++_st_stat_epoll_shake;
+                #endif
+
+                timeout = 1;
+            }
+        }
+    }
+
+    /* Submit the batched requests and wait for I/O in one syscall */
+    if (timeout < 0) {
+        _st_uring_enter(1, IORING_ENTER_GETEVENTS, NULL);
+    } else if (timeout == 0) {
+        _st_uring_enter(0, 0, NULL);
+    } else {
+        ts.tv_sec = timeout / 1000;
+        ts.tv_nsec = (long long)(timeout % 1000) * 1000000;
+        _st_uring_enter(1, IORING_ENTER_GETEVENTS, &ts);
+    }
+
+    nfd = _st_uring_reap(&ncqe);
+
+    #if defined(DEBUG) && defined(DEBUG_STATS)
+    if (ncqe <= 0) {
+        ++_st_stat_epoll_spin;
+    }
+    #endif
+
+    if (nfd > 0) {
+        for (q = _ST_IOQ.next; q != &_ST_IOQ; q = q->next) {
+            pq = _ST_POLLQUEUE_PTR(q);
+            notify = 0;
+            epds = pq->pds + pq->npds;
+
+            for (pds = pq->pds; pds < epds; pds++) {
+                if (_ST_URING_REVENTS(pds->fd) == 0) {
+                    pds->revents = 0;
+                    continue;
+                }
+                osfd = pds->fd;
+                events = pds->events;
+                revents = 0;
+                if ((events & POLLIN) && (_ST_URING_REVENTS(osfd) & POLLIN))
+                    revents |= POLLIN;
+                if ((events & POLLOUT) && (_ST_URING_REVENTS(osfd) & POLLOUT))
+                    revents |= POLLOUT;
+                if ((events & POLLPRI) && (_ST_URING_REVENTS(osfd) & POLLPRI))
+                    revents |= POLLPRI;
+                if (_ST_URING_REVENTS(osfd) & POLLERR)
+                    revents |= POLLERR;
+                if (_ST_URING_REVENTS(osfd) & POLLHUP)
+                    revents |= POLLHUP;
+
+                pds->revents = revents;
+                if (revents) {
+                    notify = 1;
+                }
+            }
+            if (notify) {
+                ST_REMOVE_LINK(&pq->links);
+                pq->on_ioq = 0;
+                /* The fired descriptors are not armed, so only others are removed. */
+                _st_uring_pollset_del(pq->pds, pq->npds);
+
+                if (pq->thread->flags & _ST_FL_ON_SLEEPQ)
+                    _ST_DEL_SLEEPQ(pq->thread);
+                pq->thread->state = _ST_ST_RUNNABLE;
+                _ST_ADD_RUNQ(pq->thread);
+            }
+        }
+
+        for (i = 0; i < nfd; i++) {
+            /* Re-arm descriptors that fired, if still waiting on them */
+            osfd = _st_uring_data->fired[i];
+            _ST_URING_REVENTS(osfd) = 0;
+            events = _ST_URING_EVENTS(osfd);
+            if (events && !_ST_URING_ARMED(osfd))
+                _st_uring_poll_add(osfd, events);
+        }
+    }
+}
+
+ST_HIDDEN int _st_uring_fd_new(int osfd)
+{
+    if (osfd >= _st_uring_data->fd_data_size && _st_uring_fd_data_expand(osfd) < 0)
+        return -1;
+
+    return 0;
+}
+
+ST_HIDDEN int _st_uring_fd_close(int osfd)
+{
+    if (_ST_URING_READ_CNT(osfd) || _ST_URING_WRITE_CNT(osfd) || _ST_URING_EXCEP_CNT(osfd) || _ST_URING_IO_CNT(osfd)) {
+        errno = EBUSY;
+        return -1;
+    }
+
+    /* The queued poll remove holds the file, so submit it before close. */
+    _st_uring_enter(0, 0, NULL);
+
+    return 0;
+}
+
+ST_HIDDEN int _st_uring_fd_getlimit(void)
+{
+    /* zero means no specific limit */
+    return 0;
+}
+
+/*
+ * Check whether the kernel supports io_uring with the features we need,
+ * which might be disabled by seccomp in containers.
+ */
+ST_HIDDEN int _st_uring_is_supported(void)
+{
+    struct io_uring_params p;
+    int fd;
+    unsigned int required = IORING_FEAT_SINGLE_MMAP | IORING_FEAT_NODROP | IORING_FEAT_FAST_POLL | IORING_FEAT_EXT_ARG;
+
+    if ((fd = _st_uring_setup(4, &p)) < 0)
+        return 0;
+    close(fd);
+
+    return (p.features & required) == required;
+}
+
+ST_HIDDEN void _st_uring_destroy(void)
+{
+    munmap(_st_uring_data->sqes, _st_uring_data->sqes_size);
+    if (_st_uring_data->cq_ring != _st_uring_data->sq_ring)
+        munmap(_st_uring_data->cq_ring, _st_uring_data->cq_ring_size);
+    munmap(_st_uring_data->sq_ring, _st_uring_data->sq_ring_size);
+    close(_st_uring_data->ring_fd);
+    free(_st_uring_data->fd_data);
+    free(_st_uring_data->fired);
+    free(_st_uring_data);
+    _st_uring_data = NULL;
+}
+
+static _st_eventsys_t _st_uring_eventsys = {
+    "io_uring",
+    ST_EVENTSYS_IO_URING,
+    _st_uring_init,
+    _st_uring_dispatch,
+    _st_uring_pollset_add,
+    _st_uring_pollset_del,
+    _st_uring_fd_new,
+    _st_uring_fd_close,
+    _st_uring_fd_getlimit,
+    _st_uring_destroy
+};
+
+int _st_io_uring_enabled(int op)
+{
+    return _st_eventsys == &_st_uring_eventsys && !_st_uring_data->nowait[op];
+}
+
+/*
+ * Submit a completion request and park the thread until it's done, the
+ * timeout or interrupt cancels it. The off is the offset of read, or the
+ * addrlen of accept, see the struct io_uring_sqe.
+ */
+int _st_io_uring_io(int op, int osfd, void *addr, unsigned int len, unsigned long long off, int flags, st_utime_t timeout)
+{
+    _st_thread_t *me = _ST_CURRENT_THREAD();
+    struct io_uring_sqe *sqe;
+    _st_uring_req_t req;
+
+    if (me->flags & _ST_FL_INTERRUPT) {
+        me->flags &= ~_ST_FL_INTERRUPT;
+        errno = EINTR;
+        return -1;
+    }
+
+    if (osfd >= _st_uring_data->fd_data_size && _st_uring_fd_data_expand(osfd) < 0)
+        return -1;
+    if ((sqe = _st_uring_get_sqe()) == NULL)
+        return -1;
+
+    sqe->opcode = (unsigned char)op;
+    sqe->fd = osfd;
+    sqe->addr = (unsigned long long)(uintptr_t)addr;
+    sqe->len = len;
+    sqe->off = off;
+    sqe->rw_flags = flags;
+    sqe->user_data = (unsigned long long)(uintptr_t)&req;
+
+    req.thread = me;
+    req.res = 0;
+    req.done = 0;
+
+    _ST_URING_IO_CNT(osfd)++;
+    if (timeout != ST_UTIME_NO_TIMEOUT)
+        _ST_ADD_SLEEPQ(me, timeout);
+    me->state = _ST_ST_IO_WAIT;
+
+    _ST_SWITCH_CONTEXT(me);
+
+    if (!req.done) {
+        /*
+         * Timed out or interrupted, the buffer and req are still owned by
+         * kernel, so we must cancel it and wait for the CQE.
+         */
+        if (me->flags & _ST_FL_ON_SLEEPQ)
+            _ST_DEL_SLEEPQ(me);
+        if ((sqe = _st_uring_get_sqe()) != NULL) {
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->fd = -1;
+            sqe->addr = (unsigned long long)(uintptr_t)&req;
+            sqe->user_data = 0;
+        }
+        while (!req.done) {
+            me->state = _ST_ST_IO_WAIT;
+            _ST_SWITCH_CONTEXT(me);
+        }
+        if (req.res == -ECANCELED) {
+            req.res = (me->flags & _ST_FL_INTERRUPT) ? -EINTR : -ETIME;
+        }
+    }
+    _ST_URING_IO_CNT(osfd)--;
+
+    if (req.res == -EINTR && (me->flags & _ST_FL_INTERRUPT))
+        me->flags &= ~_ST_FL_INTERRUPT;
+
+    /* The kernel honors O_NONBLOCK for this op, so never try it again. */
+    if (req.res == -EAGAIN)
+        _st_uring_data->nowait[op] = 1;
+
+    if (req.res < 0) {
+        errno = -req.res;
+        return -1;
+    }
+
+    return req.res;
+}
+#endif  /* MD_HAVE_IO_URING */
+
+
 /*****************************************
  * Public functions
  */
@@ -1248,6 +1975,13 @@ int st_set_eventsys(int eventsys)
 #endif
     }
 
+#if defined (MD_HAVE_IO_URING)
+    if (eventsys == ST_EVENTSYS_IO_URING && _st_uring_is_supported()) {
+        _st_eventsys = &_st_uring_eventsys;
+        return 0;
+    }
+#endif
+
     if (eventsys == ST_EVENTSYS_ALT) {
 #if defined (MD_HAVE_KQUEUE)
         _st_eventsys = &_st_kq_eventsys;
@@ -54,6 +54,12 @@
 #include <errno.h>
 #include "common.h"
 
+#ifdef MD_HAVE_IO_URING
+#include <stdint.h>
+#include <string.h>
+#include <linux/io_uring.h>
+#endif
+
 // Global stat.
 #if defined(DEBUG) && defined(DEBUG_STATS)
 __thread unsigned long long _st_stat_recvfrom = 0;
@@ -285,6 +291,15 @@ _st_netfd_t *st_accept(_st_netfd_t *fd, struct sockaddr *addr, int *addrlen, st_
             continue;
         if (!_IO_NOT_READY_ERROR)
             return NULL;
+#ifdef MD_HAVE_IO_URING
+        /* Accept by completion, fallback to poll if kernel refuses to wait */
+        if (_st_io_uring_enabled(IORING_OP_ACCEPT)) {
+            if ((osfd = _st_io_uring_io(IORING_OP_ACCEPT, fd->osfd, addr, 0, (unsigned long long)(uintptr_t)addrlen, 0, timeout)) >= 0)
+                break;
+            if (errno != EAGAIN)
+                return NULL;
+        }
+#endif
         /* Wait until the socket becomes readable */
         if (st_netfd_poll(fd, POLLIN, timeout) < 0)
             return NULL;
@@ -364,6 +379,14 @@ ssize_t st_read(_st_netfd_t *fd, void *buf, size_t nbyte, st_utime_t timeout)
         ++_st_stat_read_eagain;
         #endif
 
+#ifdef MD_HAVE_IO_URING
+        /* Read by completion, which copies data when it arrives, so no more read */
+        if (_st_io_uring_enabled(IORING_OP_READ)) {
+            if ((n = _st_io_uring_io(IORING_OP_READ, fd->osfd, buf, (unsigned int)nbyte, (unsigned long long)-1, 0, timeout)) >= 0 || errno != EAGAIN)
+                return n;
+        }
+#endif
+
         /* Wait until the socket becomes readable */
         if (st_netfd_poll(fd, POLLIN, timeout) < 0)
             return -1;
@@ -622,6 +645,10 @@ int st_writev_resid(_st_netfd_t *fd, struct iovec **iov, int *iov_size, st_utime
 int st_recvfrom(_st_netfd_t *fd, void *buf, int len, struct sockaddr *from, int *fromlen, st_utime_t timeout)
 {
     int n;
+#ifdef MD_HAVE_IO_URING
+    struct msghdr msg;
+    struct iovec iov;
+#endif
 
     #if defined(DEBUG) && defined(DEBUG_STATS)
     ++_st_stat_recvfrom;
@@ -637,6 +664,22 @@ int st_recvfrom(_st_netfd_t *fd, void *buf, int len, struct sockaddr *from, int
         ++_st_stat_recvfrom_eagain;
         #endif
 
+#ifdef MD_HAVE_IO_URING
+        if (_st_io_uring_enabled(IORING_OP_RECVMSG)) {
+            iov.iov_base = buf;
+            iov.iov_len = len;
+            memset(&msg, 0, sizeof(msg));
+            msg.msg_name = from;
+            msg.msg_namelen = fromlen ? (socklen_t)*fromlen : 0;
+            msg.msg_iov = &iov;
+            msg.msg_iovlen = 1;
+            if ((n = _st_io_uring_io(IORING_OP_RECVMSG, fd->osfd, &msg, 1, 0, 0, timeout)) >= 0 && fromlen)
+                *fromlen = (int)msg.msg_namelen;
+            if (n >= 0 || errno != EAGAIN)
+                return n;
+        }
+#endif
+
         /* Wait until the socket becomes readable */
         if (st_netfd_poll(fd, POLLIN, timeout) < 0)
             return -1;
@@ -649,6 +692,10 @@ int st_recvfrom(_st_netfd_t *fd, void *buf, int len, struct sockaddr *from, int
 int st_sendto(_st_netfd_t *fd, const void *msg, int len, const struct sockaddr *to, int tolen, st_utime_t timeout)
 {
     int n;
+#ifdef MD_HAVE_IO_URING
+    struct msghdr mh;
+    struct iovec iov;
+#endif
 
     #if defined(DEBUG) && defined(DEBUG_STATS)
     ++_st_stat_sendto;
@@ -664,6 +711,20 @@ int st_sendto(_st_netfd_t *fd, const void *msg, int len, const struct sockaddr *
         ++_st_stat_sendto_eagain;
         #endif
 
+#ifdef MD_HAVE_IO_URING
+        if (_st_io_uring_enabled(IORING_OP_SENDMSG)) {
+            iov.iov_base = (void *)msg;
+            iov.iov_len = len;
+            memset(&mh, 0, sizeof(mh));
+            mh.msg_name = (void *)to;
+            mh.msg_namelen = (socklen_t)tolen;
+            mh.msg_iov = &iov;
+            mh.msg_iovlen = 1;
+            if ((n = _st_io_uring_io(IORING_OP_SENDMSG, fd->osfd, &mh, 1, 0, 0, timeout)) >= 0 || errno != EAGAIN)
+                return n;
+        }
+#endif
+
         /* Wait until the socket becomes writable */
         if (st_netfd_poll(fd, POLLOUT, timeout) < 0)
             return -1;
@@ -691,6 +752,13 @@ int st_recvmsg(_st_netfd_t *fd, struct msghdr *msg, int flags, st_utime_t timeou
         ++_st_stat_recvmsg_eagain;
         #endif
 
+#ifdef MD_HAVE_IO_URING
+        if (_st_io_uring_enabled(IORING_OP_RECVMSG)) {
+            if ((n = _st_io_uring_io(IORING_OP_RECVMSG, fd->osfd, msg, 1, 0, flags, timeout)) >= 0 || errno != EAGAIN)
+                return n;
+        }
+#endif
+
         /* Wait until the socket becomes readable */
         if (st_netfd_poll(fd, POLLIN, timeout) < 0)
             return -1;
@@ -718,6 +786,13 @@ int st_sendmsg(_st_netfd_t *fd, const struct msghdr *msg, int flags, st_utime_t
         ++_st_stat_sendmsg_eagain;
         #endif
 
+#ifdef MD_HAVE_IO_URING
+        if (_st_io_uring_enabled(IORING_OP_SENDMSG)) {
+            if ((n = _st_io_uring_io(IORING_OP_SENDMSG, fd->osfd, (void *)msg, 1, 0, flags, timeout)) >= 0 || errno != EAGAIN)
+                return n;
+        }
+#endif
+
         /* Wait until the socket becomes writable */
         if (st_netfd_poll(fd, POLLOUT, timeout) < 0)
             return -1;
@@ -69,6 +69,7 @@
 #define ST_EVENTSYS_DEFAULT 0
 #define ST_EVENTSYS_SELECT  1
 #define ST_EVENTSYS_ALT     3
+#define ST_EVENTSYS_IO_URING 4
 
 #ifdef __cplusplus
 extern "C" {
@@ -102,6 +103,12 @@ extern void st_thread_interrupt(st_thread_t thread);
 extern void st_thread_yield();
 extern st_thread_t st_thread_create(void *(*start)(void *arg), void *arg, int joinable, int stack_size);
 extern int st_randomize_stacks(int on);
+extern int st_set_stack_pool(int max);
+extern int st_set_stack_guard(int on);
+extern int st_set_stack_watermark(int on);
+extern int st_get_free_stacks(void);
+extern int st_get_stack_guard(void);
+extern int st_thread_stack_watermark(st_thread_t thread);
 extern int st_set_utime_function(st_utime_t (*func)(void));
 
 extern st_utime_t st_utime(void);
@@ -42,6 +42,7 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <fcntl.h>
@@ -52,57 +53,75 @@
 /* How much space to leave between the stacks, at each end */
 #define REDZONE	_ST_PAGE_SIZE
 
+/* The byte to paint the stack, to measure the high-water mark. */
+#define _ST_STACK_PAINT 0xa5
+
 __thread _st_clist_t _st_free_stacks;
 __thread int _st_num_free_stacks = 0;
 __thread int _st_randomize_stacks = 0;
 
+/* The max number of free stacks to cache, -1 for unlimited. */
+#ifdef MD_CACHE_STACK
+__thread int _st_stack_pool_max = -1;
+#else
+__thread int _st_stack_pool_max = 0;
+#endif
+/* Whether protect the redzone of new stacks, to crash on stack overflow. Note that each guarded stack splits the
+ * memory mapping. The default is the same as before, that is, DEBUG build protects the mmap stacks, while the heap
+ * stacks of MALLOC_STACK were not page aligned so the mprotect never worked for them. */
+#if defined(DEBUG) && !defined(MD_NO_PROTECT) && !defined(MALLOC_STACK)
+__thread int _st_stack_guard = 1;
+#else
+__thread int _st_stack_guard = 0;
+#endif
+/* Whether paint the stacks, to measure the high-water mark. */
+__thread int _st_stack_watermark = 0;
+
 static char *_st_new_stk_segment(int size);
 static void _st_delete_stk_segment(char *vaddr, int size);
+static void _st_stack_delete(_st_stack_t *ts);
 
 _st_stack_t *_st_stack_new(int stack_size)
 {
     _st_clist_t *qp;
-    _st_stack_t *ts;
+    _st_stack_t *ts = NULL;
     int extra;
 
-   /* If cache stack, we try to use stack from the cache list. */
+    /* Reuse the most recently freed stack of the same size class, which is still hot in cache. Note that all stacks
+     * in the free list are of exited threads, except the current one which is never in the list while it runs. */
+    for (qp = _st_free_stacks.prev; qp != &_st_free_stacks; qp = qp->prev) {
+        _st_stack_t *s = _ST_THREAD_STACK_PTR(qp);
 #ifdef MD_CACHE_STACK
-    for (qp = _st_free_stacks.next; qp != &_st_free_stacks; qp = qp->next) {
-        ts = _ST_THREAD_STACK_PTR(qp);
-        if (ts->stk_size >= stack_size) {
-            /* Found a stack that is big enough */
-            ST_REMOVE_LINK(&ts->links);
+        if (s->stk_size >= stack_size) {
+#else
+        if (s->stk_size == stack_size) {
+#endif
+            ST_REMOVE_LINK(&s->links);
             _st_num_free_stacks--;
-            ts->links.next = NULL;
-            ts->links.prev = NULL;
-            return ts;
+            s->links.next = NULL;
+            s->links.prev = NULL;
+            ts = s;
+            break;
         }
     }
-#endif
 
-    extra = _st_randomize_stacks ? _ST_PAGE_SIZE : 0;
-    /* If not cache stack, we will free all stack in the list, which contains the stack to be freed.
-     * Note that we should never directly free it at _st_stack_free, because it is still be used,
-     * and will cause crash. */
-#ifndef MD_CACHE_STACK
-    for (qp = _st_free_stacks.next; qp != &_st_free_stacks;) {
-        ts = _ST_THREAD_STACK_PTR(qp);
-        /* Before qp is freed, move to next one, because the qp will be freed when free the ts. */
-        qp = qp->next;
-
-        ST_REMOVE_LINK(&ts->links);
+    /* Free the oldest stacks exceed the pool. Note that we should never directly free it at _st_stack_free, because
+     * it is still be used, and will cause crash. */
+    while (_st_stack_pool_max >= 0 && _st_num_free_stacks > _st_stack_pool_max) {
+        _st_stack_t *s = _ST_THREAD_STACK_PTR(_st_free_stacks.next);
+        ST_REMOVE_LINK(&s->links);
         _st_num_free_stacks--;
+        _st_stack_delete(s);
+    }
 
-#if defined(DEBUG) && !defined(MD_NO_PROTECT)
-        mprotect(ts->vaddr, REDZONE, PROT_READ | PROT_WRITE);
-        mprotect(ts->stk_top + extra, REDZONE, PROT_READ | PROT_WRITE);
-#endif
-
-        _st_delete_stk_segment(ts->vaddr, ts->vaddr_size);
-        free(ts);
+    if (ts) {
+        if (ts->painted)
+            memset(ts->stk_bottom, _ST_STACK_PAINT, ts->stk_top - ts->stk_bottom);
+        return ts;
     }
-#endif
-    
+
+    extra = _st_randomize_stacks ? _ST_PAGE_SIZE : 0;
+
     /* Make a new thread stack object. */
     if ((ts = (_st_stack_t *)calloc(1, sizeof(_st_stack_t))) == NULL)
         return NULL;
@@ -117,10 +136,11 @@ _st_stack_t *_st_stack_new(int stack_size)
     ts->stk_top = ts->stk_bottom + stack_size;
 
     /* For example, in OpenWRT, the memory at the begin minus 16B by mprotect is read-only. */
-#if defined(DEBUG) && !defined(MD_NO_PROTECT)
-    mprotect(ts->vaddr, REDZONE, PROT_NONE);
-    mprotect(ts->stk_top + extra, REDZONE, PROT_NONE);
-#endif
+    if (_st_stack_guard) {
+        mprotect(ts->vaddr, REDZONE, PROT_NONE);
+        mprotect(ts->vaddr + ts->vaddr_size - REDZONE, REDZONE, PROT_NONE);
+        ts->guarded = 1;
+    }
     
     if (extra) {
         long offset = (random() % extra) & ~0xf;
@@ -128,6 +148,12 @@ _st_stack_t *_st_stack_new(int stack_size)
         ts->stk_bottom += offset;
         ts->stk_top += offset;
     }
+
+    /* Note that painting touches all pages of stack, so it's only for measurement. */
+    if (_st_stack_watermark) {
+        memset(ts->stk_bottom, _ST_STACK_PAINT, ts->stk_top - ts->stk_bottom);
+        ts->painted = 1;
+    }
     
     return ts;
 }
@@ -147,10 +173,25 @@ void _st_stack_free(_st_stack_t *ts)
 }
 
 
+static void _st_stack_delete(_st_stack_t *ts)
+{
+    if (ts->guarded) {
+        mprotect(ts->vaddr, REDZONE, PROT_READ | PROT_WRITE);
+        mprotect(ts->vaddr + ts->vaddr_size - REDZONE, REDZONE, PROT_READ | PROT_WRITE);
+    }
+
+    _st_delete_stk_segment(ts->vaddr, ts->vaddr_size);
+    free(ts);
+}
+
+
 static char *_st_new_stk_segment(int size)
 {
 #ifdef MALLOC_STACK
-    void *vaddr = malloc(size);
+    /* Align to page, to protect the redzone by mprotect. */
+    void *vaddr = NULL;
+    if (posix_memalign(&vaddr, _ST_PAGE_SIZE, size) != 0)
+        return NULL;
 #else
     static int zero_fd = -1;
     int mmap_flags = MAP_PRIVATE;
@@ -197,3 +238,57 @@ int st_randomize_stacks(int on)
     
     return wason;
 }
+
+
+int st_set_stack_pool(int max)
+{
+    int wasmax = _st_stack_pool_max;
+
+    _st_stack_pool_max = max;
+
+    return wasmax;
+}
+
+int st_set_stack_guard(int on)
+{
+    int wason = _st_stack_guard;
+
+    _st_stack_guard = on;
+
+    return wason;
+}
+
+int st_set_stack_watermark(int on)
+{
+    int wason = _st_stack_watermark;
+
+    _st_stack_watermark = on;
+
+    return wason;
+}
+
+int st_get_free_stacks(void)
+{
+    return _st_num_free_stacks;
+}
+
+int st_get_stack_guard(void)
+{
+    return _st_stack_guard;
+}
+
+int st_thread_stack_watermark(_st_thread_t *thread)
+{
+    _st_stack_t *ts = thread->stack;
+    unsigned char *p;
+
+    /* The primordial thread has no stack, and only painted stack can be measured. */
+    if (!ts || !ts->painted)
+        return -1;
+
+    /* The stack grows down, so the first touched byte from bottom is the high-water mark. */
+    for (p = (unsigned char *)ts->stk_bottom; p < (unsigned char *)ts->stk_top && *p == _ST_STACK_PAINT; p++)
+        ;
+
+    return (int)((unsigned char *)ts->stk_top - p);
+}
@@ -21,6 +21,11 @@ GTEST_API_ int main(int argc, char **argv) {
     // epoll(). On BSD it will be kqueue. On Cygwin it will be select.
 #if __CYGWIN__
     assert(st_set_eventsys(ST_EVENTSYS_SELECT) != -1);
+#elif defined(MD_HAVE_IO_URING)
+    // Prefer io_uring to cover it by utest, fallback to epoll if not supported by kernel.
+    if (st_set_eventsys(ST_EVENTSYS_IO_URING) == -1) {
+        assert(st_set_eventsys(ST_EVENTSYS_ALT) != -1);
+    }
 #else
     assert(st_set_eventsys(ST_EVENTSYS_ALT) != -1);
 #endif
@@ -0,0 +1,257 @@
+/* SPDX-License-Identifier: MIT */
+/* Copyright (c) 2013-2024 The SRS Authors */
+
+#include <st_utest.hpp>
+
+#include <st.h>
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+// The io_uring is built by MD_HAVE_IO_URING, and selected by utest if supported by the kernel.
+#ifdef MD_HAVE_IO_URING
+
+#define ST_UTEST_URING_PORT 26879
+#define ST_UTEST_URING_TIMEOUT (100 * SRS_UTIME_MILLISECONDS)
+
+// Skip the test if the kernel doesn't support io_uring, which falls back to epoll, and the test
+// is reported as skipped, not passed.
+#define ST_UTEST_REQUIRE_IO_URING() \
+    if (st_get_eventsys() != ST_EVENTSYS_IO_URING) GTEST_SKIP() << "io_uring not supported, use " << st_get_eventsys_name()
+
+// The pair of connected ST sockets.
+class StSocketPair
+{
+public:
+    int fds[2];
+    st_netfd_t stfds[2];
+public:
+    StSocketPair() {
+        fds[0] = fds[1] = -1;
+        stfds[0] = stfds[1] = NULL;
+    }
+    virtual ~StSocketPair() {
+        for (int i = 0; i < 2; i++) {
+            if (stfds[i]) {
+                st_netfd_close(stfds[i]);
+            } else if (fds[i] > 0) {
+                ::close(fds[i]);
+            }
+        }
+    }
+public:
+    int initialize() {
+        int r0 = socketpair(AF_UNIX, SOCK_STREAM, 0, fds);
+        if (r0) return r0;
+
+        stfds[0] = st_netfd_open_socket(fds[0]);
+        stfds[1] = st_netfd_open_socket(fds[1]);
+        return (stfds[0] && stfds[1]) ? 0 : -1;
+    }
+    // Close the peer, to make the reader got EOF.
+    void close_peer() {
+        st_netfd_close(stfds[1]);
+        stfds[1] = NULL;
+    }
+};
+
+// The reader coroutine, which parks on the io_uring READ until done.
+struct StUringReader
+{
+    st_netfd_t stfd;
+    st_utime_t timeout;
+    char buf[64];
+    ssize_t nn;
+    int err;
+    bool done;
+
+    StUringReader(st_netfd_t fd, st_utime_t tm) : stfd(fd), timeout(tm), nn(0), err(0), done(false) {
+        memset(buf, 0, sizeof(buf));
+    }
+};
+
+void* uring_reader(void* arg)
+{
+    StUringReader* r = (StUringReader*)arg;
+
+    r->nn = st_read(r->stfd, r->buf, sizeof(r->buf), r->timeout);
+    r->err = (r->nn < 0) ? errno : 0;
+    r->done = true;
+
+    return NULL;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// The utest for io_uring accept.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+void* uring_accept_server(void* arg)
+{
+    st_netfd_t stfd = (st_netfd_t)arg;
+
+    st_netfd_t client = NULL;
+    StStfdCleanup(client);
+
+    // There is no client yet, so accept parks on the io_uring ACCEPT.
+    client = st_accept(stfd, NULL, NULL, ST_UTEST_URING_TIMEOUT);
+    ST_ASSERT_ERROR(!client, -1, "Accept client");
+
+    char buf[8];
+    ssize_t nn = st_read(client, buf, sizeof(buf), ST_UTEST_URING_TIMEOUT);
+    ST_ASSERT_ERROR(nn != 4, (int)nn, "Read client");
+    ST_ASSERT_ERROR(memcmp(buf, "ping", 4), -1, "Read client data");
+
+    return NULL;
+}
+
+VOID TEST(IoUringTest, AcceptAndRead)
+{
+    ST_UTEST_REQUIRE_IO_URING();
+
+    int fd = -1;
+    st_netfd_t stfd = NULL;
+    StFdCleanup(fd, stfd);
+
+    fd = socket(AF_INET, SOCK_STREAM, 0);
+    ASSERT_NE(-1, fd);
+
+    int v = 1;
+    ASSERT_EQ(0, setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &v, sizeof(int)));
+
+    struct sockaddr_in addr;
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = inet_addr("127.0.0.1");
+    addr.sin_port = htons(ST_UTEST_URING_PORT);
+    ASSERT_EQ(0, ::bind(fd, (const sockaddr*)&addr, sizeof(addr)));
+    ASSERT_EQ(0, ::listen(fd, 10));
+
+    stfd = st_netfd_open_socket(fd);
+    ASSERT_TRUE(stfd != NULL);
+
+    st_thread_t svr = st_thread_create(uring_accept_server, stfd, 1, 0);
+    ASSERT_TRUE(svr != NULL);
+
+    // Let the server park on accept, before the client connects.
+    st_usleep(10 * SRS_UTIME_MILLISECONDS);
+
+    int cfd = socket(AF_INET, SOCK_STREAM, 0);
+    st_netfd_t cstfd = NULL;
+    StFdCleanup(cfd, cstfd);
+    ASSERT_NE(-1, cfd);
+
+    cstfd = st_netfd_open_socket(cfd);
+    ASSERT_TRUE(cstfd != NULL);
+    ASSERT_EQ(0, st_connect(cstfd, (const sockaddr*)&addr, sizeof(addr), ST_UTEST_URING_TIMEOUT));
+    ASSERT_EQ(4, st_write(cstfd, "ping", 4, ST_UTEST_URING_TIMEOUT));
+
+    ST_COROUTINE_JOIN(svr, r0);
+    ST_EXPECT_SUCCESS(r0);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// The utest for io_uring read, timeout, interrupt and EOF.
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+VOID TEST(IoUringTest, ReadWhenDataArrives)
+{
+    ST_UTEST_REQUIRE_IO_URING();
+
+    StSocketPair pair;
+    ASSERT_EQ(0, pair.initialize());
+
+    StUringReader r(pair.stfds[0], ST_UTEST_URING_TIMEOUT);
+    st_thread_t trd = st_thread_create(uring_reader, &r, 1, 0);
+    ASSERT_TRUE(trd != NULL);
+
+    // The reader parks on the io_uring READ, because there is no data.
+    st_usleep(10 * SRS_UTIME_MILLISECONDS);
+    EXPECT_FALSE(r.done);
+
+    // The data is copied to the buffer of reader when it arrives.
+    ASSERT_EQ(5, st_write(pair.stfds[1], "hello", 5, ST_UTEST_URING_TIMEOUT));
+    st_thread_join(trd, NULL);
+
+    EXPECT_TRUE(r.done);
+    EXPECT_EQ(5, (int)r.nn);
+    EXPECT_STREQ("hello", r.buf);
+}
+
+VOID TEST(IoUringTest, ReadTimeout)
+{
+    ST_UTEST_REQUIRE_IO_URING();
+
+    StSocketPair pair;
+    ASSERT_EQ(0, pair.initialize());
+
+    StUringReader r(pair.stfds[0], 10 * SRS_UTIME_MILLISECONDS);
+    st_thread_t trd = st_thread_create(uring_reader, &r, 1, 0);
+    ASSERT_TRUE(trd != NULL);
+    st_thread_join(trd, NULL);
+
+    EXPECT_EQ(-1, (int)r.nn);
+    EXPECT_EQ(ETIME, r.err);
+
+    // The request is canceled, so the next read got the data, not lost by the canceled one.
+    ASSERT_EQ(5, st_write(pair.stfds[1], "hello", 5, ST_UTEST_URING_TIMEOUT));
+
+    char buf[8] = {0};
+    EXPECT_EQ(5, (int)st_read(pair.stfds[0], buf, sizeof(buf), ST_UTEST_URING_TIMEOUT));
+    EXPECT_STREQ("hello", buf);
+}
+
+VOID TEST(IoUringTest, ReadInterrupt)
+{
+    ST_UTEST_REQUIRE_IO_URING();
+
+    StSocketPair pair;
+    ASSERT_EQ(0, pair.initialize());
+
+    StUringReader r(pair.stfds[0], ST_UTIME_NO_TIMEOUT);
+    st_thread_t trd = st_thread_create(uring_reader, &r, 1, 0);
+    ASSERT_TRUE(trd != NULL);
+
+    st_usleep(10 * SRS_UTIME_MILLISECONDS);
+    EXPECT_FALSE(r.done);
+
+    // Interrupt the parked reader, which cancels the request.
+    st_thread_interrupt(trd);
+    st_thread_join(trd, NULL);
+
+    EXPECT_EQ(-1, (int)r.nn);
+    EXPECT_EQ(EINTR, r.err);
+
+    // The socket is still available after interrupted.
+    ASSERT_EQ(5, st_write(pair.stfds[1], "hello", 5, ST_UTEST_URING_TIMEOUT));
+
+    char buf[8] = {0};
+    EXPECT_EQ(5, (int)st_read(pair.stfds[0], buf, sizeof(buf), ST_UTEST_URING_TIMEOUT));
+    EXPECT_STREQ("hello", buf);
+}
+
+VOID TEST(IoUringTest, ReadEOF)
+{
+    ST_UTEST_REQUIRE_IO_URING();
+
+    StSocketPair pair;
+    ASSERT_EQ(0, pair.initialize());
+
+    StUringReader r(pair.stfds[0], ST_UTEST_URING_TIMEOUT);
+    st_thread_t trd = st_thread_create(uring_reader, &r, 1, 0);
+    ASSERT_TRUE(trd != NULL);
+
+    st_usleep(10 * SRS_UTIME_MILLISECONDS);
+    EXPECT_FALSE(r.done);
+
+    // The parked reader got EOF when peer closed.
+    pair.close_peer();
+    st_thread_join(trd, NULL);
+
+    EXPECT_TRUE(r.done);
+    EXPECT_EQ(0, (int)r.nn);
+}
+
+#endif
+
@@ -128,6 +128,8 @@ SRS_NASM=YES
 SRS_SRTP_ASM=YES
 SRS_DEBUG=NO
 SRS_DEBUG_STATS=NO
+# Whether use io_uring for ST, which is selected by env SRS_IO_URING=on at runtime.
+SRS_IO_URING=NO
 
 #####################################################################################
 function apply_system_options() {
@@ -238,6 +240,7 @@ Experts:
   --build-tag=<TAG>         Set the build object directory suffix.
   --debug=on|off            Whether enable the debug code, may hurt performance. Default: $(value2switch $SRS_DEBUG)
   --debug-stats=on|off      Whether enable the debug stats, may hurt performance. Default: $(value2switch $SRS_DEBUG_STATS)
+  --io-uring=on|off         Whether build ST with io_uring, enabled by env SRS_IO_URING=on. Default: $(value2switch $SRS_IO_URING)
   --gcov=on|off             Whether enable the GCOV for coverage. Default: $(value2switch $SRS_GCOV)
   --log-verbose=on|off      Whether enable the log verbose level. Default: $(value2switch $SRS_LOG_VERBOSE)
   --log-info=on|off         Whether enable the log info level. Default: $(value2switch $SRS_LOG_INFO)
@@ -380,6 +383,7 @@ function parse_user_option() {
         --log-level_v2)                 SRS_LOG_LEVEL_V2=$(switch2value $value) ;;
         --debug)                        SRS_DEBUG=$(switch2value $value) ;;
         --debug-stats)                  SRS_DEBUG_STATS=$(switch2value $value) ;;
+        --io-uring)                     SRS_IO_URING=$(switch2value $value) ;;
 
         --cross-build)                  SRS_CROSS_BUILD=YES         ;;
         --generic-linux)                SRS_GENERIC_LINUX=$(switch2value $value) ;;
@@ -567,6 +571,16 @@ function apply_auto_options() {
         SRS_SRTP_ASM=NO
     fi
 
+    # The io_uring is only for Linux, and requires the kernel headers.
+    if [[ $SRS_IO_URING == YES && ($SRS_OSX == YES || $SRS_CYGWIN64 == YES) ]]; then
+        echo "Disable io_uring for non-Linux"
+        SRS_IO_URING=NO
+    fi
+    if [[ $SRS_IO_URING == YES && ! -f /usr/include/linux/io_uring.h ]]; then
+        echo "Disable io_uring, because no linux/io_uring.h"
+        SRS_IO_URING=NO
+    fi
+
     # TODO: FIXME: Should build address sanitizer for cygwin64.
     # See https://github.com/ossrs/srs/issues/3252
     if [[ $SRS_CYGWIN64 == YES && $SRS_SANITIZER == YES ]]; then
@@ -675,6 +689,7 @@ function regenerate_options() {
     SRS_AUTO_CONFIGURE="${SRS_AUTO_CONFIGURE} --apm=$(value2switch $SRS_APM)"
     SRS_AUTO_CONFIGURE="${SRS_AUTO_CONFIGURE} --debug=$(value2switch $SRS_DEBUG)"
     SRS_AUTO_CONFIGURE="${SRS_AUTO_CONFIGURE} --debug-stats=$(value2switch $SRS_DEBUG_STATS)"
+    SRS_AUTO_CONFIGURE="${SRS_AUTO_CONFIGURE} --io-uring=$(value2switch $SRS_IO_URING)"
     SRS_AUTO_CONFIGURE="${SRS_AUTO_CONFIGURE} --cross-build=$(value2switch $SRS_CROSS_BUILD)"
     SRS_AUTO_CONFIGURE="${SRS_AUTO_CONFIGURE} --sanitizer=$(value2switch $SRS_SANITIZER)"
     SRS_AUTO_CONFIGURE="${SRS_AUTO_CONFIGURE} --sanitizer-static=$(value2switch $SRS_SANITIZER_STATIC)"
@@ -0,0 +1,81 @@
+# Install script for directory: /root/repo/trunk/objs/Platform-SRS7-Linux-6.18.44-GCC12.2.0-x86_64/srt-1-fit
+
+# Set the install prefix
+if(NOT DEFINED CMAKE_INSTALL_PREFIX)
+  set(CMAKE_INSTALL_PREFIX "/root/repo/trunk/objs/Platform-SRS7-Linux-6.18.44-GCC12.2.0-x86_64/3rdparty/srt")
+endif()
+string(REGEX REPLACE "/$" "" CMAKE_INSTALL_PREFIX "${CMAKE_INSTALL_PREFIX}")
+
+# Set the install configuration name.
+if(NOT DEFINED CMAKE_INSTALL_CONFIG_NAME)
+  if(BUILD_TYPE)
+    string(REGEX REPLACE "^[^A-Za-z0-9_]+" ""
+           CMAKE_INSTALL_CONFIG_NAME "${BUILD_TYPE}")
+  else()
+    set(CMAKE_INSTALL_CONFIG_NAME "Release")
+  endif()
+  message(STATUS "Install configuration: \"${CMAKE_INSTALL_CONFIG_NAME}\"")
+endif()
+
+# Set the component getting installed.
+if(NOT CMAKE_INSTALL_COMPONENT)
+  if(COMPONENT)
+    message(STATUS "Install component: \"${COMPONENT}\"")
+    set(CMAKE_INSTALL_COMPONENT "${COMPONENT}")
+  else()
+    set(CMAKE_INSTALL_COMPONENT)
+  endif()
+endif()
+
+# Install shared libraries without execute permission?
+if(NOT DEFINED CMAKE_INSTALL_SO_NO_EXE)
+  set(CMAKE_INSTALL_SO_NO_EXE "1")
+endif()
+
+# Is this installation the result of a crosscompile?
+if(NOT DEFINED CMAKE_CROSSCOMPILING)
+  set(CMAKE_CROSSCOMPILING "FALSE")
+endif()
+
+# Set default install directory permissions.
+if(NOT DEFINED CMAKE_OBJDUMP)
+  set(CMAKE_OBJDUMP "/usr/bin/objdump")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib" TYPE STATIC_LIBRARY FILES "/root/repo/trunk/objs/Platform-SRS7-Linux-6.18.44-GCC12.2.0-x86_64/srt-1-fit/libsrt.a")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/include/srt" TYPE FILE FILES
+    "/root/repo/trunk/objs/Platform-SRS7-Linux-6.18.44-GCC12.2.0-x86_64/srt-1-fit/version.h"
+    "/root/repo/trunk/objs/Platform-SRS7-Linux-6.18.44-GCC12.2.0-x86_64/srt-1-fit/srtcore/srt.h"
+    "/root/repo/trunk/objs/Platform-SRS7-Linux-6.18.44-GCC12.2.0-x86_64/srt-1-fit/srtcore/logging_api.h"
+    "/root/repo/trunk/objs/Platform-SRS7-Linux-6.18.44-GCC12.2.0-x86_64/srt-1-fit/srtcore/access_control.h"
+    "/root/repo/trunk/objs/Platform-SRS7-Linux-6.18.44-GCC12.2.0-x86_64/srt-1-fit/srtcore/platform_sys.h"
+    "/root/repo/trunk/objs/Platform-SRS7-Linux-6.18.44-GCC12.2.0-x86_64/srt-1-fit/srtcore/udt.h"
+    )
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib/pkgconfig" TYPE FILE FILES "/root/repo/trunk/objs/Platform-SRS7-Linux-6.18.44-GCC12.2.0-x86_64/srt-1-fit/haisrt.pc")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/lib/pkgconfig" TYPE FILE FILES "/root/repo/trunk/objs/Platform-SRS7-Linux-6.18.44-GCC12.2.0-x86_64/srt-1-fit/srt.pc")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT STREQUAL "Unspecified" OR NOT CMAKE_INSTALL_COMPONENT)
+  file(INSTALL DESTINATION "${CMAKE_INSTALL_PREFIX}/bin" TYPE PROGRAM FILES "/root/repo/trunk/objs/Platform-SRS7-Linux-6.18.44-GCC12.2.0-x86_64/srt-1-fit/scripts/srt-ffplay")
+endif()
+
+if(CMAKE_INSTALL_COMPONENT)
+  set(CMAKE_INSTALL_MANIFEST "install_manifest_${CMAKE_INSTALL_COMPONENT}.txt")
+else()
+  set(CMAKE_INSTALL_MANIFEST "install_manifest.txt")
+endif()
+
+string(REPLACE ";" "\n" CMAKE_INSTALL_MANIFEST_CONTENT
+       "${CMAKE_INSTALL_MANIFEST_FILES}")
+file(WRITE "/root/repo/trunk/objs/Platform-SRS7-Linux-6.18.44-GCC12.2.0-x86_64/srt-1-fit/${CMAKE_INSTALL_MANIFEST}"
+     "${CMAKE_INSTALL_MANIFEST_CONTENT}")
@@ -0,0 +1,3 @@
+@ECHO OFF
+%SYSTEMROOT%\System32\WindowsPowerShell\v1.0\PowerShell.exe -Command "& '%~dpn0.ps1'"
+pause
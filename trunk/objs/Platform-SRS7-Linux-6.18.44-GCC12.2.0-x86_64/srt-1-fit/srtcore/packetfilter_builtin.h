@@ -0,0 +1,18 @@
+/*
+ * SRT - Secure, Reliable, Transport
+ * Copyright (c) 2019 Haivision Systems Inc.
+ * 
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ * 
+ */
+
+
+#ifndef INC_SRT_PACKETFILTER_BUILTIN_H
+#define INC_SRT_PACKETFILTER_BUILTIN_H
+
+// Integration header
+#include "fec.h"
+
+#endif
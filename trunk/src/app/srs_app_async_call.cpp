@@ -10,6 +10,14 @@ using namespace std;
 
 #include <srs_kernel_error.hpp>
 #include <srs_kernel_log.hpp>
+#include <srs_kernel_utility.hpp>
+#include <srs_app_config.hpp>
+#include <srs_kernel_kbps.hpp>
+
+// The number of async tasks called, dropped, and the total queue latency in ms.
+SrsPps* _srs_pps_async_calls = NULL;
+SrsPps* _srs_pps_async_drops = NULL;
+SrsPps* _srs_pps_async_wait = NULL;
 
 ISrsAsyncCallTask::ISrsAsyncCallTask()
 {
@@ -19,33 +27,124 @@ ISrsAsyncCallTask::~ISrsAsyncCallTask()
 {
 }
 
-SrsAsyncCallWorker::SrsAsyncCallWorker()
+std::string ISrsAsyncCallTask::destination()
 {
+    return "";
+}
+
+SrsAsyncCallExecutor::SrsAsyncCallExecutor(SrsAsyncCallWorker* w)
+{
+    worker = w;
     trd = new SrsDummyCoroutine();
+}
+
+SrsAsyncCallExecutor::~SrsAsyncCallExecutor()
+{
+    srs_freep(trd);
+}
+
+srs_error_t SrsAsyncCallExecutor::start()
+{
+    srs_error_t err = srs_success;
+
+    srs_freep(trd);
+    trd = new SrsSTCoroutine("async", this, _srs_context->get_id());
+
+    if ((err = trd->start()) != srs_success) {
+        return srs_error_wrap(err, "coroutine");
+    }
+
+    return err;
+}
+
+void SrsAsyncCallExecutor::stop()
+{
+    trd->stop();
+}
+
+srs_error_t SrsAsyncCallExecutor::cycle()
+{
+    srs_error_t err = srs_success;
+
+    while (true) {
+        if ((err = trd->pull()) != srs_success) {
+            return srs_error_wrap(err, "async call worker");
+        }
+
+        SrsAsyncCallEntry entry;
+        if (!worker->pick(entry)) {
+            srs_cond_wait(worker->wait);
+            continue;
+        }
+
+        worker->call(entry);
+    }
+
+    return err;
+}
+
+SrsAsyncCallWorker::SrsAsyncCallWorker()
+{
+    nn_executors = 1;
+    max_per_destination = 0;
+    max_tasks = 0;
+    drop_oldest = true;
+    nn_running_tasks = 0;
     wait = srs_cond_new();
-    lock = srs_mutex_new();
 }
 
 SrsAsyncCallWorker::~SrsAsyncCallWorker()
 {
-    srs_freep(trd);
-    
-    std::vector<ISrsAsyncCallTask*>::iterator it;
-    for (it = tasks.begin(); it != tasks.end(); ++it) {
-        ISrsAsyncCallTask* task = *it;
+    std::vector<SrsAsyncCallExecutor*>::iterator it;
+    for (it = executors.begin(); it != executors.end(); ++it) {
+        SrsAsyncCallExecutor* executor = *it;
+        srs_freep(executor);
+    }
+    executors.clear();
+
+    std::deque<SrsAsyncCallEntry>::iterator it2;
+    for (it2 = tasks.begin(); it2 != tasks.end(); ++it2) {
+        ISrsAsyncCallTask* task = it2->task;
         srs_freep(task);
     }
     tasks.clear();
     
     srs_cond_destroy(wait);
-    srs_mutex_destroy(lock);
+}
+
+void SrsAsyncCallWorker::set_executors(int v)
+{
+    nn_executors = srs_max(1, v);
 }
 
 srs_error_t SrsAsyncCallWorker::execute(ISrsAsyncCallTask* t)
 {
     srs_error_t err = srs_success;
-    
-    tasks.push_back(t);
+
+    // Drop task when queue overflow, to avoid the backlog grows without bound when callback
+    // server is down or too slow. Note that we never return error, because the caller, such
+    // as HLS, should not fail for callback.
+    if (max_tasks > 0 && (int)tasks.size() >= max_tasks) {
+        _srs_pps_async_drops->sugar++;
+
+        if (!drop_oldest) {
+            srs_warn("async: drop newest task %s, queue=%d", t->to_string().c_str(), (int)tasks.size());
+            srs_freep(t);
+            return err;
+        }
+
+        ISrsAsyncCallTask* task = tasks.front().task;
+        srs_warn("async: drop oldest task %s, queue=%d", task->to_string().c_str(), (int)tasks.size());
+        tasks.pop_front();
+        srs_freep(task);
+    }
+
+    SrsAsyncCallEntry entry;
+    entry.task = t;
+    entry.dest = t->destination();
+    entry.starttime = srs_get_system_time();
+    tasks.push_back(entry);
+
     srs_cond_signal(wait);
     
     return err;
@@ -56,15 +155,26 @@ int SrsAsyncCallWorker::count()
     return (int)tasks.size();
 }
 
+int SrsAsyncCallWorker::nn_running()
+{
+    return nn_running_tasks;
+}
+
 srs_error_t SrsAsyncCallWorker::start()
 {
     srs_error_t err = srs_success;
-    
-    srs_freep(trd);
-    trd = new SrsSTCoroutine("async", this, _srs_context->get_id());
-    
-    if ((err = trd->start()) != srs_success) {
-        return srs_error_wrap(err, "coroutine");
+
+    max_per_destination = _srs_config->get_async_call_max_per_destination();
+    max_tasks = _srs_config->get_async_call_max_tasks();
+    drop_oldest = _srs_config->get_async_call_overflow() != "drop_newest";
+
+    for (int i = (int)executors.size(); i < nn_executors; i++) {
+        SrsAsyncCallExecutor* executor = new SrsAsyncCallExecutor(this);
+        executors.push_back(executor);
+
+        if ((err = executor->start()) != srs_success) {
+            return srs_error_wrap(err, "executor #%d", i);
+        }
     }
     
     return err;
@@ -73,49 +183,83 @@ srs_error_t SrsAsyncCallWorker::start()
 void SrsAsyncCallWorker::stop()
 {
     flush_tasks();
-    srs_cond_signal(wait);
-    trd->stop();
+
+    std::vector<SrsAsyncCallExecutor*>::iterator it;
+    for (it = executors.begin(); it != executors.end(); ++it) {
+        SrsAsyncCallExecutor* executor = *it;
+        executor->stop();
+    }
 }
 
-srs_error_t SrsAsyncCallWorker::cycle()
+bool SrsAsyncCallWorker::pick(SrsAsyncCallEntry& entry)
 {
-    srs_error_t err = srs_success;
-    
-    while (true) {
-        if ((err = trd->pull()) != srs_success) {
-            return srs_error_wrap(err, "async call worker");
-        }
-        
-        if (tasks.empty()) {
-            srs_cond_wait(wait);
+    std::deque<SrsAsyncCallEntry>::iterator it;
+    for (it = tasks.begin(); it != tasks.end(); ++it) {
+        const std::string& dest = it->dest;
+
+        // Skip the task if its destination is busy, so the slow destination never blocks others.
+        if (max_per_destination > 0 && !dest.empty()) {
+            std::map<std::string, int>::iterator r = running.find(dest);
+            if (r != running.end() && r->second >= max_per_destination) {
+                continue;
+            }
         }
 
-        flush_tasks();
+        entry = *it;
+        tasks.erase(it);
+
+        _srs_pps_async_wait->sugar += srsu2ms(srs_get_system_time() - entry.starttime);
+        return true;
     }
-    
-    return err;
+
+    return false;
 }
 
-void SrsAsyncCallWorker::flush_tasks()
+void SrsAsyncCallWorker::call(SrsAsyncCallEntry& entry)
 {
     srs_error_t err = srs_success;
 
-    // Avoid the async call blocking other coroutines.
-    std::vector<ISrsAsyncCallTask*> copy;
-    if (true) {
-        SrsLocker(lock);
+    ISrsAsyncCallTask* task = entry.task;
+    const std::string& dest = entry.dest;
+
+    nn_running_tasks++;
+    if (!dest.empty()) {
+        running[dest]++;
+    }
+
+    if ((err = task->call()) != srs_success) {
+        srs_warn("ignore task failed %s", srs_error_desc(err).c_str());
+        srs_freep(err);
+    }
+    srs_freep(task);
+
+    nn_running_tasks--;
+    _srs_pps_async_calls->sugar++;
 
-        if (tasks.empty()) {
-            return;
+    if (!dest.empty()) {
+        std::map<std::string, int>::iterator it = running.find(dest);
+        if (it != running.end() && --it->second <= 0) {
+            running.erase(it);
         }
 
-        copy = tasks;
-        tasks.clear();
+        // Wakeup the executors, which might be waiting for the destination.
+        if (max_per_destination > 0) {
+            srs_cond_broadcast(wait);
+        }
     }
+}
 
-    std::vector<ISrsAsyncCallTask*>::iterator it;
+void SrsAsyncCallWorker::flush_tasks()
+{
+    srs_error_t err = srs_success;
+
+    // Avoid the async call blocking other coroutines.
+    std::deque<SrsAsyncCallEntry> copy;
+    copy.swap(tasks);
+
+    std::deque<SrsAsyncCallEntry>::iterator it;
     for (it = copy.begin(); it != copy.end(); ++it) {
-        ISrsAsyncCallTask* task = *it;
+        ISrsAsyncCallTask* task = it->task;
 
         if ((err = task->call()) != srs_success) {
             srs_warn("ignore task failed %s", srs_error_desc(err).c_str());
@@ -125,4 +269,3 @@ void SrsAsyncCallWorker::flush_tasks()
     }
 }
 
-
@@ -11,6 +11,8 @@
 
 #include <string>
 #include <vector>
+#include <deque>
+#include <map>
 
 #include <srs_app_st.hpp>
 
@@ -32,32 +34,82 @@ public:
     // Convert task to string to describe it.
     // It's used for logger.
     virtual std::string to_string() = 0;
+    // The destination of task, for example, the url of callback server, the worker limits
+    // the concurrent tasks of the same destination. Empty string for no limit.
+    virtual std::string destination();
+};
+
+class SrsAsyncCallWorker;
+
+// The executor of async worker, which is a coroutine to pick and call the tasks.
+class SrsAsyncCallExecutor : public ISrsCoroutineHandler
+{
+private:
+    SrsCoroutine* trd;
+    SrsAsyncCallWorker* worker;
+public:
+    SrsAsyncCallExecutor(SrsAsyncCallWorker* w);
+    virtual ~SrsAsyncCallExecutor();
+public:
+    virtual srs_error_t start();
+    virtual void stop();
+// Interface ISrsCoroutineHandler
+public:
+    virtual srs_error_t cycle();
+};
+
+// The queued task, with the time when it's queued, to stat the queue latency.
+struct SrsAsyncCallEntry
+{
+    ISrsAsyncCallTask* task;
+    // The destination of task, see ISrsAsyncCallTask::destination.
+    std::string dest;
+    srs_utime_t starttime;
 };
 
 // The async callback for dvr, callback and other async worker.
 // When worker call with the task, the worker will do it in isolate thread.
 // That is, the task is execute/call in async mode.
-class SrsAsyncCallWorker : public ISrsCoroutineHandler
+// @remark There are N executors to call the tasks concurrently, so a slow callback server never
+//      blocks the others, however, the tasks are called in order only when there is one executor.
+class SrsAsyncCallWorker
 {
+    friend class SrsAsyncCallExecutor;
 private:
-    SrsCoroutine* trd;
+    std::vector<SrsAsyncCallExecutor*> executors;
+    // The number of executors, default to 1.
+    int nn_executors;
+    // The max concurrent tasks for each destination, 0 for no limit.
+    int max_per_destination;
+    // The max queued tasks, 0 for no limit.
+    int max_tasks;
+    // Whether drop the oldest task when queue is full, otherwise drop the newest one.
+    bool drop_oldest;
+    // The number of running tasks of each destination.
+    std::map<std::string, int> running;
+    // The total number of running tasks.
+    int nn_running_tasks;
 protected:
-    std::vector<ISrsAsyncCallTask*> tasks;
+    std::deque<SrsAsyncCallEntry> tasks;
     srs_cond_t wait;
-    srs_mutex_t lock;
 public:
     SrsAsyncCallWorker();
     virtual ~SrsAsyncCallWorker();
 public:
+    // Set the number of executors, should be called before start.
+    virtual void set_executors(int v);
     virtual srs_error_t execute(ISrsAsyncCallTask* t);
     virtual int count();
+    // Get the number of running tasks.
+    virtual int nn_running();
 public:
     virtual srs_error_t start();
     virtual void stop();
-// Interface ISrsReusableThreadHandler
-public:
-    virtual srs_error_t cycle();
 private:
+    // Pick the first task whose destination is not busy, return NULL if no task to call.
+    virtual bool pick(SrsAsyncCallEntry& entry);
+    // Call the task by executor, and free the task.
+    virtual void call(SrsAsyncCallEntry& entry);
     virtual void flush_tasks();
 };
 
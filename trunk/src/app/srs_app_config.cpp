@@ -1350,6 +1350,41 @@ SrsConfig::~SrsConfig()
     srs_freep(root);
 }
 
+SrsVhostConfig::SrsVhostConfig()
+{
+    enabled = false;
+    is_edge = false;
+    priority = 0;
+
+    gop_cache = false;
+    gop_cache_max_frames = 0;
+    queue_length = 0;
+    time_jitter = 0;
+    mix_correct = false;
+    atc = false;
+    atc_auto = false;
+    reduce_sequence_header = false;
+    send_min_interval = 0;
+    adaptive_drop = false;
+    fast_start = false;
+    fast_start_catchup = 0;
+    realtime = false;
+    mw_sleep = 0;
+    mw_msgs = 0;
+    zerocopy = false;
+    zerocopy_threshold = 0;
+
+    rtc_realtime = false;
+    rtc_mw_msgs = 0;
+    rtc_nack = false;
+    rtc_nack_no_copy = false;
+    rtc_twcc = false;
+}
+
+SrsVhostConfig::~SrsVhostConfig()
+{
+}
+
 void SrsConfig::subscribe(ISrsReloadHandler* handler)
 {
     std::vector<ISrsReloadHandler*>::iterator it;
@@ -1374,6 +1409,63 @@ void SrsConfig::unsubscribe(ISrsReloadHandler* handler)
     it = subscribes.erase(it);
 }
 
+SrsSharedPtr<SrsVhostConfig> SrsConfig::get_vhost_snapshot(string vhost)
+{
+    std::map<std::string, SrsSharedPtr<SrsVhostConfig> >::iterator it = snapshots_.find(vhost);
+    if (it != snapshots_.end()) {
+        return it->second;
+    }
+
+    // Use the resolved vhost as key, to avoid creating snapshot for each unknown vhost.
+    SrsConfDirective* conf = get_vhost(vhost);
+    string key = conf ? conf->arg0() : "";
+
+    if (key != vhost && (it = snapshots_.find(key)) != snapshots_.end()) {
+        return it->second;
+    }
+
+    SrsSharedPtr<SrsVhostConfig> snapshot(compile_vhost(vhost));
+    snapshot->vhost = key;
+    snapshots_[key] = snapshot;
+
+    return snapshot;
+}
+
+SrsVhostConfig* SrsConfig::compile_vhost(string vhost)
+{
+    SrsVhostConfig* v = new SrsVhostConfig();
+
+    v->enabled = get_vhost_enabled(vhost);
+    v->is_edge = get_vhost_is_edge(vhost);
+    v->priority = get_vhost_priority(vhost);
+
+    v->gop_cache = get_gop_cache(vhost);
+    v->gop_cache_max_frames = get_gop_cache_max_frames(vhost);
+    v->queue_length = get_queue_length(vhost);
+    v->time_jitter = get_time_jitter(vhost);
+    v->mix_correct = get_mix_correct(vhost);
+    v->atc = get_atc(vhost);
+    v->atc_auto = get_atc_auto(vhost);
+    v->reduce_sequence_header = get_reduce_sequence_header(vhost);
+    v->send_min_interval = get_send_min_interval(vhost);
+    v->adaptive_drop = get_adaptive_drop(vhost);
+    v->fast_start = get_fast_start(vhost);
+    v->fast_start_catchup = get_fast_start_catchup(vhost);
+    v->realtime = get_realtime_enabled(vhost);
+    v->mw_sleep = get_mw_sleep(vhost);
+    v->mw_msgs = get_mw_msgs(vhost, v->realtime);
+    v->zerocopy = get_zerocopy(vhost);
+    v->zerocopy_threshold = get_zerocopy_threshold(vhost);
+
+    v->rtc_realtime = get_realtime_enabled(vhost, true);
+    v->rtc_mw_msgs = get_mw_msgs(vhost, v->rtc_realtime, true);
+    v->rtc_nack = get_rtc_nack_enabled(vhost);
+    v->rtc_nack_no_copy = get_rtc_nack_no_copy(vhost);
+    v->rtc_twcc = get_rtc_twcc_enabled(vhost);
+
+    return v;
+}
+
 // LCOV_EXCL_START
 srs_error_t SrsConfig::reload(SrsReloadState *pstate)
 {
@@ -1632,6 +1724,9 @@ srs_error_t SrsConfig::reload_conf(SrsConfig* conf)
     SrsUniquePtr<SrsConfDirective> old_root(root);
     root = conf->root;
     conf->root = NULL;
+
+    // Drop the snapshots, which will be rebuilt from new root, before notify the reload handlers.
+    snapshots_.clear();
     
     // never support reload:
     //      daemon
@@ -2338,7 +2433,8 @@ srs_error_t SrsConfig::check_normal_config()
             && n != "inotify_auto_reload" && n != "auto_reload_for_docker" && n != "tcmalloc_release_rate"
             && n != "query_latest_version" && n != "first_wait_for_qlv" && n != "threads"
             && n != "circuit_breaker" && n != "is_full" && n != "in_docker" && n != "tencentcloud_cls"
-            && n != "exporter"
+            && n != "exporter" && n != "rtmp_handshake" && n != "async_call" && n != "load_redirect"
+            && n != "stack"
             ) {
             return srs_error_new(ERROR_SYSTEM_CONFIG_INVALID, "illegal directive %s", n.c_str());
         }
@@ -2404,6 +2500,43 @@ srs_error_t SrsConfig::check_normal_config()
             }
         }
     }
+    if (true) {
+        SrsConfDirective* conf = root->get("rtmp_handshake");
+        for (int i = 0; conf && i < (int)conf->directives.size(); i++) {
+            string n = conf->at(i)->name;
+            if (n != "dh_pool" && n != "dh_refill" && n != "max_concurrency") {
+                return srs_error_new(ERROR_SYSTEM_CONFIG_INVALID, "illegal rtmp_handshake.%s", n.c_str());
+            }
+        }
+    }
+    if (true) {
+        SrsConfDirective* conf = root->get("async_call");
+        for (int i = 0; conf && i < (int)conf->directives.size(); i++) {
+            string n = conf->at(i)->name;
+            if (n != "executors" && n != "max_per_destination" && n != "max_tasks" && n != "overflow") {
+                return srs_error_new(ERROR_SYSTEM_CONFIG_INVALID, "illegal async_call.%s", n.c_str());
+            }
+        }
+    }
+    if (true) {
+        SrsConfDirective* conf = root->get("load_redirect");
+        for (int i = 0; conf && i < (int)conf->directives.size(); i++) {
+            string n = conf->at(i)->name;
+            if (n != "enabled" && n != "ip" && n != "peers" && n != "cpu" && n != "connections" && n != "mbps"
+                && n != "publish") {
+                return srs_error_new(ERROR_SYSTEM_CONFIG_INVALID, "illegal load_redirect.%s", n.c_str());
+            }
+        }
+    }
+    if (true) {
+        SrsConfDirective* conf = root->get("stack");
+        for (int i = 0; conf && i < (int)conf->directives.size(); i++) {
+            string n = conf->at(i)->name;
+            if (n != "pool" && n != "guard" && n != "watermark" && n != "size" && n != "sizes") {
+                return srs_error_new(ERROR_SYSTEM_CONFIG_INVALID, "illegal stack.%s", n.c_str());
+            }
+        }
+    }
     if (true) {
         SrsConfDirective* conf = get_stats();
         for (int i = 0; conf && i < (int)conf->directives.size(); i++) {
@@ -2467,6 +2600,29 @@ srs_error_t SrsConfig::check_normal_config()
             get_heartbeat_interval());
     }
     
+    ////////////////////////////////////////////////////////////////////////
+    // check stack
+    ////////////////////////////////////////////////////////////////////////
+    if (get_stack_pool() < -1) {
+        return srs_error_new(ERROR_SYSTEM_CONFIG_INVALID, "invalid stack.pool=%d", get_stack_pool());
+    }
+    if (true) {
+        int size = get_stack_size();
+        if (size != 0 && (size < SRS_STACK_MIN_SIZE || size > SRS_STACK_MAX_SIZE)) {
+            return srs_error_new(ERROR_SYSTEM_CONFIG_INVALID, "invalid stack.size=%d, should be 0 or in [%d, %d]",
+                size, SRS_STACK_MIN_SIZE, SRS_STACK_MAX_SIZE);
+        }
+    }
+    if (true) {
+        map<string, int> sizes = get_stack_sizes();
+        for (map<string, int>::iterator it = sizes.begin(); it != sizes.end(); ++it) {
+            if (it->second < SRS_STACK_MIN_SIZE || it->second > SRS_STACK_MAX_SIZE) {
+                return srs_error_new(ERROR_SYSTEM_CONFIG_INVALID, "invalid stack.sizes.%s=%d, should be in [%d, %d]",
+                    it->first.c_str(), it->second, SRS_STACK_MIN_SIZE, SRS_STACK_MAX_SIZE);
+            }
+        }
+    }
+    
     ////////////////////////////////////////////////////////////////////////
     // check stats
     ////////////////////////////////////////////////////////////////////////
@@ -2585,7 +2741,7 @@ srs_error_t SrsConfig::check_normal_config()
                 && n != "play" && n != "publish" && n != "cluster"
                 && n != "security" && n != "http_remux" && n != "dash"
                 && n != "http_static" && n != "hds" && n != "exec"
-                && n != "in_ack_size" && n != "out_ack_size" && n != "rtc" && n != "srt") {
+                && n != "in_ack_size" && n != "out_ack_size" && n != "rtc" && n != "srt" && n != "priority") {
                 return srs_error_new(ERROR_SYSTEM_CONFIG_INVALID, "illegal vhost.%s", n.c_str());
             }
             // for each sub directives of vhost.
@@ -2616,7 +2772,8 @@ srs_error_t SrsConfig::check_normal_config()
                     string m = conf->at(j)->name;
                     if (m != "time_jitter" && m != "mix_correct" && m != "atc" && m != "atc_auto" && m != "mw_latency"
                         && m != "gop_cache" && m != "gop_cache_max_frames" && m != "queue_length" && m != "send_min_interval" && m != "reduce_sequence_header"
-                        && m != "mw_msgs") {
+                        && m != "mw_msgs" && m != "adaptive_drop" && m != "fast_start" && m != "fast_start_catchup"
+                        && m != "zerocopy" && m != "zerocopy_threshold") {
                         return srs_error_new(ERROR_SYSTEM_CONFIG_INVALID, "illegal vhost.play.%s of %s", m.c_str(), vhost->arg0().c_str());
                     }
                 }
@@ -2624,7 +2781,9 @@ srs_error_t SrsConfig::check_normal_config()
                 for (int j = 0; j < (int)conf->directives.size(); j++) {
                     string m = conf->at(j)->name;
                     if (m != "mode" && m != "origin" && m != "token_traverse" && m != "vhost" && m != "debug_srs_upnode" && m != "coworkers"
-                        && m != "origin_cluster" && m != "protocol" && m != "follow_client") {
+                        && m != "directory" && m != "directory_ttl" && m != "origin_cluster" && m != "protocol" && m != "follow_client"
+                        && m != "balance" && m != "http_origin" && m != "http_playlist_ttl" && m != "http_segment_ttl"
+                        && m != "http_cache_size") {
                         return srs_error_new(ERROR_SYSTEM_CONFIG_INVALID, "illegal vhost.cluster.%s of %s", m.c_str(), vhost->arg0().c_str());
                     }
                 }
@@ -2687,7 +2846,8 @@ srs_error_t SrsConfig::check_normal_config()
                     string m = conf->at(j)->name;
                     if (m != "enabled" && m != "on_connect" && m != "on_close" && m != "on_publish"
                         && m != "on_unpublish" && m != "on_play" && m != "on_stop"
-                        && m != "on_dvr" && m != "on_hls" && m != "on_hls_notify") {
+                        && m != "on_dvr" && m != "on_hls" && m != "on_hls_notify"
+                        && m != "cache_ttl" && m != "cache_key" && m != "coalesce") {
                         return srs_error_new(ERROR_SYSTEM_CONFIG_INVALID, "illegal vhost.http_hooks.%s of %s", m.c_str(), vhost->arg0().c_str());
                     }
                 }
@@ -2734,7 +2894,8 @@ srs_error_t SrsConfig::check_normal_config()
                         && m != "bframe" && m != "aac" && m != "stun_timeout" && m != "stun_strict_check"
                         && m != "dtls_role" && m != "dtls_version" && m != "drop_for_pt" && m != "rtc_to_rtmp"
                         && m != "pli_for_rtmp" && m != "rtmp_to_rtc" && m != "keep_bframe" && m != "opus_bitrate"
-                        && m != "aac_bitrate" && m != "keep_avc_nalu_sei") {
+                        && m != "aac_bitrate" && m != "keep_avc_nalu_sei" && m != "keep_opus" && m != "gop_cache"
+                        && m != "gop_cache_max_size") {
                         return srs_error_new(ERROR_SYSTEM_CONFIG_INVALID, "illegal vhost.rtc.%s of %s", m.c_str(), vhost->arg0().c_str());
                     }
                 }
@@ -2809,6 +2970,15 @@ srs_error_t SrsConfig::check_normal_config()
         }
     }
 
+    // Check the size of edge cache, which is never negative.
+    for (int n = 0; n < (int)vhosts.size(); n++) {
+        SrsConfDirective* vhost = vhosts[n];
+        if (get_vhost_edge_http_cache_size(vhost->arg0()) < 0) {
+            return srs_error_new(ERROR_SYSTEM_CONFIG_INVALID, "invalid vhost.cluster.http_cache_size=%d of %s",
+                get_vhost_edge_http_cache_size(vhost->arg0()), vhost->arg0().c_str());
+        }
+    }
+
     // check ingest id unique.
     for (int i = 0; i < (int)vhosts.size(); i++) {
         SrsConfDirective* vhost = vhosts[i];
@@ -2888,6 +3058,7 @@ srs_error_t SrsConfig::parse_buffer(SrsConfigBuffer* buffer)
     // We use a new root to parse buffer, to allow parse multiple times.
     srs_freep(root);
     root = new SrsConfDirective();
+    snapshots_.clear();
 
     // Parse root tree from buffer.
     if ((err = root->parse(buffer, this)) != srs_success) {
@@ -3310,6 +3481,44 @@ srs_utime_t SrsConfig::get_threads_interval()
     return v * SRS_UTIME_SECONDS;
 }
 
+int SrsConfig::get_threads_audio_transcoders()
+{
+    SRS_OVERWRITE_BY_ENV_INT("srs.threads.audio_transcoders"); // SRS_THREADS_AUDIO_TRANSCODERS
+
+    static int DEFAULT = 0;
+
+    SrsConfDirective* conf = root->get("threads");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("audio_transcoders");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return ::atoi(conf->arg0().c_str());
+}
+
+int SrsConfig::get_threads_audio_queue()
+{
+    SRS_OVERWRITE_BY_ENV_INT("srs.threads.audio_queue"); // SRS_THREADS_AUDIO_QUEUE
+
+    static int DEFAULT = 64;
+
+    SrsConfDirective* conf = root->get("threads");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("audio_queue");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return ::atoi(conf->arg0().c_str());
+}
+
 bool SrsConfig::get_circuit_breaker()
 {
     SRS_OVERWRITE_BY_ENV_BOOL2("srs.circuit_breaker.enabled"); // SRS_CIRCUIT_BREAKER_ENABLED
@@ -3443,94 +3652,94 @@ int SrsConfig::get_dying_pulse()
     return ::atoi(conf->arg0().c_str());
 }
 
-bool SrsConfig::get_tencentcloud_cls_enabled()
+int SrsConfig::get_shed_priority()
 {
-    SRS_OVERWRITE_BY_ENV_BOOL("srs.tencentcloud_cls.enabled"); // SRS_TENCENTCLOUD_CLS_ENABLED
+    SRS_OVERWRITE_BY_ENV_INT("srs.circuit_breaker.shed_priority"); // SRS_CIRCUIT_BREAKER_SHED_PRIORITY
 
-    static bool DEFAULT = false;
+    static int DEFAULT = 0;
 
-    SrsConfDirective* conf = root->get("tencentcloud_cls");
+    SrsConfDirective* conf = root->get("circuit_breaker");
     if (!conf) {
         return DEFAULT;
     }
 
-    conf = conf->get("enabled");
+    conf = conf->get("shed_priority");
     if (!conf) {
         return DEFAULT;
     }
 
-    return SRS_CONF_PREFER_FALSE(conf->arg0());
+    return ::atoi(conf->arg0().c_str());
 }
 
-bool SrsConfig::get_tencentcloud_cls_stat_heartbeat()
+int SrsConfig::get_rtmp_handshake_dh_pool()
 {
-    SRS_OVERWRITE_BY_ENV_BOOL2("srs.tencentcloud_cls.stat_heartbeat"); // SRS_TENCENTCLOUD_CLS_STAT_HEARTBEAT
+    SRS_OVERWRITE_BY_ENV_INT("srs.rtmp_handshake.dh_pool"); // SRS_RTMP_HANDSHAKE_DH_POOL
 
-    static bool DEFAULT = true;
+    static int DEFAULT = 64;
 
-    SrsConfDirective* conf = root->get("tencentcloud_cls");
+    SrsConfDirective* conf = root->get("rtmp_handshake");
     if (!conf) {
         return DEFAULT;
     }
 
-    conf = conf->get("stat_heartbeat");
+    conf = conf->get("dh_pool");
     if (!conf) {
         return DEFAULT;
     }
 
-    return SRS_CONF_PREFER_TRUE(conf->arg0());
+    return ::atoi(conf->arg0().c_str());
 }
 
-bool SrsConfig::get_tencentcloud_cls_stat_streams()
+int SrsConfig::get_rtmp_handshake_dh_refill()
 {
-    SRS_OVERWRITE_BY_ENV_BOOL2("srs.tencentcloud_cls.stat_streams"); // SRS_TENCENTCLOUD_CLS_STAT_STREAMS
+    SRS_OVERWRITE_BY_ENV_INT("srs.rtmp_handshake.dh_refill"); // SRS_RTMP_HANDSHAKE_DH_REFILL
 
-    static bool DEFAULT = true;
+    static int DEFAULT = 4;
 
-    SrsConfDirective* conf = root->get("tencentcloud_cls");
+    SrsConfDirective* conf = root->get("rtmp_handshake");
     if (!conf) {
         return DEFAULT;
     }
 
-    conf = conf->get("stat_streams");
+    conf = conf->get("dh_refill");
     if (!conf) {
         return DEFAULT;
     }
 
-    return SRS_CONF_PREFER_TRUE(conf->arg0());
+    return ::atoi(conf->arg0().c_str());
 }
 
-bool SrsConfig::get_tencentcloud_cls_debug_logging()
+int SrsConfig::get_rtmp_handshake_max_concurrency()
 {
-    SRS_OVERWRITE_BY_ENV_BOOL("srs.tencentcloud_cls.debug_logging"); // SRS_TENCENTCLOUD_CLS_DEBUG_LOGGING
+    SRS_OVERWRITE_BY_ENV_INT("srs.rtmp_handshake.max_concurrency"); // SRS_RTMP_HANDSHAKE_MAX_CONCURRENCY
 
-    static bool DEFAULT = false;
+    static int DEFAULT = 0;
 
-    SrsConfDirective* conf = root->get("tencentcloud_cls");
+    SrsConfDirective* conf = root->get("rtmp_handshake");
     if (!conf) {
         return DEFAULT;
     }
 
-    conf = conf->get("debug_logging");
+    conf = conf->get("max_concurrency");
     if (!conf) {
         return DEFAULT;
     }
 
-    return SRS_CONF_PREFER_FALSE(conf->arg0());
+    return ::atoi(conf->arg0().c_str());
 }
 
-int SrsConfig::get_tencentcloud_cls_heartbeat_ratio()
+int SrsConfig::get_async_call_executors()
 {
-    SRS_OVERWRITE_BY_ENV_INT("srs.tencentcloud_cls.heartbeat_ratio"); // SRS_TENCENTCLOUD_CLS_HEARTBEAT_RATIO
+    SRS_OVERWRITE_BY_ENV_INT("srs.async_call.executors"); // SRS_ASYNC_CALL_EXECUTORS
 
     static int DEFAULT = 1;
 
-    SrsConfDirective* conf = root->get("tencentcloud_cls");
+    SrsConfDirective* conf = root->get("async_call");
     if (!conf) {
         return DEFAULT;
     }
 
-    conf = conf->get("heartbeat_ratio");
+    conf = conf->get("executors");
     if (!conf) {
         return DEFAULT;
     }
@@ -3538,18 +3747,18 @@ int SrsConfig::get_tencentcloud_cls_heartbeat_ratio()
     return ::atoi(conf->arg0().c_str());
 }
 
-int SrsConfig::get_tencentcloud_cls_streams_ratio()
+int SrsConfig::get_async_call_max_per_destination()
 {
-    SRS_OVERWRITE_BY_ENV_INT("srs.tencentcloud_cls.streams_ratio"); // SRS_TENCENTCLOUD_CLS_STREAMS_RATIO
+    SRS_OVERWRITE_BY_ENV_INT("srs.async_call.max_per_destination"); // SRS_ASYNC_CALL_MAX_PER_DESTINATION
 
-    static int DEFAULT = 1;
+    static int DEFAULT = 0;
 
-    SrsConfDirective* conf = root->get("tencentcloud_cls");
+    SrsConfDirective* conf = root->get("async_call");
     if (!conf) {
         return DEFAULT;
     }
 
-    conf = conf->get("streams_ratio");
+    conf = conf->get("max_per_destination");
     if (!conf) {
         return DEFAULT;
     }
@@ -3557,75 +3766,75 @@ int SrsConfig::get_tencentcloud_cls_streams_ratio()
     return ::atoi(conf->arg0().c_str());
 }
 
-string SrsConfig::get_tencentcloud_cls_label()
+int SrsConfig::get_async_call_max_tasks()
 {
-    SRS_OVERWRITE_BY_ENV_STRING("srs.tencentcloud_cls.label"); // SRS_TENCENTCLOUD_CLS_LABEL
+    SRS_OVERWRITE_BY_ENV_INT("srs.async_call.max_tasks"); // SRS_ASYNC_CALL_MAX_TASKS
 
-    static string DEFAULT = "";
+    static int DEFAULT = 0;
 
-    SrsConfDirective* conf = root->get("tencentcloud_cls");
+    SrsConfDirective* conf = root->get("async_call");
     if (!conf) {
         return DEFAULT;
     }
 
-    conf = conf->get("label");
+    conf = conf->get("max_tasks");
     if (!conf) {
         return DEFAULT;
     }
 
-    return conf->arg0();
+    return ::atoi(conf->arg0().c_str());
 }
 
-string SrsConfig::get_tencentcloud_cls_tag()
+string SrsConfig::get_async_call_overflow()
 {
-    SRS_OVERWRITE_BY_ENV_STRING("srs.tencentcloud_cls.tag"); // SRS_TENCENTCLOUD_CLS_TAG
+    SRS_OVERWRITE_BY_ENV_STRING("srs.async_call.overflow"); // SRS_ASYNC_CALL_OVERFLOW
 
-    static string DEFAULT = "";
+    static string DEFAULT = "drop_oldest";
 
-    SrsConfDirective* conf = root->get("tencentcloud_cls");
+    SrsConfDirective* conf = root->get("async_call");
     if (!conf) {
         return DEFAULT;
     }
 
-    conf = conf->get("tag");
-    if (!conf) {
+    conf = conf->get("overflow");
+    if (!conf || conf->arg0().empty()) {
         return DEFAULT;
     }
 
     return conf->arg0();
 }
 
-string SrsConfig::get_tencentcloud_cls_secret_id()
+bool SrsConfig::get_load_redirect_enabled()
 {
-    SRS_OVERWRITE_BY_ENV_STRING("srs.tencentcloud_cls.secret_id"); // SRS_TENCENTCLOUD_CLS_SECRET_ID
+    SRS_OVERWRITE_BY_ENV_BOOL("srs.load_redirect.enabled"); // SRS_LOAD_REDIRECT_ENABLED
 
-    static string DEFAULT = "";
+    static bool DEFAULT = false;
 
-    SrsConfDirective* conf = root->get("tencentcloud_cls");
+    SrsConfDirective* conf = root->get("load_redirect");
     if (!conf) {
         return DEFAULT;
     }
 
-    conf = conf->get("secret_id");
+    conf = conf->get("enabled");
     if (!conf) {
         return DEFAULT;
     }
 
-    return conf->arg0();
+    return SRS_CONF_PREFER_FALSE(conf->arg0());
 }
 
-string SrsConfig::get_tencentcloud_cls_secret_key()
+string SrsConfig::get_load_redirect_ip()
 {
-    SRS_OVERWRITE_BY_ENV_STRING("srs.tencentcloud_cls.secret_key"); // SRS_TENCENTCLOUD_CLS_SECRET_KEY
+    SRS_OVERWRITE_BY_ENV_STRING("srs.load_redirect.ip"); // SRS_LOAD_REDIRECT_IP
 
     static string DEFAULT = "";
 
-    SrsConfDirective* conf = root->get("tencentcloud_cls");
+    SrsConfDirective* conf = root->get("load_redirect");
     if (!conf) {
         return DEFAULT;
     }
 
-    conf = conf->get("secret_key");
+    conf = conf->get("ip");
     if (!conf) {
         return DEFAULT;
     }
@@ -3633,151 +3842,153 @@ string SrsConfig::get_tencentcloud_cls_secret_key()
     return conf->arg0();
 }
 
-string SrsConfig::get_tencentcloud_cls_endpoint()
+vector<string> SrsConfig::get_load_redirect_peers()
 {
-    SRS_OVERWRITE_BY_ENV_STRING("srs.tencentcloud_cls.endpoint"); // SRS_TENCENTCLOUD_CLS_ENDPOINT
+    if (!srs_getenv("srs.load_redirect.peers").empty()) { // SRS_LOAD_REDIRECT_PEERS
+        return srs_string_split(srs_getenv("srs.load_redirect.peers"), " ");
+    }
 
-    static string DEFAULT = "";
+    vector<string> peers;
 
-    SrsConfDirective* conf = root->get("tencentcloud_cls");
+    SrsConfDirective* conf = root->get("load_redirect");
     if (!conf) {
-        return DEFAULT;
+        return peers;
     }
 
-    conf = conf->get("endpoint");
+    conf = conf->get("peers");
     if (!conf) {
-        return DEFAULT;
+        return peers;
     }
 
-    return conf->arg0();
+    return conf->args;
 }
 
-string SrsConfig::get_tencentcloud_cls_topic_id()
+int SrsConfig::get_load_redirect_cpu()
 {
-    SRS_OVERWRITE_BY_ENV_STRING("srs.tencentcloud_cls.topic_id"); // SRS_TENCENTCLOUD_CLS_TOPIC_ID
+    SRS_OVERWRITE_BY_ENV_INT("srs.load_redirect.cpu"); // SRS_LOAD_REDIRECT_CPU
 
-    static string DEFAULT = "";
+    static int DEFAULT = 80;
 
-    SrsConfDirective* conf = root->get("tencentcloud_cls");
+    SrsConfDirective* conf = root->get("load_redirect");
     if (!conf) {
         return DEFAULT;
     }
 
-    conf = conf->get("topic_id");
-    if (!conf) {
+    conf = conf->get("cpu");
+    if (!conf || conf->arg0().empty()) {
         return DEFAULT;
     }
 
-    return conf->arg0();
+    return ::atoi(conf->arg0().c_str());
 }
 
-bool SrsConfig::get_tencentcloud_apm_enabled()
+int SrsConfig::get_load_redirect_connections()
 {
-    SRS_OVERWRITE_BY_ENV_BOOL("srs.tencentcloud_apm.enabled"); // SRS_TENCENTCLOUD_APM_ENABLED
+    SRS_OVERWRITE_BY_ENV_INT("srs.load_redirect.connections"); // SRS_LOAD_REDIRECT_CONNECTIONS
 
-    static bool DEFAULT = false;
+    static int DEFAULT = 0;
 
-    SrsConfDirective* conf = root->get("tencentcloud_apm");
+    SrsConfDirective* conf = root->get("load_redirect");
     if (!conf) {
         return DEFAULT;
     }
 
-    conf = conf->get("enabled");
-    if (!conf) {
+    conf = conf->get("connections");
+    if (!conf || conf->arg0().empty()) {
         return DEFAULT;
     }
 
-    return SRS_CONF_PREFER_FALSE(conf->arg0());
+    return ::atoi(conf->arg0().c_str());
 }
 
-string SrsConfig::get_tencentcloud_apm_team()
+int SrsConfig::get_load_redirect_mbps()
 {
-    SRS_OVERWRITE_BY_ENV_STRING("srs.tencentcloud_apm.team"); // SRS_TENCENTCLOUD_APM_TEAM
+    SRS_OVERWRITE_BY_ENV_INT("srs.load_redirect.mbps"); // SRS_LOAD_REDIRECT_MBPS
 
-    static string DEFAULT = "";
+    static int DEFAULT = 0;
 
-    SrsConfDirective* conf = root->get("tencentcloud_apm");
+    SrsConfDirective* conf = root->get("load_redirect");
     if (!conf) {
         return DEFAULT;
     }
 
-    conf = conf->get("team");
-    if (!conf) {
+    conf = conf->get("mbps");
+    if (!conf || conf->arg0().empty()) {
         return DEFAULT;
     }
 
-    return conf->arg0();
+    return ::atoi(conf->arg0().c_str());
 }
 
-string SrsConfig::get_tencentcloud_apm_token()
+bool SrsConfig::get_load_redirect_publish()
 {
-    SRS_OVERWRITE_BY_ENV_STRING("srs.tencentcloud_apm.token"); // SRS_TENCENTCLOUD_APM_TOKEN
+    SRS_OVERWRITE_BY_ENV_BOOL("srs.load_redirect.publish"); // SRS_LOAD_REDIRECT_PUBLISH
 
-    static string DEFAULT = "";
+    static bool DEFAULT = false;
 
-    SrsConfDirective* conf = root->get("tencentcloud_apm");
+    SrsConfDirective* conf = root->get("load_redirect");
     if (!conf) {
         return DEFAULT;
     }
 
-    conf = conf->get("token");
+    conf = conf->get("publish");
     if (!conf) {
         return DEFAULT;
     }
 
-    return conf->arg0();
+    return SRS_CONF_PREFER_FALSE(conf->arg0());
 }
 
-string SrsConfig::get_tencentcloud_apm_endpoint()
+int SrsConfig::get_stack_pool()
 {
-    SRS_OVERWRITE_BY_ENV_STRING("srs.tencentcloud_apm.endpoint"); // SRS_TENCENTCLOUD_APM_ENDPOINT
+    SRS_OVERWRITE_BY_ENV_INT("srs.stack.pool"); // SRS_STACK_POOL
 
-    static string DEFAULT = "";
+    static int DEFAULT = 1000;
 
-    SrsConfDirective* conf = root->get("tencentcloud_apm");
+    SrsConfDirective* conf = root->get("stack");
     if (!conf) {
         return DEFAULT;
     }
 
-    conf = conf->get("endpoint");
+    conf = conf->get("pool");
     if (!conf) {
         return DEFAULT;
     }
 
-    return conf->arg0();
+    return ::atoi(conf->arg0().c_str());
 }
 
-string SrsConfig::get_tencentcloud_apm_service_name()
+bool SrsConfig::get_stack_guard(bool default_guard)
 {
-    SRS_OVERWRITE_BY_ENV_STRING("srs.tencentcloud_apm.service_name"); // SRS_TENCENTCLOUD_APM_SERVICE_NAME
+    SRS_OVERWRITE_BY_ENV_BOOL("srs.stack.guard"); // SRS_STACK_GUARD
 
-    static string DEFAULT = "srs-server";
+    bool DEFAULT = default_guard;
 
-    SrsConfDirective* conf = root->get("tencentcloud_apm");
+    SrsConfDirective* conf = root->get("stack");
     if (!conf) {
         return DEFAULT;
     }
 
-    conf = conf->get("service_name");
+    conf = conf->get("guard");
     if (!conf) {
         return DEFAULT;
     }
 
-    return conf->arg0();
+    return SRS_CONF_PREFER_FALSE(conf->arg0());
 }
 
-bool SrsConfig::get_tencentcloud_apm_debug_logging()
+bool SrsConfig::get_stack_watermark()
 {
-    SRS_OVERWRITE_BY_ENV_BOOL("srs.tencentcloud_apm.debug_logging"); // SRS_TENCENTCLOUD_APM_DEBUG_LOGGING
+    SRS_OVERWRITE_BY_ENV_BOOL("srs.stack.watermark"); // SRS_STACK_WATERMARK
 
     static bool DEFAULT = false;
 
-    SrsConfDirective* conf = root->get("tencentcloud_apm");
+    SrsConfDirective* conf = root->get("stack");
     if (!conf) {
         return DEFAULT;
     }
 
-    conf = conf->get("debug_logging");
+    conf = conf->get("watermark");
     if (!conf) {
         return DEFAULT;
     }
@@ -3785,45 +3996,439 @@ bool SrsConfig::get_tencentcloud_apm_debug_logging()
     return SRS_CONF_PREFER_FALSE(conf->arg0());
 }
 
-bool SrsConfig::get_exporter_enabled()
+int SrsConfig::get_stack_size()
 {
-    SRS_OVERWRITE_BY_ENV_BOOL("srs.exporter.enabled"); // SRS_EXPORTER_ENABLED
+    SRS_OVERWRITE_BY_ENV_INT("srs.stack.size"); // SRS_STACK_SIZE
 
-    static bool DEFAULT = false;
+    static int DEFAULT = 0;
 
-    SrsConfDirective* conf = root->get("exporter");
+    SrsConfDirective* conf = root->get("stack");
     if (!conf) {
         return DEFAULT;
     }
 
-    conf = conf->get("enabled");
+    conf = conf->get("size");
     if (!conf) {
         return DEFAULT;
     }
 
-    return SRS_CONF_PREFER_FALSE(conf->arg0());
+    return ::atoi(conf->arg0().c_str());
 }
 
-string SrsConfig::get_exporter_listen()
+map<string, int> SrsConfig::get_stack_sizes()
 {
-    SRS_OVERWRITE_BY_ENV_STRING("srs.exporter.listen"); // SRS_EXPORTER_LISTEN
+    map<string, int> sizes;
 
-    static string DEFAULT = "9972";
+    // For example, SRS_STACK_SIZES="recv:65536 play:65536"
+    if (!srs_getenv("srs.stack.sizes").empty()) { // SRS_STACK_SIZES
+        vector<string> pairs = srs_string_split(srs_getenv("srs.stack.sizes"), " ");
+        for (int i = 0; i < (int)pairs.size(); i++) {
+            // The malformed pair is size 0, which is rejected by check.
+            size_t pos = pairs[i].find(":");
+            if (pos != string::npos) {
+                sizes[pairs[i].substr(0, pos)] = ::atoi(pairs[i].substr(pos + 1).c_str());
+            } else if (!pairs[i].empty()) {
+                sizes[pairs[i]] = 0;
+            }
+        }
+        return sizes;
+    }
 
-    SrsConfDirective* conf = root->get("exporter");
+    SrsConfDirective* conf = root->get("stack");
     if (!conf) {
-        return DEFAULT;
+        return sizes;
     }
 
-    conf = conf->get("listen");
-    if (!conf) {
-        return DEFAULT;
+    conf = conf->get("sizes");
+    for (int i = 0; conf && i < (int)conf->directives.size(); i++) {
+        SrsConfDirective* size = conf->at(i);
+        sizes[size->name] = ::atoi(size->arg0().c_str());
     }
 
-    return conf->arg0();
+    return sizes;
 }
 
-string SrsConfig::get_exporter_label()
+bool SrsConfig::get_tencentcloud_cls_enabled()
+{
+    SRS_OVERWRITE_BY_ENV_BOOL("srs.tencentcloud_cls.enabled"); // SRS_TENCENTCLOUD_CLS_ENABLED
+
+    static bool DEFAULT = false;
+
+    SrsConfDirective* conf = root->get("tencentcloud_cls");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("enabled");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    return SRS_CONF_PREFER_FALSE(conf->arg0());
+}
+
+bool SrsConfig::get_tencentcloud_cls_stat_heartbeat()
+{
+    SRS_OVERWRITE_BY_ENV_BOOL2("srs.tencentcloud_cls.stat_heartbeat"); // SRS_TENCENTCLOUD_CLS_STAT_HEARTBEAT
+
+    static bool DEFAULT = true;
+
+    SrsConfDirective* conf = root->get("tencentcloud_cls");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("stat_heartbeat");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    return SRS_CONF_PREFER_TRUE(conf->arg0());
+}
+
+bool SrsConfig::get_tencentcloud_cls_stat_streams()
+{
+    SRS_OVERWRITE_BY_ENV_BOOL2("srs.tencentcloud_cls.stat_streams"); // SRS_TENCENTCLOUD_CLS_STAT_STREAMS
+
+    static bool DEFAULT = true;
+
+    SrsConfDirective* conf = root->get("tencentcloud_cls");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("stat_streams");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    return SRS_CONF_PREFER_TRUE(conf->arg0());
+}
+
+bool SrsConfig::get_tencentcloud_cls_debug_logging()
+{
+    SRS_OVERWRITE_BY_ENV_BOOL("srs.tencentcloud_cls.debug_logging"); // SRS_TENCENTCLOUD_CLS_DEBUG_LOGGING
+
+    static bool DEFAULT = false;
+
+    SrsConfDirective* conf = root->get("tencentcloud_cls");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("debug_logging");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    return SRS_CONF_PREFER_FALSE(conf->arg0());
+}
+
+int SrsConfig::get_tencentcloud_cls_heartbeat_ratio()
+{
+    SRS_OVERWRITE_BY_ENV_INT("srs.tencentcloud_cls.heartbeat_ratio"); // SRS_TENCENTCLOUD_CLS_HEARTBEAT_RATIO
+
+    static int DEFAULT = 1;
+
+    SrsConfDirective* conf = root->get("tencentcloud_cls");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("heartbeat_ratio");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    return ::atoi(conf->arg0().c_str());
+}
+
+int SrsConfig::get_tencentcloud_cls_streams_ratio()
+{
+    SRS_OVERWRITE_BY_ENV_INT("srs.tencentcloud_cls.streams_ratio"); // SRS_TENCENTCLOUD_CLS_STREAMS_RATIO
+
+    static int DEFAULT = 1;
+
+    SrsConfDirective* conf = root->get("tencentcloud_cls");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("streams_ratio");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    return ::atoi(conf->arg0().c_str());
+}
+
+string SrsConfig::get_tencentcloud_cls_label()
+{
+    SRS_OVERWRITE_BY_ENV_STRING("srs.tencentcloud_cls.label"); // SRS_TENCENTCLOUD_CLS_LABEL
+
+    static string DEFAULT = "";
+
+    SrsConfDirective* conf = root->get("tencentcloud_cls");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("label");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    return conf->arg0();
+}
+
+string SrsConfig::get_tencentcloud_cls_tag()
+{
+    SRS_OVERWRITE_BY_ENV_STRING("srs.tencentcloud_cls.tag"); // SRS_TENCENTCLOUD_CLS_TAG
+
+    static string DEFAULT = "";
+
+    SrsConfDirective* conf = root->get("tencentcloud_cls");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("tag");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    return conf->arg0();
+}
+
+string SrsConfig::get_tencentcloud_cls_secret_id()
+{
+    SRS_OVERWRITE_BY_ENV_STRING("srs.tencentcloud_cls.secret_id"); // SRS_TENCENTCLOUD_CLS_SECRET_ID
+
+    static string DEFAULT = "";
+
+    SrsConfDirective* conf = root->get("tencentcloud_cls");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("secret_id");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    return conf->arg0();
+}
+
+string SrsConfig::get_tencentcloud_cls_secret_key()
+{
+    SRS_OVERWRITE_BY_ENV_STRING("srs.tencentcloud_cls.secret_key"); // SRS_TENCENTCLOUD_CLS_SECRET_KEY
+
+    static string DEFAULT = "";
+
+    SrsConfDirective* conf = root->get("tencentcloud_cls");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("secret_key");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    return conf->arg0();
+}
+
+string SrsConfig::get_tencentcloud_cls_endpoint()
+{
+    SRS_OVERWRITE_BY_ENV_STRING("srs.tencentcloud_cls.endpoint"); // SRS_TENCENTCLOUD_CLS_ENDPOINT
+
+    static string DEFAULT = "";
+
+    SrsConfDirective* conf = root->get("tencentcloud_cls");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("endpoint");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    return conf->arg0();
+}
+
+string SrsConfig::get_tencentcloud_cls_topic_id()
+{
+    SRS_OVERWRITE_BY_ENV_STRING("srs.tencentcloud_cls.topic_id"); // SRS_TENCENTCLOUD_CLS_TOPIC_ID
+
+    static string DEFAULT = "";
+
+    SrsConfDirective* conf = root->get("tencentcloud_cls");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("topic_id");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    return conf->arg0();
+}
+
+bool SrsConfig::get_tencentcloud_apm_enabled()
+{
+    SRS_OVERWRITE_BY_ENV_BOOL("srs.tencentcloud_apm.enabled"); // SRS_TENCENTCLOUD_APM_ENABLED
+
+    static bool DEFAULT = false;
+
+    SrsConfDirective* conf = root->get("tencentcloud_apm");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("enabled");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    return SRS_CONF_PREFER_FALSE(conf->arg0());
+}
+
+string SrsConfig::get_tencentcloud_apm_team()
+{
+    SRS_OVERWRITE_BY_ENV_STRING("srs.tencentcloud_apm.team"); // SRS_TENCENTCLOUD_APM_TEAM
+
+    static string DEFAULT = "";
+
+    SrsConfDirective* conf = root->get("tencentcloud_apm");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("team");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    return conf->arg0();
+}
+
+string SrsConfig::get_tencentcloud_apm_token()
+{
+    SRS_OVERWRITE_BY_ENV_STRING("srs.tencentcloud_apm.token"); // SRS_TENCENTCLOUD_APM_TOKEN
+
+    static string DEFAULT = "";
+
+    SrsConfDirective* conf = root->get("tencentcloud_apm");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("token");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    return conf->arg0();
+}
+
+string SrsConfig::get_tencentcloud_apm_endpoint()
+{
+    SRS_OVERWRITE_BY_ENV_STRING("srs.tencentcloud_apm.endpoint"); // SRS_TENCENTCLOUD_APM_ENDPOINT
+
+    static string DEFAULT = "";
+
+    SrsConfDirective* conf = root->get("tencentcloud_apm");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("endpoint");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    return conf->arg0();
+}
+
+string SrsConfig::get_tencentcloud_apm_service_name()
+{
+    SRS_OVERWRITE_BY_ENV_STRING("srs.tencentcloud_apm.service_name"); // SRS_TENCENTCLOUD_APM_SERVICE_NAME
+
+    static string DEFAULT = "srs-server";
+
+    SrsConfDirective* conf = root->get("tencentcloud_apm");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("service_name");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    return conf->arg0();
+}
+
+bool SrsConfig::get_tencentcloud_apm_debug_logging()
+{
+    SRS_OVERWRITE_BY_ENV_BOOL("srs.tencentcloud_apm.debug_logging"); // SRS_TENCENTCLOUD_APM_DEBUG_LOGGING
+
+    static bool DEFAULT = false;
+
+    SrsConfDirective* conf = root->get("tencentcloud_apm");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("debug_logging");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    return SRS_CONF_PREFER_FALSE(conf->arg0());
+}
+
+bool SrsConfig::get_exporter_enabled()
+{
+    SRS_OVERWRITE_BY_ENV_BOOL("srs.exporter.enabled"); // SRS_EXPORTER_ENABLED
+
+    static bool DEFAULT = false;
+
+    SrsConfDirective* conf = root->get("exporter");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("enabled");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    return SRS_CONF_PREFER_FALSE(conf->arg0());
+}
+
+string SrsConfig::get_exporter_listen()
+{
+    SRS_OVERWRITE_BY_ENV_STRING("srs.exporter.listen"); // SRS_EXPORTER_LISTEN
+
+    static string DEFAULT = "9972";
+
+    SrsConfDirective* conf = root->get("exporter");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("listen");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    return conf->arg0();
+}
+
+string SrsConfig::get_exporter_label()
 {
     SRS_OVERWRITE_BY_ENV_STRING("srs.exporter.label"); // SRS_EXPORTER_LABEL
 
@@ -4640,6 +5245,63 @@ bool SrsConfig::get_rtc_to_rtmp(string vhost)
     return SRS_CONF_PREFER_FALSE(conf->arg0());
 }
 
+bool SrsConfig::get_rtc_keep_opus(string vhost)
+{
+    SRS_OVERWRITE_BY_ENV_BOOL("srs.vhost.rtc.keep_opus"); // SRS_VHOST_RTC_KEEP_OPUS
+
+    static bool DEFAULT = false;
+
+    SrsConfDirective* conf = get_rtc(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("keep_opus");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return SRS_CONF_PREFER_FALSE(conf->arg0());
+}
+
+bool SrsConfig::get_rtc_gop_cache(string vhost)
+{
+    SRS_OVERWRITE_BY_ENV_BOOL("srs.vhost.rtc.gop_cache"); // SRS_VHOST_RTC_GOP_CACHE
+
+    static bool DEFAULT = false;
+
+    SrsConfDirective* conf = get_rtc(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("gop_cache");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return SRS_CONF_PREFER_FALSE(conf->arg0());
+}
+
+int SrsConfig::get_rtc_gop_cache_max_size(string vhost)
+{
+    SRS_OVERWRITE_BY_ENV_INT("srs.vhost.rtc.gop_cache_max_size"); // SRS_VHOST_RTC_GOP_CACHE_MAX_SIZE
+
+    static int DEFAULT = 4096;
+
+    SrsConfDirective* conf = get_rtc(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("gop_cache_max_size");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return ::atoi(conf->arg0().c_str());
+}
+
 srs_utime_t SrsConfig::get_rtc_pli_for_rtmp(string vhost)
 {
     static srs_utime_t DEFAULT = 6 * SRS_UTIME_SECONDS;
@@ -4904,6 +5566,54 @@ int SrsConfig::get_gop_cache_max_frames(string vhost)
     return ::atoi(conf->arg0().c_str());
 }
 
+bool SrsConfig::get_fast_start(string vhost)
+{
+    SRS_OVERWRITE_BY_ENV_BOOL("srs.vhost.play.fast_start"); // SRS_VHOST_PLAY_FAST_START
+
+    static bool DEFAULT = false;
+
+    SrsConfDirective* conf = get_vhost(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("play");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("fast_start");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return SRS_CONF_PREFER_FALSE(conf->arg0());
+}
+
+srs_utime_t SrsConfig::get_fast_start_catchup(string vhost)
+{
+    SRS_OVERWRITE_BY_ENV_MILLISECONDS("srs.vhost.play.fast_start_catchup"); // SRS_VHOST_PLAY_FAST_START_CATCHUP
+
+    static srs_utime_t DEFAULT = 0;
+
+    SrsConfDirective* conf = get_vhost(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("play");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("fast_start_catchup");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return srs_utime_t(::atoi(conf->arg0().c_str()) * SRS_UTIME_MILLISECONDS);
+}
+
 
 bool SrsConfig::get_debug_srs_upnode(string vhost)
 {
@@ -5017,36 +5727,60 @@ bool SrsConfig::get_mix_correct(string vhost)
         return DEFAULT;
     }
     
-    conf = conf->get("mix_correct");
+    conf = conf->get("mix_correct");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+    
+    return SRS_CONF_PREFER_FALSE(conf->arg0());
+}
+
+srs_utime_t SrsConfig::get_queue_length(string vhost)
+{
+    SRS_OVERWRITE_BY_ENV_SECONDS("srs.vhost.play.queue_length"); // SRS_VHOST_PLAY_QUEUE_LENGTH
+
+    static srs_utime_t DEFAULT = SRS_PERF_PLAY_QUEUE;
+    
+    SrsConfDirective* conf = get_vhost(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+    
+    conf = conf->get("play");
+    if (!conf) {
+        return DEFAULT;
+    }
+    
+    conf = conf->get("queue_length");
     if (!conf || conf->arg0().empty()) {
         return DEFAULT;
     }
     
-    return SRS_CONF_PREFER_FALSE(conf->arg0());
+    return srs_utime_t(::atoi(conf->arg0().c_str()) * SRS_UTIME_SECONDS);
 }
 
-srs_utime_t SrsConfig::get_queue_length(string vhost)
+bool SrsConfig::get_adaptive_drop(string vhost)
 {
-    SRS_OVERWRITE_BY_ENV_SECONDS("srs.vhost.play.queue_length"); // SRS_VHOST_PLAY_QUEUE_LENGTH
+    SRS_OVERWRITE_BY_ENV_BOOL("srs.vhost.play.adaptive_drop"); // SRS_VHOST_PLAY_ADAPTIVE_DROP
+
+    static bool DEFAULT = false;
 
-    static srs_utime_t DEFAULT = SRS_PERF_PLAY_QUEUE;
-    
     SrsConfDirective* conf = get_vhost(vhost);
     if (!conf) {
         return DEFAULT;
     }
-    
+
     conf = conf->get("play");
     if (!conf) {
         return DEFAULT;
     }
-    
-    conf = conf->get("queue_length");
+
+    conf = conf->get("adaptive_drop");
     if (!conf || conf->arg0().empty()) {
         return DEFAULT;
     }
-    
-    return srs_utime_t(::atoi(conf->arg0().c_str()) * SRS_UTIME_SECONDS);
+
+    return SRS_CONF_PREFER_FALSE(conf->arg0());
 }
 
 bool SrsConfig::get_refer_enabled(string vhost)
@@ -5185,6 +5919,25 @@ int SrsConfig::get_chunk_size(string vhost)
     return ::atoi(conf->arg0().c_str());
 }
 
+int SrsConfig::get_vhost_priority(string vhost)
+{
+    SRS_OVERWRITE_BY_ENV_INT("srs.vhost.priority"); // SRS_VHOST_PRIORITY
+
+    static int DEFAULT = 50;
+
+    SrsConfDirective* conf = get_vhost(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("priority");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return ::atoi(conf->arg0().c_str());
+}
+
 bool SrsConfig::get_parse_sps(string vhost)
 {
     SRS_OVERWRITE_BY_ENV_BOOL2("srs.vhost.publish.parse_sps"); // SRS_VHOST_PUBLISH_PARSE_SPS
@@ -5415,6 +6168,54 @@ bool SrsConfig::get_tcp_nodelay(string vhost)
     return SRS_CONF_PREFER_FALSE(conf->arg0());
 }
 
+bool SrsConfig::get_zerocopy(string vhost)
+{
+    SRS_OVERWRITE_BY_ENV_BOOL("srs.vhost.play.zerocopy"); // SRS_VHOST_PLAY_ZEROCOPY
+
+    static bool DEFAULT = false;
+
+    SrsConfDirective* conf = get_vhost(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("play");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("zerocopy");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return SRS_CONF_PREFER_FALSE(conf->arg0());
+}
+
+int SrsConfig::get_zerocopy_threshold(string vhost)
+{
+    SRS_OVERWRITE_BY_ENV_INT("srs.vhost.play.zerocopy_threshold"); // SRS_VHOST_PLAY_ZEROCOPY_THRESHOLD
+
+    static int DEFAULT = 16384;
+
+    SrsConfDirective* conf = get_vhost(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("play");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("zerocopy_threshold");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return ::atoi(conf->arg0().c_str());
+}
+
 srs_utime_t SrsConfig::get_send_min_interval(string vhost)
 {
     SRS_OVERWRITE_BY_ENV_FLOAT_MILLISECONDS("srs.vhost.play.send_min_interval"); // SRS_VHOST_PLAY_SEND_MIN_INTERVAL
@@ -5765,6 +6566,69 @@ SrsConfDirective* SrsConfig::get_vhost_on_hls_notify(string vhost)
     return conf->get("on_hls_notify");
 }
 
+srs_utime_t SrsConfig::get_vhost_http_hooks_cache_ttl(string vhost)
+{
+    SRS_OVERWRITE_BY_ENV_SECONDS("srs.vhost.http_hooks.cache_ttl"); // SRS_VHOST_HTTP_HOOKS_CACHE_TTL
+
+    static srs_utime_t DEFAULT = 0;
+
+    SrsConfDirective* conf = get_vhost_http_hooks(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("cache_ttl");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return (srs_utime_t)(::atoi(conf->arg0().c_str()) * SRS_UTIME_SECONDS);
+}
+
+vector<string> SrsConfig::get_vhost_http_hooks_cache_key(string vhost)
+{
+    vector<string> DEFAULT;
+    DEFAULT.push_back("app");
+    DEFAULT.push_back("stream");
+    DEFAULT.push_back("param");
+
+    string env = srs_getenv("srs.vhost.http_hooks.cache_key"); // SRS_VHOST_HTTP_HOOKS_CACHE_KEY
+    if (!env.empty()) {
+        return srs_string_split(env, " ");
+    }
+
+    SrsConfDirective* conf = get_vhost_http_hooks(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("cache_key");
+    if (!conf || conf->args.empty()) {
+        return DEFAULT;
+    }
+
+    return conf->args;
+}
+
+bool SrsConfig::get_vhost_http_hooks_coalesce(string vhost)
+{
+    SRS_OVERWRITE_BY_ENV_BOOL("srs.vhost.http_hooks.coalesce"); // SRS_VHOST_HTTP_HOOKS_COALESCE
+
+    static bool DEFAULT = false;
+
+    SrsConfDirective* conf = get_vhost_http_hooks(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("coalesce");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return SRS_CONF_PREFER_FALSE(conf->arg0());
+}
+
 bool SrsConfig::get_vhost_is_edge(string vhost)
 {
     SrsConfDirective* conf = get_vhost(vhost);
@@ -5852,6 +6716,116 @@ bool SrsConfig::get_vhost_edge_follow_client(string vhost)
     return SRS_CONF_PREFER_FALSE(conf->arg0());
 }
 
+string SrsConfig::get_vhost_edge_balance(string vhost)
+{
+    static string DEFAULT = "round_robin";
+
+    SrsConfDirective* conf = get_vhost(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("cluster");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("balance");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return conf->arg0();
+}
+
+vector<string> SrsConfig::get_vhost_edge_http_origin(string vhost)
+{
+    vector<string> origins;
+
+    SrsConfDirective* conf = get_vhost(vhost);
+    if (!conf) {
+        return origins;
+    }
+
+    conf = conf->get("cluster");
+    if (!conf) {
+        return origins;
+    }
+
+    conf = conf->get("http_origin");
+    if (!conf) {
+        return origins;
+    }
+
+    return conf->args;
+}
+
+srs_utime_t SrsConfig::get_vhost_edge_http_playlist_ttl(string vhost)
+{
+    static srs_utime_t DEFAULT = 1 * SRS_UTIME_SECONDS;
+
+    SrsConfDirective* conf = get_vhost(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("cluster");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("http_playlist_ttl");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return srs_utime_t(::atof(conf->arg0().c_str()) * SRS_UTIME_SECONDS);
+}
+
+srs_utime_t SrsConfig::get_vhost_edge_http_segment_ttl(string vhost)
+{
+    static srs_utime_t DEFAULT = 60 * SRS_UTIME_SECONDS;
+
+    SrsConfDirective* conf = get_vhost(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("cluster");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("http_segment_ttl");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return srs_utime_t(::atof(conf->arg0().c_str()) * SRS_UTIME_SECONDS);
+}
+
+int SrsConfig::get_vhost_edge_http_cache_size(string vhost)
+{
+    static int DEFAULT = 256;
+
+    SrsConfDirective* conf = get_vhost(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("cluster");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("http_cache_size");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return ::atoi(conf->arg0().c_str());
+}
+
 bool SrsConfig::get_vhost_edge_token_traverse(string vhost)
 {
     static bool DEFAULT = false;
@@ -5949,6 +6923,54 @@ vector<string> SrsConfig::get_vhost_coworkers(string vhost)
     return coworkers;
 }
 
+bool SrsConfig::get_vhost_coworkers_directory(string vhost)
+{
+    SRS_OVERWRITE_BY_ENV_BOOL("srs.vhost.cluster.directory"); // SRS_VHOST_CLUSTER_DIRECTORY
+
+    static bool DEFAULT = false;
+
+    SrsConfDirective* conf = get_vhost(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("cluster");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("directory");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return SRS_CONF_PREFER_FALSE(conf->arg0());
+}
+
+srs_utime_t SrsConfig::get_vhost_coworkers_ttl(string vhost)
+{
+    SRS_OVERWRITE_BY_ENV_SECONDS("srs.vhost.cluster.directory_ttl"); // SRS_VHOST_CLUSTER_DIRECTORY_TTL
+
+    static srs_utime_t DEFAULT = 30 * SRS_UTIME_SECONDS;
+
+    SrsConfDirective* conf = get_vhost(vhost);
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("cluster");
+    if (!conf) {
+        return DEFAULT;
+    }
+
+    conf = conf->get("directory_ttl");
+    if (!conf || conf->arg0().empty()) {
+        return DEFAULT;
+    }
+
+    return ::atoi(conf->arg0().c_str()) * SRS_UTIME_SECONDS;
+}
+
 bool SrsConfig::get_security_enabled(string vhost)
 {
     static bool DEFAULT = false;
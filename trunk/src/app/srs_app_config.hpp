@@ -18,6 +18,7 @@
 #include <srs_app_reload.hpp>
 #include <srs_app_async_call.hpp>
 #include <srs_app_st.hpp>
+#include <srs_core_autofree.hpp>
 
 class SrsRequest;
 class SrsFileWriter;
@@ -269,6 +270,50 @@ enum SrsReloadState {
     SrsReloadStateFinished = 90,
 };
 
+// The compiled config of vhost, which is an immutable and typed snapshot for hot path, to avoid walking the
+// directive tree with string compares. When reload, the snapshots are dropped and rebuilt on demand, while the
+// holders of old snapshot are still safe to read it, so it's ok to keep it cross st-thread.
+// @remark The env overwrites are applied when building the snapshot, so the env changes after that take effect
+// only after reload, like the config file. Note that SRS never changes env after startup, except utest.
+class SrsVhostConfig
+{
+public:
+    // The resolved vhost name, maybe the default vhost.
+    std::string vhost;
+    bool enabled;
+    bool is_edge;
+    int priority;
+public:
+    // For vhost.play of RTMP, HTTP-FLV and so on.
+    bool gop_cache;
+    int gop_cache_max_frames;
+    srs_utime_t queue_length;
+    int time_jitter;
+    bool mix_correct;
+    bool atc;
+    bool atc_auto;
+    bool reduce_sequence_header;
+    srs_utime_t send_min_interval;
+    bool adaptive_drop;
+    bool fast_start;
+    srs_utime_t fast_start_catchup;
+    bool realtime;
+    srs_utime_t mw_sleep;
+    int mw_msgs;
+    bool zerocopy;
+    int zerocopy_threshold;
+public:
+    // For vhost.play and vhost.rtc of WebRTC.
+    bool rtc_realtime;
+    int rtc_mw_msgs;
+    bool rtc_nack;
+    bool rtc_nack_no_copy;
+    bool rtc_twcc;
+public:
+    SrsVhostConfig();
+    virtual ~SrsVhostConfig();
+};
+
 // The config service provider.
 // For the config supports reload, so never keep the reference cross st-thread,
 // that is, never save the SrsConfDirective* get by any api of config,
@@ -309,6 +354,8 @@ protected:
 private:
     // The reload subscribers, when reload, callback all handlers.
     std::vector<ISrsReloadHandler*> subscribes;
+    // The compiled snapshots of vhosts, dropped when config changed.
+    std::map<std::string, SrsSharedPtr<SrsVhostConfig> > snapshots_;
 public:
     SrsConfig();
     virtual ~SrsConfig();
@@ -322,6 +369,14 @@ public:
     // Reload  the config file.
     // @remark, user can test the config before reload it.
     virtual srs_error_t reload(SrsReloadState *pstate);
+// Snapshot
+public:
+    // Get the compiled snapshot of vhost, build it if not exists.
+    // @remark The snapshot of default vhost is used if vhost not found.
+    virtual SrsSharedPtr<SrsVhostConfig> get_vhost_snapshot(std::string vhost);
+private:
+    // Build the snapshot of vhost by the getters, so the env overwrites are applied.
+    virtual SrsVhostConfig* compile_vhost(std::string vhost);
 private:
     // Reload  the vhost section of config.
     virtual srs_error_t reload_vhost(SrsConfDirective* old_root);
@@ -456,6 +511,10 @@ public:
 // Thread pool section.
 public:
     virtual srs_utime_t get_threads_interval();
+    // The number of worker threads for audio transcoding, 0 to transcode in hybrid thread.
+    virtual int get_threads_audio_transcoders();
+    // The max number of audio frames in queue of a stream, to transcode by workers.
+    virtual int get_threads_audio_queue();
     virtual bool get_circuit_breaker();
     virtual int get_high_threshold();
     virtual int get_high_pulse();
@@ -463,6 +522,53 @@ public:
     virtual int get_critical_pulse();
     virtual int get_dying_threshold();
     virtual int get_dying_pulse();
+    // Get the priority to shed load, the vhost with lower priority is shed when overloaded, 0 to disable.
+    virtual int get_shed_priority();
+// RTMP handshake section.
+public:
+    // Get the number of DH keypairs pre-generated for RTMP complex handshake.
+    virtual int get_rtmp_handshake_dh_pool();
+    // Get the max number of DH keypairs to generate every 100ms.
+    virtual int get_rtmp_handshake_dh_refill();
+    // Get the max concurrency of RTMP complex handshake, 0 for no limit.
+    virtual int get_rtmp_handshake_max_concurrency();
+// Async call section.
+public:
+    // Get the number of executors of global async call workers, such as DVR and RTC.
+    virtual int get_async_call_executors();
+    // Get the max concurrent tasks for each destination, 0 for no limit.
+    virtual int get_async_call_max_per_destination();
+    // Get the max queued tasks of each async worker, 0 for no limit.
+    virtual int get_async_call_max_tasks();
+    // Get the overflow policy, drop_oldest or drop_newest.
+    virtual std::string get_async_call_overflow();
+// Load redirect section.
+public:
+    // Whether redirect clients to less-loaded peers when overloaded.
+    virtual bool get_load_redirect_enabled();
+    // Get the ip of this node for peers to redirect clients to, empty to use the public internet ip.
+    virtual std::string get_load_redirect_ip();
+    // Get the HTTP API endpoints of peers, to exchange load reports with.
+    virtual std::vector<std::string> get_load_redirect_peers();
+    // Get the overloaded thresholds, CPU percent, connections and egress Mbps, 0 to ignore it.
+    virtual int get_load_redirect_cpu();
+    virtual int get_load_redirect_connections();
+    virtual int get_load_redirect_mbps();
+    // Whether redirect publishers, only for cluster which the stream can be played on any node.
+    virtual bool get_load_redirect_publish();
+// Coroutine stack section.
+public:
+    // Get the max number of freed stacks to cache and reuse, -1 for unlimited.
+    virtual int get_stack_pool();
+    // Whether protect the pages around stacks, to crash on stack overflow.
+    // @param default_guard The default if not configured, which is by the build of ST.
+    virtual bool get_stack_guard(bool default_guard);
+    // Whether paint the stacks, to measure the high-water mark.
+    virtual bool get_stack_watermark();
+    // Get the default stack size in bytes of coroutines, 0 to use the default of ST.
+    virtual int get_stack_size();
+    // Get the stack size in bytes of coroutines by name.
+    virtual std::map<std::string, int> get_stack_sizes();
 // TencentCloud service section.
 public:
     virtual bool get_tencentcloud_cls_enabled();
@@ -541,6 +647,11 @@ public:
     std::string get_rtc_dtls_version(std::string vhost);
     int get_rtc_drop_for_pt(std::string vhost);
     bool get_rtc_to_rtmp(std::string vhost);
+    bool get_rtc_keep_opus(std::string vhost);
+    // Whether cache the RTP packets of the last gop, to prime new players.
+    bool get_rtc_gop_cache(std::string vhost);
+    // The max size of RTP gop cache in KB.
+    int get_rtc_gop_cache_max_size(std::string vhost);
     srs_utime_t get_rtc_pli_for_rtmp(std::string vhost);
     bool get_rtc_nack_enabled(std::string vhost);
     bool get_rtc_nack_no_copy(std::string vhost);
@@ -571,6 +682,12 @@ public:
     virtual bool get_gop_cache(std::string vhost);
     // Get the limit max frames for gop cache.
     virtual int get_gop_cache_max_frames(std::string vhost);
+    // Whether start the player at the newest keyframe, and drop the disposable frames of the cached gop.
+    // @remark, default false.
+    virtual bool get_fast_start(std::string vhost);
+    // Get the duration to compress the timestamp of cached gop in, to catch up to the live edge.
+    // @remark, default 0, disabled.
+    virtual srs_utime_t get_fast_start_catchup(std::string vhost);
     // Whether debug_srs_upnode is enabled of vhost.
     // debug_srs_upnode is very important feature for tracable log,
     // but some server, for instance, flussonic donot support it.
@@ -599,6 +716,10 @@ public:
     // when exceed the queue length, drop packet util I frame.
     // @remark, default 10s.
     virtual srs_utime_t get_queue_length(std::string vhost);
+    // Whether drop frames adaptively for slow consumer, that is, drop the non-reference frames, then the
+    // video frames, and shrink the queue as the last resort.
+    // @remark, default off.
+    virtual bool get_adaptive_drop(std::string vhost);
     // Whether the refer hotlink-denial enabled.
     virtual bool get_refer_enabled(std::string vhost);
     // Get the refer hotlink-denial for all type.
@@ -619,6 +740,8 @@ public:
     //       empty string to get the global.
     // @remark, default 60000.
     virtual int get_chunk_size(std::string vhost);
+    // Get the priority of vhost, the load of lower priority vhost is shed first when overloaded.
+    virtual int get_vhost_priority(std::string vhost);
     // Whether parse the sps when publish stream to SRS.
     virtual bool get_parse_sps(std::string vhost);
     // Whether try ANNEXB first when parsing SPS/PPS.
@@ -644,6 +767,10 @@ public:
     virtual bool get_realtime_enabled(std::string vhost, bool is_rtc = false);
     // Whether enable tcp nodelay for all clients of vhost.
     virtual bool get_tcp_nodelay(std::string vhost);
+    // Whether send with MSG_ZEROCOPY for RTMP and HTTP-FLV players.
+    virtual bool get_zerocopy(std::string vhost);
+    // The minimal bytes of a write to send with MSG_ZEROCOPY.
+    virtual int get_zerocopy_threshold(std::string vhost);
     // The minimal send interval in srs_utime_t.
     virtual srs_utime_t get_send_min_interval(std::string vhost);
     // Whether reduce the sequence header.
@@ -748,6 +875,12 @@ public:
     // Get the on_hls_notify callbacks of vhost.
     // @return the on_hls_notify callback directive, the args is the url to callback.
     virtual SrsConfDirective* get_vhost_on_hls_notify(std::string vhost);
+    // Get the TTL to cache the decision of on_connect, on_publish and on_play, 0 to disable.
+    virtual srs_utime_t get_vhost_http_hooks_cache_ttl(std::string vhost);
+    // Get the fields of request to identify the same decision, for cache and coalesce.
+    virtual std::vector<std::string> get_vhost_http_hooks_cache_key(std::string vhost);
+    // Whether coalesce the pending on_connect, on_publish and on_play with the same key.
+    virtual bool get_vhost_http_hooks_coalesce(std::string vhost);
 // vhost cluster section
 public:
     // Whether vhost is edge mode.
@@ -765,6 +898,16 @@ public:
     virtual std::string get_vhost_edge_protocol(std::string vhost);
     // Whether follow client protocol to connect to origin.
     virtual bool get_vhost_edge_follow_client(std::string vhost);
+    // Get the balance to select origin, round_robin, consistent_hash or least_loaded.
+    virtual std::string get_vhost_edge_balance(std::string vhost);
+    // Get the origin servers of HLS/DASH edge, empty to disable it.
+    virtual std::vector<std::string> get_vhost_edge_http_origin(std::string vhost);
+    // Get the TTL of playlist(m3u8 or mpd) in HLS/DASH edge cache.
+    virtual srs_utime_t get_vhost_edge_http_playlist_ttl(std::string vhost);
+    // Get the TTL of segment(ts or m4s) in HLS/DASH edge cache.
+    virtual srs_utime_t get_vhost_edge_http_segment_ttl(std::string vhost);
+    // Get the max size in MB of HLS/DASH edge cache.
+    virtual int get_vhost_edge_http_cache_size(std::string vhost);
     // Whether edge token tranverse is enabled,
     // If  true, edge will send connect origin to verfy the token of client.
     // For example, we verify all clients on the origin FMS by server-side as,
@@ -779,6 +922,10 @@ public:
     // Get the co-workers of origin cluster.
     // @see https://ossrs.net/lts/zh-cn/docs/v4/doc/origin-cluster
     virtual std::vector<std::string> get_vhost_coworkers(std::string vhost);
+    // Whether push the stream events to co-workers, to keep the directory of streams.
+    virtual bool get_vhost_coworkers_directory(std::string vhost);
+    // Get the TTL of stream in directory, expired if not refreshed by origin.
+    virtual srs_utime_t get_vhost_coworkers_ttl(std::string vhost);
 // vhost security section
 public:
     // Whether the secrity of vhost enabled.
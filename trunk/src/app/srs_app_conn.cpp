@@ -20,6 +20,7 @@ using namespace std;
 #include <srs_core_autofree.hpp>
 #include <srs_kernel_buffer.hpp>
 #include <srs_protocol_kbps.hpp>
+#include <srs_kernel_flv.hpp>
 
 SrsPps* _srs_pps_ids = NULL;
 SrsPps* _srs_pps_fids = NULL;
@@ -57,7 +58,10 @@ SrsResourceManager::~SrsResourceManager()
     }
     srs_cond_destroy(cond);
 
-    clear();
+    // Dispose all zombies, which might be more than a batch.
+    while (!zombies_.empty()) {
+        clear();
+    }
 
     // Free all objects not in zombies.
     std::vector<ISrsResource*>::iterator it;
@@ -108,6 +112,11 @@ srs_error_t SrsResourceManager::cycle()
         // when we clear zombie connection.
         while (!zombies_.empty()) {
             clear();
+
+            // Yield between batches, for there might be lots of zombies, for example, when edge reboot.
+            if (!zombies_.empty()) {
+                srs_thread_yield();
+            }
         }
 
         srs_cond_wait(cond);
@@ -118,7 +127,9 @@ srs_error_t SrsResourceManager::cycle()
 
 void SrsResourceManager::add(ISrsResource* conn, bool* exists)
 {
-    if (std::find(conns_.begin(), conns_.end(), conn) == conns_.end()) {
+    if (conns_index_.find(conn) == conns_index_.end()) {
+        SrsResourceIndex& index = conns_index_[conn];
+        index.index = (int)conns_.size();
         conns_.push_back(conn);
     } else {
         if (exists) {
@@ -131,6 +142,11 @@ void SrsResourceManager::add_with_id(const std::string& id, ISrsResource* conn)
 {
     add(conn);
     conns_id_[id] = conn;
+
+    std::vector<std::string>& ids = conns_index_[conn].ids;
+    if (std::find(ids.begin(), ids.end(), id) == ids.end()) {
+        ids.push_back(id);
+    }
 }
 
 void SrsResourceManager::add_with_fast_id(uint64_t id, ISrsResource* conn)
@@ -139,6 +155,11 @@ void SrsResourceManager::add_with_fast_id(uint64_t id, ISrsResource* conn)
     add(conn, &exists);
     conns_fast_id_[id] = conn;
 
+    std::vector<uint64_t>& fast_ids = conns_index_[conn].fast_ids;
+    if (std::find(fast_ids.begin(), fast_ids.end(), id) == fast_ids.end()) {
+        fast_ids.push_back(id);
+    }
+
     if (exists) {
         return;
     }
@@ -170,6 +191,11 @@ void SrsResourceManager::add_with_name(const std::string& name, ISrsResource* co
 {
     add(conn);
     conns_name_[name] = conn;
+
+    std::vector<std::string>& names = conns_index_[conn].names;
+    if (std::find(names.begin(), names.end(), name) == names.end()) {
+        names.push_back(name);
+    }
 }
 
 ISrsResource* SrsResourceManager::at(int index)
@@ -258,6 +284,7 @@ void SrsResourceManager::do_remove(ISrsResource* c)
 
     // Push to zombies, we will free it in another coroutine.
     zombies_.push_back(c);
+    zombies_index_.insert(c);
 
     // We should copy all handlers, because it may change during callback.
     vector<ISrsDisposingHandler*> handlers = handlers_;
@@ -283,17 +310,13 @@ void SrsResourceManager::do_remove(ISrsResource* c)
 void SrsResourceManager::check_remove(ISrsResource* c, bool& in_zombie, bool& in_disposing)
 {
     // Only notify when not removed(in zombies_).
-    vector<ISrsResource*>::iterator it = std::find(zombies_.begin(), zombies_.end(), c);
-    if (it != zombies_.end()) {
+    if (zombies_index_.find(c) != zombies_index_.end()) {
         in_zombie = true;
     }
 
     // Also ignore when we are disposing it.
-    if (p_disposing_) {
-        it = std::find(p_disposing_->begin(), p_disposing_->end(), c);
-        if (it != p_disposing_->end()) {
-            in_disposing = true;
-        }
+    if (p_disposing_ && p_disposing_->find(c) != p_disposing_->end()) {
+        in_disposing = true;
     }
 }
 
@@ -321,9 +344,19 @@ void SrsResourceManager::do_clear()
 {
     // To prevent thread switch when delete connection,
     // we copy all connections then free one by one.
-    vector<ISrsResource*> copy;
-    copy.swap(zombies_);
-    p_disposing_ = &copy;
+    // @remark We only dispose a batch of zombies, to avoid blocking other coroutines for a long time.
+    // @remark The zombies is a deque, so it only costs the size of batch to remove it from the front.
+    int nn = (int)srs_min(zombies_.size(), (size_t)SRS_RESOURCE_DISPOSE_BATCH);
+    vector<ISrsResource*> copy(zombies_.begin(), zombies_.begin() + nn);
+    zombies_.erase(zombies_.begin(), zombies_.begin() + nn);
+
+    std::set<ISrsResource*> disposing;
+    for (int i = 0; i < (int)copy.size(); i++) {
+        ISrsResource* conn = copy.at(i);
+        zombies_index_.erase(conn);
+        disposing.insert(conn);
+    }
+    p_disposing_ = &disposing;
 
     for (int i = 0; i < (int)copy.size(); i++) {
         ISrsResource* conn = copy.at(i);
@@ -354,30 +387,33 @@ void SrsResourceManager::do_clear()
 
 void SrsResourceManager::dispose(ISrsResource* c)
 {
-    for (map<string, ISrsResource*>::iterator it = conns_name_.begin(); it != conns_name_.end();) {
-        if (c != it->second) {
-            ++it;
-        } else {
-            // Use C++98 style: https://stackoverflow.com/a/4636230
-            conns_name_.erase(it++);
+    std::map<ISrsResource*, SrsResourceIndex>::iterator found = conns_index_.find(c);
+    if (found != conns_index_.end()) {
+        SrsResourceIndex& index = found->second;
+
+        // Note that the id or name might be overwrote by other resource, so we only remove the one of c.
+        for (int i = 0; i < (int)index.names.size(); i++) {
+            map<string, ISrsResource*>::iterator it = conns_name_.find(index.names.at(i));
+            if (it != conns_name_.end() && it->second == c) {
+                conns_name_.erase(it);
+            }
         }
-    }
 
-    for (map<string, ISrsResource*>::iterator it = conns_id_.begin(); it != conns_id_.end();) {
-        if (c != it->second) {
-            ++it;
-        } else {
-            // Use C++98 style: https://stackoverflow.com/a/4636230
-            conns_id_.erase(it++);
+        for (int i = 0; i < (int)index.ids.size(); i++) {
+            map<string, ISrsResource*>::iterator it = conns_id_.find(index.ids.at(i));
+            if (it != conns_id_.end() && it->second == c) {
+                conns_id_.erase(it);
+            }
         }
-    }
 
-    for (map<uint64_t, ISrsResource*>::iterator it = conns_fast_id_.begin(); it != conns_fast_id_.end();) {
-        if (c != it->second) {
-            ++it;
-        } else {
+        for (int i = 0; i < (int)index.fast_ids.size(); i++) {
+            uint64_t id = index.fast_ids.at(i);
+            map<uint64_t, ISrsResource*>::iterator it = conns_fast_id_.find(id);
+            if (it == conns_fast_id_.end() || it->second != c) {
+                continue;
+            }
+
             // Update the level-0 cache for fast-id.
-            uint64_t id = it->first;
             SrsResourceFastIdItem* item = &conns_level0_cache_[(id | id>>32) % nn_level0_cache_];
             item->nn_collisions--;
             if (!item->nn_collisions) {
@@ -385,14 +421,17 @@ void SrsResourceManager::dispose(ISrsResource* c)
                 item->available = false;
             }
 
-            // Use C++98 style: https://stackoverflow.com/a/4636230
-            conns_fast_id_.erase(it++);
+            conns_fast_id_.erase(it);
         }
-    }
 
-    vector<ISrsResource*>::iterator it = std::find(conns_.begin(), conns_.end(), c);
-    if (it != conns_.end()) {
-        it = conns_.erase(it);
+        // Move the last resource to the position of c, so we never move the others.
+        int pos = index.index;
+        ISrsResource* last = conns_.back();
+        conns_[pos] = last;
+        conns_index_[last].index = pos;
+        conns_.pop_back();
+
+        conns_index_.erase(c);
     }
 
     // We should copy all handlers, because it may change during callback.
@@ -516,6 +555,16 @@ srs_error_t SrsTcpConnection::set_socket_buffer(srs_utime_t buffer_v)
     return err;
 }
 
+srs_error_t SrsTcpConnection::set_zerocopy(int threshold)
+{
+    return skt->set_zerocopy(threshold);
+}
+
+void SrsTcpConnection::zerocopy_free(SrsSharedPtrMessage* msg)
+{
+    skt->zerocopy_free(msg);
+}
+
 void SrsTcpConnection::set_recv_timeout(srs_utime_t tm)
 {
     skt->set_recv_timeout(tm);
@@ -615,6 +664,27 @@ srs_error_t SrsBufferedReadWriter::reload_buffer()
     return err;
 }
 
+srs_error_t SrsBufferedReadWriter::set_zerocopy(int threshold)
+{
+    ISrsZerocopyWriter* zc = dynamic_cast<ISrsZerocopyWriter*>(io_);
+    if (!zc) {
+        return srs_error_new(ERROR_SOCKET_ZEROCOPY, "not supported");
+    }
+
+    return zc->set_zerocopy(threshold);
+}
+
+void SrsBufferedReadWriter::zerocopy_free(SrsSharedPtrMessage* msg)
+{
+    ISrsZerocopyWriter* zc = dynamic_cast<ISrsZerocopyWriter*>(io_);
+    if (!zc) {
+        srs_freep(msg);
+        return;
+    }
+
+    zc->zerocopy_free(msg);
+}
+
 srs_error_t SrsBufferedReadWriter::read(void* buf, size_t size, ssize_t* nread)
 {
     if (!buf_ || buf_->empty()) {
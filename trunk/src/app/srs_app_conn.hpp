@@ -11,7 +11,9 @@
 
 #include <string>
 #include <vector>
+#include <deque>
 #include <map>
+#include <set>
 
 #include <openssl/ssl.h>
 #include <openssl/err.h>
@@ -62,6 +64,25 @@ public:
     }
 };
 
+// The index of resource in manager, to remove it from all containers without scanning them.
+class SrsResourceIndex
+{
+public:
+    // The position in the resources array.
+    int index;
+    // The ids, fast ids and names of resource.
+    std::vector<std::string> ids;
+    std::vector<uint64_t> fast_ids;
+    std::vector<std::string> names;
+public:
+    SrsResourceIndex() {
+        index = -1;
+    }
+};
+
+// The max number of zombies to dispose in a batch, then yield to other coroutines.
+#define SRS_RESOURCE_DISPOSE_BATCH 1000
+
 // The resource manager remove resource and delete it asynchronously.
 class SrsResourceManager : public ISrsCoroutineHandler, public ISrsResourceManager
 {
@@ -78,9 +99,11 @@ private:
     std::vector<ISrsDisposingHandler*> unsubs_;
     // Whether we are removing resources.
     bool removing_;
-    // The zombie connections, we will delete it asynchronously.
-    std::vector<ISrsResource*> zombies_;
-    std::vector<ISrsResource*>* p_disposing_;
+    // The zombie connections, we will delete it asynchronously, in batches from the front.
+    std::deque<ISrsResource*> zombies_;
+    // The index of zombies, to check whether resource is zombie.
+    std::set<ISrsResource*> zombies_index_;
+    std::set<ISrsResource*>* p_disposing_;
 private:
     // The connections without any id.
     std::vector<ISrsResource*> conns_;
@@ -93,6 +116,8 @@ private:
     SrsResourceFastIdItem* conns_level0_cache_;
     // The connections with resource name.
     std::map<std::string, ISrsResource*> conns_name_;
+    // The index of connections, to remove the connection without scanning.
+    std::map<ISrsResource*, SrsResourceIndex> conns_index_;
 public:
     SrsResourceManager(const std::string& label, bool verbose = false);
     virtual ~SrsResourceManager();
@@ -203,7 +228,7 @@ public:
 // The basic connection of SRS, for TCP based protocols,
 // all connections accept from listener must extends from this base class,
 // server will add the connection to manager, and delete it when remove.
-class SrsTcpConnection : public ISrsProtocolReadWriter
+class SrsTcpConnection : public ISrsProtocolReadWriter, public ISrsZerocopyWriter
 {
 private:
     // The underlayer st fd handler.
@@ -218,6 +243,10 @@ public:
     virtual srs_error_t set_tcp_nodelay(bool v);
     // Set socket option SO_SNDBUF in srs_utime_t.
     virtual srs_error_t set_socket_buffer(srs_utime_t buffer_v);
+// Interface ISrsZerocopyWriter
+public:
+    virtual srs_error_t set_zerocopy(int threshold);
+    virtual void zerocopy_free(SrsSharedPtrMessage* msg);
 // Interface ISrsProtocolReadWriter
 public:
     virtual void set_recv_timeout(srs_utime_t tm);
@@ -234,7 +263,7 @@ public:
 
 // With a small fast read buffer, to support peek for protocol detecting. Note that directly write to io without any
 // cache or buffer.
-class SrsBufferedReadWriter : public ISrsProtocolReadWriter
+class SrsBufferedReadWriter : public ISrsProtocolReadWriter, public ISrsZerocopyWriter
 {
 private:
     // The under-layer transport.
@@ -252,6 +281,10 @@ public:
     srs_error_t peek(char* buf, int* size);
 private:
     srs_error_t reload_buffer();
+// Interface ISrsZerocopyWriter
+public:
+    virtual srs_error_t set_zerocopy(int threshold);
+    virtual void zerocopy_free(SrsSharedPtrMessage* msg);
 // Interface ISrsProtocolReadWriter
 public:
     virtual srs_error_t read(void* buf, size_t size, ssize_t* nread);
@@ -16,21 +16,82 @@ using namespace std;
 #include <srs_protocol_utility.hpp>
 #include <srs_protocol_utility.hpp>
 #include <srs_kernel_utility.hpp>
+#include <srs_kernel_log.hpp>
+#include <srs_app_http_hooks.hpp>
+#include <srs_app_hybrid.hpp>
+#include <srs_app_utility.hpp>
+#include <srs_app_statistic.hpp>
+
+SrsCoWorkersEntry::SrsCoWorkersEntry()
+{
+    port = 0;
+    version = 0;
+    expire = 0;
+}
+
+SrsCoWorkersEntry::~SrsCoWorkersEntry()
+{
+}
+
+SrsCoWorkersPushTask::SrsCoWorkersPushTask(string c, string b)
+{
+    coworker = c;
+    body = b;
+}
+
+SrsCoWorkersPushTask::~SrsCoWorkersPushTask()
+{
+}
+
+srs_error_t SrsCoWorkersPushTask::call()
+{
+    srs_error_t err = srs_success;
+
+    string url = "http://" + coworker + "/api/v1/clusters";
+    if ((err = SrsHttpHooks::push_co_workers(url, body)) != srs_success) {
+        return srs_error_wrap(err, "push coworker %s", coworker.c_str());
+    }
+
+    return err;
+}
+
+string SrsCoWorkersPushTask::to_string()
+{
+    return "push " + coworker + " " + body;
+}
+
+string SrsCoWorkersPushTask::destination()
+{
+    return coworker;
+}
 
 SrsCoWorkers* SrsCoWorkers::_instance = NULL;
 
 SrsCoWorkers::SrsCoWorkers()
 {
+    pusher = new SrsAsyncCallWorker();
+    last_refresh = 0;
+    counter = 0;
 }
 
 SrsCoWorkers::~SrsCoWorkers()
 {
+    pusher->stop();
+    srs_freep(pusher);
+
     map<string, SrsRequest*>::iterator it;
     for (it = streams.begin(); it != streams.end(); ++it) {
         SrsRequest* r = it->second;
         srs_freep(r);
     }
     streams.clear();
+
+    map<string, SrsCoWorkersEntry*>::iterator it2;
+    for (it2 = directory.begin(); it2 != directory.end(); ++it2) {
+        SrsCoWorkersEntry* entry = it2->second;
+        srs_freep(entry);
+    }
+    directory.clear();
 }
 
 SrsCoWorkers* SrsCoWorkers::instance()
@@ -49,37 +110,9 @@ SrsJsonAny* SrsCoWorkers::dumps(string vhost, string coworker, string app, strin
         return SrsJsonAny::null();
     }
 
-    // The service port parsing from listen port.
-    string listen_host;
-    int listen_port = SRS_CONSTS_RTMP_DEFAULT_PORT;
-    vector<string> listen_hostports = _srs_config->get_listens();
-    if (!listen_hostports.empty()) {
-        string list_hostport = listen_hostports.at(0);
-
-        if (list_hostport.find(":") != string::npos) {
-            srs_parse_hostport(list_hostport, listen_host, listen_port);
-        } else {
-            listen_port = ::atoi(list_hostport.c_str());
-        }
-    }
-
-    // The ip of server, we use the request coworker-host as ip, if listen host is localhost or loopback.
-    // For example, the server may behind a NAT(192.x.x.x), while its ip is a docker ip(172.x.x.x),
-    // we should use the NAT(192.x.x.x) address as it's the exposed ip.
-    // @see https://github.com/ossrs/srs/issues/1501
     string service_ip;
-    if (listen_host != SRS_CONSTS_LOCALHOST && listen_host != SRS_CONSTS_LOOPBACK && listen_host != SRS_CONSTS_LOOPBACK6) {
-        service_ip = listen_host;
-    }
-    if (service_ip.empty()) {
-        int coworker_port;
-        string coworker_host = coworker;
-        if (coworker.find(":") != string::npos) {
-            srs_parse_hostport(coworker, coworker_host, coworker_port);
-        }
-
-        service_ip = coworker_host;
-    }
+    int listen_port = SRS_CONSTS_RTMP_DEFAULT_PORT;
+    service_address(coworker, service_ip, listen_port);
     if (service_ip.empty()) {
         service_ip = srs_get_public_internet_address();
     }
@@ -104,6 +137,160 @@ SrsJsonAny* SrsCoWorkers::dumps(string vhost, string coworker, string app, strin
         ->set("routers", routers);
 }
 
+srs_error_t SrsCoWorkers::initialize()
+{
+    srs_error_t err = srs_success;
+
+    pusher->set_executors(_srs_config->get_async_call_executors());
+    if ((err = pusher->start()) != srs_success) {
+        return srs_error_wrap(err, "start pusher");
+    }
+
+    _srs_hybrid->timer5s()->subscribe(this);
+
+    return err;
+}
+
+bool SrsCoWorkers::find_origin(string vhost, string app, string stream, string& ip, int& port)
+{
+    string url = directory_url(vhost, app, stream);
+    map<string, SrsCoWorkersEntry*>::iterator it = directory.find(url);
+    if (it == directory.end()) {
+        return false;
+    }
+
+    SrsCoWorkersEntry* entry = it->second;
+    if (entry->expire < srs_get_system_time()) {
+        return false;
+    }
+
+    ip = entry->ip;
+    port = entry->port;
+    return true;
+}
+
+srs_error_t SrsCoWorkers::on_event(SrsJsonObject* event, string peer)
+{
+    srs_error_t err = srs_success;
+
+    SrsJsonAny* prop = NULL;
+    if ((prop = event->ensure_property_string("action")) == NULL) {
+        return srs_error_new(ERROR_OCLUSTER_DISCOVER, "no action");
+    }
+    string action = prop->to_str();
+    if (action != "on_publish" && action != "on_refresh" && action != "on_unpublish") {
+        return srs_error_new(ERROR_OCLUSTER_DISCOVER, "invalid action %s", action.c_str());
+    }
+
+    string vhost, app, stream, origin, ip;
+    if ((prop = event->ensure_property_string("vhost")) != NULL) {
+        vhost = prop->to_str();
+    }
+
+    // Only accept the events from coworkers, or anyone is able to hijack the streams.
+    if (!srs_is_endpoint_ip(_srs_config->get_vhost_coworkers(vhost), peer)) {
+        return srs_error_new(ERROR_HTTP_PEER_FORBIDDEN, "peer %s not coworker of vhost %s", peer.c_str(), vhost.c_str());
+    }
+
+    if ((prop = event->ensure_property_string("app")) != NULL) {
+        app = prop->to_str();
+    }
+    if ((prop = event->ensure_property_string("stream")) == NULL) {
+        return srs_error_new(ERROR_OCLUSTER_DISCOVER, "no stream");
+    }
+    stream = prop->to_str();
+
+    if ((prop = event->ensure_property_string("origin")) == NULL) {
+        return srs_error_new(ERROR_OCLUSTER_DISCOVER, "no origin");
+    }
+    origin = prop->to_str();
+
+    // Ignore the event of this origin itself.
+    if (origin == SrsStatistic::instance()->service_id()) {
+        return err;
+    }
+
+    // Use the ip of peer, if origin listen at localhost or any address.
+    if ((prop = event->ensure_property_string("ip")) != NULL) {
+        ip = prop->to_str();
+    }
+    if (ip.empty()) {
+        ip = peer;
+    }
+
+    int port = SRS_CONSTS_RTMP_DEFAULT_PORT;
+    if ((prop = event->ensure_property_integer("port")) != NULL) {
+        port = (int)prop->to_integer();
+    }
+
+    int64_t version = 0;
+    if ((prop = event->ensure_property_integer("version")) != NULL) {
+        version = prop->to_integer();
+    }
+
+    srs_utime_t ttl = _srs_config->get_vhost_coworkers_ttl(vhost);
+    if ((prop = event->ensure_property_integer("ttl")) != NULL) {
+        ttl = prop->to_integer() * SRS_UTIME_SECONDS;
+    }
+
+    update(action, vhost, app, stream, origin, ip, port, version, ttl);
+
+    return err;
+}
+
+void SrsCoWorkers::update(string action, string vhost, string app, string stream, string origin, string ip, int port, int64_t version, srs_utime_t ttl)
+{
+    string url = directory_url(vhost, app, stream);
+    map<string, SrsCoWorkersEntry*>::iterator it = directory.find(url);
+    SrsCoWorkersEntry* entry = (it != directory.end()) ? it->second : NULL;
+
+    // Ignore the stale event of the same origin, for example, the unpublish of previous publisher is delayed.
+    if (entry && entry->origin == origin && version < entry->version) {
+        return;
+    }
+
+    // The versions of different origins are not comparable, so only the new publisher takes over the
+    // stream, and ignore the delayed refresh or unpublish of previous origin.
+    if (entry && entry->origin != origin && action != "on_publish") {
+        if (action == "on_unpublish" || entry->expire >= srs_get_system_time()) {
+            return;
+        }
+    }
+
+    if (action == "on_unpublish") {
+        if (entry) {
+            srs_freep(entry);
+            directory.erase(it);
+            srs_trace("cluster: remove %s of %s:%d, version=%" PRId64, url.c_str(), ip.c_str(), port, version);
+        }
+        return;
+    }
+
+    if (!entry) {
+        entry = new SrsCoWorkersEntry();
+        directory[url] = entry;
+        srs_trace("cluster: add %s of %s:%d, version=%" PRId64 ", ttl=%dms", url.c_str(), ip.c_str(), port, version, srsu2msi(ttl));
+    }
+
+    entry->ip = ip;
+    entry->port = port;
+    entry->origin = origin;
+    entry->version = version;
+    entry->expire = srs_get_system_time() + ttl;
+}
+
+string SrsCoWorkers::directory_url(string vhost, string app, string stream)
+{
+    // Use the default vhost, if vhost not exists.
+    SrsConfDirective* conf = _srs_config->get_vhost(vhost, true);
+    return srs_generate_stream_url(conf ? conf->arg0() : vhost, app, stream);
+}
+
+int SrsCoWorkers::nn_directory()
+{
+    return (int)directory.size();
+}
+
 SrsRequest* SrsCoWorkers::find_stream_info(string vhost, string app, string stream)
 {
     // First, we should parse the vhost, if not exists, try default vhost instead.
@@ -122,6 +309,112 @@ SrsRequest* SrsCoWorkers::find_stream_info(string vhost, string app, string stre
     return it->second;
 }
 
+void SrsCoWorkers::service_address(string coworker, string& ip, int& port)
+{
+    // The service port parsing from listen port.
+    string listen_host;
+    vector<string> listen_hostports = _srs_config->get_listens();
+    if (!listen_hostports.empty()) {
+        string list_hostport = listen_hostports.at(0);
+
+        if (list_hostport.find(":") != string::npos) {
+            srs_parse_hostport(list_hostport, listen_host, port);
+        } else {
+            port = ::atoi(list_hostport.c_str());
+        }
+    }
+
+    // The ip of server, we use the request coworker-host as ip, if listen host is localhost or loopback.
+    // For example, the server may behind a NAT(192.x.x.x), while its ip is a docker ip(172.x.x.x),
+    // we should use the NAT(192.x.x.x) address as it's the exposed ip.
+    // @see https://github.com/ossrs/srs/issues/1501
+    if (listen_host != SRS_CONSTS_LOCALHOST && listen_host != SRS_CONSTS_LOOPBACK && listen_host != SRS_CONSTS_LOOPBACK6) {
+        ip = listen_host;
+    }
+    if (ip.empty() && !coworker.empty()) {
+        int coworker_port;
+        string coworker_host = coworker;
+        if (coworker.find(":") != string::npos) {
+            srs_parse_hostport(coworker, coworker_host, coworker_port);
+        }
+
+        ip = coworker_host;
+    }
+}
+
+void SrsCoWorkers::push(string action, SrsRequest* r, int64_t version)
+{
+    srs_error_t err = srs_success;
+
+    if (!_srs_config->get_vhost_coworkers_directory(r->vhost)) {
+        return;
+    }
+
+    vector<string> coworkers = _srs_config->get_vhost_coworkers(r->vhost);
+    if (coworkers.empty()) {
+        return;
+    }
+
+    // Leave the ip empty if listen at any address, coworker will use the ip of peer.
+    string ip;
+    int port = SRS_CONSTS_RTMP_DEFAULT_PORT;
+    service_address("", ip, port);
+
+    srs_utime_t ttl = _srs_config->get_vhost_coworkers_ttl(r->vhost);
+    SrsUniquePtr<SrsJsonObject> obj(SrsJsonAny::object());
+    obj->set("action", SrsJsonAny::str(action.c_str()))
+        ->set("vhost", SrsJsonAny::str(r->vhost.c_str()))
+        ->set("app", SrsJsonAny::str(r->app.c_str()))
+        ->set("stream", SrsJsonAny::str(r->stream.c_str()))
+        ->set("origin", SrsJsonAny::str(SrsStatistic::instance()->service_id().c_str()))
+        ->set("ip", SrsJsonAny::str(ip.c_str()))
+        ->set("port", SrsJsonAny::integer(port))
+        ->set("version", SrsJsonAny::integer(version))
+        ->set("ttl", SrsJsonAny::integer(srsu2msi(ttl) / 1000));
+    string body = obj->dumps();
+
+    for (int i = 0; i < (int)coworkers.size(); i++) {
+        // The coworkers might be shared by all origins, so never push to this origin itself.
+        if (is_self(coworkers.at(i))) {
+            continue;
+        }
+
+        if ((err = pusher->execute(new SrsCoWorkersPushTask(coworkers.at(i), body))) != srs_success) {
+            srs_warn("cluster: ignore push err %s", srs_error_desc(err).c_str());
+            srs_freep(err);
+        }
+    }
+}
+
+bool SrsCoWorkers::is_self(string coworker)
+{
+    string host;
+    int port = 0;
+    srs_parse_endpoint(coworker, host, port);
+
+    string api_host;
+    int api_port = 0;
+    srs_parse_endpoint(_srs_config->get_http_api_listen(), api_host, api_port);
+
+    if (port != api_port) {
+        return false;
+    }
+
+    if (host == api_host || host == SRS_CONSTS_LOCALHOST || host == SRS_CONSTS_LOCALHOST_NAME
+        || host == SRS_CONSTS_LOOPBACK || host == SRS_CONSTS_LOOPBACK6) {
+        return true;
+    }
+
+    vector<SrsIPAddress*>& ips = srs_get_local_ips();
+    for (int i = 0; i < (int)ips.size(); i++) {
+        if (ips.at(i)->ip == host) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 srs_error_t SrsCoWorkers::on_publish(SrsRequest* r)
 {
     srs_error_t err = srs_success;
@@ -136,6 +429,11 @@ srs_error_t SrsCoWorkers::on_publish(SrsRequest* r)
     
     // Always use the latest one.
     streams[url] = r->copy();
+
+    // The version is increased for each publishing, so the latest publisher of this origin always wins.
+    int64_t version = ++counter;
+    versions[url] = version;
+    push("on_publish", r, version);
     
     return err;
 }
@@ -149,5 +447,54 @@ void SrsCoWorkers::on_unpublish(SrsRequest* r)
         srs_freep(it->second);
         streams.erase(it);
     }
+
+    map<string, int64_t>::iterator it2 = versions.find(url);
+    if (it2 != versions.end()) {
+        push("on_unpublish", r, it2->second);
+        versions.erase(it2);
+    }
+}
+
+srs_error_t SrsCoWorkers::on_timer(srs_utime_t interval)
+{
+    srs_error_t err = srs_success;
+
+    srs_utime_t now = srs_get_system_time();
+
+    // Remove the expired streams, which is not refreshed by origin, for example, origin crashed.
+    map<string, SrsCoWorkersEntry*>::iterator it;
+    for (it = directory.begin(); it != directory.end();) {
+        SrsCoWorkersEntry* entry = it->second;
+        if (entry->expire >= now) {
+            ++it;
+            continue;
+        }
+
+        srs_trace("cluster: expire %s of %s:%d", it->first.c_str(), entry->ip.c_str(), entry->port);
+        srs_freep(entry);
+        directory.erase(it++);
+    }
+
+    // Refresh the local streams to coworkers, about 3 times in TTL. A stale entry, for example, the
+    // refresh is delayed after unpublish, will be expired by TTL.
+    bool refreshed = false;
+    map<string, SrsRequest*>::iterator it2;
+    for (it2 = streams.begin(); it2 != streams.end(); ++it2) {
+        SrsRequest* r = it2->second;
+
+        srs_utime_t ttl = _srs_config->get_vhost_coworkers_ttl(r->vhost);
+        if (now - last_refresh < ttl / 3) {
+            continue;
+        }
+
+        push("on_refresh", r, versions[it2->first]);
+        refreshed = true;
+    }
+
+    if (refreshed) {
+        last_refresh = now;
+    }
+
+    return err;
 }
 
@@ -12,29 +12,104 @@
 #include <string>
 #include <map>
 
+#include <srs_app_async_call.hpp>
+#include <srs_app_hourglass.hpp>
+
 class SrsJsonAny;
+class SrsJsonObject;
 class SrsRequest;
 class SrsLiveSource;
 
+// The stream in directory of origin cluster, pushed by the origin which is publishing it.
+class SrsCoWorkersEntry
+{
+public:
+    // The service address of origin, for client to redirect to.
+    std::string ip;
+    int port;
+    // The id of origin, which is changed when origin restarts.
+    std::string origin;
+    // The version of stream, which is a monotonic counter of origin, so it's only comparable for
+    // the events of the same origin.
+    int64_t version;
+    // The time to expire, if not refreshed by origin.
+    srs_utime_t expire;
+public:
+    SrsCoWorkersEntry();
+    virtual ~SrsCoWorkersEntry();
+};
+
+// The async call to push the stream event to coworker.
+class SrsCoWorkersPushTask : public ISrsAsyncCallTask
+{
+private:
+    std::string coworker;
+    std::string body;
+public:
+    SrsCoWorkersPushTask(std::string c, std::string b);
+    virtual ~SrsCoWorkersPushTask();
+public:
+    virtual srs_error_t call();
+    virtual std::string to_string();
+    virtual std::string destination();
+};
+
 // For origin cluster.
-class SrsCoWorkers
+// The origin pushes the publish and unpublish events to coworkers, which keep a directory of stream
+// to origin, so that the redirect is a local lookup, rather than querying each coworker by HTTP API.
+class SrsCoWorkers : public ISrsFastTimer
 {
 private:
     static SrsCoWorkers* _instance;
 private:
     std::map<std::string, SrsRequest*> streams;
+    // The version of local streams, generated by counter when publishing.
+    std::map<std::string, int64_t> versions;
+    // The monotonic counter for versions, never use the wall clock which differs between origins.
+    int64_t counter;
+    // The directory of streams published on coworkers.
+    std::map<std::string, SrsCoWorkersEntry*> directory;
+    // The async worker to push events to coworkers.
+    SrsAsyncCallWorker* pusher;
+    // The last time to refresh the local streams to coworkers.
+    srs_utime_t last_refresh;
 private:
     SrsCoWorkers();
     virtual ~SrsCoWorkers();
 public:
     static SrsCoWorkers* instance();
 public:
+    // Start the pusher and timer to refresh and expire the directory.
+    virtual srs_error_t initialize();
     virtual SrsJsonAny* dumps(std::string vhost, std::string coworker, std::string app, std::string stream);
+    // Find the origin of stream in the directory, return false if not found or expired.
+    virtual bool find_origin(std::string vhost, std::string app, std::string stream, std::string& ip, int& port);
+    // When got event pushed by coworker, the peer is the ip of coworker, which must be configured
+    // in coworkers of vhost.
+    virtual srs_error_t on_event(SrsJsonObject* event, std::string peer);
+    // Update the directory by event, the action is on_publish, on_refresh or on_unpublish. For the same
+    // origin, ignore the event which is older than the entry. For other origin, only the on_publish
+    // takes over the entry, or the on_refresh if entry is expired.
+    virtual void update(std::string action, std::string vhost, std::string app, std::string stream,
+        std::string origin, std::string ip, int port, int64_t version, srs_utime_t ttl);
+    // Get the number of streams in directory.
+    virtual int nn_directory();
 private:
     virtual SrsRequest* find_stream_info(std::string vhost, std::string app, std::string stream);
+    // Get the url of stream in directory, the vhost is resolved by config.
+    virtual std::string directory_url(std::string vhost, std::string app, std::string stream);
+    // Get the service ip and port of this origin, the coworker is the host to access this origin.
+    virtual void service_address(std::string coworker, std::string& ip, int& port);
+    // Push the event of local stream to all coworkers, except this origin itself.
+    virtual void push(std::string action, SrsRequest* r, int64_t version);
+    // Whether the coworker is this origin itself, by the HTTP API endpoint.
+    virtual bool is_self(std::string coworker);
 public:
     virtual srs_error_t on_publish(SrsRequest* r);
     virtual void on_unpublish(SrsRequest* r);
+// Interface ISrsFastTimer
+private:
+    virtual srs_error_t on_timer(srs_utime_t interval);
 };
 
 #endif
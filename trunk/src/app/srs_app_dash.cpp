@@ -799,6 +799,11 @@ srs_error_t SrsDash::on_audio(SrsSharedPtrMessage* shared_audio, SrsFormat* form
         return err;
     }
 
+    // Only support AAC in fMP4, ignore others such as Opus in enhanced RTMP.
+    if (format->acodec->id != SrsAudioCodecIdAAC) {
+        return err;
+    }
+
     // update the dash time, for dash_dispose.
     last_update_time_ = srs_get_system_time();
 
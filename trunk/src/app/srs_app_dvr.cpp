@@ -457,6 +457,11 @@ srs_error_t SrsDvrMp4Segmenter::encode_audio(SrsSharedPtrMessage* audio, SrsForm
     srs_error_t err = srs_success;
     
     SrsAudioCodecId sound_format = format->acodec->id;
+    // Only support AAC and MP3 in MP4, ignore others such as Opus in enhanced RTMP.
+    if (sound_format != SrsAudioCodecIdAAC && sound_format != SrsAudioCodecIdMP3) {
+        return err;
+    }
+
     SrsAudioSampleRate sound_rate = format->acodec->sound_rate;
     SrsAudioSampleBits sound_size = format->acodec->sound_size;
     SrsAudioChannels channels = format->acodec->sound_type;
@@ -566,6 +571,12 @@ string SrsDvrAsyncCallOnDvr::to_string()
     return ss.str();
 }
 
+string SrsDvrAsyncCallOnDvr::destination()
+{
+    SrsConfDirective* conf = _srs_config->get_vhost_on_dvr(req->vhost);
+    return conf ? srs_join_vector_string(conf->args, ",") : "";
+}
+
 SrsDvrPlan::SrsDvrPlan()
 {
     req = NULL;
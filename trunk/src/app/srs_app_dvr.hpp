@@ -151,6 +151,7 @@ public:
 public:
     virtual srs_error_t call();
     virtual std::string to_string();
+    virtual std::string destination();
 };
 
 // The DVR plan, when and how to reap segment.
@@ -43,6 +43,26 @@ using namespace std;
 // when edge error, wait for quit
 #define SRS_EDGE_FORWARDER_TIMEOUT (150 * SRS_UTIME_MILLISECONDS)
 
+// The load and health of origins, shared by all edge streams.
+SrsLbLoads* _srs_edge_loads = NULL;
+
+// Create the load balancer to select origin, by the balance of vhost.
+ISrsLoadBalancer* srs_edge_create_lb(SrsRequest* req)
+{
+    string balance = _srs_config->get_vhost_edge_balance(req->vhost);
+
+    // Concentrate each stream on one origin, for the cache locality of origin.
+    if (balance == "consistent_hash") {
+        return new SrsLbConsistentHash(req->get_stream_url());
+    }
+
+    if (balance == "least_loaded") {
+        return new SrsLbLeastLoaded(_srs_edge_loads, req->get_stream_url());
+    }
+
+    return new SrsLbRoundRobin();
+}
+
 SrsEdgeUpstream::SrsEdgeUpstream()
 {
 }
@@ -63,7 +83,7 @@ SrsEdgeRtmpUpstream::~SrsEdgeRtmpUpstream()
     close();
 }
 
-srs_error_t SrsEdgeRtmpUpstream::connect(SrsRequest* r, SrsLbRoundRobin* lb)
+srs_error_t SrsEdgeRtmpUpstream::connect(SrsRequest* r, ISrsLoadBalancer* lb)
 {
     srs_error_t err = srs_success;
     
@@ -180,7 +200,7 @@ SrsEdgeFlvUpstream::~SrsEdgeFlvUpstream()
     close();
 }
 
-srs_error_t SrsEdgeFlvUpstream::connect(SrsRequest* r, SrsLbRoundRobin* lb)
+srs_error_t SrsEdgeFlvUpstream::connect(SrsRequest* r, ISrsLoadBalancer* lb)
 {
     // Because we might modify the r, which cause retry fail, so we must copy it.
     SrsRequest* cp = r->copy();
@@ -192,7 +212,7 @@ srs_error_t SrsEdgeFlvUpstream::connect(SrsRequest* r, SrsLbRoundRobin* lb)
     return do_connect(cp, lb, 0);
 }
 
-srs_error_t SrsEdgeFlvUpstream::do_connect(SrsRequest* r, SrsLbRoundRobin* lb, int redirect_depth)
+srs_error_t SrsEdgeFlvUpstream::do_connect(SrsRequest* r, ISrsLoadBalancer* lb, int redirect_depth)
 {
     srs_error_t err = srs_success;
 
@@ -423,6 +443,9 @@ srs_error_t SrsEdgeIngester::initialize(SrsSharedPtr<SrsLiveSource> s, SrsPlayEd
     edge = e;
     req = r;
 
+    srs_freep(lb);
+    lb = srs_edge_create_lb(req);
+
 #ifdef SRS_APM
     // We create a dedicate span for edge ingester, and all players will link to this one.
     // Note that we use a producer span and end it immediately.
@@ -456,6 +479,9 @@ void SrsEdgeIngester::stop()
     trd->stop();
     upstream->close();
 
+    // Never count the stopped stream as load of origin, and acquire again when restart.
+    lb->release();
+
     // Notify source to un-publish if exists.
     if (source_) {
         source_->on_unpublish();
@@ -556,8 +582,11 @@ srs_error_t SrsEdgeIngester::do_cycle()
         }
         
         if ((err = upstream->connect(req, lb)) != srs_success) {
+            // Failover to another origin, for the sticky balancer.
+            lb->feedback(lb->selected(), false);
             return srs_error_wrap(err, "connect upstream");
         }
+        lb->feedback(lb->selected(), true);
         
         if ((err = edge->on_ingest_play()) != srs_success) {
             return srs_error_wrap(err, "notify edge play");
@@ -756,6 +785,9 @@ srs_error_t SrsEdgeForwarder::initialize(SrsSharedPtr<SrsLiveSource> s, SrsPubli
     edge = e;
     req = r;
 
+    srs_freep(lb);
+    lb = srs_edge_create_lb(req);
+
     return srs_success;
 }
 
@@ -801,8 +833,11 @@ srs_error_t SrsEdgeForwarder::start()
 #endif
     
     if ((err = sdk->connect()) != srs_success) {
+        // Failover to another origin, for the sticky balancer.
+        lb->feedback(lb->selected(), false);
         return srs_error_wrap(err, "sdk connect %s failed, cto=%dms, sto=%dms.", url.c_str(), srsu2msi(cto), srsu2msi(sto));
     }
+    lb->feedback(lb->selected(), true);
 
     // For RTMP client, we pass the vhost in tcUrl when connecting,
     // so we publish without vhost in stream.
@@ -829,6 +864,9 @@ void SrsEdgeForwarder::stop()
     srs_freep(sdk);
 
     queue->clear();
+
+    // Never count the stopped stream as load of origin, and acquire again when restart.
+    lb->release();
 }
 
 // when error, edge ingester sleep for a while and retry.
@@ -1095,8 +1133,10 @@ srs_error_t SrsPublishEdge::on_client_publish()
     // start to forward stream to origin.
     err = forwarder->start();
     
-    // when failed, revert to init
+    // when failed, revert to init, and release the origin selected by forwarder.
     if (err != srs_success) {
+        forwarder->stop();
+
         SrsEdgeState pstate = state;
         state = SrsEdgeStateInit;
         srs_trace("edge revert from %d to state %d (push), error %s", pstate, state, srs_error_desc(err).c_str());
@@ -25,7 +25,8 @@ class SrsCommonMessage;
 class SrsMessageQueue;
 class ISrsProtocolReadWriter;
 class SrsKbps;
-class SrsLbRoundRobin;
+class ISrsLoadBalancer;
+class SrsLbLoads;
 class SrsTcpClient;
 class SrsSimpleRtmpClient;
 class SrsPacket;
@@ -66,7 +67,7 @@ public:
     SrsEdgeUpstream();
     virtual ~SrsEdgeUpstream();
 public:
-    virtual srs_error_t connect(SrsRequest* r, SrsLbRoundRobin* lb) = 0;
+    virtual srs_error_t connect(SrsRequest* r, ISrsLoadBalancer* lb) = 0;
     virtual srs_error_t recv_message(SrsCommonMessage** pmsg) = 0;
     virtual srs_error_t decode_message(SrsCommonMessage* msg, SrsPacket** ppacket) = 0;
     virtual void close() = 0;
@@ -92,7 +93,7 @@ public:
     SrsEdgeRtmpUpstream(std::string r);
     virtual ~SrsEdgeRtmpUpstream();
 public:
-    virtual srs_error_t connect(SrsRequest* r, SrsLbRoundRobin* lb);
+    virtual srs_error_t connect(SrsRequest* r, ISrsLoadBalancer* lb);
     virtual srs_error_t recv_message(SrsCommonMessage** pmsg);
     virtual srs_error_t decode_message(SrsCommonMessage* msg, SrsPacket** ppacket);
     virtual void close();
@@ -121,9 +122,9 @@ public:
     SrsEdgeFlvUpstream(std::string schema);
     virtual ~SrsEdgeFlvUpstream();
 public:
-    virtual srs_error_t connect(SrsRequest* r, SrsLbRoundRobin* lb);
+    virtual srs_error_t connect(SrsRequest* r, ISrsLoadBalancer* lb);
 private:
-    virtual srs_error_t do_connect(SrsRequest* r, SrsLbRoundRobin* lb, int redirect_depth);
+    virtual srs_error_t do_connect(SrsRequest* r, ISrsLoadBalancer* lb, int redirect_depth);
 public:
     virtual srs_error_t recv_message(SrsCommonMessage** pmsg);
     virtual srs_error_t decode_message(SrsCommonMessage* msg, SrsPacket** ppacket);
@@ -144,7 +145,7 @@ private:
     SrsPlayEdge* edge;
     SrsRequest* req;
     SrsCoroutine* trd;
-    SrsLbRoundRobin* lb;
+    ISrsLoadBalancer* lb;
     SrsEdgeUpstream* upstream;
 #ifdef SRS_APM
     ISrsApmSpan* span_main_;
@@ -182,7 +183,7 @@ private:
     SrsRequest* req;
     SrsCoroutine* trd;
     SrsSimpleRtmpClient* sdk;
-    SrsLbRoundRobin* lb;
+    ISrsLoadBalancer* lb;
     // we must ensure one thread one fd principle,
     // that is, a fd must be write/read by the one thread.
     // The publish service thread will proxy(msg), and the edge forward thread
@@ -254,5 +255,8 @@ public:
     virtual void on_proxy_unpublish();
 };
 
+// The load and health of origins, shared by all edge streams.
+extern SrsLbLoads* _srs_edge_loads;
+
 #endif
 
@@ -18,6 +18,11 @@ using namespace std;
 #include <srs_core_autofree.hpp>
 #include <srs_app_http_conn.hpp>
 #include <srs_protocol_amf0.hpp>
+#include <srs_app_http_hooks.hpp>
+#include <srs_app_hybrid.hpp>
+#include <srs_app_statistic.hpp>
+#include <srs_kernel_utility.hpp>
+#include <srs_protocol_utility.hpp>
 
 SrsHttpHeartbeat::SrsHttpHeartbeat()
 {
@@ -89,3 +94,378 @@ srs_error_t SrsHttpHeartbeat::do_heartbeat()
     return err;
 }
 
+
+// The TTL of load report, the node pushes report to peers every 5s.
+#define SRS_LOAD_REPORT_TTL (15 * SRS_UTIME_SECONDS)
+
+SrsLoadReport::SrsLoadReport()
+{
+    rtmp_port = http_port = api_port = 0;
+    cpu = connections = mbps = 0;
+    load = 0;
+    expire = 0;
+}
+
+SrsLoadReport::~SrsLoadReport()
+{
+}
+
+bool SrsLoadReport::overloaded()
+{
+    return load >= 100;
+}
+
+string SrsLoadReport::id()
+{
+    return srs_fmt("%s:%d", ip.c_str(), api_port);
+}
+
+SrsJsonObject* SrsLoadReport::to_json()
+{
+    SrsJsonObject* obj = SrsJsonAny::object();
+
+    obj->set("ip", SrsJsonAny::str(ip.c_str()));
+    obj->set("rtmp", SrsJsonAny::integer(rtmp_port));
+    obj->set("http", SrsJsonAny::integer(http_port));
+    obj->set("api", SrsJsonAny::integer(api_port));
+    obj->set("cpu", SrsJsonAny::integer(cpu));
+    obj->set("connections", SrsJsonAny::integer(connections));
+    obj->set("mbps", SrsJsonAny::integer(mbps));
+    obj->set("load", SrsJsonAny::integer(load));
+
+    return obj;
+}
+
+srs_error_t SrsLoadReport::from_json(SrsJsonObject* obj)
+{
+    srs_error_t err = srs_success;
+
+    SrsJsonAny* prop = NULL;
+    if ((prop = obj->ensure_property_string("ip")) != NULL) {
+        ip = prop->to_str();
+    }
+    if ((prop = obj->ensure_property_integer("api")) == NULL) {
+        return srs_error_new(ERROR_HTTP_DATA_INVALID, "no api port");
+    }
+    api_port = (int)prop->to_integer();
+
+    if ((prop = obj->ensure_property_integer("rtmp")) != NULL) {
+        rtmp_port = (int)prop->to_integer();
+    }
+    if ((prop = obj->ensure_property_integer("http")) != NULL) {
+        http_port = (int)prop->to_integer();
+    }
+    if ((prop = obj->ensure_property_integer("cpu")) != NULL) {
+        cpu = (int)prop->to_integer();
+    }
+    if ((prop = obj->ensure_property_integer("connections")) != NULL) {
+        connections = (int)prop->to_integer();
+    }
+    if ((prop = obj->ensure_property_integer("mbps")) != NULL) {
+        mbps = (int)prop->to_integer();
+    }
+    if ((prop = obj->ensure_property_integer("load")) == NULL) {
+        return srs_error_new(ERROR_HTTP_DATA_INVALID, "no load");
+    }
+    load = (int)prop->to_integer();
+
+    return err;
+}
+
+SrsLoadReportTask::SrsLoadReportTask(string p, string b)
+{
+    peer = p;
+    body = b;
+}
+
+SrsLoadReportTask::~SrsLoadReportTask()
+{
+}
+
+srs_error_t SrsLoadReportTask::call()
+{
+    srs_error_t err = srs_success;
+
+    string url = "http://" + peer + "/api/v1/loads";
+    if ((err = SrsHttpHooks::push_co_workers(url, body)) != srs_success) {
+        return srs_error_wrap(err, "push load to %s", peer.c_str());
+    }
+
+    return err;
+}
+
+string SrsLoadReportTask::to_string()
+{
+    return "load " + peer + " " + body;
+}
+
+string SrsLoadReportTask::destination()
+{
+    return peer;
+}
+
+SrsLoadRedirect* _srs_load_redirect = NULL;
+
+SrsLoadRedirect::SrsLoadRedirect()
+{
+    enabled_ = false;
+    publish_ = false;
+    cpu_threshold_ = connections_threshold_ = mbps_threshold_ = 0;
+
+    self_ = new SrsLoadReport();
+    pusher_ = new SrsAsyncCallWorker();
+    subscribed_ = false;
+
+    last_send_bytes_ = 0;
+    last_sample_ = 0;
+}
+
+SrsLoadRedirect::~SrsLoadRedirect()
+{
+    // Note that the hybrid is disposed before this object.
+    if (subscribed_ && _srs_hybrid) {
+        _srs_hybrid->timer5s()->unsubscribe(this);
+    }
+
+    pusher_->stop();
+    srs_freep(pusher_);
+
+    srs_freep(self_);
+
+    map<string, SrsLoadReport*>::iterator it;
+    for (it = peers_.begin(); it != peers_.end(); ++it) {
+        SrsLoadReport* report = it->second;
+        srs_freep(report);
+    }
+    peers_.clear();
+}
+
+srs_error_t SrsLoadRedirect::initialize()
+{
+    srs_error_t err = srs_success;
+
+    enabled_ = _srs_config->get_load_redirect_enabled();
+    if (!enabled_) {
+        return err;
+    }
+
+    publish_ = _srs_config->get_load_redirect_publish();
+    cpu_threshold_ = _srs_config->get_load_redirect_cpu();
+    connections_threshold_ = _srs_config->get_load_redirect_connections();
+    mbps_threshold_ = _srs_config->get_load_redirect_mbps();
+
+    // The endpoint of this node, for peers to redirect clients to.
+    self_->ip = _srs_config->get_load_redirect_ip();
+    if (self_->ip.empty()) {
+        self_->ip = srs_get_public_internet_address(true);
+    }
+
+    string host;
+    vector<string> listens = _srs_config->get_listens();
+    if (!listens.empty()) {
+        srs_parse_endpoint(listens.at(0), host, self_->rtmp_port);
+    }
+    if (_srs_config->get_http_stream_enabled()) {
+        srs_parse_endpoint(_srs_config->get_http_stream_listen(), host, self_->http_port);
+    }
+    if (_srs_config->get_http_api_enabled()) {
+        srs_parse_endpoint(_srs_config->get_http_api_listen(), host, self_->api_port);
+    }
+
+    pusher_->set_executors(_srs_config->get_async_call_executors());
+    if ((err = pusher_->start()) != srs_success) {
+        return srs_error_wrap(err, "start pusher");
+    }
+
+    _srs_hybrid->timer5s()->subscribe(this);
+    subscribed_ = true;
+
+    srs_trace("LoadRedirect: self=%s, rtmp=%d, http=%d, publish=%d, threshold=%d%%,%d,%dMbps, peers=%d", self_->id().c_str(),
+        self_->rtmp_port, self_->http_port, publish_, cpu_threshold_, connections_threshold_, mbps_threshold_,
+        (int)_srs_config->get_load_redirect_peers().size());
+
+    return err;
+}
+
+void SrsLoadRedirect::sample(int cpu, int connections, int mbps)
+{
+    self_->cpu = cpu;
+    self_->connections = connections;
+    self_->mbps = mbps;
+
+    // The load is the max percent of all thresholds.
+    int load = 0;
+    if (cpu_threshold_ > 0) {
+        load = srs_max(load, cpu * 100 / cpu_threshold_);
+    }
+    if (connections_threshold_ > 0) {
+        load = srs_max(load, connections * 100 / connections_threshold_);
+    }
+    if (mbps_threshold_ > 0) {
+        load = srs_max(load, mbps * 100 / mbps_threshold_);
+    }
+    self_->load = load;
+}
+
+SrsLoadReport* SrsLoadRedirect::select(bool publish)
+{
+    if (!enabled_ || !self_->overloaded()) {
+        return NULL;
+    }
+    if (publish && !publish_) {
+        return NULL;
+    }
+
+    // Select peer randomly weighted by the headroom, rather than the least-loaded one, because
+    // the report is updated every 5s, all clients will be redirected to the same peer in the interval.
+    srs_utime_t now = srs_get_system_time();
+    vector<SrsLoadReport*> candidates;
+    int total = 0;
+
+    map<string, SrsLoadReport*>::iterator it;
+    for (it = peers_.begin(); it != peers_.end(); ++it) {
+        SrsLoadReport* report = it->second;
+        if (report->expire < now || report->overloaded() || report->load >= self_->load) {
+            continue;
+        }
+
+        candidates.push_back(report);
+        total += 100 - report->load;
+    }
+
+    if (candidates.empty()) {
+        return NULL;
+    }
+
+    int v = (int)(srs_random() % srs_max(1, total));
+    for (int i = 0; i < (int)candidates.size(); i++) {
+        SrsLoadReport* report = candidates.at(i);
+        if ((v -= 100 - report->load) < 0) {
+            return report;
+        }
+    }
+
+    return candidates.back();
+}
+
+srs_error_t SrsLoadRedirect::on_report(SrsJsonObject* obj, string peer)
+{
+    srs_error_t err = srs_success;
+
+    // Only accept the report from the configured peers, or anyone could redirect our clients to anywhere.
+    if (!srs_is_endpoint_ip(_srs_config->get_load_redirect_peers(), peer)) {
+        return srs_error_new(ERROR_HTTP_PEER_FORBIDDEN, "peer %s not configured", peer.c_str());
+    }
+
+    SrsLoadReport* report = new SrsLoadReport();
+    if ((err = report->from_json(obj)) != srs_success) {
+        srs_freep(report);
+        return srs_error_wrap(err, "parse report");
+    }
+
+    // Use the ip of peer, if not specified.
+    if (report->ip.empty()) {
+        report->ip = peer;
+    }
+
+    report->expire = srs_get_system_time() + SRS_LOAD_REPORT_TTL;
+    update(report);
+
+    return err;
+}
+
+void SrsLoadRedirect::update(SrsLoadReport* report)
+{
+    string id = report->id();
+
+    map<string, SrsLoadReport*>::iterator it = peers_.find(id);
+    if (it != peers_.end()) {
+        SrsLoadReport* previous = it->second;
+        srs_freep(previous);
+    }
+
+    peers_[id] = report;
+}
+
+SrsJsonObject* SrsLoadRedirect::dumps()
+{
+    SrsJsonObject* obj = SrsJsonAny::object();
+
+    obj->set("enabled", SrsJsonAny::boolean(enabled_));
+    obj->set("self", self_->to_json());
+
+    SrsJsonArray* peers = SrsJsonAny::array();
+    obj->set("peers", peers);
+
+    srs_utime_t now = srs_get_system_time();
+    map<string, SrsLoadReport*>::iterator it;
+    for (it = peers_.begin(); it != peers_.end(); ++it) {
+        SrsLoadReport* report = it->second;
+        if (report->expire >= now) {
+            peers->append(report->to_json());
+        }
+    }
+
+    return obj;
+}
+
+srs_error_t SrsLoadRedirect::on_timer(srs_utime_t interval)
+{
+    srs_error_t err = srs_success;
+
+    // Sample the load of this node, the CPU is updated by circuit breaker.
+    int64_t send_bytes = 0, recv_bytes = 0, nstreams = 0, nclients = 0, total_nclients = 0, nerrs = 0;
+    SrsStatistic::instance()->dumps_metrics(send_bytes, recv_bytes, nstreams, nclients, total_nclients, nerrs);
+
+    srs_utime_t now = srs_get_system_time();
+    int mbps = 0;
+    if (last_sample_ > 0 && now > last_sample_) {
+        mbps = (int)((send_bytes - last_send_bytes_) * 8 / srs_max(1, srsu2ms(now - last_sample_)) / 1000);
+    }
+    last_send_bytes_ = send_bytes;
+    last_sample_ = now;
+
+    sample((int)(srs_get_self_proc_stat()->percent * 100), (int)nclients, mbps);
+
+    // Remove the expired peers.
+    map<string, SrsLoadReport*>::iterator it;
+    for (it = peers_.begin(); it != peers_.end();) {
+        SrsLoadReport* report = it->second;
+        if (report->expire >= now) {
+            ++it;
+            continue;
+        }
+
+        srs_freep(report);
+        peers_.erase(it++);
+    }
+
+    // Push the load of this node to peers.
+    SrsUniquePtr<SrsJsonObject> obj(self_->to_json());
+    string body = obj->dumps();
+
+    vector<string> peers = _srs_config->get_load_redirect_peers();
+    for (int i = 0; i < (int)peers.size(); i++) {
+        if ((err = pusher_->execute(new SrsLoadReportTask(peers.at(i), body))) != srs_success) {
+            return srs_error_wrap(err, "push to %s", peers.at(i).c_str());
+        }
+    }
+
+    if (self_->overloaded()) {
+        srs_trace("LoadRedirect: overloaded, cpu=%d%%, conns=%d, mbps=%d, load=%d%%, peers=%d",
+            self_->cpu, self_->connections, self_->mbps, self_->load, (int)peers_.size());
+    }
+
+    return err;
+}
+
+srs_error_t srs_load_redirect_http(ISrsHttpResponseWriter* w, ISrsHttpMessage* r, SrsLoadReport* peer, int port, int code)
+{
+    // Note that the handler appends the query of request to the location.
+    string url = srs_fmt("http://%s:%d%s", peer->ip.c_str(), port, r->path().c_str());
+    srs_trace("redirect to %s%s%s for overloaded, peer load=%d%%", url.c_str(), r->query().empty() ? "" : "?",
+        r->query().c_str(), peer->load);
+
+    SrsHttpRedirectHandler h(url, code);
+    return h.serve_http(w, r);
+}
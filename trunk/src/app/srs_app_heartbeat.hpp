@@ -9,6 +9,16 @@
 
 #include <srs_core.hpp>
 
+#include <srs_app_hourglass.hpp>
+#include <srs_app_async_call.hpp>
+
+#include <map>
+#include <string>
+
+class SrsJsonObject;
+class ISrsHttpResponseWriter;
+class ISrsHttpMessage;
+
 // The http heartbeat to api-server to notice api that the information of SRS.
 class SrsHttpHeartbeat
 {
@@ -21,5 +31,92 @@ private:
     virtual srs_error_t do_heartbeat();
 };
 
+// The load report of node, exchanged between peers for load-aware redirect.
+class SrsLoadReport
+{
+public:
+    // The endpoint of node, for clients to be redirected to.
+    std::string ip;
+    int rtmp_port;
+    int http_port;
+    int api_port;
+    // The load of node, CPU percent, connections and egress Mbps.
+    int cpu;
+    int connections;
+    int mbps;
+    // The load in percent of thresholds, the node is overloaded if exceed 100.
+    int load;
+    // The expire time of report, for peers.
+    srs_utime_t expire;
+public:
+    SrsLoadReport();
+    virtual ~SrsLoadReport();
+public:
+    virtual bool overloaded();
+    // The id of node, ip:api_port.
+    virtual std::string id();
+    virtual SrsJsonObject* to_json();
+    virtual srs_error_t from_json(SrsJsonObject* obj);
+};
+
+// The task to push load report to peer.
+class SrsLoadReportTask : public ISrsAsyncCallTask
+{
+private:
+    std::string peer;
+    std::string body;
+public:
+    SrsLoadReportTask(std::string p, std::string b);
+    virtual ~SrsLoadReportTask();
+public:
+    virtual srs_error_t call();
+    virtual std::string to_string();
+    virtual std::string destination();
+};
+
+// The load-aware redirect, nodes push load reports to peers, and redirect new clients to a less-loaded
+// peer when overloaded, so a pool of nodes balances itself without a load balancer which knows media.
+class SrsLoadRedirect : public ISrsFastTimer
+{
+private:
+    bool enabled_;
+    bool publish_;
+    int cpu_threshold_;
+    int connections_threshold_;
+    int mbps_threshold_;
+    // The load of this node.
+    SrsLoadReport* self_;
+    // The load of peers, key is the id of peer.
+    std::map<std::string, SrsLoadReport*> peers_;
+    SrsAsyncCallWorker* pusher_;
+    bool subscribed_;
+    // To calculate the egress Mbps.
+    int64_t last_send_bytes_;
+    srs_utime_t last_sample_;
+public:
+    SrsLoadRedirect();
+    virtual ~SrsLoadRedirect();
+public:
+    virtual srs_error_t initialize();
+    // Update the load of this node.
+    virtual void sample(int cpu, int connections, int mbps);
+    // Select a less-loaded peer to redirect the client to, NULL if not overloaded or no peer available.
+    virtual SrsLoadReport* select(bool publish);
+    // When got load report from peer.
+    virtual srs_error_t on_report(SrsJsonObject* obj, std::string peer);
+    // Update the load report of peer, which is freed by this object.
+    virtual void update(SrsLoadReport* report);
+    virtual SrsJsonObject* dumps();
+// Interface ISrsFastTimer
+private:
+    srs_error_t on_timer(srs_utime_t interval);
+};
+
+extern SrsLoadRedirect* _srs_load_redirect;
+
+// Redirect the HTTP client to the port of peer, with the path and query of request, for example, the app and stream
+// of WHIP, or the token of player.
+extern srs_error_t srs_load_redirect_http(ISrsHttpResponseWriter* w, ISrsHttpMessage* r, SrsLoadReport* peer, int port, int code);
+
 #endif
 
@@ -131,6 +131,12 @@ string SrsDvrAsyncCallOnHls::to_string()
     return "on_hls: " + path;
 }
 
+string SrsDvrAsyncCallOnHls::destination()
+{
+    SrsConfDirective* conf = _srs_config->get_vhost_on_hls(req->vhost);
+    return conf ? srs_join_vector_string(conf->args, ",") : "";
+}
+
 SrsDvrAsyncCallOnHlsNotify::SrsDvrAsyncCallOnHlsNotify(SrsContextId c, SrsRequest* r, string u)
 {
     cid = c;
@@ -182,6 +188,12 @@ string SrsDvrAsyncCallOnHlsNotify::to_string()
     return "on_hls_notify: " + ts_url;
 }
 
+string SrsDvrAsyncCallOnHlsNotify::destination()
+{
+    SrsConfDirective* conf = _srs_config->get_vhost_on_hls_notify(req->vhost);
+    return conf ? srs_join_vector_string(conf->args, ",") : "";
+}
+
 SrsHlsMuxer::SrsHlsMuxer()
 {
     req = NULL;
@@ -80,6 +80,7 @@ public:
 public:
     virtual srs_error_t call();
     virtual std::string to_string();
+    virtual std::string destination();
 };
 
 // The hls async call: on_hls_notify
@@ -95,6 +96,7 @@ public:
 public:
     virtual srs_error_t call();
     virtual std::string to_string();
+    virtual std::string destination();
 };
 
 // Mux the HLS stream(m3u8 and ts files).
@@ -125,6 +125,144 @@ srs_error_t SrsHourGlass::cycle()
     return err;
 }
 
+SrsTimerEntry::SrsTimerEntry()
+{
+    handler = NULL;
+    expire = 0;
+    period = 0;
+    level = -1;
+    slot = -1;
+    prev = next = NULL;
+}
+
+SrsTimerEntry::~SrsTimerEntry()
+{
+}
+
+SrsTimingWheel::SrsTimingWheel()
+{
+    now_ = 0;
+    for (int i = 0; i < SRS_TIMING_WHEEL_LEVELS; i++) {
+        for (int j = 0; j < SRS_TIMING_WHEEL_SLOTS; j++) {
+            slots_[i][j] = NULL;
+        }
+    }
+}
+
+SrsTimingWheel::~SrsTimingWheel()
+{
+    // Unlink all entries, which are freed by owner.
+    for (int i = 0; i < SRS_TIMING_WHEEL_LEVELS; i++) {
+        for (int j = 0; j < SRS_TIMING_WHEEL_SLOTS; j++) {
+            while (slots_[i][j]) {
+                remove(slots_[i][j]);
+            }
+        }
+    }
+}
+
+uint64_t SrsTimingWheel::now()
+{
+    return now_;
+}
+
+void SrsTimingWheel::add(SrsTimerEntry* entry)
+{
+    remove(entry);
+
+    // The entry always expires in future, to avoid firing it again in current tick.
+    if (entry->expire <= now_) {
+        entry->expire = now_ + 1;
+    }
+
+    link(entry);
+}
+
+void SrsTimingWheel::remove(SrsTimerEntry* entry)
+{
+    if (entry->level < 0) {
+        return;
+    }
+
+    if (entry->prev) {
+        entry->prev->next = entry->next;
+    } else {
+        slots_[entry->level][entry->slot] = entry->next;
+    }
+    if (entry->next) {
+        entry->next->prev = entry->prev;
+    }
+
+    entry->prev = entry->next = NULL;
+    entry->level = entry->slot = -1;
+}
+
+void SrsTimingWheel::advance()
+{
+    now_++;
+
+    // Cascade the higher level, when the lower level wraps.
+    for (int level = 1; level < SRS_TIMING_WHEEL_LEVELS; level++) {
+        if ((now_ & ((1ULL << (SRS_TIMING_WHEEL_BITS * level)) - 1)) != 0) {
+            break;
+        }
+        cascade(level);
+    }
+}
+
+SrsTimerEntry* SrsTimingWheel::pop()
+{
+    SrsTimerEntry* entry = slots_[0][now_ & (SRS_TIMING_WHEEL_SLOTS - 1)];
+    if (entry) {
+        remove(entry);
+    }
+    return entry;
+}
+
+void SrsTimingWheel::link(SrsTimerEntry* entry)
+{
+    uint64_t delta = entry->expire - now_;
+
+    // Find the lowest level which covers the delta.
+    int level = 0;
+    while (level < SRS_TIMING_WHEEL_LEVELS - 1 && delta >= (1ULL << (SRS_TIMING_WHEEL_BITS * (level + 1)))) {
+        level++;
+    }
+
+    // For the entry out of range, put it at the end of wheel, and relink when cascade.
+    uint64_t at = entry->expire;
+    if (delta >= (1ULL << (SRS_TIMING_WHEEL_BITS * SRS_TIMING_WHEEL_LEVELS))) {
+        at = now_ + (1ULL << (SRS_TIMING_WHEEL_BITS * SRS_TIMING_WHEEL_LEVELS)) - 1;
+    }
+
+    int slot = (int)((at >> (SRS_TIMING_WHEEL_BITS * level)) & (SRS_TIMING_WHEEL_SLOTS - 1));
+
+    entry->level = level;
+    entry->slot = slot;
+    entry->prev = NULL;
+    entry->next = slots_[level][slot];
+    if (entry->next) {
+        entry->next->prev = entry;
+    }
+    slots_[level][slot] = entry;
+}
+
+void SrsTimingWheel::cascade(int level)
+{
+    int slot = (int)((now_ >> (SRS_TIMING_WHEEL_BITS * level)) & (SRS_TIMING_WHEEL_SLOTS - 1));
+
+    // Relink all entries in slot to lower levels.
+    SrsTimerEntry* entry = slots_[level][slot];
+    slots_[level][slot] = NULL;
+
+    while (entry) {
+        SrsTimerEntry* next = entry->next;
+        entry->level = entry->slot = -1;
+        link(entry);
+        entry = next;
+    }
+}
+
 ISrsFastTimer::ISrsFastTimer()
 {
 }
@@ -137,11 +275,23 @@ SrsFastTimer::SrsFastTimer(std::string label, srs_utime_t interval)
 {
     interval_ = interval;
     trd_ = new SrsSTCoroutine(label, this, _srs_context->get_id());
+    wheel_ = new SrsTimingWheel();
+    starttime_ = 0;
 }
 
 SrsFastTimer::~SrsFastTimer()
 {
     srs_freep(trd_);
+
+    std::map<ISrsFastTimer*, SrsTimerEntry*>::iterator it;
+    for (it = handlers_.begin(); it != handlers_.end(); ++it) {
+        SrsTimerEntry* entry = it->second;
+        wheel_->remove(entry);
+        srs_freep(entry);
+    }
+    handlers_.clear();
+
+    srs_freep(wheel_);
 }
 
 srs_error_t SrsFastTimer::start()
@@ -157,23 +307,59 @@ srs_error_t SrsFastTimer::start()
 
 void SrsFastTimer::subscribe(ISrsFastTimer* timer)
 {
-    if (std::find(handlers_.begin(), handlers_.end(), timer) == handlers_.end()) {
-        handlers_.push_back(timer);
+    if (handlers_.find(timer) != handlers_.end()) {
+        return;
     }
+
+    SrsTimerEntry* entry = new SrsTimerEntry();
+    entry->handler = timer;
+    entry->period = 1;
+    entry->expire = wheel_->now() + 1;
+    handlers_[timer] = entry;
+
+    wheel_->add(entry);
 }
 
-void SrsFastTimer::unsubscribe(ISrsFastTimer* timer)
+void SrsFastTimer::schedule(ISrsFastTimer* timer, srs_utime_t delay)
 {
-    vector<ISrsFastTimer*>::iterator it = std::find(handlers_.begin(), handlers_.end(), timer);
+    SrsTimerEntry* entry = NULL;
+
+    std::map<ISrsFastTimer*, SrsTimerEntry*>::iterator it = handlers_.find(timer);
     if (it != handlers_.end()) {
-        handlers_.erase(it);
+        entry = it->second;
+    } else {
+        entry = new SrsTimerEntry();
+        entry->handler = timer;
+        handlers_[timer] = entry;
     }
+
+    // Align the delay to ticks, at least one tick.
+    uint64_t ticks = (uint64_t)srs_max(1, (delay + interval_ - 1) / interval_);
+    entry->expire = wheel_->now() + ticks;
+
+    wheel_->add(entry);
+}
+
+void SrsFastTimer::unsubscribe(ISrsFastTimer* timer)
+{
+    std::map<ISrsFastTimer*, SrsTimerEntry*>::iterator it = handlers_.find(timer);
+    if (it == handlers_.end()) {
+        return;
+    }
+
+    SrsTimerEntry* entry = it->second;
+    handlers_.erase(it);
+
+    wheel_->remove(entry);
+    srs_freep(entry);
 }
 
 srs_error_t SrsFastTimer::cycle()
 {
     srs_error_t err = srs_success;
 
+    starttime_ = srs_update_system_time();
+
     while (true) {
         if ((err = trd_->pull()) != srs_success) {
             return srs_error_wrap(err, "quit");
@@ -181,18 +367,43 @@ srs_error_t SrsFastTimer::cycle()
 
         ++_srs_pps_timer->sugar;
 
-        for (int i = 0; i < (int)handlers_.size(); i++) {
-            ISrsFastTimer* timer = handlers_.at(i);
+        // Calculate the ticks by the elapsed time, but at least one tick.
+        uint64_t tick = (uint64_t)((srs_update_system_time() - starttime_) / interval_);
+        on_ticks(srs_max(tick, wheel_->now() + 1));
+
+        srs_usleep(interval_);
+    }
+
+    return err;
+}
+
+void SrsFastTimer::on_ticks(uint64_t tick)
+{
+    srs_error_t err = srs_success;
+
+    while (wheel_->now() < tick) {
+        wheel_->advance();
+
+        SrsTimerEntry* entry = NULL;
+        while ((entry = wheel_->pop()) != NULL) {
+            // Note that the handler might unsubscribe itself or others when fired, so we must
+            // update the entry before firing, and never use it after firing.
+            ISrsFastTimer* timer = entry->handler;
+
+            if (entry->period) {
+                // Coalesce the missed ticks, fire only once.
+                entry->expire = srs_max(wheel_->now() + entry->period, tick + 1);
+                wheel_->add(entry);
+            } else {
+                handlers_.erase(timer);
+                srs_freep(entry);
+            }
 
             if ((err = timer->on_timer(interval_)) != srs_success) {
                 srs_freep(err); // Ignore any error for shared timer.
             }
         }
-
-        srs_usleep(interval_);
     }
-
-    return err;
 }
 
 SrsClockWallMonitor::SrsClockWallMonitor()
@@ -100,28 +100,93 @@ public:
     virtual srs_error_t on_timer(srs_utime_t interval) = 0;
 };
 
+// The bits of slots for each level of timing wheel.
+#define SRS_TIMING_WHEEL_BITS 6
+#define SRS_TIMING_WHEEL_SLOTS (1 << SRS_TIMING_WHEEL_BITS)
+// The levels of timing wheel, which covers 2^24 ticks, about 93 hours for 20ms tick.
+#define SRS_TIMING_WHEEL_LEVELS 4
+
+// The entry of timing wheel, linked in the slot, so it's O(1) to add or remove.
+class SrsTimerEntry
+{
+public:
+    ISrsFastTimer* handler;
+    // The tick to fire.
+    uint64_t expire;
+    // The period in ticks, 0 for one-shot timer.
+    uint64_t period;
+public:
+    // The slot which links the entry, -1 if not in wheel.
+    int level;
+    int slot;
+    SrsTimerEntry* prev;
+    SrsTimerEntry* next;
+public:
+    SrsTimerEntry();
+    virtual ~SrsTimerEntry();
+};
+
+// The hierarchical timing wheel, to schedule and cancel timer in O(1). When tick, we only visit the
+// expired timers, and cascade the timers of higher level when lower level wraps.
+// @see http://www.cs.columbia.edu/~nahum/w6998/papers/sosp87-timing-wheels.pdf
+class SrsTimingWheel
+{
+private:
+    // The current tick.
+    uint64_t now_;
+    SrsTimerEntry* slots_[SRS_TIMING_WHEEL_LEVELS][SRS_TIMING_WHEEL_SLOTS];
+public:
+    SrsTimingWheel();
+    virtual ~SrsTimingWheel();
+public:
+    uint64_t now();
+    // Add entry which expires at entry->expire, it's expired at next tick if expire is not in future.
+    void add(SrsTimerEntry* entry);
+    // Remove entry from wheel, ignore if not in wheel.
+    void remove(SrsTimerEntry* entry);
+    // Advance to the next tick, and cascade the higher levels.
+    void advance();
+    // Pop the expired entry at current tick, NULL if no more.
+    SrsTimerEntry* pop();
+private:
+    void link(SrsTimerEntry* entry);
+    void cascade(int level);
+};
+
 // The fast timer, shared by objects, for high performance.
 // For example, we should never start a timer for each connection or publisher or player,
 // instead, we should start only one fast timer in server.
+// @remark The handlers are in a timing wheel, so the idle handler which schedules a long delay
+// costs nothing when tick, and it's O(1) to subscribe or unsubscribe.
 class SrsFastTimer : public ISrsCoroutineHandler
 {
 private:
     SrsCoroutine* trd_;
     srs_utime_t interval_;
-    std::vector<ISrsFastTimer*> handlers_;
+    SrsTimingWheel* wheel_;
+    std::map<ISrsFastTimer*, SrsTimerEntry*> handlers_;
+    // The start time, to calculate the ticks, so we're tolerant of jitter.
+    srs_utime_t starttime_;
 public:
     SrsFastTimer(std::string label, srs_utime_t interval);
     virtual ~SrsFastTimer();
 public:
     srs_error_t start();
 public:
+    // Call the timer every interval.
     void subscribe(ISrsFastTimer* timer);
+    // Call the timer after delay, which is aligned to interval. If subscribed, defer the next
+    // tick of timer and keep subscribed, for example, when timer is idle; or fire only once.
+    void schedule(ISrsFastTimer* timer, srs_utime_t delay);
     void unsubscribe(ISrsFastTimer* timer);
 // Interface ISrsCoroutineHandler
 private:
     // Cycle the hourglass, which will sleep resolution every time.
     // and call handler when ticked.
     virtual srs_error_t cycle();
+    // Fire the expired timers until the tick. If late for some ticks, the periodic timer only fires
+    // once, that is, the ticks are coalesced.
+    virtual void on_ticks(uint64_t tick);
 };
 
 // To monitor the system wall clock timer deviation.
@@ -30,6 +30,8 @@ using namespace std;
 #include <srs_protocol_amf0.hpp>
 #include <srs_protocol_utility.hpp>
 #include <srs_app_coworkers.hpp>
+#include <srs_app_heartbeat.hpp>
+#include <srs_app_recv_thread.hpp>
 
 #if defined(__linux__) || defined(SRS_OSX)
 #include <sys/utsname.h>
@@ -163,6 +165,109 @@ srs_error_t srs_api_response_code(ISrsHttpResponseWriter* w, ISrsHttpMessage* r,
     return err;
 }
 
+SrsHttpJsonChunkWriter::SrsHttpJsonChunkWriter(ISrsHttpResponseWriter* w)
+{
+    w_ = w;
+}
+
+SrsHttpJsonChunkWriter::~SrsHttpJsonChunkWriter()
+{
+}
+
+srs_error_t SrsHttpJsonChunkWriter::write(void* buf, size_t size, ssize_t* nwrite)
+{
+    if (nwrite) {
+        *nwrite = size;
+    }
+    return w_->write((char*)buf, (int)size);
+}
+
+srs_error_t srs_api_response_list(ISrsHttpResponseWriter* w, ISrsHttpMessage* r, string name)
+{
+    srs_error_t err = srs_success;
+
+    SrsStatistic* stat = SrsStatistic::instance();
+
+    // The cursor is the id of last element in previous page, which is stable, while the start is an offset.
+    std::string rstart = r->query_get("start");
+    std::string rcount = r->query_get("count");
+    std::string cursor = r->query_get("cursor");
+    int start = srs_max(0, atoi(rstart.c_str()));
+    int count = srs_max(10, atoi(rcount.c_str()));
+
+    // Response in chunked encoding, because we don't know the length.
+    SrsHttpHeader* h = w->header();
+    if (r->is_jsonp()) {
+        h->set_content_type("text/javascript");
+    } else if (h->content_type().empty()) {
+        h->set_content_type("application/json");
+    }
+    w->write_header(SRS_CONSTS_HTTP_OK);
+
+    string callback = r->query_get("callback") + "(";
+    if (r->is_jsonp() && (err = w->write((char*)callback.data(), (int)callback.length())) != srs_success) {
+        return srs_error_wrap(err, "write jsonp callback");
+    }
+
+    SrsHttpJsonChunkWriter writer(w);
+    SrsJsonWriter jw(&writer);
+
+    if ((err = jw.object_start()) != srs_success) {
+        return srs_error_wrap(err, "start");
+    }
+    if ((err = jw.key("code")) != srs_success || (err = jw.integer(ERROR_SUCCESS)) != srs_success) {
+        return srs_error_wrap(err, "code");
+    }
+    if ((err = jw.key("server")) != srs_success || (err = jw.str(stat->server_id())) != srs_success) {
+        return srs_error_wrap(err, "server");
+    }
+    if ((err = jw.key("service")) != srs_success || (err = jw.str(stat->service_id())) != srs_success) {
+        return srs_error_wrap(err, "service");
+    }
+    if ((err = jw.key("pid")) != srs_success || (err = jw.str(stat->service_pid())) != srs_success) {
+        return srs_error_wrap(err, "pid");
+    }
+
+    if ((err = jw.key(name)) != srs_success || (err = jw.array_start()) != srs_success) {
+        return srs_error_wrap(err, "start %s", name.c_str());
+    }
+
+    string next;
+    if (name == "clients") {
+        err = stat->dumps_clients(&jw, start, cursor, count, next);
+    } else {
+        err = stat->dumps_streams(&jw, start, cursor, count, next);
+    }
+    if (err != srs_success) {
+        return srs_error_wrap(err, "dump %s", name.c_str());
+    }
+
+    if ((err = jw.array_end()) != srs_success) {
+        return srs_error_wrap(err, "end %s", name.c_str());
+    }
+
+    // The cursor for next page, only when there are more elements.
+    if (!next.empty()) {
+        if ((err = jw.key("next")) != srs_success || (err = jw.str(next)) != srs_success) {
+            return srs_error_wrap(err, "next");
+        }
+    }
+
+    if ((err = jw.object_end()) != srs_success) {
+        return srs_error_wrap(err, "end");
+    }
+    if ((err = jw.flush()) != srs_success) {
+        return srs_error_wrap(err, "flush");
+    }
+
+    static char* c1 = (char*)")";
+    if (r->is_jsonp() && (err = w->write(c1, 1)) != srs_success) {
+        return srs_error_wrap(err, "write jsonp right token");
+    }
+
+    return w->final_request();
+}
+
 SrsGoApiRoot::SrsGoApiRoot()
 {
 }
@@ -263,6 +368,7 @@ srs_error_t SrsGoApiV1::serve_http(ISrsHttpResponseWriter* w, ISrsHttpMessage* r
     urls->set("vhosts", SrsJsonAny::str("manage all vhosts or specified vhost"));
     urls->set("streams", SrsJsonAny::str("manage all streams or specified stream"));
     urls->set("clients", SrsJsonAny::str("manage all clients or specified client, default query top 10 clients"));
+    urls->set("events", SrsJsonAny::str("the server-sent events of streams, filter by ?vhost=xxx&app=xxx"));
     urls->set("raw", SrsJsonAny::str("raw api for srs, support CUID srs for instance the config"));
     urls->set("clusters", SrsJsonAny::str("origin cluster server API"));
     urls->set("perf", SrsJsonAny::str("System performance stat"));
@@ -760,6 +866,11 @@ srs_error_t SrsGoApiStreams::serve_http(ISrsHttpResponseWriter* w, ISrsHttpMessa
         return srs_api_response_code(w, r, ERROR_RTMP_STREAM_NOT_FOUND);
     }
 
+    // Streaming the list of streams, because it might be huge.
+    if (!stream && r->is_http_get()) {
+        return srs_api_response_list(w, r, "streams");
+    }
+
     SrsUniquePtr<SrsJsonObject> obj(SrsJsonAny::object());
     
     obj->set("code", SrsJsonAny::integer(ERROR_SUCCESS));
@@ -768,28 +879,13 @@ srs_error_t SrsGoApiStreams::serve_http(ISrsHttpResponseWriter* w, ISrsHttpMessa
     obj->set("pid", SrsJsonAny::str(stat->service_pid().c_str()));
     
     if (r->is_http_get()) {
-        if (!stream) {
-            SrsJsonArray* data = SrsJsonAny::array();
-            obj->set("streams", data);
-
-            std::string rstart = r->query_get("start");
-            std::string rcount = r->query_get("count");
-            int start = srs_max(0, atoi(rstart.c_str()));
-            int count = srs_max(10, atoi(rcount.c_str()));
-            if ((err = stat->dumps_streams(data, start, count)) != srs_success) {
-                int code = srs_error_code(err);
-                srs_error_reset(err);
-                return srs_api_response_code(w, r, code);
-            }
-        } else {
-            SrsJsonObject* data = SrsJsonAny::object();
-            obj->set("stream", data);;
-            
-            if ((err = stream->dumps(data)) != srs_success) {
-                int code = srs_error_code(err);
-                srs_error_reset(err);
-                return srs_api_response_code(w, r, code);
-            }
+        SrsJsonObject* data = SrsJsonAny::object();
+        obj->set("stream", data);;
+        
+        if ((err = stream->dumps(data)) != srs_success) {
+            int code = srs_error_code(err);
+            srs_error_reset(err);
+            return srs_api_response_code(w, r, code);
         }
     } else {
         return srs_go_http_error(w, SRS_CONSTS_HTTP_MethodNotAllowed);
@@ -821,6 +917,11 @@ srs_error_t SrsGoApiClients::serve_http(ISrsHttpResponseWriter* w, ISrsHttpMessa
         return srs_api_response_code(w, r, ERROR_RTMP_CLIENT_NOT_FOUND);
     }
 
+    // Streaming the list of clients, because it might be huge.
+    if (!client && r->is_http_get()) {
+        return srs_api_response_list(w, r, "clients");
+    }
+
     SrsUniquePtr<SrsJsonObject> obj(SrsJsonAny::object());
     
     obj->set("code", SrsJsonAny::integer(ERROR_SUCCESS));
@@ -829,28 +930,13 @@ srs_error_t SrsGoApiClients::serve_http(ISrsHttpResponseWriter* w, ISrsHttpMessa
     obj->set("pid", SrsJsonAny::str(stat->service_pid().c_str()));
     
     if (r->is_http_get()) {
-        if (!client) {
-            SrsJsonArray* data = SrsJsonAny::array();
-            obj->set("clients", data);
-            
-            std::string rstart = r->query_get("start");
-            std::string rcount = r->query_get("count");
-            int start = srs_max(0, atoi(rstart.c_str()));
-            int count = srs_max(10, atoi(rcount.c_str()));
-            if ((err = stat->dumps_clients(data, start, count)) != srs_success) {
-                int code = srs_error_code(err);
-                srs_error_reset(err);
-                return srs_api_response_code(w, r, code);
-            }
-        } else {
-            SrsJsonObject* data = SrsJsonAny::object();
-            obj->set("client", data);
-            
-            if ((err = client->dumps(data)) != srs_success) {
-                int code = srs_error_code(err);
-                srs_error_reset(err);
-                return srs_api_response_code(w, r, code);
-            }
+        SrsJsonObject* data = SrsJsonAny::object();
+        obj->set("client", data);
+        
+        if ((err = client->dumps(data)) != srs_success) {
+            int code = srs_error_code(err);
+            srs_error_reset(err);
+            return srs_api_response_code(w, r, code);
         }
     } else if (r->is_http_delete()) {
         if (!client) {
@@ -871,6 +957,112 @@ srs_error_t SrsGoApiClients::serve_http(ISrsHttpResponseWriter* w, ISrsHttpMessa
     return srs_api_response(w, r, obj->dumps());
 }
 
+SrsGoApiEvents::SrsGoApiEvents()
+{
+}
+
+SrsGoApiEvents::~SrsGoApiEvents()
+{
+}
+
+srs_error_t SrsGoApiEvents::serve_http(ISrsHttpResponseWriter* w, ISrsHttpMessage* r)
+{
+    srs_error_t err = srs_success;
+
+    if (!r->is_http_get()) {
+        return srs_go_http_error(w, SRS_CONSTS_HTTP_MethodNotAllowed);
+    }
+
+    // Response the events in chunked encoding, never end until client closed.
+    SrsHttpHeader* h = w->header();
+    h->set_content_type("text/event-stream");
+    h->set("Cache-Control", "no-cache");
+    w->write_header(SRS_CONSTS_HTTP_OK);
+
+    SrsStatistic* stat = SrsStatistic::instance();
+    stat->subscribe();
+    err = do_serve_http(w, r);
+    stat->unsubscribe();
+
+    return err;
+}
+
+srs_error_t SrsGoApiEvents::do_serve_http(ISrsHttpResponseWriter* w, ISrsHttpMessage* r)
+{
+    srs_error_t err = srs_success;
+
+    SrsStatistic* stat = SrsStatistic::instance();
+
+    // Filter the events by vhost or app, empty to match all.
+    std::string vhost = r->query_get("vhost");
+    std::string app = r->query_get("app");
+
+    // Start a thread to receive all messages from client, to detect the closed client.
+    SrsHttpMessage* hr = dynamic_cast<SrsHttpMessage*>(r);
+    SrsHttpConn* hc = hr ? dynamic_cast<SrsHttpConn*>(hr->connection()) : NULL;
+    SrsHttpxConn* hxc = hc ? dynamic_cast<SrsHttpxConn*>(hc->handler()) : NULL;
+    SrsUniquePtr<SrsHttpRecvThread> trd(hxc ? new SrsHttpRecvThread(hxc) : NULL);
+    if (trd.get()) {
+        if ((err = trd->start()) != srs_success) {
+            return srs_error_wrap(err, "start recv thread");
+        }
+    }
+
+    // Resume from the Last-Event-ID of client, or start from the snapshot of streams, if the id is
+    // of other epoch, for example, the events were discarded when no subscribers.
+    std::string last_id = r->header()->get("Last-Event-ID");
+    uint64_t seq = 0;
+    bool reset = last_id.empty() || !stat->parse_event_id(last_id, seq);
+
+    srs_trace("API events vhost=%s, app=%s, last=%s", vhost.c_str(), app.c_str(), last_id.c_str());
+
+    srs_utime_t last_write = srs_get_system_time();
+    while (true) {
+        if (trd.get() && (err = trd->pull()) != srs_success) {
+            return srs_error_wrap(err, "recv thread");
+        }
+        if (hc && (err = hc->pull()) != srs_success) {
+            return srs_error_wrap(err, "http conn");
+        }
+
+        std::stringstream ss;
+        std::vector< SrsSharedPtr<SrsStatisticEvent> > events;
+
+        // The subscriber is too slow or resume from an expired id, so reset it by the snapshot.
+        if (reset || !stat->fetch_events(seq, vhost, app, events)) {
+            events.clear();
+            stat->snapshot_events(vhost, app, events);
+            ss << "event: reset" << SRS_HTTP_LF << "data: {}" << SRS_HTTP_LF << SRS_HTTP_LF;
+            reset = false;
+        }
+        seq = stat->event_seq();
+
+        for (int i = 0; i < (int)events.size(); i++) {
+            SrsSharedPtr<SrsStatisticEvent>& event = events.at(i);
+            ss << "id: " << stat->event_id(event->seq) << SRS_HTTP_LF
+                << "event: " << srs_stat_event_type_str(event->type) << SRS_HTTP_LF
+                << "data: " << event->data << SRS_HTTP_LF << SRS_HTTP_LF;
+        }
+
+        // Write comment as heartbeat, to keep alive the connection.
+        if (events.empty() && srs_get_system_time() - last_write >= SRS_STAT_EVENTS_HEARTBEAT) {
+            ss << ": heartbeat" << SRS_HTTP_LF << SRS_HTTP_LF;
+        }
+
+        std::string data = ss.str();
+        if (!data.empty()) {
+            if ((err = w->write((char*)data.data(), (int)data.length())) != srs_success) {
+                return srs_error_wrap(err, "write events");
+            }
+            last_write = srs_get_system_time();
+        }
+
+        stat->wait_events(SRS_STAT_EVENTS_HEARTBEAT);
+    }
+
+    return err;
+}
+
 SrsGoApiRaw::SrsGoApiRaw(SrsServer* svr)
 {
     server = svr;
@@ -969,6 +1161,36 @@ SrsGoApiClusters::~SrsGoApiClusters()
 
 srs_error_t SrsGoApiClusters::serve_http(ISrsHttpResponseWriter* w, ISrsHttpMessage* r)
 {
+    srs_error_t err = srs_success;
+
+    // The stream event pushed by co-worker, to update the directory.
+    if (r->is_http_post()) {
+        string body;
+        if ((err = r->body_read_all(body)) != srs_success) {
+            return srs_api_response_code(w, r, srs_error_wrap(err, "read body"));
+        }
+
+        SrsJsonAny* json = SrsJsonAny::loads(body);
+        if (!json || !json->is_object()) {
+            srs_freep(json);
+            return srs_api_response_code(w, r, ERROR_HTTP_DATA_INVALID);
+        }
+        SrsUniquePtr<SrsJsonObject> event(json->to_object());
+
+        string peer;
+        SrsHttpMessage* hm = dynamic_cast<SrsHttpMessage*>(r);
+        if (hm && hm->connection()) {
+            peer = hm->connection()->remote_ip();
+        }
+
+        SrsCoWorkers* coworkers = SrsCoWorkers::instance();
+        if ((err = coworkers->on_event(event.get(), peer)) != srs_success) {
+            return srs_api_response_code(w, r, srs_error_wrap(err, "cluster event"));
+        }
+
+        return srs_api_response_code(w, r, ERROR_SUCCESS);
+    }
+
     SrsUniquePtr<SrsJsonObject> obj(SrsJsonAny::object());
     
     obj->set("code", SrsJsonAny::integer(ERROR_SUCCESS));
@@ -992,6 +1214,54 @@ srs_error_t SrsGoApiClusters::serve_http(ISrsHttpResponseWriter* w, ISrsHttpMess
     return srs_api_response(w, r, obj->dumps());
 }
 
+SrsGoApiLoads::SrsGoApiLoads()
+{
+}
+
+SrsGoApiLoads::~SrsGoApiLoads()
+{
+}
+
+srs_error_t SrsGoApiLoads::serve_http(ISrsHttpResponseWriter* w, ISrsHttpMessage* r)
+{
+    srs_error_t err = srs_success;
+
+    // The load report pushed by peer.
+    if (r->is_http_post()) {
+        string body;
+        if ((err = r->body_read_all(body)) != srs_success) {
+            return srs_api_response_code(w, r, srs_error_wrap(err, "read body"));
+        }
+
+        SrsJsonAny* json = SrsJsonAny::loads(body);
+        if (!json || !json->is_object()) {
+            srs_freep(json);
+            return srs_api_response_code(w, r, ERROR_HTTP_DATA_INVALID);
+        }
+        SrsUniquePtr<SrsJsonObject> report(json->to_object());
+
+        string peer;
+        SrsHttpMessage* hm = dynamic_cast<SrsHttpMessage*>(r);
+        if (hm && hm->connection()) {
+            peer = hm->connection()->remote_ip();
+        }
+
+        if ((err = _srs_load_redirect->on_report(report.get(), peer)) != srs_success) {
+            return srs_api_response_code(w, r, srs_error_wrap(err, "load report"));
+        }
+
+        return srs_api_response_code(w, r, ERROR_SUCCESS);
+    }
+
+    SrsUniquePtr<SrsJsonObject> obj(SrsJsonAny::object());
+
+    obj->set("code", SrsJsonAny::integer(ERROR_SUCCESS));
+    obj->set("server", SrsJsonAny::str(SrsStatistic::instance()->server_id().c_str()));
+    obj->set("data", _srs_load_redirect->dumps());
+
+    return srs_api_response(w, r, obj->dumps());
+}
+
 SrsGoApiError::SrsGoApiError()
 {
 }
@@ -31,6 +31,21 @@ class SrsHttpConn;
 extern srs_error_t srs_api_response(ISrsHttpResponseWriter* w, ISrsHttpMessage* r, std::string json);
 extern srs_error_t srs_api_response_code(ISrsHttpResponseWriter* w, ISrsHttpMessage* r, int code);
 extern srs_error_t srs_api_response_code(ISrsHttpResponseWriter* w, ISrsHttpMessage* r, srs_error_t code);
+// Response the list of clients or streams in chunked streaming JSON, with cursor for pagination.
+// @param name the name of list, clients or streams.
+extern srs_error_t srs_api_response_list(ISrsHttpResponseWriter* w, ISrsHttpMessage* r, std::string name);
+
+// The adapter to write the chunks of streaming JSON to HTTP response.
+class SrsHttpJsonChunkWriter : public ISrsStreamWriter
+{
+private:
+    ISrsHttpResponseWriter* w_;
+public:
+    SrsHttpJsonChunkWriter(ISrsHttpResponseWriter* w);
+    virtual ~SrsHttpJsonChunkWriter();
+public:
+    virtual srs_error_t write(void* buf, size_t size, ssize_t* nwrite);
+};
 
 // For http root.
 class SrsGoApiRoot : public ISrsHttpHandler
@@ -168,6 +183,21 @@ public:
     virtual srs_error_t serve_http(ISrsHttpResponseWriter* w, ISrsHttpMessage* r);
 };
 
+// The interval to write heartbeat for events, and to wait for events.
+#define SRS_STAT_EVENTS_HEARTBEAT (10 * SRS_UTIME_SECONDS)
+
+// The server-sent events of streams, push the deltas rather than polling the streams.
+class SrsGoApiEvents : public ISrsHttpHandler
+{
+public:
+    SrsGoApiEvents();
+    virtual ~SrsGoApiEvents();
+public:
+    virtual srs_error_t serve_http(ISrsHttpResponseWriter* w, ISrsHttpMessage* r);
+private:
+    virtual srs_error_t do_serve_http(ISrsHttpResponseWriter* w, ISrsHttpMessage* r);
+};
+
 class SrsGoApiRaw : public ISrsHttpHandler, public ISrsReloadHandler
 {
 private:
@@ -196,6 +226,15 @@ public:
     virtual srs_error_t serve_http(ISrsHttpResponseWriter* w, ISrsHttpMessage* r);
 };
 
+class SrsGoApiLoads : public ISrsHttpHandler
+{
+public:
+    SrsGoApiLoads();
+    virtual ~SrsGoApiLoads();
+public:
+    virtual srs_error_t serve_http(ISrsHttpResponseWriter* w, ISrsHttpMessage* r);
+};
+
 class SrsGoApiError : public ISrsHttpHandler
 {
 public:
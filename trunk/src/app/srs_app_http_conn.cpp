@@ -42,6 +42,7 @@ using namespace std;
 #include <srs_app_utility.hpp>
 #include <srs_app_st.hpp>
 #include <srs_app_statistic.hpp>
+#include <srs_app_heartbeat.hpp>
 
 ISrsHttpConnOwner::ISrsHttpConnOwner()
 {
@@ -331,6 +332,14 @@ void SrsHttpxConn::set_enable_stat(bool v)
     enable_stat_ = v;
 }
 
+ISrsZerocopyWriter* SrsHttpxConn::zerocopy_writer()
+{
+    if (ssl) {
+        return NULL;
+    }
+    return dynamic_cast<ISrsZerocopyWriter*>(io_);
+}
+
 srs_error_t SrsHttpxConn::pop_message(ISrsHttpMessage** preq)
 {
     srs_error_t err = srs_success;
@@ -528,6 +537,15 @@ srs_error_t SrsHttpServer::serve_http(ISrsHttpResponseWriter* w, ISrsHttpMessage
         }
     }
     
+    // Redirect the player of HTTP-FLV, HLS or DASH to the less-loaded peer, when this node is overloaded.
+    // Note that only redirect the playlist of HLS or DASH, for segments are fetched by the same node.
+    if (r->is_http_get() && srs_string_ends_with(path, ".flv", ".m3u8", ".mpd")) {
+        SrsLoadReport* peer = _srs_load_redirect->select(false);
+        if (peer && peer->http_port) {
+            return srs_load_redirect_http(w, r, peer, peer->http_port, SRS_CONSTS_HTTP_Found);
+        }
+    }
+
     // Try http stream first, then http static if not found.
     ISrsHttpHandler* h = NULL;
     if ((err = http_stream->mux.find_handler(r, &h)) != srs_success) {
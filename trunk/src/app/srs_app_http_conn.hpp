@@ -152,6 +152,8 @@ public:
     // @see https://github.com/ossrs/srs/issues/636#issuecomment-298208427
     // @remark Should only used in HTTP-FLV streaming connection.
     virtual srs_error_t pop_message(ISrsHttpMessage** preq);
+    // Get the zerocopy writer of plaintext transport, NULL for HTTPS, which encrypts to a copy anyway.
+    ISrsZerocopyWriter* zerocopy_writer();
 // Interface ISrsHttpConnOwner.
 public:
     virtual srs_error_t on_start();
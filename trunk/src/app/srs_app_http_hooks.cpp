@@ -33,6 +33,160 @@ using namespace std;
 // the timeout for hls notify, in srs_utime_t.
 #define SRS_HLS_NOTIFY_TIMEOUT (10 * SRS_UTIME_SECONDS)
 
+// The max idle keep-alive connections of each hook server.
+#define SRS_HTTP_HOOKS_MAX_IDLE 16
+// The timeout for idle keep-alive connection, in srs_utime_t.
+#define SRS_HTTP_HOOKS_IDLE_TIMEOUT (10 * SRS_UTIME_SECONDS)
+// The max number of cached decisions.
+#define SRS_HTTP_HOOKS_MAX_DECISIONS 10000
+
+SrsHttpHooksDecision::SrsHttpHooksDecision()
+{
+    done = false;
+    err = srs_success;
+    code = 0;
+    expire = 0;
+    cond = srs_cond_new();
+}
+
+SrsHttpHooksDecision::~SrsHttpHooksDecision()
+{
+    srs_freep(err);
+    srs_cond_destroy(cond);
+}
+
+SrsHttpHooksIdleClient::SrsHttpHooksIdleClient(SrsHttpClient* c, srs_utime_t e)
+{
+    client = c;
+    expire = e;
+}
+
+SrsHttpHooksIdleClient::~SrsHttpHooksIdleClient()
+{
+    srs_freep(client);
+}
+
+SrsHttpHooksPool::SrsHttpHooksPool()
+{
+}
+
+SrsHttpHooksPool::~SrsHttpHooksPool()
+{
+    std::map<std::string, std::vector<SrsHttpHooksIdleClient*> >::iterator it;
+    for (it = idles_.begin(); it != idles_.end(); ++it) {
+        std::vector<SrsHttpHooksIdleClient*>& clients = it->second;
+        for (int i = 0; i < (int)clients.size(); i++) {
+            SrsHttpHooksIdleClient* client = clients.at(i);
+            srs_freep(client);
+        }
+    }
+}
+
+srs_error_t SrsHttpHooksPool::acquire(SrsHttpUri* uri, SrsHttpClient** pclient, bool* reused)
+{
+    srs_error_t err = srs_success;
+
+    string key = srs_fmt("%s://%s:%d", uri->get_schema().c_str(), uri->get_host().c_str(), uri->get_port());
+    std::vector<SrsHttpHooksIdleClient*>& clients = idles_[key];
+
+    // Use the latest idle client, which is less likely closed by server. Drop the one closed by
+    // server before sending request, because we never retry the POST after sent.
+    srs_utime_t now = srs_get_system_time();
+    while (!clients.empty()) {
+        SrsHttpHooksIdleClient* idle = clients.back();
+        clients.pop_back();
+
+        if (idle->expire < now || !idle->client->is_alive()) {
+            srs_freep(idle);
+            continue;
+        }
+
+        *pclient = idle->client;
+        *reused = true;
+        idle->client = NULL;
+        srs_freep(idle);
+        return err;
+    }
+
+    SrsHttpClient* client = new SrsHttpClient();
+    if ((err = client->initialize(uri->get_schema(), uri->get_host(), uri->get_port())) != srs_success) {
+        srs_freep(client);
+        return srs_error_wrap(err, "http: init client");
+    }
+
+    *pclient = client;
+    *reused = false;
+    return err;
+}
+
+void SrsHttpHooksPool::release(SrsHttpUri* uri, SrsHttpClient* client, bool keep_alive)
+{
+    string key = srs_fmt("%s://%s:%d", uri->get_schema().c_str(), uri->get_host().c_str(), uri->get_port());
+    std::vector<SrsHttpHooksIdleClient*>& clients = idles_[key];
+
+    if (!keep_alive || clients.size() >= SRS_HTTP_HOOKS_MAX_IDLE) {
+        srs_freep(client);
+        return;
+    }
+
+    clients.push_back(new SrsHttpHooksIdleClient(client, srs_get_system_time() + SRS_HTTP_HOOKS_IDLE_TIMEOUT));
+}
+
+SrsSharedPtr<SrsHttpHooksDecision> SrsHttpHooksPool::find(std::string key)
+{
+    std::map<std::string, SrsSharedPtr<SrsHttpHooksDecision> >::iterator it = decisions_.find(key);
+    if (it == decisions_.end()) {
+        return SrsSharedPtr<SrsHttpHooksDecision>();
+    }
+
+    SrsSharedPtr<SrsHttpHooksDecision>& decision = it->second;
+    if (decision->done && decision->expire < srs_get_system_time()) {
+        decisions_.erase(it);
+        return SrsSharedPtr<SrsHttpHooksDecision>();
+    }
+
+    return decision;
+}
+
+void SrsHttpHooksPool::set(std::string key, SrsSharedPtr<SrsHttpHooksDecision> decision)
+{
+    // Remove the expired decisions, when exceed the max number.
+    if (decisions_.size() >= SRS_HTTP_HOOKS_MAX_DECISIONS && decisions_.find(key) == decisions_.end()) {
+        srs_utime_t now = srs_get_system_time();
+        std::map<std::string, SrsSharedPtr<SrsHttpHooksDecision> >::iterator it;
+        for (it = decisions_.begin(); it != decisions_.end();) {
+            SrsSharedPtr<SrsHttpHooksDecision>& d = it->second;
+            if (d->done && d->expire < now) {
+                decisions_.erase(it++);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    // Ignore if still full, never block the callbacks.
+    if (decisions_.size() >= SRS_HTTP_HOOKS_MAX_DECISIONS && decisions_.find(key) == decisions_.end()) {
+        return;
+    }
+
+    decisions_[key] = decision;
+}
+
+void SrsHttpHooksPool::remove(std::string key, SrsHttpHooksDecision* decision)
+{
+    std::map<std::string, SrsSharedPtr<SrsHttpHooksDecision> >::iterator it = decisions_.find(key);
+    if (it != decisions_.end() && it->second.get() == decision) {
+        decisions_.erase(it);
+    }
+}
+
+int SrsHttpHooksPool::size()
+{
+    return (int)decisions_.size();
+}
+
+SrsHttpHooksPool* _srs_hooks_pool = NULL;
+
 SrsHttpHooks::SrsHttpHooks()
 {
 }
@@ -65,8 +219,7 @@ srs_error_t SrsHttpHooks::on_connect(string url, SrsRequest* req)
     std::string res;
     int status_code;
     
-    SrsHttpClient http;
-    if ((err = do_post(&http, url, data, status_code, res)) != srs_success) {
+    if ((err = do_auth("on_connect", url, req, data, status_code, res)) != srs_success) {
         return srs_error_wrap(err, "http: on_connect failed, client_id=%s, url=%s, request=%s, response=%s, code=%d",
             cid.c_str(), url.c_str(), data.c_str(), res.c_str(), status_code);
     }
@@ -99,8 +252,7 @@ void SrsHttpHooks::on_close(string url, SrsRequest* req, int64_t send_bytes, int
     std::string res;
     int status_code;
     
-    SrsHttpClient http;
-    if ((err = do_post(&http, url, data, status_code, res)) != srs_success) {
+    if ((err = do_post(url, data, status_code, res)) != srs_success) {
         int ret = srs_error_code(err);
         srs_freep(err);
         srs_warn("http: ignore on_close failed, client_id=%s, url=%s, request=%s, response=%s, code=%d, ret=%d",
@@ -143,8 +295,7 @@ srs_error_t SrsHttpHooks::on_publish(string url, SrsRequest* req)
     std::string res;
     int status_code;
     
-    SrsHttpClient http;
-    if ((err = do_post(&http, url, data, status_code, res)) != srs_success) {
+    if ((err = do_auth("on_publish", url, req, data, status_code, res)) != srs_success) {
         return srs_error_wrap(err, "http: on_publish failed, client_id=%s, url=%s, request=%s, response=%s, code=%d",
             cid.c_str(), url.c_str(), data.c_str(), res.c_str(), status_code);
     }
@@ -184,8 +335,7 @@ void SrsHttpHooks::on_unpublish(string url, SrsRequest* req)
     std::string res;
     int status_code;
     
-    SrsHttpClient http;
-    if ((err = do_post(&http, url, data, status_code, res)) != srs_success) {
+    if ((err = do_post(url, data, status_code, res)) != srs_success) {
         int ret = srs_error_code(err);
         srs_freep(err);
         srs_warn("http: ignore on_unpublish failed, client_id=%s, url=%s, request=%s, response=%s, status=%d, ret=%d",
@@ -229,8 +379,7 @@ srs_error_t SrsHttpHooks::on_play(string url, SrsRequest* req)
     std::string res;
     int status_code;
     
-    SrsHttpClient http;
-    if ((err = do_post(&http, url, data, status_code, res)) != srs_success) {
+    if ((err = do_auth("on_play", url, req, data, status_code, res)) != srs_success) {
         return srs_error_wrap(err, "http: on_play failed, client_id=%s, url=%s, request=%s, response=%s, status=%d",
             cid.c_str(), url.c_str(), data.c_str(), res.c_str(), status_code);
     }
@@ -270,8 +419,7 @@ void SrsHttpHooks::on_stop(string url, SrsRequest* req)
     std::string res;
     int status_code;
     
-    SrsHttpClient http;
-    if ((err = do_post(&http, url, data, status_code, res)) != srs_success) {
+    if ((err = do_post(url, data, status_code, res)) != srs_success) {
         int ret = srs_error_code(err);
         srs_freep(err);
         srs_warn("http: ignore on_stop failed, client_id=%s, url=%s, request=%s, response=%s, code=%d, ret=%d",
@@ -318,8 +466,7 @@ srs_error_t SrsHttpHooks::on_dvr(SrsContextId c, string url, SrsRequest* req, st
     std::string res;
     int status_code;
     
-    SrsHttpClient http;
-    if ((err = do_post(&http, url, data, status_code, res)) != srs_success) {
+    if ((err = do_post(url, data, status_code, res)) != srs_success) {
         return srs_error_wrap(err, "http post on_dvr uri failed, client_id=%s, url=%s, request=%s, response=%s, code=%d",
             cid.c_str(), url.c_str(), data.c_str(), res.c_str(), status_code);
     }
@@ -374,8 +521,7 @@ srs_error_t SrsHttpHooks::on_hls(SrsContextId c, string url, SrsRequest* req, st
     std::string res;
     int status_code;
     
-    SrsHttpClient http;
-    if ((err = do_post(&http, url, data, status_code, res)) != srs_success) {
+    if ((err = do_post(url, data, status_code, res)) != srs_success) {
         return srs_error_wrap(err, "http: post %s with %s, status=%d, res=%s", url.c_str(), data.c_str(), status_code, res.c_str());
     }
     
@@ -462,8 +608,7 @@ srs_error_t SrsHttpHooks::discover_co_workers(string url, string& host, int& por
     std::string res;
     int status_code;
     
-    SrsHttpClient http;
-    if ((err = do_post(&http, url, "", status_code, res)) != srs_success) {
+    if ((err = do_post(url, "", status_code, res)) != srs_success) {
         return srs_error_wrap(err, "http: post %s, status=%d, res=%s", url.c_str(), status_code, res.c_str());
     }
     
@@ -509,6 +654,22 @@ srs_error_t SrsHttpHooks::discover_co_workers(string url, string& host, int& por
     return err;
 }
 
+srs_error_t SrsHttpHooks::push_co_workers(string url, string body)
+{
+    srs_error_t err = srs_success;
+
+    std::string res;
+    int status_code;
+
+    if ((err = do_post(url, body, status_code, res)) != srs_success) {
+        return srs_error_wrap(err, "http: post %s, status=%d, res=%s", url.c_str(), status_code, res.c_str());
+    }
+
+    srs_info("http: cluster push ok, url=%s, body=%s, response=%s", url.c_str(), body.c_str(), res.c_str());
+
+    return err;
+}
+
 srs_error_t SrsHttpHooks::on_forward_backend(string url, SrsRequest* req, std::vector<std::string>& rtmp_urls)
 {
     srs_error_t err = srs_success;
@@ -533,8 +694,7 @@ srs_error_t SrsHttpHooks::on_forward_backend(string url, SrsRequest* req, std::v
     std::string res;
     int status_code;
 
-    SrsHttpClient http;
-    if ((err = do_post(&http, url, data, status_code, res)) != srs_success) {
+    if ((err = do_post(url, data, status_code, res)) != srs_success) {
         return srs_error_wrap(err, "http: on_forward_backend failed, client_id=%s, url=%s, request=%s, response=%s, code=%d",
             cid.c_str(), url.c_str(), data.c_str(), res.c_str(), status_code);
     }
@@ -577,17 +737,142 @@ srs_error_t SrsHttpHooks::on_forward_backend(string url, SrsRequest* req, std::v
     return err;
 }
 
-srs_error_t SrsHttpHooks::do_post(SrsHttpClient* hc, std::string url, std::string req, int& code, string& res)
+srs_error_t SrsHttpHooks::do_auth(string action, string url, SrsRequest* req, string data, int& code, string& res)
 {
     srs_error_t err = srs_success;
-    
+
+    srs_utime_t ttl = _srs_config->get_vhost_http_hooks_cache_ttl(req->vhost);
+    bool coalesce = _srs_config->get_vhost_http_hooks_coalesce(req->vhost);
+    if (!_srs_hooks_pool || (ttl <= 0 && !coalesce)) {
+        return do_post(url, data, code, res);
+    }
+
+    // Use the cached decision, or wait for the pending one.
+    string key = decision_key(action, url, req);
+    SrsSharedPtr<SrsHttpHooksDecision> decision = _srs_hooks_pool->find(key);
+    if (decision.get()) {
+        while (!decision->done) {
+            srs_cond_wait(decision->cond);
+        }
+
+        code = decision->code;
+        res = decision->res;
+        if (decision->err != srs_success) {
+            return srs_error_wrap(srs_error_copy(decision->err), "%s decision", decision->expire ? "cached" : "coalesced");
+        }
+        return err;
+    }
+
+    // Start a new decision, as pending one for others to wait.
+    decision = SrsSharedPtr<SrsHttpHooksDecision>(new SrsHttpHooksDecision());
+    if (coalesce) {
+        _srs_hooks_pool->set(key, decision);
+    }
+
+    err = do_post(url, data, code, res);
+
+    decision->done = true;
+    decision->code = code;
+    decision->res = res;
+    decision->err = srs_error_copy(err);
+    srs_cond_broadcast(decision->cond);
+
+    // Only cache the decision of server, never the network or server error.
+    int r0 = srs_error_code(err);
+    bool decided = (err == srs_success || r0 == ERROR_RESPONSE_CODE || (r0 == ERROR_HTTP_STATUS_INVALID && code >= 400 && code < 500));
+    if (ttl > 0 && decided) {
+        decision->expire = srs_get_system_time() + ttl;
+        _srs_hooks_pool->set(key, decision);
+    } else {
+        _srs_hooks_pool->remove(key, decision.get());
+    }
+
+    return err;
+}
+
+string SrsHttpHooks::decision_key(string action, string url, SrsRequest* req)
+{
+    std::stringstream ss;
+    ss << req->vhost << "|" << action << "|" << url;
+
+    std::map<std::string, std::string> query;
+    srs_parse_query_string(req->param, query);
+
+    vector<string> fields = _srs_config->get_vhost_http_hooks_cache_key(req->vhost);
+    for (int i = 0; i < (int)fields.size(); i++) {
+        string field = fields.at(i);
+
+        string v;
+        if (field == "ip") {
+            v = req->ip;
+        } else if (field == "app") {
+            v = req->app;
+        } else if (field == "stream") {
+            v = req->stream;
+        } else if (field == "param") {
+            v = req->param;
+        } else if (field == "tcUrl") {
+            v = req->tcUrl;
+        } else if (field == "pageUrl") {
+            v = req->pageUrl;
+        } else if (query.find(field) != query.end()) {
+            v = query[field];
+        }
+
+        ss << "|" << field << "=" << v;
+    }
+
+    return ss.str();
+}
+
+srs_error_t SrsHttpHooks::do_post(std::string url, std::string req, int& code, string& res)
+{
+    srs_error_t err = srs_success;
+
     SrsHttpUri uri;
     if ((err = uri.initialize(url)) != srs_success) {
         return srs_error_wrap(err, "http: post failed. url=%s", url.c_str());
     }
+
+    if (!_srs_hooks_pool) {
+        SrsHttpClient hc;
+        if ((err = hc.initialize(uri.get_schema(), uri.get_host(), uri.get_port())) != srs_success) {
+            return srs_error_wrap(err, "http: init client");
+        }
+
+        bool keep_alive = false;
+        return do_post(&hc, url, req, code, res, keep_alive);
+    }
+
+    // Never retry, because the POST is not idempotent, and the server might have handled the request
+    // even if the response is lost. The pool drops the idle client closed by server when acquire.
+    SrsHttpClient* hc = NULL;
+    bool reused = false;
+    if ((err = _srs_hooks_pool->acquire(&uri, &hc, &reused)) != srs_success) {
+        return srs_error_wrap(err, "http: acquire client");
+    }
+
+    bool keep_alive = false;
+    err = do_post(hc, url, req, code, res, keep_alive);
+    _srs_hooks_pool->release(&uri, hc, keep_alive);
+
+    if (err != srs_success) {
+        return srs_error_wrap(err, "http: post reused=%d", reused);
+    }
+
+    return err;
+}
+
+srs_error_t SrsHttpHooks::do_post(SrsHttpClient* hc, std::string url, std::string req, int& code, string& res, bool& keep_alive)
+{
+    srs_error_t err = srs_success;
+
+    code = 0;
+    keep_alive = false;
     
-    if ((err = hc->initialize(uri.get_schema(), uri.get_host(), uri.get_port())) != srs_success) {
-        return srs_error_wrap(err, "http: init client");
+    SrsHttpUri uri;
+    if ((err = uri.initialize(url)) != srs_success) {
+        return srs_error_wrap(err, "http: post failed. url=%s", url.c_str());
     }
     
     string path = uri.get_path();
@@ -605,6 +890,9 @@ srs_error_t SrsHttpHooks::do_post(SrsHttpClient* hc, std::string url, std::strin
     if ((err = msg->body_read_all(res)) != srs_success) {
         return srs_error_wrap(err, "http: body read");
     }
+
+    // The whole response is read, so the connection is reusable if server keeps it alive.
+    keep_alive = msg->is_keep_alive();
     
     // ensure the http status is ok.
     if (code != SRS_CONSTS_HTTP_OK && code != SRS_CONSTS_HTTP_Created) {
@@ -9,8 +9,12 @@
 
 #include <srs_core.hpp>
 
+#include <srs_protocol_st.hpp>
+#include <srs_core_autofree.hpp>
+
 #include <string>
 #include <vector>
+#include <map>
 
 class SrsHttpUri;
 class SrsStSocket;
@@ -18,6 +22,66 @@ class SrsRequest;
 class SrsHttpParser;
 class SrsHttpClient;
 
+// The decision of auth hooks, such as on_connect, on_publish and on_play, shared by the
+// coalesced callbacks, and cached for a while if cache_ttl is configured.
+class SrsHttpHooksDecision
+{
+public:
+    // Whether the hook server responded, for coalesced callbacks to wait.
+    bool done;
+    // The error of hook, srs_success for allow.
+    srs_error_t err;
+    int code;
+    std::string res;
+    // The expire time of cache, 0 if not cached.
+    srs_utime_t expire;
+    srs_cond_t cond;
+public:
+    SrsHttpHooksDecision();
+    virtual ~SrsHttpHooksDecision();
+};
+
+// The idle keep-alive connection to hook server.
+class SrsHttpHooksIdleClient
+{
+public:
+    SrsHttpClient* client;
+    srs_utime_t expire;
+public:
+    SrsHttpHooksIdleClient(SrsHttpClient* c, srs_utime_t e);
+    virtual ~SrsHttpHooksIdleClient();
+};
+
+// The keep-alive connection pool of hook servers, and the decisions of auth hooks, to reduce
+// the latency and load of hook servers when lots of clients join in a short time.
+class SrsHttpHooksPool
+{
+private:
+    // The idle clients of each hook server, key is schema://host:port.
+    std::map<std::string, std::vector<SrsHttpHooksIdleClient*> > idles_;
+    // The pending and cached decisions, key is vhost, action, url and request fields.
+    std::map<std::string, SrsSharedPtr<SrsHttpHooksDecision> > decisions_;
+public:
+    SrsHttpHooksPool();
+    virtual ~SrsHttpHooksPool();
+public:
+    // Fetch an idle client of hook server, or create a new one, reused is true for idle one.
+    srs_error_t acquire(SrsHttpUri* uri, SrsHttpClient** pclient, bool* reused);
+    // Give back the client, which is kept alive for next request if keep_alive, or freed.
+    void release(SrsHttpUri* uri, SrsHttpClient* client, bool keep_alive);
+public:
+    // Find the pending or cached decision, NULL if not found or expired.
+    SrsSharedPtr<SrsHttpHooksDecision> find(std::string key);
+    // Put the pending or cached decision, ignored if exceed the max number.
+    void set(std::string key, SrsSharedPtr<SrsHttpHooksDecision> decision);
+    // Remove the decision, only if it's the same object.
+    void remove(std::string key, SrsHttpHooksDecision* decision);
+    int size();
+};
+
+// It MUST be global and shared object, but only used in the hybrid thread.
+extern SrsHttpHooksPool* _srs_hooks_pool;
+
 // the http hooks, http callback api,
 // for some event, such as on_connect, call
 // a http api(hooks).
@@ -80,12 +144,20 @@ public:
     static srs_error_t on_hls_notify(SrsContextId cid, std::string url, SrsRequest* req, std::string ts_url, int nb_notify);
     // Discover co-workers for origin cluster.
     static srs_error_t discover_co_workers(std::string url, std::string& host, int& port);
+    // Push the stream event to co-worker of origin cluster.
+    static srs_error_t push_co_workers(std::string url, std::string body);
     // The on_forward_backend hook, when publish stream start to forward
     // @param url the api server url, to valid the client.
     //         ignore if empty.
     static srs_error_t on_forward_backend(std::string url, SrsRequest* req, std::vector<std::string>& rtmp_urls);
 private:
-    static srs_error_t do_post(SrsHttpClient* hc, std::string url, std::string req, int& code, std::string& res);
+    // Post the auth hook, use the cached decision, or wait for the pending one with the same key.
+    static srs_error_t do_auth(std::string action, std::string url, SrsRequest* req, std::string data, int& code, std::string& res);
+    static srs_error_t do_post(std::string url, std::string req, int& code, std::string& res);
+    static srs_error_t do_post(SrsHttpClient* hc, std::string url, std::string req, int& code, std::string& res, bool& keep_alive);
+public:
+    // Build the key of decision, by the request fields of cache_key.
+    static std::string decision_key(std::string action, std::string url, SrsRequest* req);
 };
 
 #endif
@@ -37,7 +37,10 @@ using namespace std;
 #include <srs_app_http_hooks.hpp>
 #include <srs_app_statistic.hpp>
 #include <srs_app_hybrid.hpp>
+#include <srs_app_threads.hpp>
 #include <srs_protocol_log.hpp>
+#include <srs_protocol_http_client.hpp>
+#include <srs_kernel_balance.hpp>
 
 #define SRS_CONTEXT_IN_HLS "hls_ctx"
 
@@ -113,6 +116,9 @@ srs_error_t SrsHlsStream::serve_m3u8_ctx(ISrsHttpResponseWriter* w, ISrsHttpMess
         }
 
         err = serve_exists_session(w, r, factory, fullpath);
+    } else if (_srs_circuit_breaker->should_reject_player(req->vhost)) {
+        // Reject new player when overloaded, to keep the existing players.
+        return srs_go_http_error(w, SRS_CONSTS_HTTP_ServiceUnavailable);
     } else {
         // Create a m3u8 in memory, contains the session id(ctx).
         err = serve_new_session(w, r, req, ctx);
@@ -575,6 +581,250 @@ srs_error_t SrsVodStream::serve_ts_ctx(ISrsHttpResponseWriter * w, ISrsHttpMessa
     return err;
 }
 
+// The timeout to fetch object from origin.
+#define SRS_HTTP_EDGE_TIMEOUT (10 * SRS_UTIME_SECONDS)
+
+SrsHttpEdgeObject::SrsHttpEdgeObject()
+{
+    done = false;
+    status = 0;
+    expire = 0;
+    cond = srs_cond_new();
+}
+
+SrsHttpEdgeObject::~SrsHttpEdgeObject()
+{
+    srs_cond_destroy(cond);
+}
+
+SrsHttpEdgeCache::SrsHttpEdgeCache(int64_t max)
+{
+    max_size = max;
+    size_ = 0;
+}
+
+SrsHttpEdgeCache::~SrsHttpEdgeCache()
+{
+}
+
+SrsSharedPtr<SrsHttpEdgeObject> SrsHttpEdgeCache::find(string key)
+{
+    map<string, SrsSharedPtr<SrsHttpEdgeObject> >::iterator it = pendings.find(key);
+    if (it != pendings.end()) {
+        return it->second;
+    }
+
+    it = objects.find(key);
+    if (it == objects.end()) {
+        return SrsSharedPtr<SrsHttpEdgeObject>(NULL);
+    }
+
+    SrsSharedPtr<SrsHttpEdgeObject> obj = it->second;
+    if (obj->expire < srs_get_system_time()) {
+        remove(key);
+        return SrsSharedPtr<SrsHttpEdgeObject>(NULL);
+    }
+
+    // Move to front, as the most recently used.
+    lru.splice(lru.begin(), lru, positions[key]);
+
+    return obj;
+}
+
+void SrsHttpEdgeCache::set_pending(string key, SrsSharedPtr<SrsHttpEdgeObject> obj)
+{
+    pendings[key] = obj;
+}
+
+void SrsHttpEdgeCache::remove_pending(string key, SrsHttpEdgeObject* obj)
+{
+    map<string, SrsSharedPtr<SrsHttpEdgeObject> >::iterator it = pendings.find(key);
+    if (it != pendings.end() && it->second.get() == obj) {
+        pendings.erase(it);
+    }
+}
+
+void SrsHttpEdgeCache::put(string key, SrsSharedPtr<SrsHttpEdgeObject> obj)
+{
+    remove_pending(key, obj.get());
+    remove(key);
+
+    // Never cache the object larger than the cache.
+    int64_t nn = (int64_t)obj->body.length();
+    if (nn > max_size) {
+        return;
+    }
+
+    lru.push_front(key);
+    positions[key] = lru.begin();
+    objects[key] = obj;
+    size_ += nn;
+
+    // Evict the least recently used objects.
+    while (size_ > max_size && !lru.empty()) {
+        remove(lru.back());
+    }
+}
+
+int64_t SrsHttpEdgeCache::size()
+{
+    return size_;
+}
+
+int SrsHttpEdgeCache::count()
+{
+    return (int)objects.size();
+}
+
+void SrsHttpEdgeCache::remove(string key)
+{
+    map<string, SrsSharedPtr<SrsHttpEdgeObject> >::iterator it = objects.find(key);
+    if (it == objects.end()) {
+        return;
+    }
+
+    size_ -= (int64_t)it->second->body.length();
+    objects.erase(it);
+
+    lru.erase(positions[key]);
+    positions.erase(key);
+}
+
+SrsHttpEdgeStream::SrsHttpEdgeStream(string v)
+{
+    vhost = v;
+    cache = new SrsHttpEdgeCache((int64_t)_srs_config->get_vhost_edge_http_cache_size(vhost) * 1024 * 1024);
+}
+
+SrsHttpEdgeStream::~SrsHttpEdgeStream()
+{
+    srs_freep(cache);
+}
+
+srs_error_t SrsHttpEdgeStream::serve_http(ISrsHttpResponseWriter* w, ISrsHttpMessage* r)
+{
+    srs_error_t err = srs_success;
+
+    // Use the path as key, ignore the query string, so all clients share the same object.
+    string path = r->path();
+
+    SrsSharedPtr<SrsHttpEdgeObject> obj = cache->find(path);
+    if (obj.get()) {
+        // Wait for the pending object, which is fetching by other request.
+        while (!obj->done) {
+            if (srs_cond_wait(obj->cond) != 0) {
+                return srs_error_new(ERROR_THREAD_INTERRUPED, "wait for %s", path.c_str());
+            }
+        }
+    } else {
+        obj = SrsSharedPtr<SrsHttpEdgeObject>(new SrsHttpEdgeObject());
+        cache->set_pending(path, obj);
+
+        srs_error_t r0 = fetch(path, obj.get());
+
+        obj->done = true;
+        srs_cond_broadcast(obj->cond);
+
+        // Only cache the object fetched ok, the playlist expires quickly while the segment is immutable.
+        if (r0 == srs_success && obj->status == SRS_CONSTS_HTTP_OK) {
+            bool playlist = srs_string_ends_with(path, ".m3u8", ".mpd");
+            srs_utime_t ttl = playlist ? _srs_config->get_vhost_edge_http_playlist_ttl(vhost) : _srs_config->get_vhost_edge_http_segment_ttl(vhost);
+            obj->expire = srs_get_system_time() + ttl;
+            cache->put(path, obj);
+        } else {
+            cache->remove_pending(path, obj.get());
+        }
+
+        srs_trace("http edge: fetch %s, status=%d, size=%d, cache=%d/%" PRId64 "KB, err=%s", path.c_str(), obj->status,
+            (int)obj->body.length(), cache->count(), cache->size() / 1024, srs_error_summary(r0).c_str());
+        srs_freep(r0);
+    }
+
+    if (!obj->status) {
+        return srs_go_http_error(w, SRS_CONSTS_HTTP_BadGateway);
+    }
+    if (obj->status != SRS_CONSTS_HTTP_OK) {
+        return srs_go_http_error(w, obj->status);
+    }
+
+    if (!obj->content_type.empty()) {
+        w->header()->set_content_type(obj->content_type);
+    }
+    w->header()->set_content_length((int64_t)obj->body.length());
+    w->write_header(SRS_CONSTS_HTTP_OK);
+
+    if (!obj->body.empty() && (err = w->write((char*)obj->body.data(), (int)obj->body.length())) != srs_success) {
+        return srs_error_wrap(err, "write %s", path.c_str());
+    }
+
+    return err;
+}
+
+srs_error_t SrsHttpEdgeStream::fetch(string path, SrsHttpEdgeObject* obj)
+{
+    srs_error_t err = srs_success;
+
+    vector<string> origins = _srs_config->get_vhost_edge_http_origin(vhost);
+    if (origins.empty()) {
+        return srs_error_new(ERROR_EDGE_VHOST_REMOVED, "no origin of vhost %s", vhost.c_str());
+    }
+
+    // Select origin by path, so each object is fetched from the same origin, then failover to others.
+    SrsLbConsistentHash lb(path);
+    for (int i = 0; i < (int)origins.size(); i++) {
+        string server = lb.select(origins);
+
+        string host = server;
+        int port = SRS_DEFAULT_HTTP_PORT;
+        srs_parse_hostport(server, host, port);
+
+        if ((err = do_fetch(host, port, path, obj)) == srs_success) {
+            return err;
+        }
+        lb.feedback(server, false);
+
+        if (i < (int)origins.size() - 1) {
+            srs_warn("http edge: ignore origin %s err %s", server.c_str(), srs_error_desc(err).c_str());
+            srs_freep(err);
+        }
+    }
+
+    return err;
+}
+
+srs_error_t SrsHttpEdgeStream::do_fetch(string host, int port, string path, SrsHttpEdgeObject* obj)
+{
+    srs_error_t err = srs_success;
+
+    SrsHttpClient hc;
+    if ((err = hc.initialize("http", host, port, SRS_HTTP_EDGE_TIMEOUT)) != srs_success) {
+        return srs_error_wrap(err, "init client");
+    }
+
+    ISrsHttpMessage* msg_raw = NULL;
+    if ((err = hc.get(path, "", &msg_raw)) != srs_success) {
+        return srs_error_wrap(err, "get %s:%d%s", host.c_str(), port, path.c_str());
+    }
+    SrsUniquePtr<ISrsHttpMessage> msg(msg_raw);
+
+    // Failover to other origins, when origin is error.
+    int status = msg->status_code();
+    if (status >= SRS_CONSTS_HTTP_InternalServerError) {
+        return srs_error_new(ERROR_HTTP_STATUS_INVALID, "status %d of %s:%d%s", status, host.c_str(), port, path.c_str());
+    }
+
+    string body;
+    if ((err = msg->body_read_all(body)) != srs_success) {
+        return srs_error_wrap(err, "read %s:%d%s", host.c_str(), port, path.c_str());
+    }
+
+    obj->status = status;
+    obj->content_type = msg->header()->content_type();
+    obj->body = body;
+
+    return err;
+}
+
 SrsHttpStaticServer::SrsHttpStaticServer(SrsServer* svr)
 {
     server = svr;
@@ -655,6 +905,17 @@ srs_error_t SrsHttpStaticServer::mount_vhost(string vhost, string& pmount)
         mount += "/";
     }
     
+    // mount the HLS/DASH edge of vhost, which fetches objects from origin.
+    if (_srs_config->get_vhost_is_edge(vhost) && !_srs_config->get_vhost_edge_http_origin(vhost).empty()) {
+        if ((err = mux.handle(mount, new SrsHttpEdgeStream(vhost))) != srs_success) {
+            return srs_error_wrap(err, "mux handle");
+        }
+        srs_trace("http: vhost=%s mount to %s as edge", vhost.c_str(), mount.c_str());
+
+        pmount = mount;
+        return err;
+    }
+
     // mount the http of vhost.
     if ((err = mux.handle(mount, new SrsVodStream(dir))) != srs_success) {
         return srs_error_wrap(err, "mux handle");
@@ -10,6 +10,9 @@
 #include <srs_core.hpp>
 #include <srs_app_security.hpp>
 #include <srs_app_http_conn.hpp>
+#include <srs_core_autofree.hpp>
+
+#include <list>
 
 class ISrsFileReaderFactory;
 
@@ -77,6 +80,73 @@ protected:
     virtual srs_error_t serve_ts_ctx(ISrsHttpResponseWriter* w, ISrsHttpMessage* r, std::string fullpath);
 };
 
+// The object of HLS/DASH edge, fetched from origin.
+class SrsHttpEdgeObject
+{
+public:
+    // Whether fetched from origin, for coalesced requests to wait.
+    bool done;
+    // The status code of origin, 0 if failed to fetch.
+    int status;
+    std::string content_type;
+    std::string body;
+    // The expire time of cache, 0 if not cached.
+    srs_utime_t expire;
+    srs_cond_t cond;
+public:
+    SrsHttpEdgeObject();
+    virtual ~SrsHttpEdgeObject();
+};
+
+// The LRU cache of HLS/DASH edge, bounded by the total bytes of objects.
+class SrsHttpEdgeCache
+{
+private:
+    // The max and current bytes of cached objects.
+    int64_t max_size;
+    int64_t size_;
+    // The keys of cached objects, the front is the most recently used.
+    std::list<std::string> lru;
+    std::map<std::string, std::list<std::string>::iterator> positions;
+    std::map<std::string, SrsSharedPtr<SrsHttpEdgeObject> > objects;
+    // The objects fetching from origin, for requests to coalesce.
+    std::map<std::string, SrsSharedPtr<SrsHttpEdgeObject> > pendings;
+public:
+    SrsHttpEdgeCache(int64_t max);
+    virtual ~SrsHttpEdgeCache();
+public:
+    // Find the pending or unexpired object, NULL if not found.
+    virtual SrsSharedPtr<SrsHttpEdgeObject> find(std::string key);
+    // Set the object which is fetching from origin.
+    virtual void set_pending(std::string key, SrsSharedPtr<SrsHttpEdgeObject> obj);
+    // Remove the pending object, for failed to fetch.
+    virtual void remove_pending(std::string key, SrsHttpEdgeObject* obj);
+    // Put the fetched object to cache, and evict the least recently used ones if exceed.
+    virtual void put(std::string key, SrsSharedPtr<SrsHttpEdgeObject> obj);
+    virtual int64_t size();
+    virtual int count();
+private:
+    virtual void remove(std::string key);
+};
+
+// The HLS/DASH edge, fetch the m3u8, ts and m4s from origin, serve clients from cache,
+// and coalesce the requests of the same object, so the load of origin is independent to clients.
+class SrsHttpEdgeStream : public ISrsHttpHandler
+{
+private:
+    std::string vhost;
+    SrsHttpEdgeCache* cache;
+public:
+    SrsHttpEdgeStream(std::string v);
+    virtual ~SrsHttpEdgeStream();
+// Interface ISrsHttpHandler
+public:
+    virtual srs_error_t serve_http(ISrsHttpResponseWriter* w, ISrsHttpMessage* r);
+private:
+    virtual srs_error_t fetch(std::string path, SrsHttpEdgeObject* obj);
+    virtual srs_error_t do_fetch(std::string host, int port, std::string path, SrsHttpEdgeObject* obj);
+};
+
 // The http static server instance,
 // serve http static file and flv/mp4 vod stream.
 class SrsHttpStaticServer : public ISrsReloadHandler
@@ -39,6 +39,7 @@ using namespace std;
 #include <srs_app_statistic.hpp>
 #include <srs_app_recv_thread.hpp>
 #include <srs_app_http_hooks.hpp>
+#include <srs_app_threads.hpp>
 
 SrsBufferCache::SrsBufferCache(SrsRequest* r)
 {
@@ -619,6 +620,11 @@ srs_error_t SrsLiveStream::serve_http(ISrsHttpResponseWriter* w, ISrsHttpMessage
     // update client ip
     req->ip = hc->remote_ip();
 
+    // Reject new player when overloaded, to keep the publishers and existing players.
+    if (_srs_circuit_breaker->should_reject_player(req->vhost)) {
+        return srs_go_http_error(w, SRS_CONSTS_HTTP_ServiceUnavailable);
+    }
+
     // We must do stat the client before hooks, because hooks depends on it.
     SrsStatistic* stat = SrsStatistic::instance();
     if ((err = stat->on_client(_srs_context->get_id().c_str(), req, hc, SrsFlvPlay)) != srs_success) {
@@ -737,6 +743,18 @@ srs_error_t SrsLiveStream::do_serve_http(ISrsHttpResponseWriter* w, ISrsHttpMess
     SrsHttpxConn* hxc = dynamic_cast<SrsHttpxConn*>(hc->handler());
     srs_assert(hxc);
 
+    // Send large FLV tags with MSG_ZEROCOPY, which must be enabled before the receiving thread starts, because it
+    // drains the completions when reading. Note that other encoders write from their own reused buffers.
+    ISrsZerocopyWriter* zerocopy = NULL;
+    SrsSharedPtr<SrsVhostConfig> conf = _srs_config->get_vhost_snapshot(req->vhost);
+    if (ffe && conf->zerocopy && (zerocopy = hxc->zerocopy_writer()) != NULL) {
+        if ((err = zerocopy->set_zerocopy(conf->zerocopy_threshold)) != srs_success) {
+            srs_warn("http: ignore zerocopy, err %s", srs_error_desc(err).c_str());
+            srs_freep(err);
+            zerocopy = NULL;
+        }
+    }
+
     // Start a thread to receive all messages from client, then drop them.
     SrsUniquePtr<SrsHttpRecvThread> trd(new SrsHttpRecvThread(hxc));
 
@@ -744,10 +762,10 @@ srs_error_t SrsLiveStream::do_serve_http(ISrsHttpResponseWriter* w, ISrsHttpMess
         return srs_error_wrap(err, "start recv thread");
     }
 
-    srs_utime_t mw_sleep = _srs_config->get_mw_sleep(req->vhost);
-    srs_trace("FLV %s, encoder=%s, mw_sleep=%dms, cache=%d, msgs=%d, dinm=%d, guess_av=%d/%d/%d",
+    srs_utime_t mw_sleep = conf->mw_sleep;
+    srs_trace("FLV %s, encoder=%s, mw_sleep=%dms, cache=%d, msgs=%d, dinm=%d, guess_av=%d/%d/%d, zerocopy=%d",
         entry->pattern.c_str(), enc_desc.c_str(), srsu2msi(mw_sleep), enc->has_cache(), msgs.max, drop_if_not_match,
-        has_audio, has_video, guess_has_av);
+        has_audio, has_video, guess_has_av, (zerocopy != NULL));
 
     // TODO: free and erase the disabled entry after all related connections is closed.
     // TODO: FXIME: Support timeout for player, quit infinite-loop.
@@ -775,8 +793,10 @@ srs_error_t SrsLiveStream::do_serve_http(ISrsHttpResponseWriter* w, ISrsHttpMess
         }
         
         if (pprint->can_print()) {
-            srs_trace("-> " SRS_CONSTS_LOG_HTTP_STREAM " http: got %d msgs, age=%d, min=%d, mw=%d",
-                count, pprint->age(), SRS_PERF_MW_MIN_MSGS, srsu2msi(mw_sleep));
+            int64_t nn_disposable = 0, nn_video = 0, nn_shrink = 0;
+            consumer->drop_stat(nn_disposable, nn_video, nn_shrink);
+            srs_trace("-> " SRS_CONSTS_LOG_HTTP_STREAM " http: got %d msgs, age=%d, min=%d, mw=%d, drop=%" PRId64 ",%" PRId64 ",%" PRId64,
+                count, pprint->age(), SRS_PERF_MW_MIN_MSGS, srsu2msi(mw_sleep), nn_disposable, nn_video, nn_shrink);
         }
         
         // sendout all messages.
@@ -788,10 +808,14 @@ srs_error_t SrsLiveStream::do_serve_http(ISrsHttpResponseWriter* w, ISrsHttpMess
 
         // TODO: FIXME: Update the stat.
 
-        // free the messages.
+        // free the messages, for zerocopy, the payloads are retained until kernel completes the sends.
         for (int i = 0; i < count; i++) {
             SrsSharedPtrMessage* msg = msgs.msgs[i];
-            srs_freep(msg);
+            if (zerocopy) {
+                zerocopy->zerocopy_free(msg);
+            } else {
+                srs_freep(msg);
+            }
         }
         
         // check send error code.
@@ -1193,8 +1217,9 @@ srs_error_t SrsHttpStreamServer::hijack(ISrsHttpMessage* request, ISrsHttpHandle
     }
     srs_assert(live_source.get() != NULL);
     
-    bool enabled_cache = _srs_config->get_gop_cache(r->vhost);
-    int gcmf = _srs_config->get_gop_cache_max_frames(r->vhost);
+    SrsSharedPtr<SrsVhostConfig> conf = _srs_config->get_vhost_snapshot(r->vhost);
+    bool enabled_cache = conf->gop_cache;
+    int gcmf = conf->gop_cache_max_frames;
     live_source->set_cache(enabled_cache);
     live_source->set_gop_cache_max_frames(gcmf);
 
@@ -1210,7 +1235,7 @@ srs_error_t SrsHttpStreamServer::hijack(ISrsHttpMessage* request, ISrsHttpHandle
     }
     
     // trigger edge to fetch from origin.
-    bool vhost_is_edge = _srs_config->get_vhost_is_edge(r->vhost);
+    bool vhost_is_edge = conf->is_edge;
     srs_trace("flv: source url=%s, is_edge=%d, source_id=%s/%s",
         r->get_stream_url().c_str(), vhost_is_edge, live_source->source_id().c_str(), live_source->pre_source_id().c_str());
 
@@ -13,6 +13,7 @@
 #include <srs_app_utility.hpp>
 #include <srs_app_dvr.hpp>
 #include <srs_app_tencentcloud.hpp>
+#include <srs_protocol_rtmp_handshake.hpp>
 
 using namespace std;
 
@@ -24,6 +25,18 @@ extern SrsPps* _srs_pps_pub;
 extern SrsPps* _srs_pps_conn;
 extern SrsPps* _srs_pps_dispose;
 
+extern SrsPps* _srs_pps_hs_complex;
+extern SrsPps* _srs_pps_hs_degrade;
+extern SrsPps* _srs_pps_hs_hit;
+extern SrsPps* _srs_pps_hs_miss;
+
+extern SrsPps* _srs_pps_async_calls;
+extern SrsPps* _srs_pps_async_drops;
+extern SrsPps* _srs_pps_async_wait;
+
+extern SrsPps* _srs_pps_shed_frames;
+extern SrsPps* _srs_pps_shed_rejects;
+
 #if defined(SRS_DEBUG) && defined(SRS_DEBUG_STATS)
 extern __thread unsigned long long _st_stat_recvfrom;
 extern __thread unsigned long long _st_stat_recvfrom_eagain;
@@ -161,6 +174,11 @@ srs_error_t SrsHybridServer::initialize()
 {
     srs_error_t err = srs_success;
 
+    // Setup the stacks before starting any coroutine.
+    if ((err = _srs_stacks->initialize()) != srs_success) {
+        return srs_error_wrap(err, "stacks");
+    }
+
     // Start the timer first.
     if ((err = timer20ms_->start()) != srs_success) {
         return srs_error_wrap(err, "start timer");
@@ -178,7 +196,8 @@ srs_error_t SrsHybridServer::initialize()
         return srs_error_wrap(err, "start timer");
     }
 
-    // Start the DVR async call.
+    // Start the DVR async call, with N executors to call the on_dvr concurrently.
+    _srs_dvr_async->set_executors(_srs_config->get_async_call_executors());
     if ((err = _srs_dvr_async->start()) != srs_success) {
         return srs_error_wrap(err, "dvr async");
     }
@@ -303,6 +322,31 @@ srs_error_t SrsHybridServer::on_timer(srs_utime_t interval)
         free_desc = buf;
     }
 
+    string hs_desc;
+    _srs_pps_hs_complex->update(); _srs_pps_hs_degrade->update(); _srs_pps_hs_hit->update(); _srs_pps_hs_miss->update();
+    if (_srs_pps_hs_complex->r10s() || _srs_pps_hs_degrade->r10s()) {
+        snprintf(buf, sizeof(buf), ", hs=%d,%d,%d,%d,%d,%d", _srs_pps_hs_complex->r10s(), _srs_pps_hs_degrade->r10s(),
+            _srs_pps_hs_hit->r10s(), _srs_pps_hs_miss->r10s(), _srs_handshake_pool->size(), _srs_handshake_pool->peak_concurrency());
+        hs_desc = buf;
+    }
+
+    string async_desc;
+    _srs_pps_async_calls->update(); _srs_pps_async_drops->update(); _srs_pps_async_wait->update();
+    if (_srs_pps_async_calls->r10s() || _srs_pps_async_drops->r10s()) {
+        // The average queue latency in ms of async tasks.
+        int wait = _srs_pps_async_calls->r10s() ? _srs_pps_async_wait->r10s() / _srs_pps_async_calls->r10s() : 0;
+        snprintf(buf, sizeof(buf), ", async=%d,%d,%d,%d", _srs_pps_async_calls->r10s(), _srs_pps_async_drops->r10s(),
+            wait, _srs_dvr_async->count());
+        async_desc = buf;
+    }
+
+    string shed_desc;
+    _srs_pps_shed_frames->update(); _srs_pps_shed_rejects->update();
+    if (_srs_pps_shed_frames->r10s() || _srs_pps_shed_rejects->r10s()) {
+        snprintf(buf, sizeof(buf), ", shed=%d,%d", _srs_pps_shed_frames->r10s(), _srs_pps_shed_rejects->r10s());
+        shed_desc = buf;
+    }
+
     string recvfrom_desc;
 #if defined(SRS_DEBUG) && defined(SRS_DEBUG_STATS)
     _srs_pps_recvfrom->update(_st_stat_recvfrom); _srs_pps_recvfrom_eagain->update(_st_stat_recvfrom_eagain);
@@ -389,9 +433,9 @@ srs_error_t SrsHybridServer::on_timer(srs_utime_t interval)
     }
 #endif
 
-    srs_trace("Hybrid cpu=%.2f%%,%dMB%s%s%s%s%s%s%s%s%s%s%s",
+    srs_trace("Hybrid cpu=%.2f%%,%dMB%s%s%s%s%s%s%s%s%s%s%s%s%s%s",
         u->percent * 100, memory,
-        cid_desc.c_str(), timer_desc.c_str(),
+        cid_desc.c_str(), timer_desc.c_str(), hs_desc.c_str(), async_desc.c_str(), shed_desc.c_str(),
         recvfrom_desc.c_str(), io_desc.c_str(), msg_desc.c_str(),
         epoll_desc.c_str(), sched_desc.c_str(), clock_desc.c_str(),
         thread_desc.c_str(), free_desc.c_str(), objs_desc.c_str()
@@ -280,7 +280,7 @@ SrsPublishRecvThread::SrsPublishRecvThread(SrsRtmpServer* rtmp_sdk, SrsRequest*
     mr = _srs_config->get_mr_enabled(req->vhost);
     mr_sleep = _srs_config->get_mr_sleep(req->vhost);
     
-    realtime = _srs_config->get_realtime_enabled(req->vhost);
+    realtime = _srs_config->get_vhost_snapshot(req->vhost)->realtime;
     
     _srs_config->subscribe(this);
 }
@@ -504,7 +504,7 @@ srs_error_t SrsPublishRecvThread::on_reload_vhost_realtime(string vhost)
         return err;
     }
     
-    bool realtime_enabled = _srs_config->get_realtime_enabled(req->vhost);
+    bool realtime_enabled = _srs_config->get_vhost_snapshot(req->vhost)->realtime;
     srs_trace("realtime changed %d=>%d", realtime, realtime_enabled);
     realtime = realtime_enabled;
     
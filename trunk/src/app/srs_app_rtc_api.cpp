@@ -16,6 +16,7 @@
 #include <srs_app_statistic.hpp>
 #include <srs_app_http_hooks.hpp>
 #include <srs_app_utility.hpp>
+#include <srs_app_heartbeat.hpp>
 #include <unistd.h>
 #include <deque>
 using namespace std;
@@ -641,6 +642,17 @@ srs_error_t SrsGoApiRtcWhip::serve_http(ISrsHttpResponseWriter* w, ISrsHttpMessa
         return w->write(NULL, 0);
     }
 
+    // Redirect to the less-loaded peer, when this node is overloaded. Use 307 for client to POST the
+    // offer again to the peer, see https://datatracker.ietf.org/doc/draft-ietf-wish-whip/
+    if (r->is_http_post()) {
+        bool play = srs_string_ends_with(r->path(), "/whip-play/") || srs_string_ends_with(r->path(), "/whep/")
+            || r->query_get("action") == "play";
+        SrsLoadReport* peer = _srs_load_redirect->select(!play);
+        if (peer && peer->api_port) {
+            return srs_load_redirect_http(w, r, peer, peer->api_port, SRS_CONSTS_HTTP_TemporaryRedirect);
+        }
+    }
+
     SrsRtcUserConfig ruc;
     if ((err = do_serve_http(w, r, &ruc)) != srs_success) {
         return srs_error_wrap(err, "serve");
@@ -9,6 +9,12 @@
 #include <srs_kernel_codec.hpp>
 #include <srs_kernel_error.hpp>
 #include <srs_kernel_log.hpp>
+#include <srs_kernel_utility.hpp>
+#include <srs_app_threads.hpp>
+#include <srs_app_hybrid.hpp>
+
+#include <algorithm>
+using namespace std;
 
 static const AVCodec* srs_find_decoder_by_id(SrsAudioCodecId id)
 {
@@ -51,7 +57,8 @@ public:
 
     static void ffmpeg_log_callback(void*, int level, const char* fmt, va_list vl) 
     {
-        static char buf[4096] = {0};
+        // Thread local buffer, because the codec might run in audio transcode workers.
+        static __thread char buf[4096] = {0};
         int nbytes = vsnprintf(buf, sizeof(buf), fmt, vl);
         if (nbytes > 0 && nbytes < (int)sizeof(buf)) {
             // Srs log is always start with new line, replcae '\n' to '\0', make log easy to read.
@@ -84,6 +91,22 @@ public:
 // Register FFmpeg log callback funciton.
 SrsFFmpegLogHelper _srs_ffmpeg_log_helper;
 
+// Free the audio frames and samples generated by transcoder.
+static void srs_free_audio_frames(std::vector<SrsAudioFrame*>& frames)
+{
+    for (std::vector<SrsAudioFrame*>::iterator it = frames.begin(); it != frames.end(); ++it) {
+        SrsAudioFrame* p = *it;
+
+        for (int i = 0; i < p->nb_samples; i++) {
+            char* pa = p->samples[i].bytes;
+            srs_freepa(pa);
+        }
+
+        srs_freep(p);
+    }
+    frames.clear();
+}
+
 SrsAudioTranscoder::SrsAudioTranscoder()
 {
     dec_ = NULL;
@@ -174,16 +197,7 @@ srs_error_t SrsAudioTranscoder::transcode(SrsAudioFrame *in_pkt, std::vector<Srs
 
 void SrsAudioTranscoder::free_frames(std::vector<SrsAudioFrame*>& frames)
 {
-    for (std::vector<SrsAudioFrame*>::iterator it = frames.begin(); it != frames.end(); ++it) {
-        SrsAudioFrame* p = *it;
-
-        for (int i = 0; i < p->nb_samples; i++) {
-            char* pa = p->samples[i].bytes;
-            srs_freepa(pa);
-        }
-
-        srs_freep(p);
-    }
+    srs_free_audio_frames(frames);
 }
 
 void SrsAudioTranscoder::aac_codec_header(uint8_t **data, int *len)
@@ -475,3 +489,408 @@ void SrsAudioTranscoder::free_swr_samples()
     }
 }
 
+
+ISrsAudioTranscodeHandler::ISrsAudioTranscodeHandler()
+{
+}
+
+ISrsAudioTranscodeHandler::~ISrsAudioTranscodeHandler()
+{
+}
+
+SrsAudioTranscodeTask::SrsAudioTranscodeTask(SrsAudioFrame* frame)
+{
+    data = NULL;
+    err = srs_success;
+
+    in.dts = frame->dts;
+    in.cts = frame->cts;
+
+    if (frame->nb_samples > 0 && frame->samples[0].size > 0) {
+        int size = frame->samples[0].size;
+        data = new char[size];
+        memcpy(data, frame->samples[0].bytes, size);
+
+        srs_error_t r0 = in.add_sample(data, size);
+        srs_freep(r0);
+    }
+}
+
+SrsAudioTranscodeTask::~SrsAudioTranscodeTask()
+{
+    srs_freepa(data);
+    srs_free_audio_frames(outs);
+    srs_freep(err);
+}
+
+SrsAudioTranscodeQueue::SrsAudioTranscodeQueue(SrsAsyncAudioTranscoder* o, SrsAudioTranscoder* c)
+{
+    owner = o;
+    codec = c;
+    scheduled = false;
+    notified = false;
+    nn_dropped = 0;
+}
+
+SrsAudioTranscodeQueue::~SrsAudioTranscodeQueue()
+{
+    for (std::deque<SrsAudioTranscodeTask*>::iterator it = inputs.begin(); it != inputs.end(); ++it) {
+        SrsAudioTranscodeTask* task = *it;
+        srs_freep(task);
+    }
+
+    for (std::deque<SrsAudioTranscodeTask*>::iterator it = outputs.begin(); it != outputs.end(); ++it) {
+        SrsAudioTranscodeTask* task = *it;
+        srs_freep(task);
+    }
+
+    srs_freep(codec);
+}
+
+SrsAsyncAudioTranscoder::SrsAsyncAudioTranscoder(ISrsAudioTranscodeHandler* h)
+{
+    handler_ = h;
+    codec_ = new SrsAudioTranscoder();
+    queue_ = NULL;
+}
+
+SrsAsyncAudioTranscoder::~SrsAsyncAudioTranscoder()
+{
+    // The codec is owned by queue, which might be transcoding by worker.
+    if (queue_ && _srs_audio_transcode_workers) {
+        _srs_audio_transcode_workers->detach(queue_);
+    } else if (queue_) {
+        // The workers are disposed and quit, so we are the only owner of queue.
+        srs_freep(queue_);
+    } else {
+        srs_freep(codec_);
+    }
+}
+
+srs_error_t SrsAsyncAudioTranscoder::initialize(SrsAudioCodecId from, SrsAudioCodecId to, int channels, int sample_rate, int bit_rate)
+{
+    srs_error_t err = srs_success;
+
+    if ((err = codec_->initialize(from, to, channels, sample_rate, bit_rate)) != srs_success) {
+        return srs_error_wrap(err, "initialize");
+    }
+
+    if (!queue_ && _srs_audio_transcode_workers->enabled()) {
+        queue_ = _srs_audio_transcode_workers->attach(this, codec_);
+    }
+
+    return err;
+}
+
+srs_error_t SrsAsyncAudioTranscoder::transcode(SrsAudioFrame* in)
+{
+    srs_error_t err = srs_success;
+
+    // Transcode in hybrid thread, and consume the frames immediately.
+    if (!queue_) {
+        std::vector<SrsAudioFrame*> outs;
+        if ((err = codec_->transcode(in, outs)) != srs_success) {
+            codec_->free_frames(outs);
+            return err;
+        }
+
+        err = handler_->on_audio_transcoded(in, outs);
+        codec_->free_frames(outs);
+
+        return err;
+    }
+
+    // Drop the frame if the workers is too busy, to avoid the queue grows infinitely.
+    SrsAudioTranscodeTask* task = new SrsAudioTranscodeTask(in);
+    if (!_srs_audio_transcode_workers->push(queue_, task)) {
+        if ((queue_->nn_dropped % 100) == 1) {
+            srs_warn("audio transcode: drop frame dts=%" PRId64 " for queue full, dropped=%d", in->dts, queue_->nn_dropped);
+        }
+        srs_freep(task);
+    }
+
+    // Consume the frames which are already transcoded.
+    return flush();
+}
+
+srs_error_t SrsAsyncAudioTranscoder::flush()
+{
+    srs_error_t err = srs_success;
+
+    if (!queue_) {
+        return err;
+    }
+
+    std::vector<SrsAudioTranscodeTask*> tasks;
+    _srs_audio_transcode_workers->fetch(queue_, tasks);
+
+    for (int i = 0; i < (int)tasks.size(); i++) {
+        SrsAudioTranscodeTask* task = tasks.at(i);
+
+        // Ignore the left frames if error.
+        if (err == srs_success) {
+            if (task->err != srs_success) {
+                err = task->err;
+                task->err = srs_success;
+            } else {
+                err = handler_->on_audio_transcoded(&task->in, task->outs);
+            }
+        }
+
+        srs_freep(task);
+    }
+
+    return err;
+}
+
+void SrsAsyncAudioTranscoder::aac_codec_header(uint8_t** data, int* len)
+{
+    codec_->aac_codec_header(data, len);
+}
+
+SrsAudioTranscodeWorkers::SrsAudioTranscodeWorkers()
+{
+    nn_workers_ = 0;
+    max_queue_ = 0;
+    stopping_ = false;
+    nn_running_ = 0;
+
+    lock_ = new SrsThreadMutex();
+    cond_ = new SrsThreadCond();
+}
+
+SrsAudioTranscodeWorkers::~SrsAudioTranscodeWorkers()
+{
+    stop();
+
+    srs_freep(cond_);
+    srs_freep(lock_);
+}
+
+srs_error_t SrsAudioTranscodeWorkers::initialize(int workers, int max_queue)
+{
+    srs_error_t err = srs_success;
+
+    // Ignore if already started.
+    if (nn_workers_ > 0 || workers <= 0) {
+        return err;
+    }
+
+    max_queue_ = srs_max(1, max_queue);
+
+    for (int i = 0; i < workers; i++) {
+        if (true) {
+            SrsThreadLocker(lock_);
+            nn_running_++;
+        }
+
+        if ((err = _srs_thread_pool->execute("audio", SrsAudioTranscodeWorkers::start, this)) != srs_success) {
+            SrsThreadLocker(lock_);
+            nn_running_--;
+            return srs_error_wrap(err, "start audio transcode worker #%d", i);
+        }
+        nn_workers_++;
+    }
+
+    // Consume the transcoded frames in hybrid thread.
+    _srs_hybrid->timer20ms()->subscribe(this);
+
+    srs_trace("Audio transcode workers=%d, max_queue=%d", nn_workers_, max_queue_);
+
+    return err;
+}
+
+bool SrsAudioTranscodeWorkers::enabled()
+{
+    return nn_workers_ > 0;
+}
+
+void SrsAudioTranscodeWorkers::stop()
+{
+    if (nn_workers_ <= 0) {
+        return;
+    }
+
+    _srs_hybrid->timer20ms()->unsubscribe(this);
+
+    if (true) {
+        SrsThreadLocker(lock_);
+        stopping_ = true;
+        cond_->broadcast();
+
+        while (nn_running_ > 0) {
+            cond_->wait(lock_);
+        }
+
+        // The queues are freed by owners, see SrsAsyncAudioTranscoder.
+        ready_.clear();
+        done_.clear();
+    }
+
+    srs_trace("Audio transcode workers=%d stopped", nn_workers_);
+    nn_workers_ = 0;
+}
+
+SrsAudioTranscodeQueue* SrsAudioTranscodeWorkers::attach(SrsAsyncAudioTranscoder* owner, SrsAudioTranscoder* codec)
+{
+    return new SrsAudioTranscodeQueue(owner, codec);
+}
+
+void SrsAudioTranscodeWorkers::detach(SrsAudioTranscodeQueue* queue)
+{
+    bool disposed = true;
+
+    if (true) {
+        SrsThreadLocker(lock_);
+
+        queue->owner = NULL;
+        done_.erase(std::remove(done_.begin(), done_.end(), queue), done_.end());
+
+        // If transcoding by worker, the worker will free it when done.
+        if (queue->scheduled) {
+            std::deque<SrsAudioTranscodeQueue*>::iterator it = std::find(ready_.begin(), ready_.end(), queue);
+            if (it != ready_.end()) {
+                ready_.erase(it);
+            } else if (nn_running_ > 0) {
+                disposed = false;
+            }
+        }
+    }
+
+    if (disposed) {
+        srs_freep(queue);
+    }
+}
+
+bool SrsAudioTranscodeWorkers::push(SrsAudioTranscodeQueue* queue, SrsAudioTranscodeTask* task)
+{
+    SrsThreadLocker(lock_);
+
+    if (stopping_ || (int)queue->inputs.size() >= max_queue_) {
+        queue->nn_dropped++;
+        return false;
+    }
+
+    queue->inputs.push_back(task);
+
+    // Schedule the queue, only one worker transcodes the queue at a time.
+    if (!queue->scheduled) {
+        queue->scheduled = true;
+        ready_.push_back(queue);
+        cond_->broadcast();
+    }
+
+    return true;
+}
+
+void SrsAudioTranscodeWorkers::fetch(SrsAudioTranscodeQueue* queue, std::vector<SrsAudioTranscodeTask*>& tasks)
+{
+    SrsThreadLocker(lock_);
+    tasks.insert(tasks.end(), queue->outputs.begin(), queue->outputs.end());
+    queue->outputs.clear();
+}
+
+srs_error_t SrsAudioTranscodeWorkers::start(void* arg)
+{
+    SrsAudioTranscodeWorkers* workers = (SrsAudioTranscodeWorkers*)arg;
+    workers->cycle();
+    return srs_success;
+}
+
+void SrsAudioTranscodeWorkers::cycle()
+{
+    SrsAudioTranscodeQueue* queue = NULL;
+    SrsAudioTranscodeTask* task = NULL;
+
+    while (wait_task(&queue, &task)) {
+        do_transcode(queue, task);
+    }
+}
+
+bool SrsAudioTranscodeWorkers::wait_task(SrsAudioTranscodeQueue** pqueue, SrsAudioTranscodeTask** ptask)
+{
+    SrsThreadLocker(lock_);
+    while (ready_.empty() && !stopping_) {
+        cond_->wait(lock_);
+    }
+
+    // Quit and notify the stopping thread, which waits for all workers.
+    if (stopping_) {
+        nn_running_--;
+        cond_->broadcast();
+        return false;
+    }
+
+    SrsAudioTranscodeQueue* queue = ready_.front();
+    ready_.pop_front();
+
+    *pqueue = queue;
+    *ptask = queue->inputs.front();
+    queue->inputs.pop_front();
+
+    return true;
+}
+
+void SrsAudioTranscodeWorkers::do_transcode(SrsAudioTranscodeQueue* queue, SrsAudioTranscodeTask* task)
+{
+    // Transcode without lock, the codec is only used by this worker now.
+    task->err = queue->codec->transcode(&task->in, task->outs);
+
+    bool disposed = false;
+    if (true) {
+        SrsThreadLocker(lock_);
+
+        queue->outputs.push_back(task);
+
+        if (!queue->owner) {
+            disposed = true;
+        } else {
+            if (!queue->notified) {
+                queue->notified = true;
+                done_.push_back(queue);
+            }
+
+            // Schedule the queue again to transcode the left frames, after other queues.
+            if (!queue->inputs.empty() && !stopping_) {
+                ready_.push_back(queue);
+            } else {
+                queue->scheduled = false;
+            }
+        }
+    }
+
+    if (disposed) {
+        srs_freep(queue);
+    }
+}
+
+srs_error_t SrsAudioTranscodeWorkers::on_timer(srs_utime_t interval)
+{
+    srs_error_t err = srs_success;
+
+    while (true) {
+        SrsAsyncAudioTranscoder* owner = NULL;
+
+        if (true) {
+            SrsThreadLocker(lock_);
+            if (done_.empty()) {
+                break;
+            }
+
+            SrsAudioTranscodeQueue* queue = done_.front();
+            done_.pop_front();
+            queue->notified = false;
+
+            owner = queue->owner;
+        }
+
+        if ((err = owner->flush()) != srs_success) {
+            srs_warn("audio transcode: ignore flush err %s", srs_error_desc(err).c_str());
+            srs_freep(err);
+        }
+    }
+
+    return err;
+}
+
+SrsAudioTranscodeWorkers* _srs_audio_transcode_workers = NULL;
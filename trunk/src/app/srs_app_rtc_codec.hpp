@@ -10,8 +10,11 @@
 #include <srs_core.hpp>
 
 #include <srs_kernel_codec.hpp>
+#include <srs_app_hourglass.hpp>
 
 #include <string>
+#include <vector>
+#include <deque>
 
 #ifdef __cplusplus
 extern "C" {
@@ -78,5 +81,135 @@ private:
     void free_swr_samples();
 };
 
+class SrsAsyncAudioTranscoder;
+class SrsThreadMutex;
+class SrsThreadCond;
+
+// The handler for async audio transcoder, to consume the transcoded frames in hybrid thread.
+class ISrsAudioTranscodeHandler
+{
+public:
+    ISrsAudioTranscodeHandler();
+    virtual ~ISrsAudioTranscodeHandler();
+public:
+    // When transcoded the input frame in, as output audio frames outs. The in only contains the
+    // dts and cts of input frame, to pass through the timestamp to bridge.
+    virtual srs_error_t on_audio_transcoded(SrsAudioFrame* in, std::vector<SrsAudioFrame*>& outs) = 0;
+};
+
+// The input audio frame to transcode in worker thread, and the transcoded frames.
+class SrsAudioTranscodeTask
+{
+public:
+    // The input frame, the sample is copied from the bridge.
+    SrsAudioFrame in;
+    char* data;
+    // The output frames, and the error when transcoding.
+    std::vector<SrsAudioFrame*> outs;
+    srs_error_t err;
+public:
+    SrsAudioTranscodeTask(SrsAudioFrame* frame);
+    virtual ~SrsAudioTranscodeTask();
+};
+
+// The transcoding queue of a stream, shared by hybrid and worker threads, protected by the lock
+// of workers. The transcoder is only used by one worker at a time, so the frames of a stream are
+// transcoded in order.
+class SrsAudioTranscodeQueue
+{
+public:
+    SrsAudioTranscoder* codec;
+    // The owner in hybrid thread, NULL if owner is freed.
+    SrsAsyncAudioTranscoder* owner;
+    // The input frames to transcode, and the transcoded frames to consume.
+    std::deque<SrsAudioTranscodeTask*> inputs;
+    std::deque<SrsAudioTranscodeTask*> outputs;
+    // Whether the queue is in the ready list or transcoding by worker.
+    bool scheduled;
+    // Whether the queue is in the done list, to consume by hybrid thread.
+    bool notified;
+    // The number of dropped frames, for queue is full.
+    int nn_dropped;
+public:
+    SrsAudioTranscodeQueue(SrsAsyncAudioTranscoder* o, SrsAudioTranscoder* c);
+    virtual ~SrsAudioTranscodeQueue();
+};
+
+// The audio transcoder of a stream, which transcodes in the worker threads if enabled, to avoid
+// blocking the hybrid thread, and the transcoded frames are consumed by handler in hybrid thread.
+// If workers is disabled, transcode in hybrid thread and consume the frames immediately.
+class SrsAsyncAudioTranscoder
+{
+private:
+    ISrsAudioTranscodeHandler* handler_;
+    SrsAudioTranscoder* codec_;
+    // The queue shared with workers, NULL if transcode in hybrid thread.
+    SrsAudioTranscodeQueue* queue_;
+public:
+    SrsAsyncAudioTranscoder(ISrsAudioTranscodeHandler* h);
+    virtual ~SrsAsyncAudioTranscoder();
+public:
+    // Initialize the transcoder, see SrsAudioTranscoder::initialize.
+    srs_error_t initialize(SrsAudioCodecId from, SrsAudioCodecId to, int channels, int sample_rate, int bit_rate);
+    // Transcode the input audio frame in, the transcoded frames are consumed by handler.
+    // @remark The frame is copied if transcode in worker threads.
+    srs_error_t transcode(SrsAudioFrame* in);
+    // Consume the transcoded frames by handler, in the order of input frames.
+    srs_error_t flush();
+    // Get the aac codec header, see SrsAudioTranscoder::aac_codec_header.
+    void aac_codec_header(uint8_t** data, int* len);
+};
+
+// The worker threads for audio transcoding, shared by all streams.
+class SrsAudioTranscodeWorkers : public ISrsFastTimer
+{
+private:
+    int nn_workers_;
+    // The max number of frames in queue of a stream, drop the frame if exceed.
+    int max_queue_;
+private:
+    SrsThreadMutex* lock_;
+    // To wakeup the workers for new frames, and notify the stopping thread for worker quit.
+    SrsThreadCond* cond_;
+    // Whether stopping, the workers quit after the transcoding frame is done.
+    bool stopping_;
+    // The number of running workers, to wait for all workers quit.
+    int nn_running_;
+    // The queues to transcode by workers, and the queues have transcoded frames to consume.
+    std::deque<SrsAudioTranscodeQueue*> ready_;
+    std::deque<SrsAudioTranscodeQueue*> done_;
+public:
+    SrsAudioTranscodeWorkers();
+    virtual ~SrsAudioTranscodeWorkers();
+public:
+    // Start the worker threads, disabled if workers is 0.
+    srs_error_t initialize(int workers, int max_queue);
+    bool enabled();
+    // Stop and wait for all worker threads to quit.
+    // @remark The left frames are not transcoded, and freed with the queue by owner.
+    void stop();
+public:
+    // Create the queue of stream, and free the queue when owner is freed.
+    SrsAudioTranscodeQueue* attach(SrsAsyncAudioTranscoder* owner, SrsAudioTranscoder* codec);
+    void detach(SrsAudioTranscodeQueue* queue);
+    // Push the task to transcode, return false if queue is full and the task is not consumed.
+    bool push(SrsAudioTranscodeQueue* queue, SrsAudioTranscodeTask* task);
+    // Fetch the transcoded tasks of stream.
+    void fetch(SrsAudioTranscodeQueue* queue, std::vector<SrsAudioTranscodeTask*>& tasks);
+private:
+    static srs_error_t start(void* arg);
+    void cycle();
+    // Wait for a task to transcode, return false if stopping and the worker should quit.
+    bool wait_task(SrsAudioTranscodeQueue** pqueue, SrsAudioTranscodeTask** ptask);
+    // Transcode the task of queue, then notify the owner to consume it, or free the queue if detached.
+    void do_transcode(SrsAudioTranscodeQueue* queue, SrsAudioTranscodeTask* task);
+// Interface ISrsFastTimer
+private:
+    srs_error_t on_timer(srs_utime_t interval);
+};
+
+// It MUST be thread-safe, global and shared object.
+extern SrsAudioTranscodeWorkers* _srs_audio_transcode_workers;
+
 #endif /* SRS_APP_AUDIO_RECODE_HPP */
 
@@ -69,6 +69,9 @@ extern SrsPps* _srs_pps_rnack2;
 extern SrsPps* _srs_pps_pub;
 extern SrsPps* _srs_pps_conn;
 
+// The window to coalesce the PLI of the same ssrc, when many players join at the same time.
+#define SRS_RTC_PLI_COALESCE (500 * SRS_UTIME_MILLISECONDS)
+
 ISrsRtcTransport::ISrsRtcTransport()
 {
 }
@@ -415,6 +418,12 @@ std::string SrsRtcAsyncCallOnStop::to_string()
     return std::string("");
 }
 
+std::string SrsRtcAsyncCallOnStop::destination()
+{
+    SrsConfDirective* conf = _srs_config->get_vhost_on_stop(req->vhost);
+    return conf ? srs_join_vector_string(conf->args, ",") : "";
+}
+
 SrsRtcPlayStream::SrsRtcPlayStream(SrsRtcConnection* s, const SrsContextId& cid) : source_(new SrsRtcSource())
 {
     cid_ = cid;
@@ -504,8 +513,9 @@ srs_error_t SrsRtcPlayStream::initialize(SrsRequest* req, std::map<uint32_t, Srs
     }
 
     // TODO: FIXME: Support reload.
-    nack_enabled_ = _srs_config->get_rtc_nack_enabled(req->vhost);
-    nack_no_copy_ = _srs_config->get_rtc_nack_no_copy(req->vhost);
+    SrsSharedPtr<SrsVhostConfig> conf = _srs_config->get_vhost_snapshot(req->vhost);
+    nack_enabled_ = conf->rtc_nack;
+    nack_no_copy_ = conf->rtc_nack_no_copy;
     srs_trace("RTC player nack=%d, nnc=%d", nack_enabled_, nack_no_copy_);
 
     // Setup tracks.
@@ -585,8 +595,9 @@ srs_error_t SrsRtcPlayStream::on_reload_vhost_play(string vhost)
         return srs_success;
     }
 
-    realtime = _srs_config->get_realtime_enabled(req_->vhost, true);
-    mw_msgs = _srs_config->get_mw_msgs(req_->vhost, realtime, true);
+    SrsSharedPtr<SrsVhostConfig> conf = _srs_config->get_vhost_snapshot(req_->vhost);
+    realtime = conf->rtc_realtime;
+    mw_msgs = conf->rtc_mw_msgs;
 
     srs_trace("Reload play realtime=%d, mw_msgs=%d", realtime, mw_msgs);
 
@@ -654,13 +665,14 @@ srs_error_t SrsRtcPlayStream::cycle()
 
     consumer->set_handler(this);
 
-    // TODO: FIXME: Dumps the SPS/PPS from gop cache, without other frames.
+    // Dumps the RTP packets from the last keyframe, if gop cache enabled.
     if ((err = source->consumer_dumps(consumer.get())) != srs_success) {
         return srs_error_wrap(err, "dumps consumer, url=%s", req_->get_stream_url().c_str());
     }
 
-    realtime = _srs_config->get_realtime_enabled(req_->vhost, true);
-    mw_msgs = _srs_config->get_mw_msgs(req_->vhost, realtime, true);
+    SrsSharedPtr<SrsVhostConfig> conf = _srs_config->get_vhost_snapshot(req_->vhost);
+    realtime = conf->rtc_realtime;
+    mw_msgs = conf->rtc_mw_msgs;
 
     // TODO: FIXME: Add cost in ms.
     SrsContextId cid = source->source_id();
@@ -995,12 +1007,9 @@ srs_error_t SrsRtcPublishTwccTimer::on_timer(srs_utime_t interval)
 
     ++_srs_pps_pub->sugar;
 
-    if (!p_->is_started) {
-        return err;
-    }
-
-    // For TWCC feedback.
-    if (!p_->twcc_enabled_) {
+    // For idle publisher without TWCC, check it later, to avoid waking up every tick.
+    if (!p_->is_started || !p_->twcc_enabled_) {
+        _srs_hybrid->timer100ms()->schedule(this, 1 * SRS_UTIME_SECONDS);
         return err;
     }
 
@@ -1073,6 +1082,12 @@ std::string SrsRtcAsyncCallOnUnpublish::to_string()
     return std::string("");
 }
 
+std::string SrsRtcAsyncCallOnUnpublish::destination()
+{
+    SrsConfDirective* conf = _srs_config->get_vhost_on_unpublish(req->vhost);
+    return conf ? srs_join_vector_string(conf->args, ",") : "";
+}
+
 SrsRtcPublishStream::SrsRtcPublishStream(SrsRtcConnection* session, const SrsContextId& cid) : source_(new SrsRtcSource())
 {
     cid_ = cid;
@@ -1172,10 +1187,11 @@ srs_error_t SrsRtcPublishStream::initialize(SrsRequest* r, SrsRtcSourceDescripti
         rtcp_twcc_.set_media_ssrc(media_ssrc);
     }
 
-    nack_enabled_ = _srs_config->get_rtc_nack_enabled(req_->vhost);
-    nack_no_copy_ = _srs_config->get_rtc_nack_no_copy(req_->vhost);
+    SrsSharedPtr<SrsVhostConfig> conf = _srs_config->get_vhost_snapshot(req_->vhost);
+    nack_enabled_ = conf->rtc_nack;
+    nack_no_copy_ = conf->rtc_nack_no_copy;
     pt_to_drop_ = (uint16_t)_srs_config->get_rtc_drop_for_pt(req_->vhost);
-    twcc_enabled_ = _srs_config->get_rtc_twcc_enabled(req_->vhost);
+    twcc_enabled_ = conf->rtc_twcc;
 
     // No TWCC when negotiate, disable it.
     if (twcc_id <= 0) {
@@ -1268,6 +1284,9 @@ srs_error_t SrsRtcPublishStream::start()
 
     is_started = true;
 
+    // The TWCC timer might be deferred when idle, so wake it up at the next tick.
+    _srs_hybrid->timer100ms()->schedule(timer_twcc_, 0);
+
     return err;
 }
 
@@ -1665,6 +1684,15 @@ void SrsRtcPublishStream::request_keyframe(uint32_t ssrc, SrsContextId cid)
 srs_error_t SrsRtcPublishStream::do_request_keyframe(uint32_t ssrc, SrsContextId sub_cid)
 {
     srs_error_t err = srs_success;
+
+    // Coalesce the PLI in a short window, because the keyframe is sent to all players.
+    srs_utime_t now = srs_get_system_time();
+    std::map<uint32_t, srs_utime_t>::iterator it = pli_last_sent_.find(ssrc);
+    if (it != pli_last_sent_.end() && now - it->second < SRS_RTC_PLI_COALESCE) {
+        return err;
+    }
+    pli_last_sent_[ssrc] = now;
+
     if ((err = session_->send_rtcp_fb_pli(ssrc, sub_cid)) != srs_success) {
         srs_warn("PLI err %s", srs_error_desc(err).c_str());
         srs_freep(err);
@@ -1751,7 +1779,9 @@ srs_error_t SrsRtcConnectionNackTimer::on_timer(srs_utime_t interval)
 {
     srs_error_t err = srs_success;
 
-    if (!p_->nack_enabled_) {
+    // For idle connection without NACK or publisher, check it later, to avoid waking up every tick.
+    if (!p_->nack_enabled_ || p_->publishers_.empty()) {
+        _srs_hybrid->timer20ms()->schedule(this, 1 * SRS_UTIME_SECONDS);
         return err;
     }
 
@@ -3484,6 +3514,9 @@ srs_error_t SrsRtcConnection::create_publisher(SrsRequest* req, SrsRtcSourceDesc
     }
     publishers_[req->get_stream_url()] = publisher;
 
+    // The NACK timer might be deferred when no publisher, so wake it up at the next tick.
+    _srs_hybrid->timer20ms()->schedule(timer_nack_, 0);
+
     if(NULL != stream_desc->audio_track_desc_) {
         if(publishers_ssrc_map_.end() != publishers_ssrc_map_.find(stream_desc->audio_track_desc_->ssrc_)) {
             return srs_error_new(ERROR_RTC_DUPLICATED_SSRC, " duplicate ssrc %d, track id: %s",
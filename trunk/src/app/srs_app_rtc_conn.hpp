@@ -205,6 +205,7 @@ public:
 public:
     virtual srs_error_t call();
     virtual std::string to_string();
+    virtual std::string destination();
 };
 
 // A RTC play stream, client pull and play stream from SRS.
@@ -316,6 +317,7 @@ public:
 public:
     virtual srs_error_t call();
     virtual std::string to_string();
+    virtual std::string destination();
 };
 
 // A RTC publish stream, client push and publish stream to SRS.
@@ -342,6 +344,8 @@ private:
 private:
     bool request_keyframe_;
     SrsErrorPithyPrint* pli_epp;
+    // The last time to send PLI for each ssrc, to coalesce the PLI from many players.
+    std::map<uint32_t, srs_utime_t> pli_last_sent_;
 private:
     SrsRequest* req_;
     SrsSharedPtr<SrsRtcSource> source_;
@@ -130,6 +130,11 @@ SrsRtpPacket* SrsRtpRingBuffer::at(uint16_t seq) {
     return queue_[seq % capacity_];
 }
 
+uint16_t SrsRtpRingBuffer::capacity()
+{
+    return capacity_;
+}
+
 void SrsRtpRingBuffer::notify_nack_list_full()
 {
     clear_all_histroy();
@@ -192,7 +197,8 @@ SrsNackOption::SrsNackOption()
 
 SrsRtpNackInfo::SrsRtpNackInfo()
 {
-    generate_time_ = srs_update_system_time();
+    // Set by the nack list when inserted, to avoid updating system time for each seq.
+    generate_time_ = 0;
     pre_req_nack_time_ = 0;
     req_nack_count_ = 0;
 }
@@ -204,12 +210,30 @@ SrsRtpNackForReceiver::SrsRtpNackForReceiver(SrsRtpRingBuffer* rtp, size_t queue
     pre_check_time_ = 0;
     rtt_ = 0;
 
-    srs_info("max_queue_size=%u, nack opt: max_count=%d, max_alive_time=%us, first_nack_interval=%" PRId64 ", nack_interval=%" PRId64,
-        max_queue_size_, opts_.max_count, opts_.max_alive_time, opts_.first_nack_interval, opts_.nack_interval);
+    // Share the window of ring buffer, round up to power of 2 and bitmap word.
+    int capacity = 64;
+    while (capacity < rtp->capacity() && capacity < 32768) {
+        capacity <<= 1;
+    }
+    capacity_ = (uint16_t)capacity;
+    mask_ = capacity_ - 1;
+
+    bitmap_ = new uint64_t[capacity_ / 64];
+    memset(bitmap_, 0, sizeof(uint64_t) * (capacity_ / 64));
+    infos_ = new SrsRtpNackInfo[capacity_];
+
+    size_ = 0;
+    head_ = tail_ = 0;
+    nn_dropped_ = 0;
+
+    srs_info("max_queue_size=%u, capacity=%u, nack opt: max_count=%d, max_alive_time=%us, first_nack_interval=%" PRId64 ", nack_interval=%" PRId64,
+        max_queue_size_, capacity_, opts_.max_count, opts_.max_alive_time, opts_.first_nack_interval, opts_.nack_interval);
 }
 
 SrsRtpNackForReceiver::~SrsRtpNackForReceiver()
 {
+    srs_freepa(bitmap_);
+    srs_freepa(infos_);
 }
 
 void SrsRtpNackForReceiver::insert(uint16_t first, uint16_t last)
@@ -220,40 +244,133 @@ void SrsRtpNackForReceiver::insert(uint16_t first, uint16_t last)
         return;
     }
 
+    // The older seqs are out of window, drop them like timeout, after the older ones in window.
+    if ((uint16_t)(last - first) > capacity_) {
+        uint16_t head = last - capacity_;
+        evict(head);
+
+        nn_dropped_ += (uint16_t)(head - first);
+        rtp_->notify_drop_seq(head - 1);
+        first = head;
+    }
+
+    srs_utime_t now = srs_update_system_time();
     for (uint16_t s = first; s != last; ++s) {
-        queue_[s] = SrsRtpNackInfo();
+        set(s, now);
     }
 }
 
 void SrsRtpNackForReceiver::remove(uint16_t seq)
 {
-    queue_.erase(seq);
+    if (find(seq)) {
+        erase(seq);
+    }
 }
 
 SrsRtpNackInfo* SrsRtpNackForReceiver::find(uint16_t seq)
 {
-    std::map<uint16_t, SrsRtpNackInfo>::iterator iter = queue_.find(seq);
+    // Only the seq in window is in the list, because different seqs may share the same slot.
+    if (!size_ || (uint16_t)(seq - head_) >= (uint16_t)(tail_ - head_)) {
+        return NULL;
+    }
 
-    if (iter == queue_.end()) {
+    uint16_t slot = seq & mask_;
+    if ((bitmap_[slot >> 6] & (1ULL << (slot & 63))) == 0) {
         return NULL;
     }
 
-    return &(iter->second);
+    return &infos_[slot];
 }
 
 void SrsRtpNackForReceiver::check_queue_size()
 {
-    if (queue_.size() >= max_queue_size_) {
+    if (size_ >= max_queue_size_) {
         rtp_->notify_nack_list_full();
-        queue_.clear();
+        clear();
+    }
+}
+
+size_t SrsRtpNackForReceiver::size()
+{
+    return size_;
+}
+
+void SrsRtpNackForReceiver::set(uint16_t seq, srs_utime_t now)
+{
+    if (!size_) {
+        head_ = seq;
+        tail_ = seq + 1;
+    } else if (srs_rtp_seq_distance(tail_, seq) >= 0) {
+        // Newer than the window, move forward and drop the seqs out of window.
+        evict(seq + 1 - capacity_);
+        if (!size_) {
+            head_ = seq;
+        }
+        tail_ = seq + 1;
+    } else if (srs_rtp_seq_distance(seq, head_) > 0) {
+        // Older than the window, ignore it if the window could not cover it.
+        if ((uint16_t)(tail_ - seq) > capacity_) {
+            return;
+        }
+        head_ = seq;
     }
+
+    uint16_t slot = seq & mask_;
+    uint64_t& word = bitmap_[slot >> 6];
+    uint64_t bit = 1ULL << (slot & 63);
+    if ((word & bit) == 0) {
+        word |= bit;
+        size_++;
+    }
+
+    SrsRtpNackInfo& info = infos_[slot];
+    info.generate_time_ = now;
+    info.pre_req_nack_time_ = 0;
+    info.req_nack_count_ = 0;
+}
+
+void SrsRtpNackForReceiver::evict(uint16_t head)
+{
+    if (!size_ || srs_rtp_seq_distance(head_, head) <= 0) {
+        return;
+    }
+
+    // Drop in seq order, because the ring buffer advances to the dropped seq.
+    uint16_t end = (srs_rtp_seq_distance(tail_, head) > 0) ? tail_ : head;
+    for (uint16_t s = head_; s != end && size_; ++s) {
+        if (find(s)) {
+            ++nn_dropped_;
+            rtp_->notify_drop_seq(s);
+            erase(s);
+        }
+    }
+
+    head_ = head;
+}
+
+void SrsRtpNackForReceiver::erase(uint16_t seq)
+{
+    uint16_t slot = seq & mask_;
+    bitmap_[slot >> 6] &= ~(1ULL << (slot & 63));
+    size_--;
+}
+
+void SrsRtpNackForReceiver::clear()
+{
+    memset(bitmap_, 0, sizeof(uint64_t) * (capacity_ / 64));
+    size_ = 0;
+    head_ = tail_ = 0;
 }
 
 void SrsRtpNackForReceiver::get_nack_seqs(SrsRtcpNack& seqs, uint32_t& timeout_nacks)
 {
+    // The seqs dropped out of window, are also timeout.
+    timeout_nacks += nn_dropped_;
+    nn_dropped_ = 0;
+
     // If circuit-breaker is enabled, disable nack.
     if (_srs_circuit_breaker->hybrid_high_water_level()) {
-        queue_.clear();
+        clear();
         ++_srs_pps_snack4->sugar;
         return;
     }
@@ -266,37 +383,60 @@ void SrsRtpNackForReceiver::get_nack_seqs(SrsRtcpNack& seqs, uint32_t& timeout_n
     }
     pre_check_time_ = now;
 
-    std::map<uint16_t, SrsRtpNackInfo>::iterator iter = queue_.begin();
-    while (iter != queue_.end()) {
-        const uint16_t& seq = iter->first;
-        SrsRtpNackInfo& nack_info = iter->second;
+    if (!size_) {
+        return;
+    }
+
+    srs_utime_t nack_interval = srs_max(opts_.min_nack_interval, opts_.nack_interval / 3);
+    if(opts_.nack_interval < 50 * SRS_UTIME_MILLISECONDS){
+        nack_interval = srs_max(opts_.min_nack_interval, opts_.nack_interval);
+    }
+
+    // Walk the window in seq order, skip the empty bits of word.
+    uint16_t first = tail_;
+    uint16_t nn = tail_ - head_;
+    for (uint16_t offset = 0; offset < nn;) {
+        uint16_t slot = (head_ + offset) & mask_;
+        uint64_t word = bitmap_[slot >> 6] >> (slot & 63);
+        if (!word) {
+            offset += 64 - (slot & 63);
+            continue;
+        }
+
+        offset += __builtin_ctzll(word);
+        if (offset >= nn) {
+            break;
+        }
+
+        uint16_t seq = head_ + offset++;
+        SrsRtpNackInfo& nack_info = infos_[seq & mask_];
 
         int alive_time = now - nack_info.generate_time_;
         if (alive_time > opts_.max_alive_time || nack_info.req_nack_count_ > opts_.max_count) {
             ++timeout_nacks;
             rtp_->notify_drop_seq(seq);
-            queue_.erase(iter++);
+            erase(seq);
             continue;
         }
 
+        if (first == tail_) {
+            first = seq;
+        }
+
         // TODO:Statistics unorder packet.
         if (now - nack_info.generate_time_ < opts_.first_nack_interval) {
             break;
         }
 
-        srs_utime_t nack_interval = srs_max(opts_.min_nack_interval, opts_.nack_interval / 3);
-        if(opts_.nack_interval < 50 * SRS_UTIME_MILLISECONDS){
-            nack_interval = srs_max(opts_.min_nack_interval, opts_.nack_interval);
-        }
-
         if (now - nack_info.pre_req_nack_time_ >= nack_interval ) {
             ++nack_info.req_nack_count_;
             nack_info.pre_req_nack_time_ = now;
             seqs.add_lost_sn(seq);
         }
-
-        ++iter;
     }
+
+    // Shrink the window to the oldest seq in list.
+    head_ = first;
 }
 
 void SrsRtpNackForReceiver::update_rtt(int rtt)
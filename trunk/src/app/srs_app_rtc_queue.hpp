@@ -66,6 +66,8 @@ public:
     bool update(uint16_t seq, uint16_t& nack_first, uint16_t& nack_last);
     // Get the packet by seq.
     SrsRtpPacket* at(uint16_t seq);
+    // Get the capacity of ring buffer.
+    uint16_t capacity();
 public:
     // TODO: FIXME: Refine it?
     void notify_nack_list_full();
@@ -101,11 +103,26 @@ struct SrsRtpNackInfo
     SrsRtpNackInfo();
 };
 
+// The nack list of receiver, which is a bitmap indexed by sequence, shares the window of ring buffer.
+// A seq is stored in slot (seq & mask_), and all seqs in list are in window [head_, tail_), so we
+// walk the bitmap from head_ in seq order, word by word, to generate the NACK.
 class SrsRtpNackForReceiver
 {
 private:
-    // Nack queue, seq order, oldest to newest.
-    std::map<uint16_t, SrsRtpNackInfo, SrsSeqCompareLess> queue_;
+    // The bitmap of slots, the bit is set if the seq in slot is in nack list.
+    uint64_t* bitmap_;
+    // The nack state of each slot, valid only when the bit is set.
+    SrsRtpNackInfo* infos_;
+    // The number of slots, power of 2 and not less than the ring buffer, at least 64.
+    uint16_t capacity_;
+    uint16_t mask_;
+    // The number of seqs in nack list.
+    size_t size_;
+    // The window of nack list, the oldest seq is not before head_, and the newest is before tail_.
+    uint16_t head_;
+    uint16_t tail_;
+    // The number of seqs dropped out of window, counted as timeout nacks when get nack seqs.
+    uint32_t nn_dropped_;
     // Max nack count.
     size_t max_queue_size_;
     SrsRtpRingBuffer* rtp_;
@@ -122,6 +139,14 @@ public:
     void remove(uint16_t seq);
     SrsRtpNackInfo* find(uint16_t seq);
     void check_queue_size();
+    // Get the number of seqs in nack list.
+    size_t size();
+private:
+    void set(uint16_t seq, srs_utime_t now);
+    // Drop the seqs older than head out of window, and notify the ring buffer like timeout.
+    void evict(uint16_t head);
+    void erase(uint16_t seq);
+    void clear();
 public:
     void get_nack_seqs(SrsRtcpNack& seqs, uint32_t& timeout_nacks);
 public:
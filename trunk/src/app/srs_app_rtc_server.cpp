@@ -30,6 +30,10 @@ using namespace std;
 #include <srs_protocol_utility.hpp>
 #include <srs_protocol_log.hpp>
 #include <srs_app_rtc_network.hpp>
+#include <srs_app_threads.hpp>
+#ifdef SRS_FFMPEG_FIT
+#include <srs_app_rtc_codec.hpp>
+#endif
 
 extern SrsPps* _srs_pps_rpkts;
 SrsPps* _srs_pps_rstuns = NULL;
@@ -319,7 +323,20 @@ srs_error_t SrsRtcServer::initialize()
         return srs_error_wrap(err, "black hole");
     }
 
-    async->start();
+#ifdef SRS_FFMPEG_FIT
+    // Start the workers to transcode audio for RTMP and WebRTC bridge.
+    int workers = _srs_config->get_threads_audio_transcoders();
+    int max_queue = _srs_config->get_threads_audio_queue();
+    if ((err = _srs_audio_transcode_workers->initialize(workers, max_queue)) != srs_success) {
+        return srs_error_wrap(err, "audio transcode workers");
+    }
+#endif
+
+    // Start the async worker for RTC callbacks, with N executors to call them concurrently.
+    async->set_executors(_srs_config->get_async_call_executors());
+    if ((err = async->start()) != srs_success) {
+        return srs_error_wrap(err, "async worker");
+    }
 
     return err;
 }
@@ -511,6 +528,11 @@ srs_error_t SrsRtcServer::create_session(SrsRtcUserConfig* ruc, SrsSdp& local_sd
         return srs_error_new(ERROR_RTC_SOURCE_BUSY, "stream %s busy", req->get_stream_url().c_str());
     }
 
+    // Reject new player when overloaded, to keep the publishers and existing players.
+    if (!ruc->publish_ && _srs_circuit_breaker->should_reject_player(req->vhost)) {
+        return srs_error_new(ERROR_SYSTEM_OVERLOAD, "reject player of %s for overloaded", req->vhost.c_str());
+    }
+
     // TODO: FIXME: add do_create_session to error process.
     SrsRtcConnection* session = new SrsRtcConnection(this, cid);
     if ((err = do_create_session(ruc, local_sdp, session)) != srs_success) {
@@ -388,6 +388,11 @@ SrsRtcSource::SrsRtcSource()
 
     pli_for_rtmp_ = pli_elapsed_ = 0;
     stream_die_at_ = 0;
+
+    gop_cache_enabled_ = false;
+    gop_cache_max_size_ = gop_cache_size_ = 0;
+    gop_cache_ts_ = 0;
+    clear_gop_cache();
 }
 
 SrsRtcSource::~SrsRtcSource()
@@ -396,6 +401,8 @@ SrsRtcSource::~SrsRtcSource()
     // for all consumers are auto free.
     consumers.clear();
 
+    clear_gop_cache();
+
 #ifdef SRS_FFMPEG_FIT
     srs_freep(frame_builder_);
 #endif
@@ -565,8 +572,21 @@ srs_error_t SrsRtcSource::consumer_dumps(SrsRtcConsumer* consumer, bool ds, bool
 {
     srs_error_t err = srs_success;
 
-    // print status.
-    srs_trace("create consumer, no gop cache");
+    if (!dg || gop_cache_.empty()) {
+        srs_trace("create consumer, no gop cache");
+        return err;
+    }
+
+    // Prime the consumer from the last keyframe, so it starts without waiting for PLI.
+    std::vector<SrsRtpPacket*>::iterator it;
+    for (it = gop_cache_.begin(); it != gop_cache_.end(); ++it) {
+        SrsRtpPacket* pkt = *it;
+        if ((err = consumer->enqueue(pkt->copy())) != srs_success) {
+            return srs_error_wrap(err, "consume gop cache");
+        }
+    }
+
+    srs_trace("create consumer, dispatch gop cache, count=%d, size=%d", (int)gop_cache_.size(), gop_cache_size_);
 
     return err;
 }
@@ -618,6 +638,10 @@ srs_error_t SrsRtcSource::on_publish()
     is_created_ = true;
     is_delivering_packets_ = true;
 
+    gop_cache_enabled_ = _srs_config->get_rtc_gop_cache(req->vhost);
+    gop_cache_max_size_ = _srs_config->get_rtc_gop_cache_max_size(req->vhost) * 1024;
+    clear_gop_cache();
+
     // Notify the consumers about stream change event.
     if ((err = on_source_changed()) != srs_success) {
         return srs_error_wrap(err, "source id change");
@@ -664,6 +688,9 @@ void SrsRtcSource::on_unpublish()
     is_created_ = false;
     is_delivering_packets_ = false;
 
+    // Drop the cached packets of this publisher, which should never be delivered to new players.
+    clear_gop_cache();
+
     if (!_source_id.empty()) {
         _pre_source_id = _source_id;
     }
@@ -733,6 +760,10 @@ srs_error_t SrsRtcSource::on_rtp(SrsRtpPacket* pkt)
         return err;
     }
 
+    if (gop_cache_enabled_) {
+        cache_rtp(pkt);
+    }
+
     for (int i = 0; i < (int)consumers.size(); i++) {
         SrsRtcConsumer* consumer = consumers.at(i);
         if ((err = consumer->enqueue(pkt->copy())) != srs_success) {
@@ -749,6 +780,41 @@ srs_error_t SrsRtcSource::on_rtp(SrsRtpPacket* pkt)
     return err;
 }
 
+void SrsRtcSource::cache_rtp(SrsRtpPacket* pkt)
+{
+    // Restart the cache when got a new keyframe, note that the SPS/PPS and IDR are the same timestamp.
+    uint32_t ts = pkt->header.get_timestamp();
+    if (pkt->is_keyframe()) {
+        if (gop_cache_.empty() || ts != gop_cache_ts_) {
+            clear_gop_cache();
+            gop_cache_ts_ = ts;
+        }
+    } else if (gop_cache_.empty()) {
+        // Ignore the packets before the first keyframe.
+        return;
+    }
+
+    SrsRtpPacket* copy = pkt->copy();
+    gop_cache_.push_back(copy);
+    gop_cache_size_ += (int)copy->nb_bytes();
+
+    if (gop_cache_max_size_ > 0 && gop_cache_size_ > gop_cache_max_size_) {
+        srs_warn("RTC: gop cache exceed max size=%d, count=%d", gop_cache_max_size_, (int)gop_cache_.size());
+        clear_gop_cache();
+    }
+}
+
+void SrsRtcSource::clear_gop_cache()
+{
+    std::vector<SrsRtpPacket*>::iterator it;
+    for (it = gop_cache_.begin(); it != gop_cache_.end(); ++it) {
+        SrsRtpPacket* pkt = *it;
+        srs_freep(pkt);
+    }
+    gop_cache_.clear();
+    gop_cache_size_ = 0;
+}
+
 bool SrsRtcSource::has_stream_desc()
 {
     return stream_desc_;
@@ -826,7 +892,7 @@ SrsRtcRtpBuilder::SrsRtcRtpBuilder(SrsFrameToRtcBridge* bridge, uint32_t assrc,
     req = NULL;
     bridge_ = bridge;
     format = new SrsRtmpFormat();
-    codec_ = new SrsAudioTranscoder();
+    codec_ = new SrsAsyncAudioTranscoder(this);
     latest_codec_ = SrsAudioCodecIdForbidden;
     keep_bframe = false;
     keep_avc_nalu_sei = true;
@@ -908,11 +974,6 @@ srs_error_t SrsRtcRtpBuilder::on_audio(SrsSharedPtrMessage* msg)
         return srs_error_wrap(err, "format consume audio");
     }
 
-    // Try to init codec when startup or codec changed.
-    if (format->acodec && (err = init_codec(format->acodec->id)) != srs_success) {
-        return srs_error_wrap(err, "init codec");
-    }
-
     // Ignore if no format->acodec, it means the codec is not parsed, or unknown codec.
     // @issue https://github.com/ossrs/srs/issues/1506#issuecomment-562079474
     if (!format->acodec) {
@@ -925,6 +986,11 @@ srs_error_t SrsRtcRtpBuilder::on_audio(SrsSharedPtrMessage* msg)
         return err;
     }
 
+    // Try to init codec when startup or codec changed.
+    if ((err = init_codec(acodec)) != srs_success) {
+        return srs_error_wrap(err, "init codec");
+    }
+
     // ignore sequence header
     srs_assert(format->audio);
 
@@ -970,7 +1036,7 @@ srs_error_t SrsRtcRtpBuilder::init_codec(SrsAudioCodecId codec)
 
     // Create a new codec.
     srs_freep(codec_);
-    codec_ = new SrsAudioTranscoder();
+    codec_ = new SrsAsyncAudioTranscoder(this);
 
     // Initialize the codec according to the codec in stream.
     int bitrate = _srs_config->get_rtc_opus_bitrate(req->vhost);// The output bitrate in bps.
@@ -994,16 +1060,19 @@ srs_error_t SrsRtcRtpBuilder::transcode(SrsAudioFrame* audio)
 {
     srs_error_t err = srs_success;
 
-    std::vector<SrsAudioFrame*> out_audios;
-    if ((err = codec_->transcode(audio, out_audios)) != srs_success) {
+    // The transcoded frames are consumed by on_audio_transcoded.
+    if ((err = codec_->transcode(audio)) != srs_success) {
         return srs_error_wrap(err, "recode error");
     }
 
-    // Save OPUS packets in shared message.
-    if (out_audios.empty()) {
-        return err;
-    }
+    return err;
+}
 
+srs_error_t SrsRtcRtpBuilder::on_audio_transcoded(SrsAudioFrame* in, std::vector<SrsAudioFrame*>& out_audios)
+{
+    srs_error_t err = srs_success;
+
+    // Save OPUS packets in shared message.
     for (std::vector<SrsAudioFrame*>::iterator it = out_audios.begin(); it != out_audios.end(); ++it) {
         SrsAudioFrame* out_audio = *it;
         SrsUniquePtr<SrsRtpPacket> pkt(new SrsRtpPacket());
@@ -1019,8 +1088,6 @@ srs_error_t SrsRtcRtpBuilder::transcode(SrsAudioFrame* audio)
         }
     }
 
-    codec_->free_frames(out_audios);
-
     return err;
 }
 
@@ -1406,6 +1473,7 @@ SrsRtcFrameBuilder::SrsRtcFrameBuilder(ISrsStreamBridge* bridge)
     bridge_ = bridge;
     is_first_audio_ = true;
     codec_ = NULL;
+    keep_opus_ = false;
     header_sn_ = 0;
     memset(cache_video_pkts_, 0, sizeof(cache_video_pkts_));
     rtp_key_frame_ts_ = -1;
@@ -1426,7 +1494,15 @@ srs_error_t SrsRtcFrameBuilder::initialize(SrsRequest* r)
     srs_error_t err = srs_success;
 
     srs_freep(codec_);
-    codec_ = new SrsAudioTranscoder();
+
+    // Keep the Opus in enhanced RTMP, never transcode it.
+    keep_opus_ = _srs_config->get_rtc_keep_opus(r->vhost);
+    if (keep_opus_) {
+        srs_trace("RTC2RTMP: Keep opus audio in enhanced RTMP");
+        return err;
+    }
+
+    codec_ = new SrsAsyncAudioTranscoder(this);
 
     SrsAudioCodecId from = SrsAudioCodecIdOpus; // TODO: From SDP?
     SrsAudioCodecId to = SrsAudioCodecIdAAC; // The output audio codec.
@@ -1476,7 +1552,7 @@ srs_error_t SrsRtcFrameBuilder::on_rtp(SrsRtpPacket *pkt)
     }
 
     if (pkt->is_audio()) {
-        err = transcode_audio(pkt);
+        err = keep_opus_ ? passthrough_audio(pkt) : transcode_audio(pkt);
     } else {
         err = packet_video(pkt);
     }
@@ -1510,7 +1586,6 @@ srs_error_t SrsRtcFrameBuilder::transcode_audio(SrsRtpPacket *pkt)
         is_first_audio_ = false;
     }
 
-    std::vector<SrsAudioFrame*> out_pkts;
     SrsRtpRawPayload *payload = dynamic_cast<SrsRtpRawPayload*>(pkt->payload());
 
     SrsAudioFrame frame;
@@ -1518,15 +1593,21 @@ srs_error_t SrsRtcFrameBuilder::transcode_audio(SrsRtpPacket *pkt)
     frame.dts = ts;
     frame.cts = 0;
 
-    err = codec_->transcode(&frame, out_pkts);
-    if (err != srs_success) {
-        return err;
-    }
+    // The transcoded frames are consumed by on_audio_transcoded.
+    return codec_->transcode(&frame);
+}
+
+srs_error_t SrsRtcFrameBuilder::on_audio_transcoded(SrsAudioFrame* in, std::vector<SrsAudioFrame*>& out_pkts)
+{
+    srs_error_t err = srs_success;
+
+    // Use the timestamp of input RTP packet.
+    uint32_t ts = (uint32_t)in->dts;
 
     for (std::vector<SrsAudioFrame*>::iterator it = out_pkts.begin(); it != out_pkts.end(); ++it) {
         SrsCommonMessage out_rtmp;
         out_rtmp.header.timestamp = (*it)->dts;
-        packet_aac(&out_rtmp, (*it)->samples[0].bytes, (*it)->samples[0].size, ts, is_first_audio_);
+        packet_aac(&out_rtmp, (*it)->samples[0].bytes, (*it)->samples[0].size, ts, false);
 
         SrsSharedPtrMessage msg;
         if ((err = msg.create(&out_rtmp)) != srs_success) {
@@ -1538,7 +1619,63 @@ srs_error_t SrsRtcFrameBuilder::transcode_audio(SrsRtpPacket *pkt)
             break;
         }
     }
-    codec_->free_frames(out_pkts);
+
+    return err;
+}
+
+srs_error_t SrsRtcFrameBuilder::passthrough_audio(SrsRtpPacket *pkt)
+{
+    srs_error_t err = srs_success;
+
+    SrsRtpRawPayload *payload = dynamic_cast<SrsRtpRawPayload*>(pkt->payload());
+    if (!payload || payload->nn_payload <= 0) {
+        return err;
+    }
+
+    uint32_t ts = pkt->get_avsync_time();
+    if (is_first_audio_) {
+        // The channels is the stereo flag s of TOC, the first byte of Opus packet.
+        // See https://datatracker.ietf.org/doc/html/rfc6716#section-3.1
+        int channels = (payload->payload[0] & 0x04) ? 2 : 1;
+
+        // The OpusHead for 48KHz, without pre-skip and gain.
+        // See https://datatracker.ietf.org/doc/html/rfc7845#section-5.1
+        char header[19];
+        SrsBuffer stream(header, sizeof(header));
+        stream.write_string("OpusHead");
+        stream.write_1bytes(1); // Version.
+        stream.write_1bytes(channels); // Output channel count.
+        stream.write_le2bytes(0); // Pre-skip.
+        stream.write_le4bytes(48000); // Input sample rate.
+        stream.write_le2bytes(0); // Output gain.
+        stream.write_1bytes(0); // Channel mapping family.
+
+        SrsCommonMessage out_rtmp;
+        packet_opus(&out_rtmp, header, sizeof(header), ts, true);
+
+        SrsSharedPtrMessage msg;
+        if ((err = msg.create(&out_rtmp)) != srs_success) {
+            return srs_error_wrap(err, "create message");
+        }
+
+        if ((err = bridge_->on_frame(&msg)) != srs_success) {
+            return srs_error_wrap(err, "source on audio");
+        }
+
+        is_first_audio_ = false;
+    }
+
+    SrsCommonMessage out_rtmp;
+    packet_opus(&out_rtmp, payload->payload, payload->nn_payload, ts, false);
+
+    SrsSharedPtrMessage msg;
+    if ((err = msg.create(&out_rtmp)) != srs_success) {
+        return srs_error_wrap(err, "create message");
+    }
+
+    if ((err = bridge_->on_frame(&msg)) != srs_success) {
+        return srs_error_wrap(err, "source on audio");
+    }
 
     return err;
 }
@@ -1560,6 +1697,20 @@ void SrsRtcFrameBuilder::packet_aac(SrsCommonMessage* audio, char* data, int len
     audio->size = rtmp_len;
 }
 
+void SrsRtcFrameBuilder::packet_opus(SrsCommonMessage* audio, char* data, int len, uint32_t pts, bool is_header)
+{
+    // See https://github.com/veovera/enhanced-rtmp
+    int rtmp_len = len + 5;
+    audio->header.initialize_audio(rtmp_len, pts, 1);
+    audio->create_payload(rtmp_len);
+    SrsBuffer stream(audio->payload, rtmp_len);
+    SrsAudioPacketType packet_type = is_header ? SrsAudioPacketTypeSequenceStart : SrsAudioPacketTypeCodedFrames;
+    stream.write_1bytes((SrsAudioCodecIdExHeader << 4) | packet_type);
+    stream.write_4bytes(SRS_AUDIO_FOURCC_OPUS);
+    stream.write_bytes(data, len);
+    audio->size = rtmp_len;
+}
+
 srs_error_t SrsRtcFrameBuilder::packet_video(SrsRtpPacket* src)
 {
     srs_error_t err = srs_success;
@@ -23,6 +23,9 @@
 #include <srs_protocol_format.hpp>
 #include <srs_app_stream_bridge.hpp>
 #include <srs_core_autofree.hpp>
+#ifdef SRS_FFMPEG_FIT
+#include <srs_app_rtc_codec.hpp>
+#endif
 
 class SrsRequest;
 class SrsMetaCache;
@@ -31,7 +34,6 @@ class SrsCommonMessage;
 class SrsMessageArray;
 class SrsRtcSource;
 class SrsFrameToRtcBridge;
-class SrsAudioTranscoder;
 class SrsRtpPacket;
 class SrsSample;
 class SrsRtcSourceDescription;
@@ -202,6 +204,15 @@ private:
 private:
     // The last die time, while die means neither publishers nor players.
     srs_utime_t stream_die_at_;
+private:
+    // Whether cache the RTP packets from the last keyframe, for new players.
+    bool gop_cache_enabled_;
+    // The max bytes of gop cache, clear the cache when exceed it.
+    int gop_cache_max_size_;
+    int gop_cache_size_;
+    // The RTP timestamp of keyframe, the first packet of cache.
+    uint32_t gop_cache_ts_;
+    std::vector<SrsRtpPacket*> gop_cache_;
 public:
     SrsRtcSource();
     virtual ~SrsRtcSource();
@@ -253,6 +264,11 @@ public:
     void set_publish_stream(ISrsRtcPublishStream* v);
     // Consume the shared RTP packet, user must free it.
     srs_error_t on_rtp(SrsRtpPacket* pkt);
+private:
+    // Cache the RTP packet in gop cache, restart the cache when got a new keyframe.
+    void cache_rtp(SrsRtpPacket* pkt);
+    void clear_gop_cache();
+public:
     // Set and get stream description for souce
     bool has_stream_desc();
     void set_stream_desc(SrsRtcSourceDescription* stream_desc);
@@ -265,7 +281,7 @@ private:
 #ifdef SRS_FFMPEG_FIT
 
 // Convert AV frame to RTC RTP packets.
-class SrsRtcRtpBuilder
+class SrsRtcRtpBuilder : public ISrsAudioTranscodeHandler
 {
 private:
     SrsRequest* req;
@@ -276,7 +292,7 @@ private:
     SrsMetaCache* meta;
 private:
     SrsAudioCodecId latest_codec_;
-    SrsAudioTranscoder* codec_;
+    SrsAsyncAudioTranscoder* codec_;
     bool keep_bframe;
     bool keep_avc_nalu_sei;
     bool merge_nalus;
@@ -300,6 +316,10 @@ private:
 private:
     srs_error_t init_codec(SrsAudioCodecId codec);
     srs_error_t transcode(SrsAudioFrame* audio);
+// Interface ISrsAudioTranscodeHandler
+public:
+    virtual srs_error_t on_audio_transcoded(SrsAudioFrame* in, std::vector<SrsAudioFrame*>& outs);
+private:
     srs_error_t package_opus(SrsAudioFrame* audio, SrsRtpPacket* pkt);
 private:
     virtual srs_error_t on_video(SrsSharedPtrMessage* msg);
@@ -313,13 +333,15 @@ private:
 };
 
 // Collect and build WebRTC RTP packets to AV frames.
-class SrsRtcFrameBuilder
+class SrsRtcFrameBuilder : public ISrsAudioTranscodeHandler
 {
 private:
     ISrsStreamBridge* bridge_;
 private:
     bool is_first_audio_;
-    SrsAudioTranscoder *codec_;
+    SrsAsyncAudioTranscoder *codec_;
+    // Whether keep the Opus audio in enhanced RTMP, without transcoding to AAC.
+    bool keep_opus_;
 private:
     const static uint16_t s_cache_size = 512;
     //TODO:use SrsRtpRingBuffer
@@ -352,7 +374,13 @@ public:
     virtual srs_error_t on_rtp(SrsRtpPacket *pkt);
 private:
     srs_error_t transcode_audio(SrsRtpPacket *pkt);
+    srs_error_t passthrough_audio(SrsRtpPacket *pkt);
+// Interface ISrsAudioTranscodeHandler
+public:
+    virtual srs_error_t on_audio_transcoded(SrsAudioFrame* in, std::vector<SrsAudioFrame*>& outs);
+private:
     void packet_aac(SrsCommonMessage* audio, char* data, int len, uint32_t pts, bool is_header);
+    void packet_opus(SrsCommonMessage* audio, char* data, int len, uint32_t pts, bool is_header);
 private:
     srs_error_t packet_video(SrsRtpPacket* pkt);
     srs_error_t packet_video_key_frame(SrsRtpPacket* pkt);
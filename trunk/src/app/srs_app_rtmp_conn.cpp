@@ -40,6 +40,9 @@ using namespace std;
 #include <srs_app_rtc_source.hpp>
 #include <srs_app_tencentcloud.hpp>
 #include <srs_app_srt_source.hpp>
+#include <srs_app_coworkers.hpp>
+#include <srs_app_heartbeat.hpp>
+#include <srs_app_threads.hpp>
 
 // the timeout in srs_utime_t to wait encoder to republish
 // if timeout, close the connection.
@@ -309,17 +312,19 @@ srs_error_t SrsRtmpConn::on_reload_vhost_play(string vhost)
         return err;
     }
     
+    SrsSharedPtr<SrsVhostConfig> conf = _srs_config->get_vhost_snapshot(req->vhost);
+
     // send_min_interval
     if (true) {
-        srs_utime_t v = _srs_config->get_send_min_interval(vhost);
+        srs_utime_t v = conf->send_min_interval;
         if (v != send_min_interval) {
             srs_trace("apply smi %d=>%d ms", srsu2msi(send_min_interval), srsu2msi(v));
             send_min_interval = v;
         }
     }
 
-    mw_msgs = _srs_config->get_mw_msgs(req->vhost, realtime);
-    mw_sleep = _srs_config->get_mw_sleep(req->vhost);
+    mw_msgs = conf->mw_msgs;
+    mw_sleep = conf->mw_sleep;
     skt->set_socket_buffer(mw_sleep);
     
     return err;
@@ -350,14 +355,16 @@ srs_error_t SrsRtmpConn::on_reload_vhost_realtime(string vhost)
         return err;
     }
     
-    bool realtime_enabled = _srs_config->get_realtime_enabled(req->vhost);
+    SrsSharedPtr<SrsVhostConfig> conf = _srs_config->get_vhost_snapshot(req->vhost);
+
+    bool realtime_enabled = conf->realtime;
     if (realtime_enabled != realtime) {
         srs_trace("realtime changed %d=>%d", realtime, realtime_enabled);
         realtime = realtime_enabled;
     }
 
-    mw_msgs = _srs_config->get_mw_msgs(req->vhost, realtime);
-    mw_sleep = _srs_config->get_mw_sleep(req->vhost);
+    mw_msgs = conf->mw_msgs;
+    mw_sleep = conf->mw_sleep;
     skt->set_socket_buffer(mw_sleep);
     
     return err;
@@ -546,7 +553,7 @@ srs_error_t SrsRtmpConn::stream_service_cycle()
     // do token traverse before serve it.
     // @see https://github.com/ossrs/srs/pull/239
     if (true) {
-        info->edge = _srs_config->get_vhost_is_edge(req->vhost);
+        info->edge = _srs_config->get_vhost_snapshot(req->vhost)->is_edge;
         bool edge_traverse = _srs_config->get_vhost_edge_token_traverse(req->vhost);
         if (info->edge && edge_traverse) {
             if ((err = check_edge_token_traverse_auth()) != srs_success) {
@@ -566,6 +573,26 @@ srs_error_t SrsRtmpConn::stream_service_cycle()
         return srs_error_new(ERROR_RTMP_STREAM_NAME_EMPTY, "rtmp: empty stream");
     }
 
+    // Redirect to the less-loaded peer, when this node is overloaded.
+    SrsLoadReport* peer = _srs_load_redirect->select(srs_client_type_is_publish(info->type));
+    if (peer && peer->rtmp_port) {
+        string rurl = srs_generate_rtmp_url(peer->ip, peer->rtmp_port, req->host, req->vhost, req->app, req->stream, req->param);
+        srs_trace("rtmp: redirect for overloaded, target=%s:%d, load=%d%%, rurl=%s",
+            peer->ip.c_str(), peer->rtmp_port, peer->load, rurl.c_str());
+
+        bool accepted = false;
+        if ((err = rtmp->redirect(req, rurl, accepted)) != srs_success) {
+            srs_error_reset(err);
+        } else {
+            return srs_error_new(ERROR_CONTROL_REDIRECT, "redirected");
+        }
+    }
+
+    // Reject new player when overloaded, to keep the publishers and existing players.
+    if (!srs_client_type_is_publish(info->type) && _srs_circuit_breaker->should_reject_player(req->vhost)) {
+        return srs_error_new(ERROR_SYSTEM_OVERLOAD, "rtmp: reject player of %s for overloaded", req->vhost.c_str());
+    }
+
     // client is identified, set the timeout to service timeout.
     rtmp->set_recv_timeout(SRS_CONSTS_RTMP_TIMEOUT);
     rtmp->set_send_timeout(SRS_CONSTS_RTMP_TIMEOUT);
@@ -577,8 +604,9 @@ srs_error_t SrsRtmpConn::stream_service_cycle()
     }
     srs_assert(live_source.get() != NULL);
 
-    bool enabled_cache = _srs_config->get_gop_cache(req->vhost);
-    int gcmf = _srs_config->get_gop_cache_max_frames(req->vhost);
+    SrsSharedPtr<SrsVhostConfig> conf = _srs_config->get_vhost_snapshot(req->vhost);
+    bool enabled_cache = conf->gop_cache;
+    int gcmf = conf->gop_cache_max_frames;
     srs_trace("source url=%s, ip=%s, cache=%d/%d, is_edge=%d, source_id=%s/%s",
         req->get_stream_url().c_str(), ip.c_str(), enabled_cache, gcmf, info->edge, live_source->source_id().c_str(),
               live_source->pre_source_id().c_str());
@@ -677,7 +705,7 @@ srs_error_t SrsRtmpConn::check_vhost(bool try_default_vhost)
         return srs_error_new(ERROR_RTMP_VHOST_NOT_FOUND, "rtmp: no vhost %s", req->vhost.c_str());
     }
     
-    if (!_srs_config->get_vhost_enabled(req->vhost)) {
+    if (!_srs_config->get_vhost_snapshot(req->vhost)->enabled) {
         return srs_error_new(ERROR_RTMP_VHOST_NOT_FOUND, "rtmp: vhost %s disabled", req->vhost.c_str());
     }
     
@@ -714,6 +742,22 @@ srs_error_t SrsRtmpConn::playing(SrsSharedPtr<SrsLiveSource> source)
     // When origin cluster enabled, try to redirect to the origin which is active.
     // A active origin is a server which is delivering stream.
     if (!info->edge && _srs_config->get_vhost_origin_cluster(req->vhost) && source->inactive()) {
+        // Lookup the directory pushed by co-workers, fallback to query each co-worker if not found.
+        string host; int port = 0;
+        if (_srs_config->get_vhost_coworkers_directory(req->vhost)
+            && SrsCoWorkers::instance()->find_origin(req->vhost, req->app, req->stream, host, port)) {
+            string rurl = srs_generate_rtmp_url(host, port, req->host, req->vhost, req->app, req->stream, req->param);
+            srs_trace("rtmp: redirect in cluster by directory, from=%s:%d, target=%s:%d, rurl=%s",
+                req->host.c_str(), req->port, host.c_str(), port, rurl.c_str());
+
+            bool accepted = false;
+            if ((err = rtmp->redirect(req, rurl, accepted)) != srs_success) {
+                srs_error_reset(err);
+            } else {
+                return srs_error_new(ERROR_CONTROL_REDIRECT, "redirected");
+            }
+        }
+
         vector<string> coworkers = _srs_config->get_vhost_coworkers(req->vhost);
         for (int i = 0; i < (int)coworkers.size(); i++) {
             // TODO: FIXME: User may config the server itself as coworker, we must identify and ignore it.
@@ -753,6 +797,14 @@ srs_error_t SrsRtmpConn::playing(SrsSharedPtr<SrsLiveSource> source)
     
     // Set the socket options for transport.
     set_sock_options();
+
+    // Send large writes with MSG_ZEROCOPY, which must be enabled before the receiving thread starts, because it drains
+    // the completions when reading.
+    SrsSharedPtr<SrsVhostConfig> conf = _srs_config->get_vhost_snapshot(req->vhost);
+    if (conf->zerocopy && (err = rtmp->set_zerocopy(conf->zerocopy_threshold)) != srs_success) {
+        srs_warn("rtmp: ignore zerocopy, err %s", srs_error_desc(err).c_str());
+        srs_freep(err);
+    }
     
     // Create a consumer of source.
     SrsLiveConsumer* consumer_raw = NULL;
@@ -802,15 +854,17 @@ srs_error_t SrsRtmpConn::do_playing(SrsSharedPtr<SrsLiveSource> source, SrsLiveC
     bool user_specified_duration_to_stop = (req->duration > 0);
     int64_t starttime = -1;
 
+    SrsSharedPtr<SrsVhostConfig> conf = _srs_config->get_vhost_snapshot(req->vhost);
+
     // setup the realtime.
-    realtime = _srs_config->get_realtime_enabled(req->vhost);
+    realtime = conf->realtime;
     // setup the mw config.
     // when mw_sleep changed, resize the socket send buffer.
-    mw_msgs = _srs_config->get_mw_msgs(req->vhost, realtime);
-    mw_sleep = _srs_config->get_mw_sleep(req->vhost);
+    mw_msgs = conf->mw_msgs;
+    mw_sleep = conf->mw_sleep;
     skt->set_socket_buffer(mw_sleep);
     // initialize the send_min_interval
-    send_min_interval = _srs_config->get_send_min_interval(req->vhost);
+    send_min_interval = conf->send_min_interval;
     
     srs_trace("start play smi=%dms, mw_sleep=%d, mw_msgs=%d, realtime=%d, tcp_nodelay=%d",
         srsu2msi(send_min_interval), srsu2msi(mw_sleep), mw_msgs, realtime, tcp_nodelay);
@@ -859,9 +913,12 @@ srs_error_t SrsRtmpConn::do_playing(SrsSharedPtr<SrsLiveSource> source, SrsLiveC
         // reportable
         if (pprint->can_print()) {
             kbps->sample();
-            srs_trace("-> " SRS_CONSTS_LOG_PLAY " time=%d, msgs=%d, okbps=%d,%d,%d, ikbps=%d,%d,%d, mw=%d/%d",
+            int64_t nn_disposable = 0, nn_video = 0, nn_shrink = 0;
+            consumer->drop_stat(nn_disposable, nn_video, nn_shrink);
+            srs_trace("-> " SRS_CONSTS_LOG_PLAY " time=%d, msgs=%d, okbps=%d,%d,%d, ikbps=%d,%d,%d, mw=%d/%d, drop=%" PRId64 ",%" PRId64 ",%" PRId64,
                 (int)pprint->age(), count, kbps->get_send_kbps(), kbps->get_send_kbps_30s(), kbps->get_send_kbps_5m(),
-                kbps->get_recv_kbps(), kbps->get_recv_kbps_30s(), kbps->get_recv_kbps_5m(), srsu2msi(mw_sleep), mw_msgs);
+                kbps->get_recv_kbps(), kbps->get_recv_kbps_30s(), kbps->get_recv_kbps_5m(), srsu2msi(mw_sleep), mw_msgs,
+                nn_disposable, nn_video, nn_shrink);
 
 #ifdef SRS_APM
             // TODO: Do not use pithy print for frame span.
@@ -37,6 +37,8 @@ using namespace std;
 #include <srs_protocol_log.hpp>
 #include <srs_app_latest_version.hpp>
 #include <srs_app_conn.hpp>
+#include <srs_app_hybrid.hpp>
+#include <srs_protocol_rtmp_handshake.hpp>
 #ifdef SRS_RTC
 #include <srs_app_rtc_network.hpp>
 #include <srs_app_rtc_server.hpp>
@@ -370,6 +372,8 @@ SrsServer::~SrsServer()
 
 void SrsServer::destroy()
 {
+    _srs_hybrid->timer100ms()->unsubscribe(this);
+
     srs_freep(trd_);
     srs_freep(timer_);
 
@@ -534,6 +538,16 @@ srs_error_t SrsServer::initialize()
     if ((err = http_server->initialize()) != srs_success) {
         return srs_error_wrap(err, "http server initialize");
     }
+
+    // Start the directory of origin cluster, to push stream events to co-workers.
+    if ((err = SrsCoWorkers::instance()->initialize()) != srs_success) {
+        return srs_error_wrap(err, "coworkers initialize");
+    }
+
+    // Start the load-aware redirect, to exchange load reports with peers.
+    if ((err = _srs_load_redirect->initialize()) != srs_success) {
+        return srs_error_wrap(err, "load redirect initialize");
+    }
     
     return err;
 }
@@ -745,12 +759,18 @@ srs_error_t SrsServer::http_handle()
     if ((err = http_api_mux->handle("/api/v1/clients/", new SrsGoApiClients())) != srs_success) {
         return srs_error_wrap(err, "handle clients");
     }
+    if ((err = http_api_mux->handle("/api/v1/events", new SrsGoApiEvents())) != srs_success) {
+        return srs_error_wrap(err, "handle events");
+    }
     if ((err = http_api_mux->handle("/api/v1/raw", new SrsGoApiRaw(this))) != srs_success) {
         return srs_error_wrap(err, "handle raw");
     }
     if ((err = http_api_mux->handle("/api/v1/clusters", new SrsGoApiClusters())) != srs_success) {
         return srs_error_wrap(err, "handle clusters");
     }
+    if ((err = http_api_mux->handle("/api/v1/loads", new SrsGoApiLoads())) != srs_success) {
+        return srs_error_wrap(err, "handle loads");
+    }
     
     // test the request info.
     if ((err = http_api_mux->handle("/api/v1/tests/requests", new SrsGoApiRequests())) != srs_success) {
@@ -1081,6 +1101,16 @@ srs_error_t SrsServer::setup_ticks()
         return srs_error_wrap(err, "timer");
     }
 
+    // Pre-generate the DH keypairs for RTMP complex handshake, refill the pool in background.
+    int dh_pool = _srs_config->get_rtmp_handshake_dh_pool();
+    int max_concurrency = _srs_config->get_rtmp_handshake_max_concurrency();
+    if ((err = _srs_handshake_pool->initialize(dh_pool, max_concurrency)) != srs_success) {
+        return srs_error_wrap(err, "handshake pool");
+    }
+    _srs_hybrid->timer100ms()->subscribe(this);
+    srs_trace("RTMP handshake pool dh=%d, refill=%d, concurrency=%d", dh_pool,
+        _srs_config->get_rtmp_handshake_dh_refill(), max_concurrency);
+
     return err;
 }
 
@@ -1102,6 +1132,20 @@ srs_error_t SrsServer::notify(int event, srs_utime_t interval, srs_utime_t tick)
     return err;
 }
 
+srs_error_t SrsServer::on_timer(srs_utime_t interval)
+{
+    srs_error_t err = srs_success;
+
+    // Generate a few DH keypairs every time, to avoid blocking other coroutines too long.
+    int refill = _srs_config->get_rtmp_handshake_dh_refill();
+    if ((err = _srs_handshake_pool->refill(refill)) != srs_success) {
+        srs_warn("ignore handshake pool err %s", srs_error_desc(err).c_str());
+        srs_freep(err);
+    }
+
+    return err;
+}
+
 void SrsServer::resample_kbps()
 {
     SrsStatistic* stat = SrsStatistic::instance();
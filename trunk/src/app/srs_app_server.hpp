@@ -92,7 +92,7 @@ public:
 // TODO: FIXME: Rename to SrsLiveServer.
 // SRS RTMP server, initialize and listen, start connection service thread, destroy client.
 class SrsServer : public ISrsReloadHandler, public ISrsLiveSourceHandler, public ISrsTcpHandler
-    , public ISrsResourceManager, public ISrsCoroutineHandler, public ISrsHourGlass
+    , public ISrsResourceManager, public ISrsCoroutineHandler, public ISrsHourGlass, public ISrsFastTimer
 {
 private:
     // TODO: FIXME: Extract an HttpApiServer.
@@ -210,6 +210,9 @@ private:
 private:
     virtual srs_error_t setup_ticks();
     virtual srs_error_t notify(int event, srs_utime_t interval, srs_utime_t tick);
+// interface ISrsFastTimer
+private:
+    virtual srs_error_t on_timer(srs_utime_t interval);
 private:
     // Resample the server kbs.
     virtual void resample_kbps();
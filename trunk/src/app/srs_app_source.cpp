@@ -35,6 +35,10 @@ using namespace std;
 #include <srs_protocol_format.hpp>
 #include <srs_app_rtc_source.hpp>
 #include <srs_app_http_hooks.hpp>
+#include <srs_app_threads.hpp>
+#include <srs_kernel_kbps.hpp>
+
+extern SrsPps* _srs_pps_shed_frames;
 
 #define CONST_MAX_JITTER_MS         250
 #define CONST_MAX_JITTER_MS_NEG         -250
@@ -412,6 +416,11 @@ SrsLiveConsumer::SrsLiveConsumer(SrsLiveSource* s)
     jitter = new SrsRtmpJitter();
     queue = new SrsMessageQueue();
     should_update_source_id = false;
+    low_priority_ = false;
+    queue_size_ = 0;
+    adaptive_drop_ = false;
+    audio_only_ = false;
+    nn_drop_disposable_ = nn_drop_video_ = nn_shrink_ = 0;
     
 #ifdef SRS_PERF_QUEUE_COND_WAIT
     mw_wait = srs_cond_new();
@@ -434,6 +443,7 @@ SrsLiveConsumer::~SrsLiveConsumer()
 
 void SrsLiveConsumer::set_queue_size(srs_utime_t queue_size)
 {
+    queue_size_ = queue_size;
     queue->set_queue_size(queue_size);
 }
 
@@ -442,6 +452,26 @@ void SrsLiveConsumer::update_source_id()
     should_update_source_id = true;
 }
 
+void SrsLiveConsumer::set_low_priority(bool v)
+{
+    low_priority_ = v;
+}
+
+void SrsLiveConsumer::set_adaptive_drop(bool v)
+{
+    adaptive_drop_ = v;
+    if (!v) {
+        audio_only_ = false;
+    }
+}
+
+void SrsLiveConsumer::drop_stat(int64_t& disposable, int64_t& video, int64_t& shrink)
+{
+    disposable = nn_drop_disposable_;
+    video = nn_drop_video_;
+    shrink = nn_shrink_;
+}
+
 int64_t SrsLiveConsumer::get_time()
 {
     return jitter->get_time();
@@ -451,6 +481,18 @@ srs_error_t SrsLiveConsumer::enqueue(SrsSharedPtrMessage* shared_msg, bool atc,
 {
     srs_error_t err = srs_success;
     
+    // Drop the disposable frames for low-priority consumer, when overloaded.
+    if (low_priority_ && shared_msg->is_video() && _srs_circuit_breaker->hybrid_high_water_level()
+        && SrsFlvVideo::disposable(shared_msg->payload, shared_msg->size)) {
+        ++_srs_pps_shed_frames->sugar;
+        return err;
+    }
+
+    // Drop the video frames for slow consumer, before shrink the whole gop.
+    if (adaptive_drop_ && adaptive_drop(shared_msg)) {
+        return err;
+    }
+
     SrsSharedPtrMessage* msg = shared_msg->copy();
 
     if (!atc) {
@@ -459,9 +501,14 @@ srs_error_t SrsLiveConsumer::enqueue(SrsSharedPtrMessage* shared_msg, bool atc,
         }
     }
 
-    if ((err = queue->enqueue(msg, NULL)) != srs_success) {
+    bool is_overflow = false;
+    if ((err = queue->enqueue(msg, &is_overflow)) != srs_success) {
         return srs_error_wrap(err, "enqueue message");
     }
+
+    if (is_overflow) {
+        nn_shrink_++;
+    }
     
 #ifdef SRS_PERF_QUEUE_COND_WAIT
     // fire the mw when msgs is enough.
@@ -560,6 +607,43 @@ srs_error_t SrsLiveConsumer::on_play_client_pause(bool is_pause)
     return err;
 }
 
+bool SrsLiveConsumer::adaptive_drop(SrsSharedPtrMessage* msg)
+{
+    // Never drop the audio and sequence header, and ignore if no queue size.
+    if (!msg->is_video() || queue_size_ <= 0 || SrsFlvVideo::sh(msg->payload, msg->size)) {
+        return false;
+    }
+
+    srs_utime_t duration = queue->duration();
+
+    // Exit the audio-only mode when queue is drained and a keyframe comes, for the decoder requires it.
+    if (audio_only_ && duration < queue_size_ / 2 && SrsFlvVideo::keyframe(msg->payload, msg->size)) {
+        audio_only_ = false;
+        srs_trace("adaptive drop: exit audio-only, queue=%dms/%dms, drop=%" PRId64 ",%" PRId64 ",%" PRId64,
+            srsu2msi(duration), srsu2msi(queue_size_), nn_drop_disposable_, nn_drop_video_, nn_shrink_);
+    }
+
+    // Enter the audio-only mode when the queue is almost full, to avoid shrink the whole gop.
+    if (!audio_only_ && duration > queue_size_ * 3 / 4) {
+        audio_only_ = true;
+        srs_trace("adaptive drop: enter audio-only, queue=%dms/%dms, drop=%" PRId64 ",%" PRId64 ",%" PRId64,
+            srsu2msi(duration), srsu2msi(queue_size_), nn_drop_disposable_, nn_drop_video_, nn_shrink_);
+    }
+
+    if (audio_only_) {
+        nn_drop_video_++;
+        return true;
+    }
+
+    // Drop the non-reference frames first, which never break the decoding.
+    if (duration > queue_size_ / 2 && SrsFlvVideo::disposable(msg->payload, msg->size)) {
+        nn_drop_disposable_++;
+        return true;
+    }
+
+    return false;
+}
+
 void SrsLiveConsumer::wakeup()
 {
 #ifdef SRS_PERF_QUEUE_COND_WAIT
@@ -699,6 +783,71 @@ srs_error_t SrsGopCache::dump(SrsLiveConsumer* consumer, bool atc, SrsRtmpJitter
     return err;
 }
 
+srs_error_t SrsGopCache::fast_dump(SrsLiveConsumer* consumer, bool atc, SrsRtmpJitterAlgorithm jitter_algorithm, srs_utime_t catchup)
+{
+    srs_error_t err = srs_success;
+
+    // Start at the newest keyframe, because the frames before it are useless for a new player.
+    int start = -1;
+    for (int i = (int)gop_cache.size() - 1; i >= 0; i--) {
+        SrsSharedPtrMessage* msg = gop_cache[i];
+        if (msg->is_video() && SrsFlvVideo::keyframe(msg->payload, msg->size) && !SrsFlvVideo::sh(msg->payload, msg->size)) {
+            start = i;
+            break;
+        }
+    }
+
+    if (start < 0) {
+        srs_trace("fast start: no keyframe in gop, count=%d", (int)gop_cache.size());
+        return err;
+    }
+
+    // The live edge is the last cached message, the backlog of gop is from the keyframe to it.
+    int64_t base = gop_cache[start]->timestamp;
+    int64_t edge = gop_cache[gop_cache.size() - 1]->timestamp;
+    int64_t window = srsu2ms(catchup);
+    bool compress = window > 0 && edge - base > window;
+
+    int nn_dumped = 0, nn_dropped = 0;
+    for (int i = start; i < (int)gop_cache.size(); i++) {
+        SrsSharedPtrMessage* msg = gop_cache[i];
+
+        // Never drop the sequence header and metadata.
+        bool sh = (msg->is_video() && SrsFlvVideo::sh(msg->payload, msg->size))
+            || (msg->is_audio() && SrsFlvAudio::sh(msg->payload, msg->size));
+        if (!sh && msg->is_video() && SrsFlvVideo::disposable(msg->payload, msg->size)) {
+            nn_dropped++;
+            continue;
+        }
+
+        // The audio of backlog is dropped when catch up, because it's not able to play in fast speed.
+        if (!sh && compress && msg->is_audio()) {
+            nn_dropped++;
+            continue;
+        }
+
+        if (!compress) {
+            if ((err = consumer->enqueue(msg, atc, jitter_algorithm)) != srs_success) {
+                return srs_error_wrap(err, "enqueue message");
+            }
+            nn_dumped++;
+            continue;
+        }
+
+        // Compress the timestamp to [edge-window, edge], so the player catches up to the live edge in the window.
+        SrsUniquePtr<SrsSharedPtrMessage> copy(msg->copy());
+        copy->timestamp = edge - (edge - msg->timestamp) * window / (edge - base);
+        if ((err = consumer->enqueue(copy.get(), atc, jitter_algorithm)) != srs_success) {
+            return srs_error_wrap(err, "enqueue message");
+        }
+        nn_dumped++;
+    }
+    srs_trace("fast start: dispatch cached gop, count=%d, start=%d, dumped=%d, dropped=%d, backlog=%dms, catchup=%dms",
+        (int)gop_cache.size(), start, nn_dumped, nn_dropped, (int)(edge - base), compress ? (int)window : 0);
+
+    return err;
+}
+
 bool SrsGopCache::empty()
 {
     return gop_cache.empty();
@@ -834,6 +983,9 @@ SrsOriginHub::SrsOriginHub()
     hds = new SrsHds();
 #endif
     ng_exec = new SrsNgExec();
+
+    low_priority_ = false;
+    packaging_paused_ = false;
     
     _srs_config->subscribe(this);
 }
@@ -947,7 +1099,7 @@ srs_error_t SrsOriginHub::on_audio(SrsSharedPtrMessage* shared_audio)
     SrsRtmpFormat* format = source_->format_;
     
     // Handle the metadata when got sequence header.
-    if (format->is_aac_sequence_header() || format->is_mp3_sequence_header()) {
+    if (format->is_aac_sequence_header() || format->is_mp3_sequence_header() || format->is_opus_sequence_header()) {
         srs_assert(format->acodec);
         SrsAudioCodecConfig* c = format->acodec;
         
@@ -960,7 +1112,10 @@ srs_error_t SrsOriginHub::on_audio(SrsSharedPtrMessage* shared_audio)
             return srs_error_wrap(err, "stat audio");
         }
 
-        if (format->acodec->id == SrsAudioCodecIdMP3) {
+        if (format->acodec->id == SrsAudioCodecIdOpus) {
+            srs_trace("%dB audio sh, codec(%d, %dchannels, 48000HZ), enhanced-rtmp",
+                msg->size, c->id, c->aac_channels);
+        } else if (format->acodec->id == SrsAudioCodecIdMP3) {
             srs_trace("%dB audio sh, codec(%d, %dbits, %dchannels, %dHZ)",
                 msg->size, c->id, flv_sample_sizes[c->sound_size], flv_sound_types[c->sound_type],
                 srs_flv_srates[c->sound_rate]);
@@ -973,7 +1128,11 @@ srs_error_t SrsOriginHub::on_audio(SrsSharedPtrMessage* shared_audio)
         }
     }
     
-    if ((err = hls->on_audio(msg, format)) != srs_success) {
+    // Pause the HLS, DASH and DVR when overloaded, but always feed the sequence header.
+    bool is_sequence_header = format->is_aac_sequence_header() || format->is_mp3_sequence_header() || format->is_opus_sequence_header();
+    bool packaging = !packaging_paused_ || is_sequence_header;
+
+    if (packaging && (err = hls->on_audio(msg, format)) != srs_success) {
         // apply the error strategy for hls.
         std::string hls_error_strategy = _srs_config->get_hls_on_error(req_->vhost);
         if (srs_config_hls_is_on_error_ignore(hls_error_strategy)) {
@@ -991,20 +1150,20 @@ srs_error_t SrsOriginHub::on_audio(SrsSharedPtrMessage* shared_audio)
         }
     }
     
-    if ((err = dash->on_audio(msg, format)) != srs_success) {
+    if (packaging && (err = dash->on_audio(msg, format)) != srs_success) {
         srs_warn("dash: ignore audio error %s", srs_error_desc(err).c_str());
         srs_error_reset(err);
         dash->on_unpublish();
     }
     
-    if ((err = dvr->on_audio(msg, format)) != srs_success) {
+    if (packaging && (err = dvr->on_audio(msg, format)) != srs_success) {
         srs_warn("dvr: ignore audio error %s", srs_error_desc(err).c_str());
         srs_error_reset(err);
         dvr->on_unpublish();
     }
     
 #ifdef SRS_HDS
-    if ((err = hds->on_audio(msg)) != srs_success) {
+    if (packaging && (err = hds->on_audio(msg)) != srs_success) {
         srs_warn("hds: ignore audio error %s", srs_error_desc(err).c_str());
         srs_error_reset(err);
         hds->on_unpublish();
@@ -1065,7 +1224,11 @@ srs_error_t SrsOriginHub::on_video(SrsSharedPtrMessage* shared_video, bool is_se
         return err;
     }
     
-    if ((err = hls->on_video(msg, format)) != srs_success) {
+    // Pause the HLS, DASH and DVR when overloaded, but always feed the sequence header.
+    update_packaging(SrsFlvVideo::keyframe(msg->payload, msg->size));
+    bool packaging = !packaging_paused_ || is_sequence_header;
+
+    if (packaging && (err = hls->on_video(msg, format)) != srs_success) {
         // TODO: We should support more strategies.
         // apply the error strategy for hls.
         std::string hls_error_strategy = _srs_config->get_hls_on_error(req_->vhost);
@@ -1084,20 +1247,20 @@ srs_error_t SrsOriginHub::on_video(SrsSharedPtrMessage* shared_video, bool is_se
         }
     }
     
-    if ((err = dash->on_video(msg, format)) != srs_success) {
+    if (packaging && (err = dash->on_video(msg, format)) != srs_success) {
         srs_warn("dash: ignore video error %s", srs_error_desc(err).c_str());
         srs_error_reset(err);
         dash->on_unpublish();
     }
     
-    if ((err = dvr->on_video(msg, format)) != srs_success) {
+    if (packaging && (err = dvr->on_video(msg, format)) != srs_success) {
         srs_warn("dvr: ignore video error %s", srs_error_desc(err).c_str());
         srs_error_reset(err);
         dvr->on_unpublish();
     }
     
 #ifdef SRS_HDS
-    if ((err = hds->on_video(msg)) != srs_success) {
+    if (packaging && (err = hds->on_video(msg)) != srs_success) {
         srs_warn("hds: ignore video error %s", srs_error_desc(err).c_str());
         srs_error_reset(err);
         hds->on_unpublish();
@@ -1118,10 +1281,27 @@ srs_error_t SrsOriginHub::on_video(SrsSharedPtrMessage* shared_video, bool is_se
     return err;
 }
 
+void SrsOriginHub::update_packaging(bool keyframe)
+{
+    // Pause immediately when overloaded, but resume at keyframe, for segment must start with keyframe.
+    bool paused = low_priority_ && _srs_circuit_breaker->hybrid_critical_water_level();
+    if (paused == packaging_paused_ || (!paused && !keyframe)) {
+        return;
+    }
+
+    packaging_paused_ = paused;
+    srs_trace("CircuitBreaker: %s HLS/DASH/DVR of low-priority stream %s", paused ? "pause" : "resume",
+        req_->get_stream_url().c_str());
+}
+
 srs_error_t SrsOriginHub::on_publish()
 {
     srs_error_t err = srs_success;
     
+    // Load the priority, which might be changed by reload.
+    low_priority_ = _srs_circuit_breaker->is_low_priority(req_->vhost);
+    packaging_paused_ = false;
+
     // create forwarders
     if ((err = create_forwarders()) != srs_success) {
         return srs_error_wrap(err, "create forwarders");
@@ -2020,8 +2200,9 @@ srs_error_t SrsLiveSource::initialize(SrsSharedPtr<SrsLiveSource> wrapper, SrsRe
     srs_utime_t queue_size = _srs_config->get_queue_length(req->vhost);
     publish_edge->set_queue_size(queue_size);
     
-    jitter_algorithm = (SrsRtmpJitterAlgorithm)_srs_config->get_time_jitter(req->vhost);
-    mix_correct = _srs_config->get_mix_correct(req->vhost);
+    SrsSharedPtr<SrsVhostConfig> conf = _srs_config->get_vhost_snapshot(req->vhost);
+    jitter_algorithm = (SrsRtmpJitterAlgorithm)conf->time_jitter;
+    mix_correct = conf->mix_correct;
     
     return err;
 }
@@ -2040,12 +2221,14 @@ srs_error_t SrsLiveSource::on_reload_vhost_play(string vhost)
         return err;
     }
     
+    SrsSharedPtr<SrsVhostConfig> conf = _srs_config->get_vhost_snapshot(req->vhost);
+
     // time_jitter
-    jitter_algorithm = (SrsRtmpJitterAlgorithm)_srs_config->get_time_jitter(req->vhost);
+    jitter_algorithm = (SrsRtmpJitterAlgorithm)conf->time_jitter;
     
     // mix_correct
     if (true) {
-        bool v = _srs_config->get_mix_correct(req->vhost);
+        bool v = conf->mix_correct;
         
         // when changed, clear the mix queue.
         if (v != mix_correct) {
@@ -2067,13 +2250,13 @@ srs_error_t SrsLiveSource::on_reload_vhost_play(string vhost)
     
     // gop cache changed.
     if (true) {
-        bool v = _srs_config->get_gop_cache(vhost);
+        bool v = conf->gop_cache;
         
         if (v != gop_cache->enabled()) {
             string url = req->get_stream_url();
             srs_trace("vhost %s gop_cache changed to %d, source url=%s", vhost.c_str(), v, url.c_str());
             gop_cache->set(v);
-            gop_cache->set_gop_cache_max_frames(_srs_config->get_gop_cache_max_frames(vhost));
+            gop_cache->set_gop_cache_max_frames(conf->gop_cache_max_frames);
         }
     }
     
@@ -2087,6 +2270,7 @@ srs_error_t SrsLiveSource::on_reload_vhost_play(string vhost)
             for (it = consumers.begin(); it != consumers.end(); ++it) {
                 SrsLiveConsumer* consumer = *it;
                 consumer->set_queue_size(v);
+                consumer->set_adaptive_drop(_srs_config->get_adaptive_drop(req->vhost));
             }
             
             srs_trace("consumers reload queue size success.");
@@ -2180,8 +2364,9 @@ srs_error_t SrsLiveSource::on_meta_data(SrsCommonMessage* msg, SrsOnMetaDataPack
     
     // if allow atc_auto and bravo-atc detected, open atc for vhost.
     SrsAmf0Any* prop = NULL;
-    atc = _srs_config->get_atc(req->vhost);
-    if (_srs_config->get_atc_auto(req->vhost)) {
+    SrsSharedPtr<SrsVhostConfig> conf = _srs_config->get_vhost_snapshot(req->vhost);
+    atc = conf->atc;
+    if (conf->atc_auto) {
         if ((prop = metadata->metadata->get_property("bravo_atc")) != NULL) {
             if (prop->is_string() && prop->to_str() == "true") {
                 atc = true;
@@ -2200,7 +2385,7 @@ srs_error_t SrsLiveSource::on_meta_data(SrsCommonMessage* msg, SrsOnMetaDataPack
     
     // when already got metadata, drop when reduce sequence header.
     bool drop_for_reduce = false;
-    if (meta->data() && _srs_config->get_reduce_sequence_header(req->vhost)) {
+    if (meta->data() && _srs_config->get_vhost_snapshot(req->vhost)->reduce_sequence_header) {
         drop_for_reduce = true;
         srs_warn("drop for reduce sh metadata, size=%d", msg->size);
     }
@@ -2293,11 +2478,12 @@ srs_error_t SrsLiveSource::on_audio_imp(SrsSharedPtrMessage* msg)
     }
 
     // Whether current packet is sequence header. Note that MP3 does not have one, but we use the first packet as it.
-    bool is_sequence_header = format_->is_aac_sequence_header() || format_->is_mp3_sequence_header();
+    bool is_sequence_header = format_->is_aac_sequence_header() || format_->is_mp3_sequence_header()
+        || format_->is_opus_sequence_header();
 
     // whether consumer should drop for the duplicated sequence header.
     bool drop_for_reduce = false;
-    if (is_sequence_header && meta->previous_ash() && _srs_config->get_reduce_sequence_header(req->vhost)) {
+    if (is_sequence_header && meta->previous_ash() && _srs_config->get_vhost_snapshot(req->vhost)->reduce_sequence_header) {
         if (meta->previous_ash()->size == msg->size) {
             drop_for_reduce = srs_bytes_equals(meta->previous_ash()->payload, msg->payload, msg->size);
             srs_warn("drop for reduce sh audio, size=%d", msg->size);
@@ -2414,7 +2600,7 @@ srs_error_t SrsLiveSource::on_video_imp(SrsSharedPtrMessage* msg)
     
     // whether consumer should drop for the duplicated sequence header.
     bool drop_for_reduce = false;
-    if (is_sequence_header && meta->previous_vsh() && _srs_config->get_reduce_sequence_header(req->vhost)) {
+    if (is_sequence_header && meta->previous_vsh() && _srs_config->get_vhost_snapshot(req->vhost)->reduce_sequence_header) {
         if (meta->previous_vsh()->size == msg->size) {
             drop_for_reduce = srs_bytes_equals(meta->previous_vsh()->payload, msg->payload, msg->size);
             srs_warn("drop for reduce sh video, size=%d", msg->size);
@@ -2662,7 +2848,7 @@ srs_error_t SrsLiveSource::create_consumer(SrsLiveConsumer*& consumer)
     srs_error_t err = srs_success;
 
     // for edge, when play edge stream, check the state
-    if (_srs_config->get_vhost_is_edge(req->vhost)) {
+    if (_srs_config->get_vhost_snapshot(req->vhost)->is_edge) {
         // notice edge to start for the first client.
         if ((err = play_edge->on_client_play()) != srs_success) {
             return srs_error_wrap(err, "play edge");
@@ -2670,6 +2856,7 @@ srs_error_t SrsLiveSource::create_consumer(SrsLiveConsumer*& consumer)
     }
 
     consumer = new SrsLiveConsumer(this);
+    consumer->set_low_priority(_srs_circuit_breaker->is_low_priority(req->vhost));
     consumers.push_back(consumer);
 
     // There are more than one consumer, so reset the timeout.
@@ -2683,8 +2870,10 @@ srs_error_t SrsLiveSource::consumer_dumps(SrsLiveConsumer* consumer, bool ds, bo
 {
     srs_error_t err = srs_success;
 
-    srs_utime_t queue_size = _srs_config->get_queue_length(req->vhost);
+    SrsSharedPtr<SrsVhostConfig> conf = _srs_config->get_vhost_snapshot(req->vhost);
+    srs_utime_t queue_size = conf->queue_length;
     consumer->set_queue_size(queue_size);
+    consumer->set_adaptive_drop(conf->adaptive_drop);
 
     // if atc, update the sequence header to gop cache time.
     if (atc && !gop_cache->empty()) {
@@ -2706,8 +2895,12 @@ srs_error_t SrsLiveSource::consumer_dumps(SrsLiveConsumer* consumer, bool ds, bo
             return srs_error_wrap(err, "meta dumps");
         }
 
-        // copy gop cache to client.
-        if (dg && (err = gop_cache->dump(consumer, atc, jitter_algorithm)) != srs_success) {
+        // copy gop cache to client, start at the newest keyframe for fast start.
+        if (dg && conf->fast_start) {
+            if ((err = gop_cache->fast_dump(consumer, atc, jitter_algorithm, conf->fast_start_catchup)) != srs_success) {
+                return srs_error_wrap(err, "gop cache fast dumps");
+            }
+        } else if (dg && (err = gop_cache->dump(consumer, atc, jitter_algorithm)) != srs_success) {
             return srs_error_wrap(err, "gop cache dumps");
         }
     }
@@ -2740,7 +2933,7 @@ void SrsLiveSource::on_consumer_destroy(SrsLiveConsumer* consumer)
 
         // For edge server, the stream die when the last player quit, because the edge stream is created by player
         // activities, so it should die when all players quit.
-        if (_srs_config->get_vhost_is_edge(req->vhost)) {
+        if (_srs_config->get_vhost_snapshot(req->vhost)->is_edge) {
             stream_die_at_ = srs_get_system_time();
         }
 
@@ -178,6 +178,19 @@ private:
     bool paused;
     // when source id changed, notice all consumers
     bool should_update_source_id;
+    // Whether the consumer is low-priority, to drop disposable frames when overloaded.
+    bool low_priority_;
+private:
+    // The max queue size, the adaptive drop is based on it.
+    srs_utime_t queue_size_;
+    // Whether drop frames adaptively when the consumer falls behind.
+    bool adaptive_drop_;
+    // Whether in audio-only mode, all video frames are dropped until the next keyframe.
+    bool audio_only_;
+    // The counters for dropped disposable frames, dropped video frames and shrinks of queue.
+    int64_t nn_drop_disposable_;
+    int64_t nn_drop_video_;
+    int64_t nn_shrink_;
 #ifdef SRS_PERF_QUEUE_COND_WAIT
     // The cond wait for mw.
     srs_cond_t mw_wait;
@@ -193,6 +206,15 @@ public:
     virtual void set_queue_size(srs_utime_t queue_size);
     // when source id changed, notice client to print.
     virtual void update_source_id();
+    // Set the consumer to low-priority, whose load is shed first.
+    virtual void set_low_priority(bool v);
+    // Whether drop frames adaptively, see play.adaptive_drop of vhost.
+    virtual void set_adaptive_drop(bool v);
+    // Get the counters of dropped messages, for slow consumer.
+    // @param disposable, the dropped non-reference video frames.
+    // @param video, the dropped video frames in audio-only mode.
+    // @param shrink, the times of queue shrinked.
+    virtual void drop_stat(int64_t& disposable, int64_t& video, int64_t& shrink);
 public:
     // Get current client time, the last packet time.
     virtual int64_t get_time();
@@ -214,6 +236,9 @@ public:
 #endif
     // when client send the pause message.
     virtual srs_error_t on_play_client_pause(bool is_pause);
+private:
+    // Whether drop the message adaptively, by the duration of queue.
+    virtual bool adaptive_drop(SrsSharedPtrMessage* msg);
 // Interface ISrsWakable
 public:
     // when the consumer(for player) got msg from recv thread,
@@ -270,6 +295,10 @@ public:
     virtual void clear();
     // dump the cached gop to consumer.
     virtual srs_error_t dump(SrsLiveConsumer* consumer, bool atc, SrsRtmpJitterAlgorithm jitter_algorithm);
+    // Fast dump the cached gop to consumer, start at the newest keyframe and skip the disposable frames.
+    // @param catchup, compress the timestamp of cached gop in this duration and drop the audio, to catch up to the
+    //      live edge. 0 to disable it.
+    virtual srs_error_t fast_dump(SrsLiveConsumer* consumer, bool atc, SrsRtmpJitterAlgorithm jitter_algorithm, srs_utime_t catchup);
     // used for atc to get the time of gop cache,
     // The atc will adjust the sequence header timestamp to gop cache.
     virtual bool empty();
@@ -340,6 +369,9 @@ private:
     SrsNgExec* ng_exec;
     // To forward stream to other servers
     std::vector<SrsForwarder*> forwarders;
+    // Whether the stream is low-priority, and whether HLS, DASH and DVR is paused for overloaded.
+    bool low_priority_;
+    bool packaging_paused_;
 public:
     SrsOriginHub();
     virtual ~SrsOriginHub();
@@ -364,6 +396,9 @@ public:
     virtual srs_error_t on_audio(SrsSharedPtrMessage* shared_audio);
     // When got a parsed video packet.
     virtual srs_error_t on_video(SrsSharedPtrMessage* shared_video, bool is_sequence_header);
+private:
+    // Pause or resume the HLS, DASH and DVR by the water-level.
+    virtual void update_packaging(bool keyframe);
 public:
     // When start publish stream.
     virtual srs_error_t on_publish();
@@ -379,8 +379,9 @@ srs_error_t SrsMpegtsSrtConn::acquire_publish()
 
     srs_assert(live_source.get() != NULL);
 
-    bool enabled_cache = _srs_config->get_gop_cache(req_->vhost);
-    int gcmf = _srs_config->get_gop_cache_max_frames(req_->vhost);
+    SrsSharedPtr<SrsVhostConfig> conf = _srs_config->get_vhost_snapshot(req_->vhost);
+    bool enabled_cache = conf->gop_cache;
+    int gcmf = conf->gop_cache_max_frames;
     live_source->set_cache(enabled_cache);
     live_source->set_gop_cache_max_frames(gcmf);
 
@@ -392,7 +393,7 @@ srs_error_t SrsMpegtsSrtConn::acquire_publish()
     SrsSharedPtr<SrsRtcSource> rtc;
     bool rtc_server_enabled = _srs_config->get_rtc_server_enabled();
     bool rtc_enabled = _srs_config->get_rtc_enabled(req_->vhost);
-    bool edge = _srs_config->get_vhost_is_edge(req_->vhost);
+    bool edge = conf->is_edge;
     if (rtc_server_enabled && rtc_enabled && ! edge) {
         if ((err = _srs_rtc_sources->fetch_or_create(req_, rtc)) != srs_success) {
             return srs_error_wrap(err, "create source");
@@ -19,10 +19,104 @@ using namespace std;
 #include <srs_app_source.hpp>
 #include <srs_app_statistic.hpp>
 #include <srs_app_pithy_print.hpp>
+#include <srs_app_config.hpp>
 
 // the time to cleanup source.
 #define SRS_SRT_SOURCE_CLEANUP (3 * SRS_UTIME_SECONDS)
 
+// The max packets of gop cache for fast start, about 13MB, clear the cache if exceed it.
+#define SRS_SRT_GOP_CACHE_MAX_PACKETS 10240
+
+bool srs_srt_packet_is_keyframe(char* data, int size)
+{
+    for (int i = 0; i + SRS_TS_PACKET_SIZE <= size; i += SRS_TS_PACKET_SIZE) {
+        uint8_t* p = (uint8_t*)data + i;
+        if (p[0] != 0x47) {
+            continue;
+        }
+
+        // Must be the start of PES, with adaptation field and payload.
+        bool pusi = (p[1] & 0x40) == 0x40;
+        int afc = (p[3] >> 4) & 0x03;
+        if (!pusi || afc != 0x03 || p[4] < 1) {
+            continue;
+        }
+
+        // The random access indicator.
+        if ((p[5] & 0x40) != 0x40) {
+            continue;
+        }
+
+        // Must be the video PES, the stream id is 0xE0 to 0xEF.
+        int pos = 5 + p[4];
+        if (pos + 4 > SRS_TS_PACKET_SIZE) {
+            continue;
+        }
+        if (p[pos] == 0x00 && p[pos + 1] == 0x00 && p[pos + 2] == 0x01 && (p[pos + 3] & 0xf0) == 0xe0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool srs_srt_packet_has_pid(char* data, int size, int pid)
+{
+    for (int i = 0; i + SRS_TS_PACKET_SIZE <= size; i += SRS_TS_PACKET_SIZE) {
+        uint8_t* p = (uint8_t*)data + i;
+        if (p[0] == 0x47 && (((p[1] & 0x1f) << 8) | p[2]) == pid) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool srs_srt_packet_has_pat(char* data, int size)
+{
+    return srs_srt_packet_has_pid(data, size, 0);
+}
+
+int srs_srt_packet_pmt_pid(char* data, int size)
+{
+    for (int i = 0; i + SRS_TS_PACKET_SIZE <= size; i += SRS_TS_PACKET_SIZE) {
+        uint8_t* p = (uint8_t*)data + i;
+
+        // Must be the start of PAT section.
+        if (p[0] != 0x47 || (p[1] & 0x40) != 0x40 || (p[1] & 0x1f) != 0 || p[2] != 0) {
+            continue;
+        }
+
+        // Skip the adaptation field and the pointer field.
+        int pos = 4;
+        if ((p[3] & 0x20) == 0x20) {
+            pos += 1 + p[4];
+        }
+        if (pos >= SRS_TS_PACKET_SIZE) {
+            continue;
+        }
+        pos += 1 + p[pos];
+
+        // The table id, section length, transport stream id, version, section number and last section number.
+        if (pos + 8 > SRS_TS_PACKET_SIZE) {
+            continue;
+        }
+        int section_length = ((p[pos + 1] & 0x0f) << 8) | p[pos + 2];
+        // The programs are before the CRC32.
+        int end = srs_min(pos + 3 + section_length - 4, SRS_TS_PACKET_SIZE);
+
+        // The program number 0 is the network PID, ignore it.
+        for (int j = pos + 8; j + 4 <= end; j += 4) {
+            int number = (p[j] << 8) | p[j + 1];
+            if (number != 0) {
+                return ((p[j + 2] & 0x1f) << 8) | p[j + 3];
+            }
+        }
+    }
+
+    return -1;
+}
+
 SrsSrtPacket::SrsSrtPacket()
 {
     shared_buffer_ = NULL;
@@ -901,6 +995,12 @@ SrsSrtSource::SrsSrtSource()
     frame_builder_ = NULL;
     bridge_ = NULL;
     stream_die_at_ = 0;
+    fast_start_ = false;
+    pat_ = NULL;
+    pmt_ = NULL;
+    pmt_pid_ = -1;
+
+    _srs_config->subscribe(this);
 }
 
 SrsSrtSource::~SrsSrtSource()
@@ -909,6 +1009,12 @@ SrsSrtSource::~SrsSrtSource()
     // for all consumers are auto free.
     consumers.clear();
 
+    _srs_config->unsubscribe(this);
+
+    clear_cache();
+    srs_freep(pat_);
+    srs_freep(pmt_);
+
     srs_freep(frame_builder_);
     srs_freep(bridge_);
     srs_freep(req);
@@ -923,6 +1029,7 @@ srs_error_t SrsSrtSource::initialize(SrsRequest* r)
     srs_error_t err = srs_success;
 
     req = r->copy();
+    fast_start_ = _srs_config->get_vhost_snapshot(req->vhost)->fast_start;
 
 	return err;
 }
@@ -1011,8 +1118,35 @@ srs_error_t SrsSrtSource::consumer_dumps(SrsSrtConsumer* consumer)
 {
     srs_error_t err = srs_success;
 
-    // print status.
-    srs_trace("create ts consumer, no gop cache");
+    if (!fast_start_ || gop_cache_.empty()) {
+        srs_trace("create ts consumer, no gop cache");
+        return err;
+    }
+
+    // Dump the PAT and PMT first, if not in the cache.
+    SrsSrtPacket* first = gop_cache_[0];
+    bool has_pmt = pmt_pid_ > 0 && srs_srt_packet_has_pid(first->data(), first->size(), pmt_pid_);
+    if (pat_ && !srs_srt_packet_has_pat(first->data(), first->size())) {
+        if ((err = consumer->enqueue(pat_->copy())) != srs_success) {
+            return srs_error_wrap(err, "consume pat");
+        }
+        has_pmt = has_pmt || (pmt_pid_ > 0 && srs_srt_packet_has_pid(pat_->data(), pat_->size(), pmt_pid_));
+    }
+    if (pmt_ && !has_pmt) {
+        if ((err = consumer->enqueue(pmt_->copy())) != srs_success) {
+            return srs_error_wrap(err, "consume pmt");
+        }
+    }
+
+    std::vector<SrsSrtPacket*>::iterator it;
+    for (it = gop_cache_.begin(); it != gop_cache_.end(); ++it) {
+        SrsSrtPacket* pkt = *it;
+        if ((err = consumer->enqueue(pkt->copy())) != srs_success) {
+            return srs_error_wrap(err, "consume ts packet");
+        }
+    }
+
+    srs_trace("create ts consumer, fast start, count=%d", (int)gop_cache_.size());
 
     return err;
 }
@@ -1075,6 +1209,11 @@ void SrsSrtSource::on_unpublish()
 
     can_publish_ = true;
 
+    clear_cache();
+    srs_freep(pat_);
+    srs_freep(pmt_);
+    pmt_pid_ = -1;
+
     SrsStatistic* stat = SrsStatistic::instance();
     stat->on_stream_close(req);
 
@@ -1103,6 +1242,10 @@ srs_error_t SrsSrtSource::on_packet(SrsSrtPacket* packet)
         }
     }
 
+    if (fast_start_) {
+        cache_packet(packet);
+    }
+
     if (frame_builder_ && (err = frame_builder_->on_packet(packet)) != srs_success) {
         return srs_error_wrap(err, "bridge consume message");
     }
@@ -1110,3 +1253,69 @@ srs_error_t SrsSrtSource::on_packet(SrsSrtPacket* packet)
     return err;
 }
 
+void SrsSrtSource::cache_packet(SrsSrtPacket* packet)
+{
+    // The PAT/PMT is usually before the keyframe, in the same packet.
+    if (srs_srt_packet_has_pat(packet->data(), packet->size())) {
+        srs_freep(pat_);
+        pat_ = packet->copy();
+
+        int pid = srs_srt_packet_pmt_pid(packet->data(), packet->size());
+        if (pid > 0) {
+            pmt_pid_ = pid;
+        }
+    }
+
+    // The PMT is found by the PID in PAT.
+    if (pmt_pid_ > 0 && srs_srt_packet_has_pid(packet->data(), packet->size(), pmt_pid_)) {
+        srs_freep(pmt_);
+        pmt_ = packet->copy();
+    }
+
+    // Restart the cache when got a keyframe, and ignore packets before the first keyframe.
+    if (srs_srt_packet_is_keyframe(packet->data(), packet->size())) {
+        clear_cache();
+    } else if (gop_cache_.empty()) {
+        return;
+    }
+
+    gop_cache_.push_back(packet->copy());
+
+    if (gop_cache_.size() > SRS_SRT_GOP_CACHE_MAX_PACKETS) {
+        srs_warn("srt gop cache exceed max packets=%d", SRS_SRT_GOP_CACHE_MAX_PACKETS);
+        clear_cache();
+    }
+}
+
+void SrsSrtSource::clear_cache()
+{
+    std::vector<SrsSrtPacket*>::iterator it;
+    for (it = gop_cache_.begin(); it != gop_cache_.end(); ++it) {
+        SrsSrtPacket* pkt = *it;
+        srs_freep(pkt);
+    }
+    gop_cache_.clear();
+}
+
+srs_error_t SrsSrtSource::on_reload_vhost_play(string vhost)
+{
+    srs_error_t err = srs_success;
+
+    if (!req || req->vhost != vhost) {
+        return err;
+    }
+
+    bool v = _srs_config->get_vhost_snapshot(req->vhost)->fast_start;
+    if (v != fast_start_) {
+        srs_trace("vhost %s fast_start changed to %d, source url=%s", vhost.c_str(), v, req->get_stream_url().c_str());
+        fast_start_ = v;
+    }
+
+    // Drop the cache, which is useless when fast start disabled.
+    if (!fast_start_) {
+        clear_cache();
+    }
+
+    return err;
+}
+
@@ -17,6 +17,7 @@
 #include <srs_app_stream_bridge.hpp>
 #include <srs_core_autofree.hpp>
 #include <srs_app_hourglass.hpp>
+#include <srs_app_reload.hpp>
 
 class SrsSharedPtrMessage;
 class SrsRequest;
@@ -48,6 +49,15 @@ private:
     int actual_buffer_size_;
 };
 
+// Whether the SRT packet starts a video keyframe, that is, a video PES with random access indicator.
+extern bool srs_srt_packet_is_keyframe(char* data, int size);
+// Whether the SRT packet contains the TS packet of pid.
+extern bool srs_srt_packet_has_pid(char* data, int size, int pid);
+// Whether the SRT packet contains the PAT, which is required by a new player.
+extern bool srs_srt_packet_has_pat(char* data, int size);
+// Get the PID of PMT from the PAT in SRT packet, -1 if not found.
+extern int srs_srt_packet_pmt_pid(char* data, int size);
+
 class SrsSrtSourceManager : public ISrsHourGlass
 {
 private:
@@ -155,7 +165,7 @@ private:
     SrsAlonePithyPrint* pp_audio_duration_;
 };
 
-class SrsSrtSource
+class SrsSrtSource : public ISrsReloadHandler
 {
 public:
     SrsSrtSource();
@@ -190,6 +200,13 @@ public:
     virtual void on_unpublish();
 public:
     srs_error_t on_packet(SrsSrtPacket* packet);
+private:
+    // Cache the packets from the newest keyframe, for fast start.
+    void cache_packet(SrsSrtPacket* packet);
+    void clear_cache();
+// Interface ISrsReloadHandler
+public:
+    virtual srs_error_t on_reload_vhost_play(std::string vhost);
 private:
     // Source id.
     SrsContextId _source_id;
@@ -204,6 +221,16 @@ private:
 private:
     SrsSrtFrameBuilder* frame_builder_;
     ISrsStreamBridge* bridge_;
+private:
+    // Whether fast start, to cache the packets from the newest keyframe.
+    bool fast_start_;
+    // The last packet with PAT, dump before the cached packets.
+    SrsSrtPacket* pat_;
+    // The last packet with PMT, and the PID of PMT from PAT.
+    SrsSrtPacket* pmt_;
+    int pmt_pid_;
+    // The cached packets, from the newest keyframe.
+    std::vector<SrsSrtPacket*> gop_cache_;
 };
 
 #endif
@@ -11,8 +11,11 @@ using namespace std;
 
 #include <srs_kernel_error.hpp>
 #include <srs_kernel_log.hpp>
+#include <srs_kernel_utility.hpp>
 #include <srs_app_utility.hpp>
 #include <srs_app_log.hpp>
+#include <srs_app_config.hpp>
+#include <srs_protocol_json.hpp>
 
 ISrsCoroutineHandler::ISrsCoroutineHandler()
 {
@@ -208,6 +211,11 @@ srs_error_t SrsFastCoroutine::start()
         return err;
     }
 
+    // Use the stack size class of config, by the name of coroutine.
+    if (_srs_stacks) {
+        stack_size = _srs_stacks->stack_size(name, stack_size);
+    }
+
     if ((trd = (srs_thread_t)_pfn_st_thread_create(pfn, this, 1, stack_size)) == NULL) {
         err = srs_error_new(ERROR_ST_CREATE_CYCLE_THREAD, "create failed");
         
@@ -323,6 +331,11 @@ void* SrsFastCoroutine::pfn(void* arg)
 
     srs_error_t err = p->cycle();
 
+    // Measure the stack before exit, which is still on the stack of coroutine.
+    if (_srs_stacks) {
+        _srs_stacks->on_exit(p->name, p->stack_size, srs_thread_stack_watermark(srs_thread_self()));
+    }
+
     // Set the err for function pull to fetch it.
     // @see https://github.com/ossrs/srs/pull/1304#issuecomment-480484151
     if (err != srs_success) {
@@ -334,6 +347,78 @@ void* SrsFastCoroutine::pfn(void* arg)
     return (void*)err;
 }
 
+SrsCoroutineStacks* _srs_stacks = NULL;
+
+SrsCoroutineStacks::SrsCoroutineStacks()
+{
+    default_size_ = 0;
+}
+
+SrsCoroutineStacks::~SrsCoroutineStacks()
+{
+}
+
+srs_error_t SrsCoroutineStacks::initialize()
+{
+    srs_error_t err = srs_success;
+
+    int pool = _srs_config->get_stack_pool();
+    // Keep the guard of ST build if not configured, for example, the DEBUG build guards the mmap stacks.
+    bool guard = _srs_config->get_stack_guard(srs_stack_guard());
+    bool watermark = _srs_config->get_stack_watermark();
+    srs_stack_setup(pool, guard, watermark);
+
+    default_size_ = _srs_config->get_stack_size();
+    sizes_ = _srs_config->get_stack_sizes();
+
+    srs_trace("Stack pool=%d, guard=%d, watermark=%d, size=%d, sizes=%d", pool, guard, watermark,
+        default_size_, (int)sizes_.size());
+
+    return err;
+}
+
+int SrsCoroutineStacks::stack_size(const std::string& name, int v)
+{
+    std::map<std::string, int>::iterator it = sizes_.find(name);
+    if (it != sizes_.end()) {
+        return it->second;
+    }
+
+    return v ? v : default_size_;
+}
+
+void SrsCoroutineStacks::on_exit(const std::string& name, int size, int watermark)
+{
+    if (watermark < 0) {
+        return;
+    }
+
+    SrsCoroutineStackStat& stat = stats_[name];
+    stat.size = size;
+    stat.count++;
+    stat.watermark = srs_max(stat.watermark, watermark);
+}
+
+void SrsCoroutineStacks::dumps(SrsJsonObject* obj)
+{
+    obj->set("free", SrsJsonAny::integer(srs_stack_free_count()));
+
+    SrsJsonObject* coroutines = SrsJsonAny::object();
+    obj->set("coroutines", coroutines);
+
+    std::map<std::string, SrsCoroutineStackStat>::iterator it;
+    for (it = stats_.begin(); it != stats_.end(); ++it) {
+        SrsCoroutineStackStat& stat = it->second;
+
+        SrsJsonObject* co = SrsJsonAny::object();
+        coroutines->set(it->first, co);
+
+        co->set("size", SrsJsonAny::integer(stat.size));
+        co->set("count", SrsJsonAny::integer(stat.count));
+        co->set("watermark", SrsJsonAny::integer(stat.watermark));
+    }
+}
+
 SrsWaitGroup::SrsWaitGroup()
 {
     nn_ = 0;
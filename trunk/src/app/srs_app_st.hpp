@@ -10,6 +10,7 @@
 #include <srs_core.hpp>
 
 #include <string>
+#include <map>
 
 #include <srs_kernel_log.hpp>
 #include <srs_kernel_error.hpp>
@@ -18,6 +19,7 @@
 #include <srs_protocol_conn.hpp>
 
 class SrsFastCoroutine;
+class SrsJsonObject;
 class SrsExecutorCoroutine;
 
 // Each ST-coroutine must implements this interface,
@@ -219,6 +221,44 @@ private:
     static void* pfn(void* arg);
 };
 
+// The stat of stacks of coroutines with the same name.
+struct SrsCoroutineStackStat
+{
+    // The stack size in bytes, 0 for the default of ST.
+    int size;
+    // The number of coroutines measured.
+    int count;
+    // The max high-water mark in bytes.
+    int watermark;
+};
+
+// The range of stack size in bytes of coroutines, 0 for the default of ST.
+#define SRS_STACK_MIN_SIZE (16 * 1024)
+#define SRS_STACK_MAX_SIZE (64 * 1024 * 1024)
+
+// The stack size classes of coroutines, and the high-water mark of stacks, by name of coroutine.
+class SrsCoroutineStacks
+{
+private:
+    int default_size_;
+    std::map<std::string, int> sizes_;
+    std::map<std::string, SrsCoroutineStackStat> stats_;
+public:
+    SrsCoroutineStacks();
+    virtual ~SrsCoroutineStacks();
+public:
+    // Setup the stacks of ST by config, and load the size classes.
+    srs_error_t initialize();
+    // Get the stack size for coroutine, the size of config is prefered to the size v by code.
+    int stack_size(const std::string& name, int v);
+    // When coroutine exits, update the high-water mark of stack, -1 if not measured.
+    void on_exit(const std::string& name, int size, int watermark);
+    // Dumps the pool and high-water marks to json.
+    void dumps(SrsJsonObject* obj);
+};
+
+extern SrsCoroutineStacks* _srs_stacks;
+
 // Like goroutine sync.WaitGroup.
 class SrsWaitGroup
 {
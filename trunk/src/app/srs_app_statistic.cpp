@@ -21,6 +21,8 @@ using namespace std;
 #include <srs_app_tencentcloud.hpp>
 #include <srs_kernel_kbps.hpp>
 #include <srs_app_utility.hpp>
+#include <srs_protocol_st.hpp>
+#include <srs_core_autofree.hpp>
 
 string srs_generate_stat_vid()
 {
@@ -98,6 +100,9 @@ SrsStatisticStream::SrsStatisticStream()
 
     nb_clients = 0;
     frames = new SrsPps();
+
+    event_send_bytes = 0;
+    event_recv_bytes = 0;
 }
 
 SrsStatisticStream::~SrsStatisticStream()
@@ -250,18 +255,59 @@ srs_error_t SrsStatisticClient::dumps(SrsJsonObject* obj)
 
 SrsStatistic* SrsStatistic::_instance = NULL;
 
+SrsStatisticEvent::SrsStatisticEvent()
+{
+    seq = 0;
+    type = SrsStatisticEventChanged;
+}
+
+SrsStatisticEvent::~SrsStatisticEvent()
+{
+}
+
+bool SrsStatisticEvent::match(string vhost, string app)
+{
+    if (!vhost.empty() && vhost != this->vhost) {
+        return false;
+    }
+    if (!app.empty() && app != this->app) {
+        return false;
+    }
+    return true;
+}
+
+string srs_stat_event_type_str(SrsStatisticEventType type)
+{
+    switch (type) {
+        case SrsStatisticEventAdded: return "added";
+        case SrsStatisticEventRemoved: return "removed";
+        case SrsStatisticEventKbps: return "kbps";
+        default: return "changed";
+    }
+}
+
 SrsStatistic::SrsStatistic()
 {
     kbps = new SrsKbps();
 
     nb_clients_ = 0;
     nb_errs_ = 0;
+
+    event_seq_ = 0;
+    event_epoch_ = srs_random_str(8);
+    nn_subscribers_ = 0;
+    event_cond_ = NULL;
 }
 
 SrsStatistic::~SrsStatistic()
 {
     srs_freep(kbps);
 
+    events_.clear();
+    if (event_cond_) {
+        srs_cond_destroy(event_cond_);
+    }
+
     if (true) {
         std::map<std::string, SrsStatisticVhost*>::iterator it;
         for (it = vhosts.begin(); it != vhosts.end(); it++) {
@@ -372,6 +418,8 @@ srs_error_t SrsStatistic::on_video_info(SrsRequest* req, SrsVideoCodecId vcodec,
 
     stream->width = width;
     stream->height = height;
+
+    on_stream_event(SrsStatisticEventChanged, stream);
     
     return err;
 }
@@ -388,6 +436,8 @@ srs_error_t SrsStatistic::on_audio_info(SrsRequest* req, SrsAudioCodecId acodec,
     stream->asample_rate = asample_rate;
     stream->asound_type = asound_type;
     stream->aac_object = aac_object;
+
+    on_stream_event(SrsStatisticEventChanged, stream);
     
     return err;
 }
@@ -410,6 +460,7 @@ void SrsStatistic::on_stream_publish(SrsRequest* req, std::string publisher_id)
     SrsStatisticStream* stream = create_stream(vhost, req);
     
     stream->publish(publisher_id);
+    on_stream_event(SrsStatisticEventChanged, stream);
 }
 
 void SrsStatistic::on_stream_close(SrsRequest* req)
@@ -417,6 +468,7 @@ void SrsStatistic::on_stream_close(SrsRequest* req)
     SrsStatisticVhost* vhost = create_vhost(req);
     SrsStatisticStream* stream = create_stream(vhost, req);
     stream->close();
+    on_stream_event(SrsStatisticEventChanged, stream);
 }
 
 srs_error_t SrsStatistic::on_client(std::string id, SrsRequest* req, ISrsExpire* conn, SrsRtmpConnType type)
@@ -449,6 +501,8 @@ srs_error_t SrsStatistic::on_client(std::string id, SrsRequest* req, ISrsExpire*
     client->req = req->copy();
 
     nb_clients_++;
+
+    on_stream_event(SrsStatisticEventChanged, stream);
     
     return err;
 }
@@ -472,6 +526,7 @@ void SrsStatistic::on_disconnect(std::string id, srs_error_t err)
         nb_errs_++;
     }
 
+    on_stream_event(SrsStatisticEventChanged, stream);
     cleanup_stream(stream);
 }
 
@@ -503,10 +558,161 @@ void SrsStatistic::cleanup_stream(SrsStatisticStream* stream)
         }
     }
 
+    on_stream_event(SrsStatisticEventRemoved, stream);
+
     // It's safe to delete the stream now.
     srs_freep(stream);
 }
 
+void SrsStatistic::on_stream_event(SrsStatisticEventType type, SrsStatisticStream* stream)
+{
+    srs_error_t err = srs_success;
+
+    // Never generate events if no subscribers, who start from the snapshot when subscribe.
+    if (nn_subscribers_ <= 0) {
+        return;
+    }
+
+    SrsUniquePtr<SrsJsonObject> obj(SrsJsonAny::object());
+    if (type == SrsStatisticEventRemoved) {
+        obj->set("id", SrsJsonAny::str(stream->id.c_str()));
+    } else if ((err = stream->dumps(obj.get())) != srs_success) {
+        srs_warn("ignore stream event err %s", srs_error_desc(err).c_str());
+        srs_freep(err);
+        return;
+    }
+
+    push_event(type, stream->vhost->vhost, stream->app, obj->dumps());
+}
+
+void SrsStatistic::push_event(SrsStatisticEventType type, string vhost, string app, string data)
+{
+    SrsStatisticEvent* event = new SrsStatisticEvent();
+    event->seq = ++event_seq_;
+    event->type = type;
+    event->vhost = vhost;
+    event->app = app;
+    event->data = data;
+
+    events_.push_back(SrsSharedPtr<SrsStatisticEvent>(event));
+    while (events_.size() > SRS_STAT_EVENTS_MAX) {
+        events_.pop_front();
+    }
+
+    if (event_cond_) {
+        srs_cond_broadcast(event_cond_);
+    }
+}
+
+void SrsStatistic::subscribe()
+{
+    nn_subscribers_++;
+}
+
+void SrsStatistic::unsubscribe()
+{
+    nn_subscribers_--;
+
+    // Free the events when no subscribers, and the events are not recorded until subscribe again,
+    // so renew the epoch to reset the subscriber which resumes from the previous events.
+    if (nn_subscribers_ <= 0) {
+        events_.clear();
+        event_epoch_ = srs_random_str(8);
+    }
+}
+
+uint64_t SrsStatistic::event_seq()
+{
+    return event_seq_;
+}
+
+string SrsStatistic::event_id(uint64_t seq)
+{
+    return srs_fmt("%s-%" PRIu64, event_epoch_.c_str(), seq);
+}
+
+bool SrsStatistic::parse_event_id(string id, uint64_t& seq)
+{
+    size_t pos = id.find("-");
+    if (pos == string::npos || id.substr(0, pos) != event_epoch_) {
+        return false;
+    }
+
+    string v = id.substr(pos + 1);
+    if (v.empty() || v.find_first_not_of("0123456789") != string::npos) {
+        return false;
+    }
+
+    seq = (uint64_t)::strtoull(v.c_str(), NULL, 10);
+    return true;
+}
+
+bool SrsStatistic::fetch_events(uint64_t seq, string vhost, string app, vector< SrsSharedPtr<SrsStatisticEvent> >& events)
+{
+    // The seq is newer than the last event, which is never generated in this epoch.
+    if (seq > event_seq_) {
+        return false;
+    }
+    if (seq == event_seq_) {
+        return true;
+    }
+
+    // The events are continuous, so we find the start by seq.
+    if (events_.empty() || seq + 1 < events_.front()->seq) {
+        return false;
+    }
+    uint64_t first = events_.front()->seq;
+
+    for (size_t i = (size_t)(seq + 1 - first); i < events_.size(); i++) {
+        SrsSharedPtr<SrsStatisticEvent>& event = events_.at(i);
+        if (event->match(vhost, app)) {
+            events.push_back(event);
+        }
+    }
+
+    return true;
+}
+
+void SrsStatistic::snapshot_events(string vhost, string app, vector< SrsSharedPtr<SrsStatisticEvent> >& events)
+{
+    srs_error_t err = srs_success;
+
+    std::map<std::string, SrsStatisticStream*>::iterator it;
+    for (it = streams.begin(); it != streams.end(); it++) {
+        SrsStatisticStream* stream = it->second;
+
+        SrsStatisticEvent* event = new SrsStatisticEvent();
+        SrsSharedPtr<SrsStatisticEvent> event_ptr(event);
+        event->seq = event_seq_;
+        event->type = SrsStatisticEventAdded;
+        event->vhost = stream->vhost->vhost;
+        event->app = stream->app;
+        if (!event->match(vhost, app)) {
+            continue;
+        }
+
+        SrsUniquePtr<SrsJsonObject> obj(SrsJsonAny::object());
+        if ((err = stream->dumps(obj.get())) != srs_success) {
+            srs_warn("ignore stream snapshot err %s", srs_error_desc(err).c_str());
+            srs_freep(err);
+            continue;
+        }
+        event->data = obj->dumps();
+
+        events.push_back(event_ptr);
+    }
+}
+
+void SrsStatistic::wait_events(srs_utime_t timeout)
+{
+    // Create the cond when used, because the ST might not be ready when create the statistic.
+    if (!event_cond_) {
+        event_cond_ = srs_cond_new();
+    }
+
+    srs_cond_timedwait(event_cond_, timeout);
+}
+
 void SrsStatistic::kbps_add_delta(std::string id, ISrsKbpsDelta* delta)
 {
     if (!delta) return;
@@ -539,11 +745,49 @@ void SrsStatistic::kbps_sample()
         }
     }
     if (true) {
+        // The kbps of changed streams, aggregated by app, to push one kbps event for each app.
+        std::map<std::string, SrsStatisticStream*> apps;
+        std::map<std::string, SrsJsonArray*> changes;
+
         std::map<std::string, SrsStatisticStream*>::iterator it;
         for (it = streams.begin(); it != streams.end(); it++) {
             SrsStatisticStream* stream = it->second;
             stream->kbps->sample();
             stream->frames->update();
+
+            // Only push the kbps of streams which have data transferred.
+            int64_t send_bytes = stream->kbps->get_send_bytes();
+            int64_t recv_bytes = stream->kbps->get_recv_bytes();
+            if (send_bytes == stream->event_send_bytes && recv_bytes == stream->event_recv_bytes) {
+                continue;
+            }
+            stream->event_send_bytes = send_bytes;
+            stream->event_recv_bytes = recv_bytes;
+
+            if (nn_subscribers_ <= 0) {
+                continue;
+            }
+
+            string key = stream->vhost->vhost + "/" + stream->app;
+            SrsJsonArray*& arr = changes[key];
+            if (!arr) {
+                arr = SrsJsonAny::array();
+                apps[key] = stream;
+            }
+
+            arr->append(SrsJsonAny::object()
+                ->set("id", SrsJsonAny::str(stream->id.c_str()))
+                ->set("name", SrsJsonAny::str(stream->stream.c_str()))
+                ->set("kbps", SrsJsonAny::object()
+                    ->set("recv_30s", SrsJsonAny::integer(stream->kbps->get_recv_kbps_30s()))
+                    ->set("send_30s", SrsJsonAny::integer(stream->kbps->get_send_kbps_30s()))));
+        }
+
+        std::map<std::string, SrsJsonArray*>::iterator it2;
+        for (it2 = changes.begin(); it2 != changes.end(); ++it2) {
+            SrsUniquePtr<SrsJsonArray> arr(it2->second);
+            SrsStatisticStream* stream = apps[it2->first];
+            push_event(SrsStatisticEventKbps, stream->vhost->vhost, stream->app, arr->dumps());
         }
     }
     if (true) {
@@ -603,49 +847,83 @@ srs_error_t SrsStatistic::dumps_vhosts(SrsJsonArray* arr)
     return err;
 }
 
-srs_error_t SrsStatistic::dumps_streams(SrsJsonArray* arr, int start, int count)
+srs_error_t SrsStatistic::dumps_streams(SrsJsonWriter* jw, int start, string cursor, int count, string& next)
 {
     srs_error_t err = srs_success;
 
-    std::map<std::string, SrsStatisticStream*>::iterator it = streams.begin();
-    for (int i = 0; i < start + count && it != streams.end(); it++, i++) {
-        if (i < start) {
-            continue;
-        }
+    // The cursor is the key of map, so the page is stable even if streams are added or removed.
+    std::map<std::string, SrsStatisticStream*>::iterator it = streams.upper_bound(cursor);
+    for (int i = 0; cursor.empty() && i < start && it != streams.end(); i++) {
+        it++;
+    }
 
+    for (int i = 0; i < count && it != streams.end(); i++) {
         SrsStatisticStream* stream = it->second;
-        
-        SrsJsonObject* obj = SrsJsonAny::object();
-        arr->append(obj);
-        
-        if ((err = stream->dumps(obj)) != srs_success) {
+        cursor = it->first;
+
+        SrsUniquePtr<SrsJsonObject> obj(SrsJsonAny::object());
+        if ((err = stream->dumps(obj.get())) != srs_success) {
             return srs_error_wrap(err, "dump stream");
         }
+
+        if ((err = jw->any(obj.get())) != srs_success) {
+            return srs_error_wrap(err, "write stream");
+        }
+
+        // Yield between batches, to keep the media coroutines running.
+        if (((i + 1) % SRS_STAT_DUMPS_BATCH) == 0) {
+            if ((err = jw->flush()) != srs_success) {
+                return srs_error_wrap(err, "flush streams");
+            }
+            srs_thread_yield();
+        }
+
+        // Find by cursor again, because the iterator is invalid if streams changed when writing or yield.
+        it = streams.upper_bound(cursor);
     }
-    
+
+    next = (it != streams.end()) ? cursor : "";
+
     return err;
 }
 
-srs_error_t SrsStatistic::dumps_clients(SrsJsonArray* arr, int start, int count)
+srs_error_t SrsStatistic::dumps_clients(SrsJsonWriter* jw, int start, string cursor, int count, string& next)
 {
     srs_error_t err = srs_success;
-    
-    std::map<std::string, SrsStatisticClient*>::iterator it = clients.begin();
-    for (int i = 0; i < start + count && it != clients.end(); it++, i++) {
-        if (i < start) {
-            continue;
-        }
-        
+
+    // The cursor is the key of map, so the page is stable even if clients are added or removed.
+    std::map<std::string, SrsStatisticClient*>::iterator it = clients.upper_bound(cursor);
+    for (int i = 0; cursor.empty() && i < start && it != clients.end(); i++) {
+        it++;
+    }
+
+    for (int i = 0; i < count && it != clients.end(); i++) {
         SrsStatisticClient* client = it->second;
-        
-        SrsJsonObject* obj = SrsJsonAny::object();
-        arr->append(obj);
-        
-        if ((err = client->dumps(obj)) != srs_success) {
+        cursor = it->first;
+
+        SrsUniquePtr<SrsJsonObject> obj(SrsJsonAny::object());
+        if ((err = client->dumps(obj.get())) != srs_success) {
             return srs_error_wrap(err, "dump client");
         }
+
+        if ((err = jw->any(obj.get())) != srs_success) {
+            return srs_error_wrap(err, "write client");
+        }
+
+        // Yield between batches, to keep the media coroutines running.
+        if (((i + 1) % SRS_STAT_DUMPS_BATCH) == 0) {
+            if ((err = jw->flush()) != srs_success) {
+                return srs_error_wrap(err, "flush clients");
+            }
+            srs_thread_yield();
+        }
+
+        // Find by cursor again, because the iterator is invalid if clients changed when writing or yield.
+        it = clients.upper_bound(cursor);
     }
-    
+
+    next = (it != clients.end()) ? cursor : "";
+
     return err;
 }
 
@@ -776,6 +1054,7 @@ SrsStatisticStream* SrsStatistic::create_stream(SrsStatisticVhost* vhost, SrsReq
         stream->tcUrl = req->tcUrl;
         rstreams[url] = stream;
         streams[stream->id] = stream;
+        on_stream_event(SrsStatisticEventAdded, stream);
         return stream;
     }
     
@@ -10,12 +10,15 @@
 #include <srs_core.hpp>
 
 #include <map>
+#include <deque>
 #include <string>
 #include <vector>
 #include <sstream>
 
 #include <srs_kernel_codec.hpp>
 #include <srs_protocol_rtmp_stack.hpp>
+#include <srs_protocol_st.hpp>
+#include <srs_core_autofree.hpp>
 
 class SrsKbps;
 class SrsWallClock;
@@ -23,11 +26,17 @@ class SrsRequest;
 class ISrsExpire;
 class SrsJsonObject;
 class SrsJsonArray;
+class SrsJsonWriter;
 class ISrsKbpsDelta;
 class SrsClsSugar;
 class SrsClsSugars;
 class SrsPps;
 
+// The number of clients or streams to dump, before yield to other coroutines.
+#define SRS_STAT_DUMPS_BATCH 100
+// The max number of events to keep for subscribers, the slow subscriber should reload the snapshot.
+#define SRS_STAT_EVENTS_MAX 4096
+
 struct SrsStatisticVhost
 {
 public:
@@ -63,6 +72,9 @@ public:
     SrsKbps* kbps;
     // The fps of stream.
     SrsPps* frames;
+    // The bytes when generate the last kbps event.
+    int64_t event_send_bytes;
+    int64_t event_recv_bytes;
 public:
     bool has_video;
     SrsVideoCodecId vcodec;
@@ -122,6 +134,37 @@ public:
     virtual srs_error_t dumps(SrsJsonObject* obj);
 };
 
+// The type of stream event, pushed to subscribers.
+enum SrsStatisticEventType
+{
+    SrsStatisticEventAdded = 0,
+    SrsStatisticEventChanged,
+    SrsStatisticEventRemoved,
+    SrsStatisticEventKbps,
+};
+std::string srs_stat_event_type_str(SrsStatisticEventType type);
+
+// The event of stream, a delta of statistic for subscribers.
+class SrsStatisticEvent
+{
+public:
+    // The sequence of event, increase from 1.
+    uint64_t seq;
+    SrsStatisticEventType type;
+    // The vhost and app, for subscribers to filter the events.
+    std::string vhost;
+    std::string app;
+    // The JSON of stream, or only the id for removed stream. For kbps event, it's the array of kbps
+    // of changed streams in the same app.
+    std::string data;
+public:
+    SrsStatisticEvent();
+    virtual ~SrsStatisticEvent();
+public:
+    // Whether match the filter, empty to match all.
+    virtual bool match(std::string vhost, std::string app);
+};
+
 class SrsStatistic
 {
 private:
@@ -154,6 +197,19 @@ private:
     int64_t nb_clients_;
     // The total of clients errors.
     int64_t nb_errs_;
+private:
+    // The events for subscribers, only record when there are subscribers.
+    std::deque< SrsSharedPtr<SrsStatisticEvent> > events_;
+    // The sequence of last event.
+    uint64_t event_seq_;
+    // The epoch of events, renew when the events are discarded, so the subscriber must reset by the
+    // snapshot if the epoch of its last event id is not the same, for example, after an idle gap
+    // without subscribers, or the server restarted.
+    std::string event_epoch_;
+    // The number of subscribers.
+    int nn_subscribers_;
+    // To notify the subscribers for new events.
+    srs_cond_t event_cond_;
 private:
     SrsStatistic();
     virtual ~SrsStatistic();
@@ -195,6 +251,30 @@ public:
 private:
     // Cleanup the stream if stream is not active and for the last client.
     void cleanup_stream(SrsStatisticStream* stream);
+    // Generate the event of stream for subscribers.
+    void on_stream_event(SrsStatisticEventType type, SrsStatisticStream* stream);
+    // Push the event to subscribers, the seq only increases when event is pushed, so the events
+    // are continuous for subscribers to resume.
+    void push_event(SrsStatisticEventType type, std::string vhost, std::string app, std::string data);
+public:
+    // Subscribe or unsubscribe the events, we only record events when there are subscribers.
+    virtual void subscribe();
+    virtual void unsubscribe();
+    // The sequence of last event.
+    virtual uint64_t event_seq();
+    // The id of event for subscriber to resume, in the format of epoch-seq.
+    virtual std::string event_id(uint64_t seq);
+    // Parse the seq from the id of event.
+    // @return false if the id is malformed or of other epoch, so the subscriber should reload the snapshot.
+    virtual bool parse_event_id(std::string id, uint64_t& seq);
+    // Fetch the events after seq, filtered by vhost and app, which are empty to match all.
+    // @return false if some events after seq are discarded, or the seq is newer than the last event,
+    //      so the subscriber should reload the snapshot.
+    virtual bool fetch_events(uint64_t seq, std::string vhost, std::string app, std::vector< SrsSharedPtr<SrsStatisticEvent> >& events);
+    // The added events of all streams, filtered by vhost and app, as the snapshot for subscriber.
+    virtual void snapshot_events(std::string vhost, std::string app, std::vector< SrsSharedPtr<SrsStatisticEvent> >& events);
+    // Wait for new events, or timeout.
+    virtual void wait_events(srs_utime_t timeout);
 public:
     // Sample the kbps, add delta bytes of conn.
     // Use kbps_sample() to get all result of kbps stat.
@@ -211,14 +291,14 @@ public:
     virtual std::string service_pid();
     // Dumps the vhosts to amf0 array.
     virtual srs_error_t dumps_vhosts(SrsJsonArray* arr);
-    // Dumps the streams to amf0 array.
-    // @param start the start index, from 0.
-    // @param count the max count of streams to dump.
-    virtual srs_error_t dumps_streams(SrsJsonArray* arr, int start, int count);
-    // Dumps the clients to amf0 array
-    // @param start the start index, from 0.
-    // @param count the max count of clients to dump.
-    virtual srs_error_t dumps_clients(SrsJsonArray* arr, int start, int count);
+    // Dumps the streams to streaming JSON writer, yield between batches, so never build the whole list.
+    // @param cursor the id of last stream in previous page, empty to use start.
+    // @param next the cursor of next page, empty if no more streams.
+    virtual srs_error_t dumps_streams(SrsJsonWriter* jw, int start, std::string cursor, int count, std::string& next);
+    // Dumps the clients to streaming JSON writer, yield between batches, so never build the whole list.
+    // @param cursor the id of last client in previous page, empty to use start.
+    // @param next the cursor of next page, empty if no more clients.
+    virtual srs_error_t dumps_clients(SrsJsonWriter* jw, int start, std::string cursor, int count, std::string& next);
     // Dumps the hints about SRS server.
     void dumps_hints_kv(std::stringstream & ss);
 #ifdef SRS_APM
@@ -18,10 +18,18 @@
 #include <srs_app_async_call.hpp>
 #include <srs_app_tencentcloud.hpp>
 #include <srs_app_conn.hpp>
+#include <srs_protocol_rtmp_handshake.hpp>
+#include <srs_app_http_hooks.hpp>
+#include <srs_app_edge.hpp>
+#include <srs_kernel_balance.hpp>
+#include <srs_app_heartbeat.hpp>
 #ifdef SRS_RTC
 #include <srs_app_rtc_dtls.hpp>
 #include <srs_app_rtc_conn.hpp>
 #endif
+#ifdef SRS_FFMPEG_FIT
+#include <srs_app_rtc_codec.hpp>
+#endif
 #ifdef SRS_SRT
 #include <srs_app_srt_source.hpp>
 #endif
@@ -71,6 +79,10 @@ extern SrsDtlsCertificate* _srs_rtc_dtls_certificate;
 
 SrsPps* _srs_pps_aloss2 = NULL;
 
+// The frames dropped and players rejected for load shedding.
+SrsPps* _srs_pps_shed_frames = NULL;
+SrsPps* _srs_pps_shed_rejects = NULL;
+
 extern SrsPps* _srs_pps_ids;
 extern SrsPps* _srs_pps_fids;
 extern SrsPps* _srs_pps_fids_level0;
@@ -78,6 +90,15 @@ extern SrsPps* _srs_pps_dispose;
 
 extern SrsPps* _srs_pps_timer;
 
+extern SrsPps* _srs_pps_hs_complex;
+extern SrsPps* _srs_pps_hs_degrade;
+extern SrsPps* _srs_pps_hs_hit;
+extern SrsPps* _srs_pps_hs_miss;
+
+extern SrsPps* _srs_pps_async_calls;
+extern SrsPps* _srs_pps_async_drops;
+extern SrsPps* _srs_pps_async_wait;
+
 extern SrsPps* _srs_pps_snack;
 extern SrsPps* _srs_pps_snack2;
 extern SrsPps* _srs_pps_snack3;
@@ -183,6 +204,7 @@ SrsCircuitBreaker::SrsCircuitBreaker()
     critical_pulse_ = 0;
     dying_threshold_ = 0;
     dying_pulse_ = 0;
+    shed_priority_ = 0;
 
     hybrid_high_water_level_ = 0;
     hybrid_critical_water_level_ = 0;
@@ -204,14 +226,15 @@ srs_error_t SrsCircuitBreaker::initialize()
     critical_pulse_ = _srs_config->get_critical_pulse();
     dying_threshold_ = _srs_config->get_dying_threshold();
     dying_pulse_ = _srs_config->get_dying_pulse();
+    shed_priority_ = _srs_config->get_shed_priority();
 
     // Update the water level for circuit breaker.
     // @see SrsCircuitBreaker::on_timer()
     _srs_hybrid->timer1s()->subscribe(this);
 
-    srs_trace("CircuitBreaker: enabled=%d, high=%dx%d, critical=%dx%d, dying=%dx%d", enabled_,
+    srs_trace("CircuitBreaker: enabled=%d, high=%dx%d, critical=%dx%d, dying=%dx%d, shed=%d", enabled_,
         high_pulse_, high_threshold_, critical_pulse_, critical_threshold_,
-        dying_pulse_, dying_threshold_);
+        dying_pulse_, dying_threshold_, shed_priority_);
 
     return err;
 }
@@ -231,6 +254,25 @@ bool SrsCircuitBreaker::hybrid_dying_water_level()
     return enabled_ && dying_pulse_ && hybrid_dying_water_level_ >= dying_pulse_;
 }
 
+bool SrsCircuitBreaker::is_low_priority(string vhost)
+{
+    return enabled_ && shed_priority_ > 0 && _srs_config->get_vhost_snapshot(vhost)->priority < shed_priority_;
+}
+
+bool SrsCircuitBreaker::should_reject_player(string vhost)
+{
+    if (!enabled_ || shed_priority_ <= 0) {
+        return false;
+    }
+
+    bool reject = hybrid_dying_water_level() || (hybrid_critical_water_level() && is_low_priority(vhost));
+    if (reject) {
+        ++_srs_pps_shed_rejects->sugar;
+    }
+
+    return reject;
+}
+
 srs_error_t SrsCircuitBreaker::on_timer(srs_utime_t interval)
 {
     srs_error_t err = srs_success;
@@ -319,6 +361,8 @@ srs_error_t srs_global_initialize()
     _srs_sources = new SrsLiveSourceManager();
     _srs_stages = new SrsStageManager();
     _srs_circuit_breaker = new SrsCircuitBreaker();
+    _srs_stacks = new SrsCoroutineStacks();
+    _srs_hooks_pool = new SrsHttpHooksPool();
 
 #ifdef SRS_SRT
     _srs_srt_sources = new SrsSrtSourceManager();
@@ -331,6 +375,9 @@ srs_error_t srs_global_initialize()
     _srs_rtc_manager = new SrsResourceManager("RTC", true);
     _srs_rtc_dtls_certificate = new SrsDtlsCertificate();
 #endif
+#ifdef SRS_FFMPEG_FIT
+    _srs_audio_transcode_workers = new SrsAudioTranscodeWorkers();
+#endif
 #ifdef SRS_GB28181
     _srs_gb_manager = new SrsResourceManager("GB", true);
 #endif
@@ -345,6 +392,21 @@ srs_error_t srs_global_initialize()
     _srs_pps_conn = new SrsPps();
     _srs_pps_pub = new SrsPps();
 
+    _srs_pps_hs_complex = new SrsPps();
+    _srs_pps_hs_degrade = new SrsPps();
+    _srs_pps_hs_hit = new SrsPps();
+    _srs_pps_hs_miss = new SrsPps();
+
+    // The pool for RTMP complex handshake, which depends on pps.
+    _srs_handshake_pool = new SrsHandshakeKeyPool();
+
+    _srs_pps_async_calls = new SrsPps();
+    _srs_pps_async_drops = new SrsPps();
+    _srs_pps_async_wait = new SrsPps();
+
+    _srs_pps_shed_frames = new SrsPps();
+    _srs_pps_shed_rejects = new SrsPps();
+
 #ifdef SRS_RTC
     _srs_pps_snack = new SrsPps();
     _srs_pps_snack2 = new SrsPps();
@@ -442,6 +504,12 @@ srs_error_t srs_global_initialize()
     // Create global async worker for DVR.
     _srs_dvr_async = new SrsAsyncCallWorker();
 
+    // The load and health of origins for edge.
+    _srs_edge_loads = new SrsLbLoads();
+
+    // The load of peers, for load-aware redirect.
+    _srs_load_redirect = new SrsLoadRedirect();
+
 #ifdef SRS_APM
     // Initialize global TencentCloud CLS object.
     _srs_cls = new SrsClsClient();
@@ -457,6 +525,12 @@ srs_error_t srs_global_initialize()
 
 void srs_global_dispose()
 {
+#ifdef SRS_FFMPEG_FIT
+    // Stop the audio transcode workers, which depends on hybrid timer, and the transcoders in
+    // sources free the queues after workers quit.
+    srs_freep(_srs_audio_transcode_workers);
+#endif
+
     // Note that hybrid depends on sources.
     srs_freep(_srs_hybrid);
     srs_freep(_srs_sources);
@@ -465,6 +539,8 @@ void srs_global_dispose()
 
     srs_freep(_srs_stages);
     srs_freep(_srs_circuit_breaker);
+    srs_freep(_srs_hooks_pool);
+    srs_freep(_srs_stacks);
 
 #ifdef SRS_SRT
     srs_freep(_srs_srt_sources);
@@ -489,6 +565,18 @@ void srs_global_dispose()
     srs_freep(_srs_pps_conn);
     srs_freep(_srs_pps_pub);
 
+    srs_freep(_srs_handshake_pool);
+    srs_freep(_srs_pps_hs_complex);
+    srs_freep(_srs_pps_hs_degrade);
+    srs_freep(_srs_pps_hs_hit);
+    srs_freep(_srs_pps_hs_miss);
+
+    srs_freep(_srs_pps_async_calls);
+    srs_freep(_srs_pps_shed_frames);
+    srs_freep(_srs_pps_shed_rejects);
+    srs_freep(_srs_pps_async_drops);
+    srs_freep(_srs_pps_async_wait);
+
 #ifdef SRS_RTC
     srs_freep(_srs_pps_snack);
     srs_freep(_srs_pps_snack2);
@@ -584,6 +672,8 @@ void srs_global_dispose()
 #endif
 
     srs_freep(_srs_dvr_async);
+    srs_freep(_srs_edge_loads);
+    srs_freep(_srs_load_redirect);
 
 #ifdef SRS_APM
     srs_freep(_srs_cls);
@@ -643,6 +733,38 @@ void SrsThreadMutex::unlock()
     srs_assert(!r0);
 }
 
+SrsThreadCond::SrsThreadCond()
+{
+    // https://man7.org/linux/man-pages/man3/pthread_cond_init.3p.html
+    int r0 = pthread_cond_init(&cond_, NULL);
+    srs_assert(!r0);
+}
+
+SrsThreadCond::~SrsThreadCond()
+{
+    int r0 = pthread_cond_destroy(&cond_);
+    srs_assert(!r0);
+}
+
+void SrsThreadCond::wait(SrsThreadMutex* mutex)
+{
+    // https://man7.org/linux/man-pages/man3/pthread_cond_wait.3p.html
+    int r0 = pthread_cond_wait(&cond_, &mutex->lock_);
+    srs_assert(!r0);
+}
+
+void SrsThreadCond::signal()
+{
+    int r0 = pthread_cond_signal(&cond_);
+    srs_assert(!r0);
+}
+
+void SrsThreadCond::broadcast()
+{
+    int r0 = pthread_cond_broadcast(&cond_);
+    srs_assert(!r0);
+}
+
 SrsThreadEntry::SrsThreadEntry()
 {
     pool = NULL;
@@ -12,6 +12,7 @@
 #include <srs_app_hourglass.hpp>
 
 #include <pthread.h>
+#include <string>
 
 class SrsThreadPool;
 class SrsProcSelfStat;
@@ -28,6 +29,8 @@ private:
     int critical_pulse_;
     int dying_threshold_;
     int dying_pulse_;
+    // The vhost with lower priority is shed first.
+    int shed_priority_;
 private:
     // Reset the water-level when CPU is low for N times.
     // @note To avoid the CPU change rapidly.
@@ -44,6 +47,12 @@ public:
     bool hybrid_high_water_level();
     bool hybrid_critical_water_level();
     bool hybrid_dying_water_level();
+public:
+    // Whether the vhost is low-priority, whose load is shed first when overloaded.
+    bool is_low_priority(std::string vhost);
+    // Whether reject the new player of vhost, never reject publishers and existing players.
+    // @remark Reject new players of low-priority vhosts if critical, and all vhosts if dying.
+    bool should_reject_player(std::string vhost);
 // interface ISrsFastTimer
 private:
     srs_error_t on_timer(srs_utime_t interval);
@@ -58,6 +67,7 @@ extern void srs_global_dispose();
 // The thread mutex wrapper, without error.
 class SrsThreadMutex
 {
+    friend class SrsThreadCond;
 private:
     pthread_mutex_t lock_;
     pthread_mutexattr_t attr_;
@@ -69,6 +79,22 @@ public:
     void unlock();
 };
 
+// The thread condition variable, wait with a locked SrsThreadMutex.
+class SrsThreadCond
+{
+private:
+    pthread_cond_t cond_;
+public:
+    SrsThreadCond();
+    virtual ~SrsThreadCond();
+public:
+    // Unlock the mutex and wait for signal, then lock the mutex again.
+    // @remark The mutex MUST be locked by current thread.
+    void wait(SrsThreadMutex* mutex);
+    void signal();
+    void broadcast();
+};
+
 // The thread mutex locker.
 // TODO: FIXME: Rename _SRS to _srs
 #define SrsThreadLocker(instance) \
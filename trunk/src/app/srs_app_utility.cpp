@@ -25,6 +25,8 @@ using namespace std;
 
 #include <srs_kernel_log.hpp>
 #include <srs_app_config.hpp>
+#include <srs_app_st.hpp>
+#include <srs_protocol_stream.hpp>
 #include <srs_kernel_utility.hpp>
 #include <srs_kernel_error.hpp>
 #include <srs_protocol_kbps.hpp>
@@ -1263,6 +1265,31 @@ int srs_get_peer_port(int fd)
     return port;
 }
 
+bool srs_is_endpoint_ip(const vector<string>& endpoints, const string& ip)
+{
+    if (ip.empty()) {
+        return false;
+    }
+
+    for (int i = 0; i < (int)endpoints.size(); i++) {
+        string host; int port = 0;
+        srs_parse_endpoint(endpoints.at(i), host, port);
+        if (host.empty()) {
+            continue;
+        }
+        if (host == ip) {
+            return true;
+        }
+
+        int family = 0;
+        if (srs_dns_resolve(host, family) == ip) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
 bool srs_is_boolean(string str)
 {
     return str == "true" || str == "false";
@@ -1377,6 +1404,25 @@ void srs_api_dump_summaries(SrsJsonObject* obj)
     sys->set("conn_sys_tw", SrsJsonAny::integer(nrs->nb_conn_sys_tw));
     sys->set("conn_sys_udp", SrsJsonAny::integer(nrs->nb_conn_sys_udp));
     sys->set("conn_srs", SrsJsonAny::integer(nrs->nb_conn_srs));
+
+    // The receive buffers of connections.
+    SrsFastStreamPool* pool = SrsFastStreamPool::instance();
+    SrsJsonObject* rbuf = SrsJsonAny::object();
+    data->set("recv_buffer", rbuf);
+
+    rbuf->set("streams", SrsJsonAny::integer(pool->nn_streams));
+    rbuf->set("bytes", SrsJsonAny::integer(pool->nb_bytes));
+    rbuf->set("avg_bytes", SrsJsonAny::integer(pool->nn_streams ? pool->nb_bytes / pool->nn_streams : 0));
+    rbuf->set("pool_bytes", SrsJsonAny::integer(pool->free_bytes()));
+    rbuf->set("grows", SrsJsonAny::integer(pool->nn_grows));
+    rbuf->set("shrinks", SrsJsonAny::integer(pool->nn_shrinks));
+
+    // The stacks of coroutines.
+    SrsJsonObject* stack = SrsJsonAny::object();
+    data->set("stack", stack);
+    if (_srs_stacks) {
+        _srs_stacks->dumps(stack);
+    }
 }
 
 string srs_getenv(const string& key)
@@ -668,6 +668,10 @@ extern int srs_get_local_port(int fd);
 extern std::string srs_get_peer_ip(int fd);
 extern int srs_get_peer_port(int fd);
 
+// Whether the ip is the host of any endpoint, to accept requests from the configured peers only.
+// @remark The host of endpoint is resolved if it's a domain name.
+extern bool srs_is_endpoint_ip(const std::vector<std::string>& endpoints, const std::string& ip);
+
 // Whether string is boolean
 //      is_bool("true") == true
 //      is_bool("false") == true
@@ -7,9 +7,31 @@
 #include <srs_kernel_balance.hpp>
 
 #include <srs_kernel_error.hpp>
+#include <srs_kernel_utility.hpp>
 
 using namespace std;
 
+// The penalty of each continuous failure, in number of active streams.
+#define SRS_LB_FAILURE_PENALTY 100
+// The failures expire after this timeout, then the server will be probed again.
+#define SRS_LB_FAILURE_TIMEOUT (30 * SRS_UTIME_SECONDS)
+
+ISrsLoadBalancer::ISrsLoadBalancer()
+{
+}
+
+ISrsLoadBalancer::~ISrsLoadBalancer()
+{
+}
+
+void ISrsLoadBalancer::feedback(const string& /*server*/, bool /*ok*/)
+{
+}
+
+void ISrsLoadBalancer::release()
+{
+}
+
 SrsLbRoundRobin::SrsLbRoundRobin()
 {
     index = -1;
@@ -40,3 +62,227 @@ string SrsLbRoundRobin::select(const vector<string>& servers)
     return elem;
 }
 
+SrsLbConsistentHash::SrsLbConsistentHash(string k)
+{
+    key = k;
+    index = -1;
+}
+
+SrsLbConsistentHash::~SrsLbConsistentHash()
+{
+}
+
+uint32_t SrsLbConsistentHash::current()
+{
+    return index;
+}
+
+string SrsLbConsistentHash::selected()
+{
+    return elem;
+}
+
+string SrsLbConsistentHash::select(const vector<string>& servers)
+{
+    srs_assert(!servers.empty());
+
+    // Stick to the selected server, until it fails or removed.
+    for (int i = 0; !elem.empty() && i < (int)servers.size(); i++) {
+        if (servers.at(i) == elem && failed.find(elem) == failed.end()) {
+            index = i;
+            return elem;
+        }
+    }
+
+    // Reset the failed servers if all failed, to retry from the highest weight one.
+    int nn_failed = 0;
+    for (int i = 0; i < (int)servers.size(); i++) {
+        if (failed.find(servers.at(i)) != failed.end()) {
+            nn_failed++;
+        }
+    }
+    if (nn_failed == (int)servers.size()) {
+        failed.clear();
+    }
+
+    // Select the highest weight server, which is not failed.
+    index = -1;
+    uint32_t max_weight = 0;
+    for (int i = 0; i < (int)servers.size(); i++) {
+        const string& server = servers.at(i);
+        if (failed.find(server) != failed.end()) {
+            continue;
+        }
+
+        uint32_t w = weight(key, server);
+        if (index == -1 || w > max_weight) {
+            index = i;
+            max_weight = w;
+        }
+    }
+
+    elem = servers.at(index);
+    return elem;
+}
+
+void SrsLbConsistentHash::feedback(const string& server, bool ok)
+{
+    if (ok) {
+        failed.erase(server);
+    } else {
+        failed.insert(server);
+    }
+}
+
+uint32_t SrsLbConsistentHash::weight(const string& key, const string& server)
+{
+    uint32_t v = srs_crc32_ieee(key.data(), (int)key.length());
+    v = srs_crc32_ieee(server.data(), (int)server.length(), v);
+
+    // Mix the bits, because CRC is linear and weak as hash for similar inputs.
+    v ^= v >> 16; v *= 0x85ebca6b;
+    v ^= v >> 13; v *= 0xc2b2ae35;
+    v ^= v >> 16;
+    return v;
+}
+
+SrsLbLoads::SrsLbLoads()
+{
+}
+
+SrsLbLoads::~SrsLbLoads()
+{
+}
+
+void SrsLbLoads::acquire(const string& server)
+{
+    actives[server]++;
+}
+
+void SrsLbLoads::release(const string& server)
+{
+    map<string, int>::iterator it = actives.find(server);
+    if (it != actives.end() && --it->second <= 0) {
+        actives.erase(it);
+    }
+}
+
+void SrsLbLoads::on_failure(const string& server)
+{
+    failures[server]++;
+    failed_at[server] = srs_get_system_time();
+}
+
+void SrsLbLoads::on_success(const string& server)
+{
+    failures.erase(server);
+    failed_at.erase(server);
+}
+
+int SrsLbLoads::load(const string& server)
+{
+    int v = 0;
+
+    map<string, int>::iterator it = actives.find(server);
+    if (it != actives.end()) {
+        v = it->second;
+    }
+
+    map<string, int>::iterator it2 = failures.find(server);
+    if (it2 != failures.end() && srs_get_system_time() - failed_at[server] < SRS_LB_FAILURE_TIMEOUT) {
+        v += it2->second * SRS_LB_FAILURE_PENALTY;
+    }
+
+    return v;
+}
+
+SrsLbLeastLoaded::SrsLbLeastLoaded(SrsLbLoads* l, string k)
+{
+    loads = l;
+    key = k;
+    index = -1;
+    elem_failed = false;
+    elem_acquired = false;
+}
+
+SrsLbLeastLoaded::~SrsLbLeastLoaded()
+{
+    release();
+}
+
+uint32_t SrsLbLeastLoaded::current()
+{
+    return index;
+}
+
+string SrsLbLeastLoaded::selected()
+{
+    return elem;
+}
+
+string SrsLbLeastLoaded::select(const vector<string>& servers)
+{
+    srs_assert(!servers.empty());
+
+    // Stick to the selected server, until it fails or removed.
+    for (int i = 0; !elem.empty() && !elem_failed && i < (int)servers.size(); i++) {
+        if (servers.at(i) == elem) {
+            index = i;
+
+            // Count the load again if released, for example, restart the stopped stream.
+            if (!elem_acquired) {
+                loads->acquire(elem);
+                elem_acquired = true;
+            }
+            return elem;
+        }
+    }
+
+    // Release the previous server, to not count it as load.
+    release();
+
+    // Select the least loaded server, use weight for the same load.
+    index = -1;
+    int min_load = 0;
+    uint32_t max_weight = 0;
+    for (int i = 0; i < (int)servers.size(); i++) {
+        const string& server = servers.at(i);
+
+        int v = loads->load(server);
+        uint32_t w = SrsLbConsistentHash::weight(key, server);
+        if (index == -1 || v < min_load || (v == min_load && w > max_weight)) {
+            index = i;
+            min_load = v;
+            max_weight = w;
+        }
+    }
+
+    elem = servers.at(index);
+    elem_failed = false;
+    loads->acquire(elem);
+    elem_acquired = true;
+
+    return elem;
+}
+
+void SrsLbLeastLoaded::feedback(const string& server, bool ok)
+{
+    if (ok) {
+        loads->on_success(server);
+    } else {
+        loads->on_failure(server);
+    }
+
+    if (server == elem) {
+        elem_failed = !ok;
+    }
+}
+
+void SrsLbLeastLoaded::release()
+{
+    if (elem_acquired) {
+        loads->release(elem);
+        elem_acquired = false;
+    }
+}
+
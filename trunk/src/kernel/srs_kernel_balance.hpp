@@ -11,12 +11,36 @@
 
 #include <vector>
 #include <string>
+#include <map>
+#include <set>
+
+/**
+ * the load balance interface, to select a server from servers,
+ * used for edge pull and other multiple server feature.
+ */
+class ISrsLoadBalancer
+{
+public:
+    ISrsLoadBalancer();
+    virtual ~ISrsLoadBalancer();
+public:
+    // Get the index of selected server.
+    virtual uint32_t current() = 0;
+    // Get the selected server.
+    virtual std::string selected() = 0;
+    // Select a server from servers.
+    virtual std::string select(const std::vector<std::string>& servers) = 0;
+    // Feedback the health of server, ok is false if failed to connect to server.
+    virtual void feedback(const std::string& server, bool ok);
+    // Release the load of selected server, when stop using it, and acquire again when select.
+    virtual void release();
+};
 
 /**
  * the round-robin load balance algorithm,
  * used for edge pull and other multiple server feature.
  */
-class SrsLbRoundRobin
+class SrsLbRoundRobin : public ISrsLoadBalancer
 {
 private:
     // current selected index.
@@ -34,5 +58,88 @@ public:
     virtual std::string select(const std::vector<std::string>& servers);
 };
 
+/**
+ * the rendezvous(highest random weight) hashing load balance algorithm,
+ * the same key, for example, the stream url, always selects the same server,
+ * so the stream is concentrated on one server. When the selected server
+ * failed, failover to the server of next highest weight, and stick to it
+ * until it fails again, to avoid flapping between servers.
+ */
+class SrsLbConsistentHash : public ISrsLoadBalancer
+{
+private:
+    // The key to hash, for example, the stream url.
+    std::string key;
+    // current selected index.
+    int index;
+    // current selected server.
+    std::string elem;
+    // The failed servers, ignored when select, util all servers failed.
+    std::set<std::string> failed;
+public:
+    SrsLbConsistentHash(std::string k);
+    virtual ~SrsLbConsistentHash();
+public:
+    virtual uint32_t current();
+    virtual std::string selected();
+    virtual std::string select(const std::vector<std::string>& servers);
+    virtual void feedback(const std::string& server, bool ok);
+public:
+    // Get the weight of server for key.
+    static uint32_t weight(const std::string& key, const std::string& server);
+};
+
+/**
+ * the load and health of servers, shared by balancers.
+ */
+class SrsLbLoads
+{
+private:
+    // The number of active streams on each server.
+    std::map<std::string, int> actives;
+    // The number of continuous failures and the last failed time of each server.
+    std::map<std::string, int> failures;
+    std::map<std::string, srs_utime_t> failed_at;
+public:
+    SrsLbLoads();
+    virtual ~SrsLbLoads();
+public:
+    virtual void acquire(const std::string& server);
+    virtual void release(const std::string& server);
+    virtual void on_failure(const std::string& server);
+    virtual void on_success(const std::string& server);
+    // Get the load of server, the recently failed server is considered to be heavy loaded.
+    virtual int load(const std::string& server);
+};
+
+/**
+ * the least-loaded load balance algorithm, select the server with the least
+ * active streams and failures, and stick to it until it fails. For the servers
+ * of the same load, use the rendezvous hashing of key to select one.
+ */
+class SrsLbLeastLoaded : public ISrsLoadBalancer
+{
+private:
+    SrsLbLoads* loads;
+    std::string key;
+    // current selected index.
+    int index;
+    // current selected server.
+    std::string elem;
+    // Whether the selected server failed.
+    bool elem_failed;
+    // Whether the load of selected server is acquired.
+    bool elem_acquired;
+public:
+    SrsLbLeastLoaded(SrsLbLoads* l, std::string k);
+    virtual ~SrsLbLeastLoaded();
+public:
+    virtual uint32_t current();
+    virtual std::string selected();
+    virtual std::string select(const std::vector<std::string>& servers);
+    virtual void feedback(const std::string& server, bool ok);
+    virtual void release();
+};
+
 #endif
 
@@ -207,6 +207,56 @@ bool SrsFlvVideo::h264(char* data, int size)
     return codec_id == SrsVideoCodecIdAVC;
 }
 
+bool SrsFlvVideo::disposable(char* data, int size)
+{
+    // 5bytes required, the frame type, packet type and composition time.
+    if (size < 5) {
+        return false;
+    }
+
+    // Ignore the enhanced RTMP, for we never parse NALUs of HEVC.
+    uint8_t frame_type = data[0];
+    if (frame_type & 0x80) {
+        return false;
+    }
+
+    frame_type = (frame_type >> 4) & 0x0F;
+    if (frame_type == SrsVideoAvcFrameTypeDisposableInterFrame) {
+        return true;
+    }
+    if (frame_type != SrsVideoAvcFrameTypeInterFrame || !h264(data, size)) {
+        return false;
+    }
+    if ((SrsVideoAvcFrameTrait)data[1] != SrsVideoAvcFrameTraitNALU) {
+        return false;
+    }
+
+    // Parse the NALUs in IBMF format, the frame is non-reference if nal_ref_idc of all slices is 0.
+    bool has_slice = false;
+    char* p = data + 5;
+    int left = size - 5;
+    while (left > 4) {
+        uint32_t nb_nalu = ((uint8_t)p[0] << 24) | ((uint8_t)p[1] << 16) | ((uint8_t)p[2] << 8) | (uint8_t)p[3];
+        if (nb_nalu == 0 || nb_nalu > (uint32_t)(left - 4)) {
+            return false;
+        }
+
+        uint8_t nal = (uint8_t)p[4];
+        SrsAvcNaluType nal_type = (SrsAvcNaluType)(nal & 0x1f);
+        if (nal_type == SrsAvcNaluTypeNonIDR || nal_type == SrsAvcNaluTypeIDR) {
+            if ((nal >> 5) & 0x03) {
+                return false;
+            }
+            has_slice = true;
+        }
+
+        p += 4 + nb_nalu;
+        left -= 4 + nb_nalu;
+    }
+
+    return has_slice;
+}
+
 #ifdef SRS_H265
 bool SrsFlvVideo::hevc(char* data, int size)
 {
@@ -292,6 +342,11 @@ SrsFlvAudio::~SrsFlvAudio()
 
 bool SrsFlvAudio::sh(char* data, int size)
 {
+    // For enhanced RTMP, the sequence start of opus.
+    if (opus(data, size)) {
+        return (data[0] & 0x0f) == SrsAudioPacketTypeSequenceStart;
+    }
+
     // sequence header only for aac
     if (!aac(data, size)) {
         return false;
@@ -320,6 +375,22 @@ bool SrsFlvAudio::aac(char* data, int size)
     return sound_format == SrsAudioCodecIdAAC;
 }
 
+bool SrsFlvAudio::opus(char* data, int size)
+{
+    // 1bytes header and 4bytes FourCC required.
+    if (size < 5) {
+        return false;
+    }
+
+    uint8_t sound_format = ((uint8_t)data[0] >> 4) & 0x0F;
+    if (sound_format != SrsAudioCodecIdExHeader) {
+        return false;
+    }
+
+    uint32_t four_cc = ((uint8_t)data[1] << 24) | ((uint8_t)data[2] << 16) | ((uint8_t)data[3] << 8) | (uint8_t)data[4];
+    return four_cc == SRS_AUDIO_FOURCC_OPUS;
+}
+
 /**
  * the public data, event HLS disable, others can use it.
  */
@@ -801,8 +872,11 @@ srs_error_t SrsFormat::on_audio(int64_t timestamp, char* data, int size)
     // @see: E.4.2 Audio Tags, video_file_format_spec_v10_1.pdf, page 76
     uint8_t v = buffer->read_1bytes();
     SrsAudioCodecId codec = (SrsAudioCodecId)((v >> 4) & 0x0f);
+
+    // For enhanced RTMP, only support Opus, identified by FourCC.
+    bool is_opus = (codec == SrsAudioCodecIdExHeader && SrsFlvAudio::opus(data, size));
     
-    if (codec != SrsAudioCodecIdMP3 && codec != SrsAudioCodecIdAAC) {
+    if (codec != SrsAudioCodecIdMP3 && codec != SrsAudioCodecIdAAC && !is_opus) {
         return err;
     }
 
@@ -824,6 +898,10 @@ srs_error_t SrsFormat::on_audio(int64_t timestamp, char* data, int size)
     if (codec == SrsAudioCodecIdMP3) {
         return audio_mp3_demux(buffer.get(), timestamp, fresh);
     }
+
+    if (is_opus) {
+        return audio_opus_demux(buffer.get(), timestamp);
+    }
     
     return audio_aac_demux(buffer.get(), timestamp);
 }
@@ -871,6 +949,12 @@ bool SrsFormat::is_mp3_sequence_header()
         && audio && audio->aac_packet_type == SrsAudioMp3FrameTraitSequenceHeader;
 }
 
+bool SrsFormat::is_opus_sequence_header()
+{
+    return acodec && acodec->id == SrsAudioCodecIdOpus
+        && audio && audio->aac_packet_type == SrsAudioAacFrameTraitSequenceHeader;
+}
+
 bool SrsFormat::is_avc_sequence_header()
 {
     bool h264 = (vcodec && vcodec->id == SrsVideoCodecIdAVC);
@@ -2800,6 +2884,53 @@ srs_error_t SrsFormat::audio_mp3_demux(SrsBuffer* stream, int64_t timestamp, boo
     return err;
 }
 
+srs_error_t SrsFormat::audio_opus_demux(SrsBuffer* stream, int64_t timestamp)
+{
+    srs_error_t err = srs_success;
+
+    audio->cts = 0;
+    audio->dts = timestamp;
+
+    // See https://github.com/veovera/enhanced-rtmp
+    SrsAudioPacketType packet_type = (SrsAudioPacketType)(stream->read_1bytes() & 0x0f);
+    stream->skip(4); // The FourCC, already checked by caller.
+
+    acodec->id = SrsAudioCodecIdOpus;
+    acodec->sound_size = SrsAudioSampleBits16bit;
+    // Opus always decodes at 48KHz, see https://datatracker.ietf.org/doc/html/rfc7845#section-5.1
+    acodec->sound_rate = SrsAudioSampleRate48000;
+
+    // Update the RAW Opus data.
+    raw = stream->data() + stream->pos();
+    nb_raw = stream->size() - stream->pos();
+
+    if (packet_type == SrsAudioPacketTypeSequenceStart) {
+        audio->aac_packet_type = SrsAudioAacFrameTraitSequenceHeader;
+
+        // The OpusHead, the identification header, the channel count is at offset 9.
+        // See https://datatracker.ietf.org/doc/html/rfc7845#section-5.1
+        if (nb_raw < 19 || memcmp(raw, "OpusHead", 8) != 0) {
+            return srs_error_new(ERROR_HLS_DECODE_ERROR, "opus decode OpusHead, size=%d", nb_raw);
+        }
+        acodec->aac_extra_data = std::vector<char>(raw, raw + nb_raw);
+
+        uint8_t channels = (uint8_t)raw[9];
+        acodec->aac_channels = channels;
+        acodec->sound_type = (channels == 1) ? SrsAudioChannelsMono : SrsAudioChannelsStereo;
+    } else if (packet_type == SrsAudioPacketTypeCodedFrames) {
+        audio->aac_packet_type = SrsAudioOpusFrameTraitRaw;
+
+        if ((err = audio->add_sample(raw, nb_raw)) != srs_success) {
+            return srs_error_wrap(err, "add audio frame");
+        }
+    } else {
+        // Ignore the sequence end, multichannel config and multitrack.
+        audio->aac_packet_type = SrsAudioAacFrameTraitReserved;
+    }
+
+    return err;
+}
+
 srs_error_t SrsFormat::audio_aac_sequence_header_demux(char* data, int size)
 {
     srs_error_t err = srs_success;
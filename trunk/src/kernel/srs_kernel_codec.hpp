@@ -131,7 +131,7 @@ enum SrsVideoAvcFrameType
  *     6 = Nellymoser
  *     7 = G.711 A-law logarithmic PCM
  *     8 = G.711 mu-law logarithmic PCM
- *     9 = reserved
+ *     9 = reserved, ExHeader for enhanced RTMP
  *     10 = AAC
  *     11 = Speex
  *     14 = MP3 8 kHz
@@ -159,6 +159,9 @@ enum SrsAudioCodecId
     SrsAudioCodecIdReservedG711AlawLogarithmicPCM = 7,
     SrsAudioCodecIdReservedG711MuLawLogarithmicPCM = 8,
     SrsAudioCodecIdReserved = 9,
+    // For enhanced RTMP, the codec is identified by FourCC after the header.
+    // See https://github.com/veovera/enhanced-rtmp
+    SrsAudioCodecIdExHeader = 9,
     SrsAudioCodecIdAAC = 10,
     SrsAudioCodecIdSpeex = 11,
     // For FLV, it's undefined, we define it as Opus for WebRTC.
@@ -199,6 +202,22 @@ enum SrsAudioAacFrameTrait
     SrsAudioMp3FrameTraitRawData = 64,
 };
 
+/**
+ * The audio packet type of enhanced RTMP, when SoundFormat is ExHeader.
+ * @see https://github.com/veovera/enhanced-rtmp
+ */
+enum SrsAudioPacketType
+{
+    SrsAudioPacketTypeSequenceStart = 0,
+    SrsAudioPacketTypeCodedFrames = 1,
+    SrsAudioPacketTypeSequenceEnd = 2,
+    SrsAudioPacketTypeMultichannelConfig = 4,
+    SrsAudioPacketTypeMultitrack = 5,
+};
+
+// The FourCC of Opus audio in enhanced RTMP, 'Opus'=0x4f707573
+#define SRS_AUDIO_FOURCC_OPUS 0x4f707573
+
 /**
  * The audio sample rate.
  * @see srs_flv_srates and srs_aac_srates.
@@ -283,6 +302,10 @@ public:
      * check codec h264.
      */
     static bool h264(char* data, int size);
+    // Whether the frame is non-reference, which can be dropped without breaking decoding of other frames,
+    // for example, the B frame of H.264 which nal_ref_idc of all slices is 0.
+    // @remark Only check the H.264 with 4bytes NALU size, return false for other codecs.
+    static bool disposable(char* data, int size);
 #ifdef SRS_H265
     // Check whether codec is HEVC(H.265).
     static bool hevc(char* data, int size);
@@ -314,6 +337,8 @@ public:
      * check codec aac.
      */
     static bool aac(char* data, int size);
+    // Check codec opus, in enhanced RTMP.
+    static bool opus(char* data, int size);
 };
 
 /**
@@ -1361,6 +1386,7 @@ public:
 public:
     virtual bool is_aac_sequence_header();
     virtual bool is_mp3_sequence_header();
+    virtual bool is_opus_sequence_header();
     virtual bool is_avc_sequence_header();
 private:
     // Demux the video packet in H.264 codec.
@@ -1402,6 +1428,10 @@ private:
     //          Demux the sampels from RAW data.
     virtual srs_error_t audio_aac_demux(SrsBuffer* stream, int64_t timestamp);
     virtual srs_error_t audio_mp3_demux(SrsBuffer* stream, int64_t timestamp, bool fresh);
+    // Demux the audio packet in Opus codec, in enhanced RTMP.
+    //          Demux the OpusHead from sequence start.
+    //          Demux the sampels from coded frames.
+    virtual srs_error_t audio_opus_demux(SrsBuffer* stream, int64_t timestamp);
 public:
     // Directly demux the sequence header, without RTMP packet header.
     virtual srs_error_t audio_aac_sequence_header_demux(char* data, int size);
@@ -702,21 +702,73 @@ SrsRtcpTWCC::SrsRtcpTWCC(uint32_t sender_ssrc) : pkt_len(0)
     reference_time_ = 0;
     fb_pkt_count_ = 0;
     next_base_sn_ = 0;
+
+    nn_encoded_chucks_ = 0;
+    nn_pkt_deltas_ = 0;
+
+    recv_times_ = NULL;
+    recv_bitmap_ = NULL;
+    nn_recv_packets_ = 0;
+    recv_head_ = recv_tail_ = 0;
 }
 
 SrsRtcpTWCC::~SrsRtcpTWCC()
 {
+    srs_freepa(recv_times_);
+    srs_freepa(recv_bitmap_);
 }
 
 void SrsRtcpTWCC::clear()
 {
-    encoded_chucks_.clear();
-    pkt_deltas_.clear();
-    recv_packets_.clear();
-    recv_sns_.clear();
+    nn_encoded_chucks_ = 0;
+    nn_pkt_deltas_ = 0;
+
+    if (recv_bitmap_) {
+        memset(recv_bitmap_, 0, sizeof(uint64_t) * (kTwccFbRecvWindow / 64));
+    }
+    nn_recv_packets_ = 0;
+    recv_head_ = recv_tail_ = 0;
+
     next_base_sn_ = 0;
 }
 
+bool SrsRtcpTWCC::find_recv_packet(uint16_t& sn)
+{
+    if (srs_rtp_seq_distance(recv_head_, sn) < 0) {
+        sn = recv_head_;
+    }
+
+    // Walk the window in sn order, skip the empty bits of word.
+    uint16_t nn = recv_tail_ - recv_head_;
+    for (uint16_t offset = sn - recv_head_; offset < nn;) {
+        uint16_t slot = (recv_head_ + offset) & (kTwccFbRecvWindow - 1);
+        uint64_t word = recv_bitmap_[slot >> 6] >> (slot & 63);
+        if (!word) {
+            offset += 64 - (slot & 63);
+            continue;
+        }
+
+        offset += __builtin_ctzll(word);
+        if (offset < nn) {
+            sn = recv_head_ + offset;
+            return true;
+        }
+        break;
+    }
+
+    return false;
+}
+
+void SrsRtcpTWCC::remove_recv_packet(uint16_t sn)
+{
+    uint16_t slot = sn & (kTwccFbRecvWindow - 1);
+    uint64_t bit = 1ULL << (slot & 63);
+    if ((recv_bitmap_[slot >> 6] & bit) != 0) {
+        recv_bitmap_[slot >> 6] &= ~bit;
+        nn_recv_packets_--;
+    }
+}
+
 uint16_t SrsRtcpTWCC::get_base_sn() const
 {
     return base_sn_;
@@ -734,12 +786,12 @@ uint8_t SrsRtcpTWCC::get_feedback_count() const
     
 vector<uint16_t> SrsRtcpTWCC::get_packet_chucks() const
 {
-    return encoded_chucks_;
+    return vector<uint16_t>(encoded_chucks_, encoded_chucks_ + nn_encoded_chucks_);
 }
 
 vector<uint16_t> SrsRtcpTWCC::get_recv_deltas() const
 {
-    return pkt_deltas_;
+    return vector<uint16_t>(pkt_deltas_, pkt_deltas_ + nn_pkt_deltas_);
 }
 
 void SrsRtcpTWCC::set_base_sn(uint16_t sn)
@@ -757,32 +809,77 @@ void SrsRtcpTWCC::set_feedback_count(uint8_t count)
     fb_pkt_count_ = count;
 }
     
-void SrsRtcpTWCC::add_packet_chuck(uint16_t chunk)
+srs_error_t SrsRtcpTWCC::add_packet_chuck(uint16_t chunk)
 {
-    encoded_chucks_.push_back(chunk);
+    if (nn_encoded_chucks_ >= kTwccFbMaxChunks) {
+        return srs_error_new(ERROR_RTC_RTCP, "TWCC chunks overflow, max=%d", kTwccFbMaxChunks);
+    }
+
+    encoded_chucks_[nn_encoded_chucks_++] = chunk;
+    return srs_success;
 }
 
-void SrsRtcpTWCC::add_recv_delta(uint16_t delta)
+srs_error_t SrsRtcpTWCC::add_recv_delta(uint16_t delta)
 {
-    pkt_deltas_.push_back(delta);
+    if (nn_pkt_deltas_ >= kTwccFbMaxDeltas) {
+        return srs_error_new(ERROR_RTC_RTCP, "TWCC deltas overflow, max=%d", kTwccFbMaxDeltas);
+    }
+
+    pkt_deltas_[nn_pkt_deltas_++] = delta;
+    return srs_success;
 }
 
 srs_error_t SrsRtcpTWCC::recv_packet(uint16_t sn, srs_utime_t ts)
 {
-    map<uint16_t, srs_utime_t>::iterator it = recv_packets_.find(sn);
-    if(it != recv_packets_.end()) {
+    if (!recv_times_) {
+        recv_times_ = new srs_utime_t[kTwccFbRecvWindow];
+        recv_bitmap_ = new uint64_t[kTwccFbRecvWindow / 64];
+        memset(recv_bitmap_, 0, sizeof(uint64_t) * (kTwccFbRecvWindow / 64));
+    }
+
+    if (!nn_recv_packets_) {
+        recv_head_ = sn;
+        recv_tail_ = sn + 1;
+    } else if (srs_rtp_seq_distance(recv_tail_, sn) >= 0) {
+        // Newer than the window, move forward and drop the packets out of window.
+        recv_tail_ = sn + 1;
+
+        uint16_t head = recv_tail_ - kTwccFbRecvWindow;
+        if (srs_rtp_seq_distance(recv_head_, head) >= kTwccFbRecvWindow) {
+            memset(recv_bitmap_, 0, sizeof(uint64_t) * (kTwccFbRecvWindow / 64));
+            nn_recv_packets_ = 0;
+            recv_head_ = sn;
+        } else if (srs_rtp_seq_distance(recv_head_, head) > 0) {
+            for (uint16_t s = recv_head_; s != head; ++s) {
+                remove_recv_packet(s);
+            }
+            recv_head_ = head;
+        }
+    } else if (srs_rtp_seq_distance(sn, recv_head_) > 0) {
+        // Older than the window, ignore it if the window could not cover it.
+        if ((uint16_t)(recv_tail_ - sn) > kTwccFbRecvWindow) {
+            return srs_error_new(ERROR_RTC_RTCP, "TWCC out of window seq: %d, window=[%d, %d)", sn, recv_head_, recv_tail_);
+        }
+        recv_head_ = sn;
+    }
+
+    uint16_t slot = sn & (kTwccFbRecvWindow - 1);
+    uint64_t& word = recv_bitmap_[slot >> 6];
+    uint64_t bit = 1ULL << (slot & 63);
+    if ((word & bit) != 0) {
         return srs_error_new(ERROR_RTC_RTCP, "TWCC dup seq: %d", sn);
     }
 
-    recv_packets_[sn] = ts;
-    recv_sns_.insert(sn);
+    word |= bit;
+    recv_times_[slot] = ts;
+    nn_recv_packets_++;
 
     return srs_success;
 }
 
 bool SrsRtcpTWCC::need_feedback()
 {
-    return recv_packets_.size() > 0;
+    return nn_recv_packets_ > 0;
 }
 
 srs_error_t SrsRtcpTWCC::decode(SrsBuffer *buffer)
@@ -889,16 +986,22 @@ srs_error_t SrsRtcpTWCC::encode_chunk_run_length(SrsRtcpTWCC::SrsRtcpTWCCChunk&
         return srs_error_new(ERROR_RTC_RTCP, "invalid run all_same:%d, size:%d", chunk.all_same, chunk.size);
     }
 
+    srs_error_t err = srs_success;
+
     uint16_t encoded_chunk = (chunk.delta_sizes[0] << 13) | chunk.size;
 
-    encoded_chucks_.push_back(encoded_chunk);
+    if ((err = add_packet_chuck(encoded_chunk)) != srs_success) {
+        return srs_error_wrap(err, "add chunk");
+    }
     pkt_len += sizeof(encoded_chunk);
 
-    return srs_success;
+    return err;
 }
 
 srs_error_t SrsRtcpTWCC::encode_chunk_one_bit(SrsRtcpTWCC::SrsRtcpTWCCChunk& chunk)
 {
+    srs_error_t err = srs_success;
+
     int i = 0;
     if (chunk.has_large_delta) {
         return srs_error_new(ERROR_RTC_RTCP, "invalid large delta");
@@ -909,15 +1012,19 @@ srs_error_t SrsRtcpTWCC::encode_chunk_one_bit(SrsRtcpTWCC::SrsRtcpTWCCChunk& chu
         encoded_chunk |= (chunk.delta_sizes[i] << (kTwccFbOneBitElements - 1 - i));
     }
 
-    encoded_chucks_.push_back(encoded_chunk);
+    if ((err = add_packet_chuck(encoded_chunk)) != srs_success) {
+        return srs_error_wrap(err, "add chunk");
+    }
     pkt_len += sizeof(encoded_chunk);
 
     // 1 0 symbol_list
-    return srs_success;
+    return err;
 }
     
 srs_error_t SrsRtcpTWCC::encode_chunk_two_bit(SrsRtcpTWCC::SrsRtcpTWCCChunk& chunk, size_t size, bool shift)
 {
+    srs_error_t err = srs_success;
+
     unsigned int i = 0;
     uint8_t delta_size = 0;
     
@@ -926,7 +1033,9 @@ srs_error_t SrsRtcpTWCC::encode_chunk_two_bit(SrsRtcpTWCC::SrsRtcpTWCCChunk& chu
     for (i = 0; i < size; ++i) {
         encoded_chunk |= (chunk.delta_sizes[i] << (2 * (kTwccFbTwoBitElements - 1 - i)));
     }
-    encoded_chucks_.push_back(encoded_chunk);
+    if ((err = add_packet_chuck(encoded_chunk)) != srs_success) {
+        return srs_error_wrap(err, "add chunk");
+    }
     pkt_len += sizeof(encoded_chunk);
 
     if (shift) {
@@ -941,7 +1050,7 @@ srs_error_t SrsRtcpTWCC::encode_chunk_two_bit(SrsRtcpTWCC::SrsRtcpTWCCChunk& chu
         }
     }
 
-    return srs_success;
+    return err;
 }
 
 void SrsRtcpTWCC::reset_chunk(SrsRtcpTWCC::SrsRtcpTWCCChunk& chunk)
@@ -1067,17 +1176,17 @@ srs_error_t SrsRtcpTWCC::do_encode(SrsBuffer *buffer)
     }
 
     pkt_len = kTwccFbPktHeaderSize;
+    nn_encoded_chucks_ = 0;
+    nn_pkt_deltas_ = 0;
 
-    set<uint16_t, SrsSeqCompareLess>::iterator it_sn = recv_sns_.begin();
-    if (!next_base_sn_) {
-        base_sn_ = *it_sn;
-    } else {
-        base_sn_ = next_base_sn_;
-        it_sn = recv_sns_.find(base_sn_);
+    // Start from the next base sn, or the first received packet.
+    uint16_t current_sn = next_base_sn_ ? next_base_sn_ : recv_head_;
+    if (!nn_recv_packets_ || !find_recv_packet(current_sn)) {
+        return srs_error_new(ERROR_RTC_RTCP, "TWCC no packets");
     }
+    base_sn_ = current_sn;
 
-    map<uint16_t, srs_utime_t>::iterator it_ts = recv_packets_.find(base_sn_);
-    srs_utime_t ts = it_ts->second;
+    srs_utime_t ts = recv_times_[base_sn_ & (kTwccFbRecvWindow - 1)];
 
     reference_time_ = (ts % kTwccFbReferenceTimeDivisor) / kTwccFbTimeMultiplier;
     srs_utime_t last_ts = (srs_utime_t)(reference_time_) * kTwccFbTimeMultiplier;
@@ -1087,22 +1196,16 @@ srs_error_t SrsRtcpTWCC::do_encode(SrsBuffer *buffer)
 
     // encode chunk
     SrsRtcpTWCC::SrsRtcpTWCCChunk chunk;
-    for(; it_sn != recv_sns_.end(); ++it_sn) {
+    bool has_packet = true;
+    for(; has_packet; has_packet = find_recv_packet(++current_sn)) {
         // check whether exceed buffer len
         // max recv_delta_size = 2
         if (pkt_len + 2 >= buffer->left()) {
             break;
         }
 
-        uint16_t current_sn = *it_sn;
-        // calculate delta
-        it_ts = recv_packets_.find(current_sn);
-        if (it_ts == recv_packets_.end()) {
-            continue;
-        }
-
         packet_count++;
-        srs_utime_t delta_us = calculate_delta_us(it_ts->second, last_ts);
+        srs_utime_t delta_us = calculate_delta_us(recv_times_[current_sn & (kTwccFbRecvWindow - 1)], last_ts);
         int16_t delta = delta_us;
         if(delta != delta_us) {
             return srs_error_new(ERROR_RTC_RTCP, "twcc: delta:%" PRId64 ", exceeds the 16bits", delta_us);
@@ -1122,17 +1225,19 @@ srs_error_t SrsRtcpTWCC::do_encode(SrsBuffer *buffer)
             return srs_error_wrap(err, "delta_size %d, failed to append_recv_delta", recv_delta_size);
         }
 
-        pkt_deltas_.push_back(delta);
+        if ((err = add_recv_delta(delta)) != srs_success) {
+            return srs_error_wrap(err, "add delta");
+        }
         last_ts += delta * kTwccFbDeltaUnit;
         pkt_len += recv_delta_size;
         last_sn = current_sn;
 
-        recv_packets_.erase(it_ts);
+        remove_recv_packet(current_sn);
     }
 
     next_base_sn_ = 0;
-    if (it_sn != recv_sns_.end()) {
-        next_base_sn_ = *it_sn;
+    if (has_packet) {
+        next_base_sn_ = current_sn;
     }
 
     if(0 < chunk.size) {
@@ -1159,28 +1264,31 @@ srs_error_t SrsRtcpTWCC::do_encode(SrsBuffer *buffer)
     buffer->write_3bytes(reference_time_);
     buffer->write_1bytes(fb_pkt_count_);
 
-    int required_size = encoded_chucks_.size() * 2;
+    int required_size = nn_encoded_chucks_ * 2;
     if(!buffer->require(required_size)) {
-        return srs_error_new(ERROR_RTC_RTCP, "encoded_chucks_[%d] requires %d bytes", (int)encoded_chucks_.size(), required_size);
+        return srs_error_new(ERROR_RTC_RTCP, "encoded_chucks_[%d] requires %d bytes", nn_encoded_chucks_, required_size);
     }
 
-    for(vector<uint16_t>::iterator it = encoded_chucks_.begin(); it != encoded_chucks_.end(); ++it) {
-        buffer->write_2bytes(*it);
+    for (int i = 0; i < nn_encoded_chucks_; ++i) {
+        buffer->write_2bytes(encoded_chucks_[i]);
     }
 
-    required_size = pkt_deltas_.size() * 2;
+    // The small delta is 1 byte, and the large or negative delta is 2 bytes.
+    required_size = 0;
+    for (int i = 0; i < nn_pkt_deltas_; ++i) {
+        required_size += (pkt_deltas_[i] <= 0xFF) ? 1 : 2;
+    }
     if(!buffer->require(required_size)) {
-        return srs_error_new(ERROR_RTC_RTCP, "pkt_deltas_[%d] requires %d bytes", (int)pkt_deltas_.size(), required_size);
+        return srs_error_new(ERROR_RTC_RTCP, "pkt_deltas_[%d] requires %d bytes", nn_pkt_deltas_, required_size);
     }
 
-    for(vector<uint16_t>::iterator it = pkt_deltas_.begin(); it != pkt_deltas_.end(); ++it) {
-        if(0 <= *it && 0xFF >= *it) {
+    for (int i = 0; i < nn_pkt_deltas_; ++i) {
+        if(0xFF >= pkt_deltas_[i]) {
             // small delta
-            uint8_t delta = *it;
-            buffer->write_1bytes(delta);
+            buffer->write_1bytes((uint8_t)pkt_deltas_[i]);
         } else {
             // large or negative delta
-            buffer->write_2bytes(*it);
+            buffer->write_2bytes(pkt_deltas_[i]);
         }
     }
 
@@ -1189,8 +1297,8 @@ srs_error_t SrsRtcpTWCC::do_encode(SrsBuffer *buffer)
         pkt_len++;
     }
 
-    encoded_chucks_.clear();
-    pkt_deltas_.clear();
+    nn_encoded_chucks_ = 0;
+    nn_pkt_deltas_ = 0;
 
     return err;
 }
@@ -268,6 +268,11 @@ public:
 #define kTwccFbTwoBitElements 		7
 #define kTwccFbLargeRecvDeltaBytes	2
 #define kTwccFbMaxBitElements 		kTwccFbOneBitElements
+// The max chunks and deltas in a feedback packet, limited by the packet size.
+#define kTwccFbMaxChunks			(kRtcpPacketSize / kTwccFbChunkBytes)
+#define kTwccFbMaxDeltas			(kRtcpPacketSize)
+// The window of received packets for feedback, must be power of 2.
+#define kTwccFbRecvWindow			(1 << 12)
 
 class SrsRtcpTWCC : public SrsRtcpFbCommon
 {
@@ -275,11 +280,21 @@ private:
     uint16_t base_sn_;
     int32_t reference_time_;
     uint8_t fb_pkt_count_;
-    std::vector<uint16_t> encoded_chucks_;
-    std::vector<uint16_t> pkt_deltas_;
-
-    std::map<uint16_t, srs_utime_t> recv_packets_;
-    std::set<uint16_t, SrsSeqCompareLess> recv_sns_;
+    // The encoded chunks and deltas of feedback, reused to avoid allocation.
+    uint16_t encoded_chucks_[kTwccFbMaxChunks];
+    int nn_encoded_chucks_;
+    uint16_t pkt_deltas_[kTwccFbMaxDeltas];
+    int nn_pkt_deltas_;
+
+    // The arrival time of received packets, indexed by sn in window, valid only if the bit is set.
+    // Allocated when got the first packet, because the decoded TWCC doesn't need it.
+    srs_utime_t* recv_times_;
+    uint64_t* recv_bitmap_;
+    // The number of received packets to feedback.
+    int nn_recv_packets_;
+    // The window of received packets, all sn are in [recv_head_, recv_tail_).
+    uint16_t recv_head_;
+    uint16_t recv_tail_;
 
     struct SrsRtcpTWCCChunk {
         uint8_t delta_sizes[kTwccFbMaxBitElements];
@@ -293,6 +308,9 @@ private:
     uint16_t next_base_sn_;
 private:
     void clear();
+    // Find the first received packet from sn in window, update sn if found.
+    bool find_recv_packet(uint16_t& sn);
+    void remove_recv_packet(uint16_t sn);
     srs_utime_t calculate_delta_us(srs_utime_t ts, srs_utime_t last);
     srs_error_t process_pkt_chunk(SrsRtcpTWCCChunk& chunk, int delta_size);
     bool can_add_to_chunk(SrsRtcpTWCCChunk& chunk, int delta_size);
@@ -316,8 +334,9 @@ public:
     void set_base_sn(uint16_t sn);
     void set_reference_time(uint32_t time);
     void set_feedback_count(uint8_t count);
-    void add_packet_chuck(uint16_t chuck);
-    void add_recv_delta(uint16_t delta);
+    // Append the encoded chunk or delta, return error if exceed the packet size.
+    srs_error_t add_packet_chuck(uint16_t chuck);
+    srs_error_t add_recv_delta(uint16_t delta);
 
     srs_error_t recv_packet(uint16_t sn, srs_utime_t ts);
     bool need_feedback();
@@ -416,6 +416,11 @@ void SrsHttpClient::set_recv_timeout(srs_utime_t tm)
     recv_timeout = tm;
 }
 
+bool SrsHttpClient::is_alive()
+{
+    return transport && transport->is_alive();
+}
+
 void SrsHttpClient::kbps_sample(const char* label, srs_utime_t age)
 {
     kbps->sample();
@@ -102,6 +102,8 @@ public:
     virtual srs_error_t get(std::string path, std::string req, ISrsHttpMessage** ppmsg);
 public:
     virtual void set_recv_timeout(srs_utime_t tm);
+    // Whether the connection is established and still usable for the next request.
+    virtual bool is_alive();
 public:
     virtual void kbps_sample(const char* label, srs_utime_t age);
 private:
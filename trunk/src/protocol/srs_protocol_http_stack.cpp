@@ -624,6 +624,162 @@ SrsHttpMuxEntry::~SrsHttpMuxEntry()
     srs_freep(handler);
 }
 
+SrsHttpRadixNode::SrsHttpRadixNode()
+{
+    entry = NULL;
+}
+
+SrsHttpRadixNode::~SrsHttpRadixNode()
+{
+    std::map<char, SrsHttpRadixNode*>::iterator it;
+    for (it = children.begin(); it != children.end(); ++it) {
+        SrsHttpRadixNode* child = it->second;
+        srs_freep(child);
+    }
+    children.clear();
+}
+
+SrsHttpRadixTree::SrsHttpRadixTree()
+{
+    root_ = new SrsHttpRadixNode();
+}
+
+SrsHttpRadixTree::~SrsHttpRadixTree()
+{
+    srs_freep(root_);
+}
+
+void SrsHttpRadixTree::insert(string pattern, SrsHttpMuxEntry* entry)
+{
+    SrsHttpRadixNode* node = root_;
+    size_t pos = 0;
+
+    while (pos < pattern.length()) {
+        std::map<char, SrsHttpRadixNode*>::iterator it = node->children.find(pattern.at(pos));
+
+        // No child with the same first char, create a leaf for the rest.
+        if (it == node->children.end()) {
+            SrsHttpRadixNode* leaf = new SrsHttpRadixNode();
+            leaf->label = pattern.substr(pos);
+            leaf->entry = entry;
+            node->children[pattern.at(pos)] = leaf;
+            return;
+        }
+
+        // Get the common prefix of label and the rest of pattern.
+        SrsHttpRadixNode* child = it->second;
+        size_t n = 0;
+        while (n < child->label.length() && pos + n < pattern.length() && child->label.at(n) == pattern.at(pos + n)) {
+            n++;
+        }
+
+        // Split the child if partial matched, for example, insert /api/v2 to /api/v1.
+        if (n < child->label.length()) {
+            SrsHttpRadixNode* mid = new SrsHttpRadixNode();
+            mid->label = child->label.substr(0, n);
+            child->label = child->label.substr(n);
+            mid->children[child->label.at(0)] = child;
+            it->second = mid;
+            child = mid;
+        }
+
+        node = child;
+        pos += n;
+    }
+
+    node->entry = entry;
+}
+
+void SrsHttpRadixTree::remove(string pattern)
+{
+    // The path from root to the node of pattern.
+    std::vector<SrsHttpRadixNode*> nodes;
+    nodes.push_back(root_);
+
+    SrsHttpRadixNode* node = root_;
+    size_t pos = 0;
+    while (pos < pattern.length()) {
+        std::map<char, SrsHttpRadixNode*>::iterator it = node->children.find(pattern.at(pos));
+        if (it == node->children.end()) {
+            return;
+        }
+
+        SrsHttpRadixNode* child = it->second;
+        if (pattern.compare(pos, child->label.length(), child->label) != 0) {
+            return;
+        }
+
+        node = child;
+        pos += child->label.length();
+        nodes.push_back(node);
+    }
+
+    node->entry = NULL;
+
+    // Remove the empty leaf, or merge the node with its only child, bottom-up.
+    for (int i = (int)nodes.size() - 1; i > 0; i--) {
+        node = nodes.at(i);
+        SrsHttpRadixNode* parent = nodes.at(i - 1);
+
+        if (node->entry) {
+            break;
+        }
+
+        if (node->children.empty()) {
+            parent->children.erase(node->label.at(0));
+            srs_freep(node);
+            continue;
+        }
+
+        if (node->children.size() == 1) {
+            SrsHttpRadixNode* child = node->children.begin()->second;
+            node->label += child->label;
+            node->entry = child->entry;
+            node->children = child->children;
+            child->children.clear();
+            srs_freep(child);
+        }
+        break;
+    }
+}
+
+SrsHttpMuxEntry* SrsHttpRadixTree::match(const string& path)
+{
+    SrsHttpMuxEntry* matched = NULL;
+
+    SrsHttpRadixNode* node = root_;
+    size_t pos = 0;
+    while (true) {
+        // The deeper entry is longer, so overwrite the matched one.
+        SrsHttpMuxEntry* entry = node->entry;
+        if (entry && entry->enabled && pos > 0) {
+            // Endswith '/' match any, for example, '/api/' match '/api/[N]', or exactly match.
+            if (path.at(pos - 1) == '/' || pos == path.length()) {
+                matched = entry;
+            }
+        }
+
+        if (pos >= path.length()) {
+            break;
+        }
+
+        std::map<char, SrsHttpRadixNode*>::iterator it = node->children.find(path.at(pos));
+        if (it == node->children.end()) {
+            break;
+        }
+
+        SrsHttpRadixNode* child = it->second;
+        if (path.compare(pos, child->label.length(), child->label) != 0) {
+            break;
+        }
+
+        node = child;
+        pos += child->label.length();
+    }
+
+    return matched;
+}
+
 ISrsHttpMatchHijacker::ISrsHttpMatchHijacker()
 {
 }
@@ -642,6 +798,7 @@ ISrsHttpServeMux::~ISrsHttpServeMux()
 
 SrsHttpServeMux::SrsHttpServeMux()
 {
+    tree_ = new SrsHttpRadixTree();
 }
 
 SrsHttpServeMux::~SrsHttpServeMux()
@@ -652,6 +809,7 @@ SrsHttpServeMux::~SrsHttpServeMux()
         srs_freep(entry);
     }
     entries.clear();
+    srs_freep(tree_);
     
     vhosts.clear();
     hijackers.clear();
@@ -719,6 +877,7 @@ srs_error_t SrsHttpServeMux::handle(std::string pattern, ISrsHttpHandler* handle
             srs_freep(exists);
         }
         entries[pattern] = entry;
+        tree_->insert(pattern, entry);
     }
     
     // Helpful behavior:
@@ -744,6 +903,7 @@ srs_error_t SrsHttpServeMux::handle(std::string pattern, ISrsHttpHandler* handle
             entry->handler->entry = entry;
             
             entries[rpattern] = entry;
+            tree_->insert(rpattern, entry);
         }
     }
     
@@ -757,6 +917,7 @@ void SrsHttpServeMux::unhandle(std::string pattern, ISrsHttpHandler* handler)
         if (it != entries.end()) {
             SrsHttpMuxEntry* entry = it->second;
             entries.erase(it);
+            tree_->remove(pattern);
 
             // We don't free the handler, because user should free it.
             if (entry->handler == handler) {
@@ -838,57 +999,13 @@ srs_error_t SrsHttpServeMux::match(ISrsHttpMessage* r, ISrsHttpHandler** ph)
         path = r->host() + path;
     }
     
-    int nb_matched = 0;
-    ISrsHttpHandler* h = NULL;
-    
-    std::map<std::string, SrsHttpMuxEntry*>::iterator it;
-    for (it = entries.begin(); it != entries.end(); ++it) {
-        std::string pattern = it->first;
-        SrsHttpMuxEntry* entry = it->second;
-        
-        if (!entry->enabled) {
-            continue;
-        }
-        
-        if (!path_match(pattern, path)) {
-            continue;
-        }
-        
-        if (!h || (int)pattern.length() > nb_matched) {
-            nb_matched = (int)pattern.length();
-            h = entry->handler;
-        }
-    }
-    
-    *ph = h;
+    // Match the longest pattern in radix tree.
+    SrsHttpMuxEntry* entry = tree_->match(path);
+    *ph = entry ? entry->handler : NULL;
     
     return srs_success;
 }
 
-bool SrsHttpServeMux::path_match(string pattern, string path)
-{
-    if (pattern.empty()) {
-        return false;
-    }
-    
-    int n = (int)pattern.length();
-    
-    // not endswith '/', exactly match.
-    if (pattern.at(n - 1) != '/') {
-        return pattern == path;
-    }
-    
-    // endswith '/', match any,
-    // for example, '/api/' match '/api/[N]'
-    if ((int)path.length() >= n) {
-        if (memcmp(pattern.data(), path.data(), n) == 0) {
-            return true;
-        }
-    }
-    
-    return false;
-}
-
 SrsHttpCorsMux::SrsHttpCorsMux(ISrsHttpHandler* h)
 {
     enabled = false;
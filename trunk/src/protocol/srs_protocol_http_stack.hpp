@@ -391,6 +391,43 @@ public:
     virtual ~SrsHttpMuxEntry();
 };
 
+// The node of radix tree for http mux.
+class SrsHttpRadixNode
+{
+public:
+    // The label of edge from parent to this node.
+    std::string label;
+    // The entry whose pattern ends at this node, NULL if none. Note that we never free it.
+    SrsHttpMuxEntry* entry;
+    // The children, indexed by the first char of label.
+    std::map<char, SrsHttpRadixNode*> children;
+public:
+    SrsHttpRadixNode();
+    virtual ~SrsHttpRadixNode();
+};
+
+// The compressed radix tree to match the patterns of http mux, the cost of insert, remove and match is
+// O(length of path), no matter how many patterns, for example, each stream mounts an HTTP-FLV handler.
+// The pattern with vhost, such as ossrs.net/live/, is in a different subtree from the pattern starts
+// with /, so each vhost has its own root.
+class SrsHttpRadixTree
+{
+private:
+    SrsHttpRadixNode* root_;
+public:
+    SrsHttpRadixTree();
+    virtual ~SrsHttpRadixTree();
+public:
+    // Set the entry of pattern, overwrite the exists one.
+    virtual void insert(std::string pattern, SrsHttpMuxEntry* entry);
+    // Remove the entry of pattern, and merge the nodes.
+    virtual void remove(std::string pattern);
+    // Match the enabled entry with the longest pattern, where the pattern ends with / matches the path
+    // with this prefix, while other pattern matches the path exactly.
+    // @return NULL if not matched.
+    virtual SrsHttpMuxEntry* match(const std::string& path);
+};
+
 // The hijacker for http pattern match.
 class ISrsHttpMatchHijacker
 {
@@ -447,6 +484,8 @@ class SrsHttpServeMux : public ISrsHttpServeMux
 private:
     // The pattern handler, to handle the http request.
     std::map<std::string, SrsHttpMuxEntry*> entries;
+    // The index of entries to match the path.
+    SrsHttpRadixTree* tree_;
     // The vhost handler.
     // When find the handler to process the request,
     // append the matched vhost when pattern not starts with /,
@@ -479,7 +518,6 @@ public:
     virtual srs_error_t find_handler(ISrsHttpMessage* r, ISrsHttpHandler** ph);
 private:
     virtual srs_error_t match(ISrsHttpMessage* r, ISrsHttpHandler** ph);
-    virtual bool path_match(std::string pattern, std::string path);
 };
 
 // The filter http mux, directly serve the http CORS requests
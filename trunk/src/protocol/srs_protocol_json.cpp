@@ -1327,6 +1327,7 @@ using namespace std;
 #include <srs_kernel_log.hpp>
 #include <srs_protocol_amf0.hpp>
 #include <srs_kernel_utility.hpp>
+#include <srs_kernel_io.hpp>
 
 /* json encode
  cout<< SRS_JOBJECT_START
@@ -2027,6 +2028,148 @@ SrsAmf0Any* SrsJsonArray::to_amf0()
     return arr;
 }
 
+SrsJsonWriter::SrsJsonWriter(ISrsStreamWriter* writer, int chunk_size)
+{
+    writer_ = writer;
+    chunk_size_ = chunk_size;
+    after_key_ = false;
+}
+
+SrsJsonWriter::~SrsJsonWriter()
+{
+}
+
+srs_error_t SrsJsonWriter::object_start()
+{
+    srs_error_t err = srs_success;
+
+    if ((err = write_value(SRS_JOBJECT_START)) != srs_success) {
+        return srs_error_wrap(err, "object start");
+    }
+    firsts_.push_back(true);
+
+    return err;
+}
+
+srs_error_t SrsJsonWriter::object_end()
+{
+    return write_end(SRS_JOBJECT_END);
+}
+
+srs_error_t SrsJsonWriter::array_start()
+{
+    srs_error_t err = srs_success;
+
+    if ((err = write_value(SRS_JARRAY_START)) != srs_success) {
+        return srs_error_wrap(err, "array start");
+    }
+    firsts_.push_back(true);
+
+    return err;
+}
+
+srs_error_t SrsJsonWriter::array_end()
+{
+    return write_end(SRS_JARRAY_END);
+}
+
+srs_error_t SrsJsonWriter::key(string name)
+{
+    srs_error_t err = srs_success;
+
+    if ((err = write_value(json_serialize_string(name) + ":")) != srs_success) {
+        return srs_error_wrap(err, "key %s", name.c_str());
+    }
+    after_key_ = true;
+
+    return err;
+}
+
+srs_error_t SrsJsonWriter::str(string value)
+{
+    return write_value(json_serialize_string(value));
+}
+
+srs_error_t SrsJsonWriter::integer(int64_t value)
+{
+    return write_value(srs_int2str(value));
+}
+
+srs_error_t SrsJsonWriter::number(double value)
+{
+    // len(max int64_t) is 20, plus one "+-."
+    char tmp[21 + 1];
+    snprintf(tmp, sizeof(tmp), "%.2f", value);
+    return write_value(tmp);
+}
+
+srs_error_t SrsJsonWriter::boolean(bool value)
+{
+    return write_value(value ? "true" : "false");
+}
+
+srs_error_t SrsJsonWriter::null()
+{
+    return write_value("null");
+}
+
+srs_error_t SrsJsonWriter::any(SrsJsonAny* value)
+{
+    return write_value(value->dumps());
+}
+
+srs_error_t SrsJsonWriter::flush()
+{
+    srs_error_t err = srs_success;
+
+    if (buf_.empty()) {
+        return err;
+    }
+
+    if ((err = writer_->write((void*)buf_.data(), buf_.length(), NULL)) != srs_success) {
+        return srs_error_wrap(err, "write %d bytes", (int)buf_.length());
+    }
+    buf_.clear();
+
+    return err;
+}
+
+srs_error_t SrsJsonWriter::write_value(const string& value)
+{
+    // Separate the elements of object or array, except the value of a key.
+    if (!firsts_.empty()) {
+        if (!firsts_.back() && !after_key_) {
+            buf_.append(SRS_JFIELD_CONT);
+        }
+        firsts_.back() = false;
+    }
+    after_key_ = false;
+
+    buf_.append(value);
+
+    return try_flush();
+}
+
+srs_error_t SrsJsonWriter::write_end(const string& token)
+{
+    if (!firsts_.empty()) {
+        firsts_.pop_back();
+    }
+
+    buf_.append(token);
+
+    return try_flush();
+}
+
+srs_error_t SrsJsonWriter::try_flush()
+{
+    if ((int)buf_.length() < chunk_size_) {
+        return srs_success;
+    }
+
+    return flush();
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////
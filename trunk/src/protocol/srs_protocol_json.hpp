@@ -152,4 +152,52 @@ public:
 ////////////////////////////////////////////////////////////////////////
 // JSON encode, please use JSON.dumps() to encode json object.
 
+class ISrsStreamWriter;
+
+// The default size of chunk to flush for streaming JSON writer.
+#define SRS_JSON_WRITER_CHUNK 65536
+
+// The streaming JSON encoder, which writes the tokens to the writer in chunks, without building the
+// whole tree in memory, for example, to response a huge list of clients. Usage:
+//        SrsJsonWriter jw(writer);
+//        jw.object_start(); jw.key("code"); jw.integer(0); jw.object_end();
+//        jw.flush();
+// @remark User must check the error of each call, and flush at the end.
+class SrsJsonWriter
+{
+private:
+    ISrsStreamWriter* writer_;
+    int chunk_size_;
+    std::string buf_;
+    // Whether the next element is the first one, for each level of object or array.
+    std::vector<bool> firsts_;
+    // Whether the next value follows a key, so it never starts with comma.
+    bool after_key_;
+public:
+    SrsJsonWriter(ISrsStreamWriter* writer, int chunk_size = SRS_JSON_WRITER_CHUNK);
+    virtual ~SrsJsonWriter();
+public:
+    virtual srs_error_t object_start();
+    virtual srs_error_t object_end();
+    virtual srs_error_t array_start();
+    virtual srs_error_t array_end();
+    // Write the key of object, then the value.
+    virtual srs_error_t key(std::string name);
+public:
+    virtual srs_error_t str(std::string value);
+    virtual srs_error_t integer(int64_t value);
+    virtual srs_error_t number(double value);
+    virtual srs_error_t boolean(bool value);
+    virtual srs_error_t null();
+    // Write a small JSON tree as a value, for example, an element of a huge array.
+    virtual srs_error_t any(SrsJsonAny* value);
+public:
+    // Write all buffered bytes to writer.
+    virtual srs_error_t flush();
+private:
+    virtual srs_error_t write_value(const std::string& value);
+    virtual srs_error_t write_end(const std::string& token);
+    virtual srs_error_t try_flush();
+};
+
 #endif
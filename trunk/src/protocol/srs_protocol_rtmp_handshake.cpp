@@ -16,7 +16,9 @@
 #include <srs_protocol_rtmp_stack.hpp>
 #include <srs_kernel_buffer.hpp>
 #include <srs_kernel_utility.hpp>
+#include <srs_kernel_kbps.hpp>
 
+using namespace std;
 using namespace srs_internal;
 
 // for openssl_HMACsha256
@@ -25,6 +27,13 @@ using namespace srs_internal;
 // for openssl_generate_key
 #include <openssl/dh.h>
 
+// The number of complex handshakes, and degraded to simple handshake for exceed max concurrency.
+SrsPps* _srs_pps_hs_complex = NULL;
+SrsPps* _srs_pps_hs_degrade = NULL;
+// The number of DH keypairs fetched from pool, and generated when pool is empty.
+SrsPps* _srs_pps_hs_hit = NULL;
+SrsPps* _srs_pps_hs_miss = NULL;
+
 // For randomly generate the handshake bytes.
 #define RTMP_SIG_SRS_HANDSHAKE RTMP_SIG_SRS_KEY "(" RTMP_SIG_SRS_VERSION ")"
 
@@ -185,6 +194,14 @@ namespace srs_internal
         
         return err;
     }
+
+    srs_error_t genuine_HMACsha256(const void* key, int key_size, const void* data, int data_size, void* digest)
+    {
+        if (_srs_handshake_pool) {
+            return _srs_handshake_pool->hmac_sha256(key, key_size, data, data_size, digest);
+        }
+        return openssl_HMACsha256(key, key_size, data, data_size, digest);
+    }
     
     #define RFC2409_PRIME_1024 \
         "FFFFFFFFFFFFFFFFC90FDAA22168C234C4C6628B80DC1CD1" \
@@ -558,16 +575,22 @@ namespace srs_internal
     {
         srs_error_t err = srs_success;
         
-        SrsDH dh;
-        
-        // ensure generate 128bytes public key.
-        if ((err = dh.initialize(true)) != srs_success) {
-            return srs_error_wrap(err, "dh init");
+        // Use the pre-generated DH keypair if possible, which is generated in background.
+        SrsDH* pdh = _srs_handshake_pool ? _srs_handshake_pool->fetch() : NULL;
+        if (!pdh) {
+            pdh = new SrsDH();
+            
+            // ensure generate 128bytes public key.
+            if ((err = pdh->initialize(true)) != srs_success) {
+                srs_freep(pdh);
+                return srs_error_wrap(err, "dh init");
+            }
         }
+        SrsUniquePtr<SrsDH> dh(pdh);
         
         // directly generate the public key.
         int pkey_size = 128;
-        if ((err = dh.copy_shared_key(c1->get_key(), 128, key.key, pkey_size)) != srs_success) {
+        if ((err = dh->copy_shared_key(c1->get_key(), 128, key.key, pkey_size)) != srs_success) {
             return srs_error_wrap(err, "copy shared key");
         }
         
@@ -622,7 +645,7 @@ namespace srs_internal
         }
         
         c1_digest = new char[SRS_OpensslHashSize];
-        if ((err = openssl_HMACsha256(SrsGenuineFPKey, 30, c1s1_joined_bytes.get(), 1536 - 32, c1_digest)) != srs_success) {
+        if ((err = genuine_HMACsha256(SrsGenuineFPKey, 30, c1s1_joined_bytes.get(), 1536 - 32, c1_digest)) != srs_success) {
             srs_freepa(c1_digest);
             return srs_error_wrap(err, "calc c1 digest");
         }
@@ -645,7 +668,7 @@ namespace srs_internal
         }
         
         s1_digest = new char[SRS_OpensslHashSize];
-        if ((err = openssl_HMACsha256(SrsGenuineFMSKey, 36, c1s1_joined_bytes.get(), 1536 - 32, s1_digest)) != srs_success) {
+        if ((err = genuine_HMACsha256(SrsGenuineFMSKey, 36, c1s1_joined_bytes.get(), 1536 - 32, s1_digest)) != srs_success) {
             srs_freepa(s1_digest);
             return srs_error_wrap(err, "calc s1 digest");
         }
@@ -986,7 +1009,7 @@ namespace srs_internal
         srs_error_t err = srs_success;
         
         char temp_key[SRS_OpensslHashSize];
-        if ((err = openssl_HMACsha256(SrsGenuineFPKey, 62, s1->get_digest(), 32, temp_key)) != srs_success) {
+        if ((err = genuine_HMACsha256(SrsGenuineFPKey, 62, s1->get_digest(), 32, temp_key)) != srs_success) {
             return srs_error_wrap(err, "create c2 temp key");
         }
         
@@ -1006,7 +1029,7 @@ namespace srs_internal
         srs_error_t err = srs_success;
         
         char temp_key[SRS_OpensslHashSize];
-        if ((err = openssl_HMACsha256(SrsGenuineFPKey, 62, s1->get_digest(), 32, temp_key)) != srs_success) {
+        if ((err = genuine_HMACsha256(SrsGenuineFPKey, 62, s1->get_digest(), 32, temp_key)) != srs_success) {
             return srs_error_wrap(err, "create c2 temp key");
         }
         
@@ -1025,7 +1048,7 @@ namespace srs_internal
         srs_error_t err = srs_success;
         
         char temp_key[SRS_OpensslHashSize];
-        if ((err = openssl_HMACsha256(SrsGenuineFMSKey, 68, c1->get_digest(), 32, temp_key)) != srs_success) {
+        if ((err = genuine_HMACsha256(SrsGenuineFMSKey, 68, c1->get_digest(), 32, temp_key)) != srs_success) {
             return srs_error_wrap(err, "create s2 temp key");
         }
         
@@ -1045,7 +1068,7 @@ namespace srs_internal
         srs_error_t err = srs_success;
         
         char temp_key[SRS_OpensslHashSize];
-        if ((err = openssl_HMACsha256(SrsGenuineFMSKey, 68, c1->get_digest(), 32, temp_key)) != srs_success) {
+        if ((err = genuine_HMACsha256(SrsGenuineFMSKey, 68, c1->get_digest(), 32, temp_key)) != srs_success) {
             return srs_error_wrap(err, "create s2 temp key");
         }
         
@@ -1060,6 +1083,207 @@ namespace srs_internal
     }
 }
 
+SrsHandshakeKeyPool::SrsHandshakeKeyPool()
+{
+    capacity_ = 0;
+    max_concurrency_ = 0;
+    concurrency_ = 0;
+    peak_concurrency_ = 0;
+
+    fp30_ = fms36_ = fp62_ = fms68_ = NULL;
+}
+
+SrsHandshakeKeyPool::~SrsHandshakeKeyPool()
+{
+    vector<SrsDH*>::iterator it;
+    for (it = keys_.begin(); it != keys_.end(); ++it) {
+        SrsDH* dh = *it;
+        srs_freep(dh);
+    }
+    keys_.clear();
+
+    HMAC_CTX* ctxs[] = {fp30_, fms36_, fp62_, fms68_};
+    for (int i = 0; i < (int)(sizeof(ctxs) / sizeof(HMAC_CTX*)); i++) {
+        if (ctxs[i]) HMAC_CTX_free(ctxs[i]);
+    }
+}
+
+srs_error_t SrsHandshakeKeyPool::initialize(int capacity, int max_concurrency)
+{
+    srs_error_t err = srs_success;
+
+    capacity_ = srs_max(0, capacity);
+    max_concurrency_ = srs_max(0, max_concurrency);
+
+    // Initialize the HMAC context by genuine keys, so we only need to copy it for each digest.
+    HMAC_CTX** ctxs[] = {&fp30_, &fms36_, &fp62_, &fms68_};
+    uint8_t* keys[] = {SrsGenuineFPKey, SrsGenuineFMSKey, SrsGenuineFPKey, SrsGenuineFMSKey};
+    int sizes[] = {30, 36, 62, 68};
+    for (int i = 0; i < (int)(sizeof(sizes) / sizeof(int)); i++) {
+        if (*ctxs[i]) continue;
+
+        HMAC_CTX* ctx = HMAC_CTX_new();
+        if (ctx == NULL) {
+            return srs_error_new(ERROR_OpenSslCreateHMAC, "hmac new");
+        }
+
+        if (HMAC_Init_ex(ctx, keys[i], sizes[i], EVP_sha256(), NULL) < 0) {
+            HMAC_CTX_free(ctx);
+            return srs_error_new(ERROR_OpenSslSha256Init, "hmac init, key=%d", sizes[i]);
+        }
+
+        *ctxs[i] = ctx;
+    }
+
+    // Drop the keys if pool shrinks.
+    while ((int)keys_.size() > capacity_) {
+        SrsDH* dh = keys_.back();
+        keys_.pop_back();
+        srs_freep(dh);
+    }
+
+    return err;
+}
+
+srs_error_t SrsHandshakeKeyPool::refill(int max)
+{
+    srs_error_t err = srs_success;
+
+    for (int i = 0; i < max && (int)keys_.size() < capacity_; i++) {
+        SrsDH* dh = new SrsDH();
+
+        // Ensure generate 128bytes public key, @see c1s1_strategy::s1_create
+        if ((err = dh->initialize(true)) != srs_success) {
+            srs_freep(dh);
+            return srs_error_wrap(err, "dh init");
+        }
+
+        keys_.push_back(dh);
+    }
+
+    return err;
+}
+
+SrsDH* SrsHandshakeKeyPool::fetch()
+{
+    if (keys_.empty()) {
+        ++_srs_pps_hs_miss->sugar;
+        return NULL;
+    }
+
+    SrsDH* dh = keys_.back();
+    keys_.pop_back();
+    ++_srs_pps_hs_hit->sugar;
+
+    return dh;
+}
+
+bool SrsHandshakeKeyPool::acquire()
+{
+    if (max_concurrency_ > 0 && concurrency_ >= max_concurrency_) {
+        ++_srs_pps_hs_degrade->sugar;
+        return false;
+    }
+
+    concurrency_++;
+    peak_concurrency_ = srs_max(peak_concurrency_, concurrency_);
+    ++_srs_pps_hs_complex->sugar;
+
+    return true;
+}
+
+void SrsHandshakeKeyPool::release()
+{
+    srs_assert(concurrency_ > 0);
+    concurrency_--;
+}
+
+srs_error_t SrsHandshakeKeyPool::hmac_sha256(const void* key, int key_size, const void* data, int data_size, void* digest)
+{
+    srs_error_t err = srs_success;
+
+    HMAC_CTX* initialized = find_hmac(key, key_size);
+    if (!initialized) {
+        return openssl_HMACsha256(key, key_size, data, data_size, digest);
+    }
+
+    HMAC_CTX* ctx = HMAC_CTX_new();
+    if (ctx == NULL) {
+        return srs_error_new(ERROR_OpenSslCreateHMAC, "hmac new");
+    }
+
+    if (!HMAC_CTX_copy(ctx, initialized)) {
+        HMAC_CTX_free(ctx);
+        return srs_error_new(ERROR_OpenSslSha256Init, "hmac copy");
+    }
+
+    unsigned int digest_size = 0;
+    err = do_openssl_HMACsha256(ctx, data, data_size, digest, &digest_size);
+    HMAC_CTX_free(ctx);
+
+    if (err != srs_success) {
+        return srs_error_wrap(err, "hmac sha256");
+    }
+
+    if (digest_size != 32) {
+        return srs_error_new(ERROR_OpenSslSha256DigestSize, "digest size %d", digest_size);
+    }
+
+    return err;
+}
+
+int SrsHandshakeKeyPool::size()
+{
+    return (int)keys_.size();
+}
+
+int SrsHandshakeKeyPool::capacity()
+{
+    return capacity_;
+}
+
+int SrsHandshakeKeyPool::concurrency()
+{
+    return concurrency_;
+}
+
+int SrsHandshakeKeyPool::peak_concurrency()
+{
+    return peak_concurrency_;
+}
+
+HMAC_CTX* SrsHandshakeKeyPool::find_hmac(const void* key, int key_size)
+{
+    if (key == SrsGenuineFPKey) {
+        if (key_size == 30) return fp30_;
+        if (key_size == 62) return fp62_;
+    } else if (key == SrsGenuineFMSKey) {
+        if (key_size == 36) return fms36_;
+        if (key_size == 68) return fms68_;
+    }
+    return NULL;
+}
+
+SrsHandshakeKeyPool* _srs_handshake_pool = NULL;
+
+SrsHandshakeSlot::SrsHandshakeSlot(SrsHandshakeKeyPool* pool)
+{
+    pool_ = pool;
+    acquired_ = pool_ ? pool_->acquire() : true;
+}
+
+SrsHandshakeSlot::~SrsHandshakeSlot()
+{
+    if (pool_ && acquired_) {
+        pool_->release();
+    }
+}
+
+bool SrsHandshakeSlot::acquired()
+{
+    return acquired_;
+}
+
 SrsSimpleHandshake::SrsSimpleHandshake()
 {
 }
@@ -1159,6 +1383,13 @@ srs_error_t SrsComplexHandshake::handshake_with_client(SrsHandshakeBytes* hs_byt
         return srs_error_wrap(err, "read c0c1");
     }
     
+    // Limit the concurrency of complex handshake, degrade to simple handshake when overload,
+    // so that the reconnect storm never starves the established streams.
+    SrsHandshakeSlot slot(_srs_handshake_pool);
+    if (!slot.acquired()) {
+        return srs_error_new(ERROR_RTMP_TRY_SIMPLE_HS, "complex handshake overload, try simple handshake");
+    }
+    
     // decode c1
     c1s1 c1;
     // try schema0.
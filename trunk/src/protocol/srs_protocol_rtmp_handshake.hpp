@@ -9,6 +9,8 @@
 
 #include <srs_core.hpp>
 
+#include <vector>
+
 class ISrsProtocolReadWriter;
 class SrsComplexHandshake;
 class SrsHandshakeBytes;
@@ -30,6 +32,8 @@ namespace srs_internal
     extern uint8_t SrsGenuineFMSKey[];
     extern uint8_t SrsGenuineFPKey[];
     srs_error_t openssl_HMACsha256(const void* key, int key_size, const void* data, int data_size, void* digest);
+    // Same to openssl_HMACsha256, but use the initialized HMAC context of handshake pool if possible.
+    srs_error_t genuine_HMACsha256(const void* key, int key_size, const void* data, int data_size, void* digest);
     srs_error_t openssl_generate_key(char* public_key, int32_t size);
     
     // The DH wrapper.
@@ -398,6 +402,77 @@ namespace srs_internal
     };
 }
 
+// The pool for RTMP complex handshake, to protect the server from reconnect storms.
+// It pre-generates the DH keypairs in background, keeps the HMAC contexts initialized by
+// the genuine keys, and limits the number of concurrent complex handshakes.
+// @remark When exceed the max concurrency, the handshake degrades to simple handshake.
+class SrsHandshakeKeyPool
+{
+private:
+    // The pre-generated DH keypairs, each keypair is used by only one handshake.
+    std::vector<srs_internal::SrsDH*> keys_;
+    // The max number of DH keypairs in pool, 0 to disable the pool.
+    int capacity_;
+private:
+    // The max number of concurrent complex handshakes, 0 to disable the limiter.
+    int max_concurrency_;
+    // The number of complex handshakes in progress, and the peak of it.
+    int concurrency_;
+    int peak_concurrency_;
+private:
+    // The HMAC contexts initialized by the genuine FP and FMS keys, the key size is
+    // 30, 36, 62 and 68 bytes, which is used to sign and validate the c1s1 and c2s2.
+    HMAC_CTX* fp30_;
+    HMAC_CTX* fms36_;
+    HMAC_CTX* fp62_;
+    HMAC_CTX* fms68_;
+public:
+    SrsHandshakeKeyPool();
+    virtual ~SrsHandshakeKeyPool();
+public:
+    // Initialize the pool, without generating any DH keypair.
+    // @param capacity The max number of DH keypairs in pool, 0 to disable the pool.
+    // @param max_concurrency The max number of concurrent complex handshakes, 0 to disable the limiter.
+    virtual srs_error_t initialize(int capacity, int max_concurrency);
+    // Generate at most max DH keypairs, until the pool is full.
+    // @remark It consumes CPU, so user should call it in background, for example, by a timer.
+    virtual srs_error_t refill(int max);
+    // Fetch a DH keypair from pool, or NULL if the pool is empty.
+    // @remark User must free the fetched keypair.
+    virtual srs_internal::SrsDH* fetch();
+    // Acquire a slot for complex handshake, return false if exceed the max concurrency.
+    // @remark User must release the slot if acquired.
+    virtual bool acquire();
+    virtual void release();
+    // Sign the data by HMAC-SHA256, use the initialized HMAC context if key is one of genuine keys.
+    virtual srs_error_t hmac_sha256(const void* key, int key_size, const void* data, int data_size, void* digest);
+public:
+    virtual int size();
+    virtual int capacity();
+    virtual int concurrency();
+    virtual int peak_concurrency();
+private:
+    virtual HMAC_CTX* find_hmac(const void* key, int key_size);
+};
+
+// The global handshake pool, NULL to always generate DH keypair for each handshake.
+extern SrsHandshakeKeyPool* _srs_handshake_pool;
+
+// The slot of complex handshake, acquire the slot when created, release it when destroyed.
+class SrsHandshakeSlot
+{
+private:
+    SrsHandshakeKeyPool* pool_;
+    bool acquired_;
+public:
+    // @param pool The handshake pool, NULL to always acquired.
+    SrsHandshakeSlot(SrsHandshakeKeyPool* pool);
+    virtual ~SrsHandshakeSlot();
+public:
+    // Whether acquired the slot, or exceed the max concurrency.
+    bool acquired();
+};
+
 // Simple handshake.
 // user can try complex handshake first,
 // rollback to simple handshake if error ERROR_RTMP_TRY_SIMPLE_HS
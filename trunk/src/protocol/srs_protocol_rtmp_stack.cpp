@@ -14,6 +14,7 @@
 #include <srs_protocol_stream.hpp>
 #include <srs_protocol_utility.hpp>
 #include <srs_protocol_rtmp_handshake.hpp>
+#include <srs_protocol_st.hpp>
 
 // for srs-librtmp, @see https://github.com/ossrs/srs/issues/213
 #ifndef _WIN32
@@ -188,6 +189,7 @@ SrsProtocol::SrsProtocol(ISrsProtocolReadWriter* io)
     srs_assert(nb_out_iovs >= 2);
     
     warned_c0c3_cache_dry = false;
+    zerocopy_ = NULL;
     auto_response_when_recv = true;
     show_debug_info = true;
     in_buffer_length = 0;
@@ -289,6 +291,24 @@ void SrsProtocol::set_recv_buffer(int buffer_size)
 }
 #endif
 
+srs_error_t SrsProtocol::set_zerocopy(int threshold)
+{
+    srs_error_t err = srs_success;
+
+    ISrsZerocopyWriter* zc = dynamic_cast<ISrsZerocopyWriter*>(skt);
+    if (!zc) {
+        return srs_error_new(ERROR_SOCKET_ZEROCOPY, "not supported");
+    }
+
+    if ((err = zc->set_zerocopy(threshold)) != srs_success) {
+        return srs_error_wrap(err, "zerocopy");
+    }
+
+    zerocopy_ = zc;
+
+    return err;
+}
+
 void SrsProtocol::set_recv_timeout(srs_utime_t tm)
 {
     return skt->set_recv_timeout(tm);
@@ -747,9 +767,14 @@ srs_error_t SrsProtocol::send_and_free_messages(SrsSharedPtrMessage** msgs, int
     // for performance issue.
     srs_error_t err = do_send_messages(msgs, nb_msgs);
     
+    // For zerocopy, the payloads are retained until kernel completes the sends.
     for (int i = 0; i < nb_msgs; i++) {
         SrsSharedPtrMessage* msg = msgs[i];
-        srs_freep(msg);
+        if (zerocopy_) {
+            zerocopy_->zerocopy_free(msg);
+        } else {
+            srs_freep(msg);
+        }
     }
     
     // donot flush when send failed
@@ -2155,6 +2180,11 @@ void SrsRtmpServer::set_recv_buffer(int buffer_size)
 }
 #endif
 
+srs_error_t SrsRtmpServer::set_zerocopy(int threshold)
+{
+    return protocol->set_zerocopy(threshold);
+}
+
 void SrsRtmpServer::set_recv_timeout(srs_utime_t tm)
 {
     protocol->set_recv_timeout(tm);
@@ -43,6 +43,7 @@ class SrsPacket;
 class SrsAmf0Object;
 class IMergeReadHandler;
 class SrsCallPacket;
+class ISrsZerocopyWriter;
 
 // The amf0 command message, command name macros
 #define RTMP_AMF0_COMMAND_CONNECT               "connect"
@@ -199,6 +200,8 @@ private:
     bool warned_c0c3_cache_dry;
     // The output chunk size, default to 128, set by config.
     int32_t out_chunk_size;
+    // The zerocopy writer to free the sent messages, NULL to directly free them.
+    ISrsZerocopyWriter* zerocopy_;
 public:
     SrsProtocol(ISrsProtocolReadWriter* io);
     virtual ~SrsProtocol();
@@ -225,6 +228,9 @@ public:
     // @remark when buffer changed, the previous ptr maybe invalid.
     virtual void set_recv_buffer(int buffer_size);
 #endif
+    // Enable MSG_ZEROCOPY of the socket for writes no less than threshold bytes, then the sent messages are retained
+    // by socket until kernel completes the sends.
+    virtual srs_error_t set_zerocopy(int threshold);
 public:
     // To set/get the recv timeout in srs_utime_t.
     // if timeout, recv/send message return ERROR_SOCKET_TIMEOUT.
@@ -640,6 +646,8 @@ public:
     // @remark when buffer changed, the previous ptr maybe invalid.
     virtual void set_recv_buffer(int buffer_size);
 #endif
+    // Enable MSG_ZEROCOPY for writes no less than threshold bytes.
+    virtual srs_error_t set_zerocopy(int threshold);
     // To set/get the recv timeout in srs_utime_t.
     // if timeout, recv/send message return ERROR_SOCKET_TIMEOUT.
     virtual void set_recv_timeout(srs_utime_t tm);
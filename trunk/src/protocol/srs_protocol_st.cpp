@@ -10,6 +10,11 @@
 #include <fcntl.h>
 #include <sys/socket.h>
 #include <netdb.h>
+#include <poll.h>
+#include <netinet/in.h>
+#ifdef __linux__
+#include <linux/errqueue.h>
+#endif
 using namespace std;
 
 #include <srs_core_autofree.hpp>
@@ -18,10 +23,29 @@ using namespace std;
 #include <srs_protocol_utility.hpp>
 #include <srs_kernel_utility.hpp>
 #include <srs_core_deprecated.hpp>
+#include <srs_kernel_flv.hpp>
 
 // nginx also set to 512
 #define SERVER_LISTEN_BACKLOG 512
 
+// For MSG_ZEROCOPY, which requires linux 4.14+, define them for the old headers.
+#ifndef SO_ZEROCOPY
+#define SO_ZEROCOPY 60
+#endif
+#ifndef MSG_ZEROCOPY
+#define MSG_ZEROCOPY 0x4000000
+#endif
+#ifndef SO_EE_ORIGIN_ZEROCOPY
+#define SO_EE_ORIGIN_ZEROCOPY 5
+#endif
+#ifndef SO_EE_CODE_ZEROCOPY_COPIED
+#define SO_EE_CODE_ZEROCOPY_COPIED 1
+#endif
+
+// The iovs smaller than this are copied when send with MSG_ZEROCOPY, because they're generally the chunk or tag
+// headers reused by caller, and it's not worth to pin pages for small buffers.
+#define SRS_ZEROCOPY_MIN_IOV 1024
+
 #ifdef __linux__
 #include <sys/epoll.h>
 
@@ -54,7 +78,15 @@ srs_error_t srs_st_init()
         return srs_error_new(ERROR_ST_SET_SELECT, "st enable st failed, current is %s", st_get_eventsys_name());
     }
 #else
-    if (st_set_eventsys(ST_EVENTSYS_ALT) == -1) {
+#ifdef SRS_IO_URING
+    // Use io_uring if enabled by env, because ST initializes before parsing config. Fallback to epoll if not
+    // supported by kernel, for example, disabled by seccomp in docker.
+    char* io_uring = ::getenv("SRS_IO_URING");
+    if (io_uring && string(io_uring) == "on" && st_set_eventsys(ST_EVENTSYS_IO_URING) == -1) {
+        srs_warn("st io_uring not supported, fallback to epoll");
+    }
+#endif
+    if (st_get_eventsys() == -1 && st_set_eventsys(ST_EVENTSYS_ALT) == -1) {
         return srs_error_new(ERROR_ST_SET_EPOLL, "st enable st failed, current is %s", st_get_eventsys_name());
     }
 #endif
@@ -72,7 +104,7 @@ srs_error_t srs_st_init()
 
     // Switch to the background cid.
     _srs_context->set_id(cid);
-    srs_info("st_init success, use %s", st_get_eventsys_name());
+    srs_trace("st_init success, use %s", st_get_eventsys_name());
     
     return srs_success;
 }
@@ -174,6 +206,28 @@ void srs_thread_yield()
     st_thread_yield();
 }
 
+void srs_stack_setup(int pool, bool guard, bool watermark)
+{
+    st_set_stack_pool(pool);
+    st_set_stack_guard(guard ? 1 : 0);
+    st_set_stack_watermark(watermark ? 1 : 0);
+}
+
+int srs_stack_free_count()
+{
+    return st_get_free_stacks();
+}
+
+bool srs_stack_guard()
+{
+    return st_get_stack_guard() != 0;
+}
+
+int srs_thread_stack_watermark(srs_thread_t thread)
+{
+    return st_thread_stack_watermark((st_thread_t)thread);
+}
+
 _ST_THREAD_CREATE_PFN _pfn_st_thread_create = (_ST_THREAD_CREATE_PFN)st_thread_create;
 
 srs_error_t srs_tcp_connect(string server, int port, srs_utime_t tm, srs_netfd_t* pstfd)
@@ -484,6 +538,14 @@ bool srs_is_never_timeout(srs_utime_t tm)
     return tm == SRS_UTIME_NO_TIMEOUT;
 }
 
+ISrsZerocopyWriter::ISrsZerocopyWriter()
+{
+}
+
+ISrsZerocopyWriter::~ISrsZerocopyWriter()
+{
+}
+
 SrsStSocket::SrsStSocket()
 {
     init(NULL);
@@ -496,6 +558,19 @@ SrsStSocket::SrsStSocket(srs_netfd_t fd)
 
 SrsStSocket::~SrsStSocket()
 {
+    // If zerocopy sends are still in flight, kernel keeps sending the queued pages after the fd is gracefully closed,
+    // while the pages are freed and reused by others, so we must abort the connection to drop the send queue.
+    if (stfd_ && zc_threshold_ > 0) {
+        zerocopy_reap();
+        if (zc_completed_ != zc_next_) {
+            zerocopy_abort();
+        }
+    }
+
+    for (std::deque<ZerocopyRetained>::iterator it = zc_retained_.begin(); it != zc_retained_.end(); ++it) {
+        srs_freep(it->msg);
+        srs_freepa(it->copied);
+    }
 }
 
 void SrsStSocket::init(srs_netfd_t fd)
@@ -503,6 +578,284 @@ void SrsStSocket::init(srs_netfd_t fd)
     stfd_ = fd;
     stm = rtm = SRS_UTIME_NO_TIMEOUT;
     rbytes = sbytes = 0;
+
+    zc_threshold_ = 0;
+    zc_copied_ = false;
+    zc_next_ = zc_completed_ = 0;
+}
+
+srs_error_t SrsStSocket::set_zerocopy(int threshold)
+{
+    srs_error_t err = srs_success;
+
+    srs_assert(stfd_);
+
+#ifdef __linux__
+    int fd = srs_netfd_fileno(stfd_);
+
+    int v = 1;
+    if (setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &v, sizeof(v)) != 0) {
+        return srs_error_new(ERROR_SOCKET_ZEROCOPY, "setsockopt fd=%d", fd);
+    }
+
+    zc_threshold_ = srs_max(1, threshold);
+    srs_trace("set fd=%d SO_ZEROCOPY, threshold=%d", fd, zc_threshold_);
+#else
+    err = srs_error_new(ERROR_SOCKET_ZEROCOPY, "not supported");
+#endif
+
+    return err;
+}
+
+void SrsStSocket::zerocopy_free(SrsSharedPtrMessage* msg)
+{
+    if (!msg) {
+        return;
+    }
+
+    // Directly free it, if no zerocopy send in flight.
+    if (zc_completed_ == zc_next_) {
+        srs_freep(msg);
+        return;
+    }
+
+    ZerocopyRetained r;
+    r.sends = zc_next_;
+    r.msg = msg;
+    r.copied = NULL;
+    zc_retained_.push_back(r);
+}
+
+ssize_t SrsStSocket::zerocopy_read(void* buf, size_t size)
+{
+    int fd = srs_netfd_fileno(stfd_);
+
+    while (true) {
+        ssize_t nn = ::read(fd, buf, size);
+        if (nn >= 0) {
+            return nn;
+        }
+
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno != EAGAIN) {
+            return -1;
+        }
+
+        zerocopy_reap();
+
+        st_utime_t timeout = (rtm == SRS_UTIME_NO_TIMEOUT) ? ST_UTIME_NO_TIMEOUT : rtm;
+        if (st_netfd_poll((st_netfd_t)stfd_, POLLIN, timeout) < 0) {
+            return -1;
+        }
+    }
+}
+
+srs_error_t SrsStSocket::zerocopy_writev(const iovec *iov, int iov_size, bool zerocopy, ssize_t* nwrite)
+{
+    srs_error_t err = srs_success;
+
+    int fd = srs_netfd_fileno(stfd_);
+
+    // Copy the small iovs to a buffer retained until the sends complete, because caller might reuse them.
+    std::vector<iovec> iovs(iov, iov + iov_size);
+    char* copied = NULL;
+    if (zerocopy) {
+        int nn_copied = 0;
+        for (int i = 0; i < iov_size; i++) {
+            if (iovs[i].iov_len < SRS_ZEROCOPY_MIN_IOV) {
+                nn_copied += (int)iovs[i].iov_len;
+            }
+        }
+
+        char* p = copied = (nn_copied > 0) ? new char[nn_copied] : NULL;
+        for (int i = 0; p && i < iov_size; i++) {
+            if (iovs[i].iov_len < SRS_ZEROCOPY_MIN_IOV) {
+                memcpy(p, iovs[i].iov_base, iovs[i].iov_len);
+                iovs[i].iov_base = p;
+                p += iovs[i].iov_len;
+            }
+        }
+    }
+
+    msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iovs.empty() ? NULL : &iovs[0];
+    msg.msg_iovlen = iovs.size();
+
+    ssize_t nb_write = 0;
+    bool sent_zerocopy = false;
+    while (msg.msg_iovlen > 0) {
+        ssize_t r0 = ::sendmsg(fd, &msg, zerocopy ? MSG_ZEROCOPY : 0);
+        if (r0 < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            // Kernel fails to pin the pages, for example, exceeds the optmem limit, so we fallback to copy.
+            if (errno == ENOBUFS && zerocopy) {
+                zerocopy = false;
+                continue;
+            }
+
+            if (errno != EAGAIN) {
+                err = srs_error_new(ERROR_SOCKET_WRITE, "sendmsg");
+                break;
+            }
+
+            zerocopy_reap();
+
+            st_utime_t timeout = (stm == SRS_UTIME_NO_TIMEOUT) ? ST_UTIME_NO_TIMEOUT : stm;
+            if (st_netfd_poll((st_netfd_t)stfd_, POLLOUT, timeout) < 0) {
+                if (errno == ETIME) {
+                    err = srs_error_new(ERROR_SOCKET_TIMEOUT, "writev timeout %d ms", srsu2msi(stm));
+                } else {
+                    err = srs_error_new(ERROR_SOCKET_WRITE, "writev");
+                }
+                break;
+            }
+            continue;
+        }
+
+        // Each zerocopy send with data is notified by kernel in sequence.
+        if (zerocopy && r0 > 0) {
+            zc_next_++;
+            sent_zerocopy = true;
+        }
+        nb_write += r0;
+
+        // Skip the sent iovs, and move on for the partially sent one.
+        iovec* p = msg.msg_iov;
+        while (msg.msg_iovlen > 0 && (size_t)r0 >= p->iov_len) {
+            r0 -= p->iov_len;
+            p++;
+            msg.msg_iovlen--;
+        }
+        if (r0 > 0) {
+            p->iov_base = (char*)p->iov_base + r0;
+            p->iov_len -= r0;
+        }
+        msg.msg_iov = p;
+    }
+
+    if (sent_zerocopy && copied) {
+        ZerocopyRetained r;
+        r.sends = zc_next_;
+        r.msg = NULL;
+        r.copied = copied;
+        zc_retained_.push_back(r);
+    } else {
+        srs_freepa(copied);
+    }
+
+    // Free the retained messages in time.
+    if (!zc_retained_.empty()) {
+        zerocopy_reap();
+    }
+
+    if (nwrite) {
+        *nwrite = nb_write;
+    }
+    sbytes += nb_write;
+
+    return err;
+}
+
+void SrsStSocket::zerocopy_reap()
+{
+#ifdef __linux__
+    int fd = srs_netfd_fileno(stfd_);
+
+    while (true) {
+        char control[128];
+        msghdr msg;
+        memset(&msg, 0, sizeof(msg));
+        msg.msg_control = control;
+        msg.msg_controllen = sizeof(control);
+
+        // Until the error queue is empty.
+        if (::recvmsg(fd, &msg, MSG_ERRQUEUE | MSG_DONTWAIT) < 0) {
+            break;
+        }
+
+        for (cmsghdr* cm = CMSG_FIRSTHDR(&msg); cm; cm = CMSG_NXTHDR(&msg, cm)) {
+            bool is_recverr = (cm->cmsg_level == SOL_IP && cm->cmsg_type == IP_RECVERR)
+                || (cm->cmsg_level == SOL_IPV6 && cm->cmsg_type == IPV6_RECVERR);
+            if (!is_recverr) {
+                continue;
+            }
+
+            sock_extended_err* serr = (sock_extended_err*)CMSG_DATA(cm);
+            if (serr->ee_errno != 0 || serr->ee_origin != SO_EE_ORIGIN_ZEROCOPY) {
+                continue;
+            }
+
+            // Kernel copies the data, for example, for loopback or device without scatter-gather, so it's better to
+            // stop using MSG_ZEROCOPY which only costs more for page pinning and notifications.
+            if ((serr->ee_code & SO_EE_CODE_ZEROCOPY_COPIED) && !zc_copied_) {
+                zc_copied_ = true;
+                srs_trace("zerocopy fd=%d is copied by kernel, fallback to copy", fd);
+            }
+
+            zerocopy_complete(serr->ee_info, serr->ee_data);
+        }
+    }
+#endif
+
+    // Free the retained messages, whose sends are all completed.
+    while (!zc_retained_.empty()) {
+        ZerocopyRetained& r = zc_retained_.front();
+        if ((int32_t)(zc_completed_ - r.sends) < 0) {
+            break;
+        }
+
+        srs_freep(r.msg);
+        srs_freepa(r.copied);
+        zc_retained_.pop_front();
+    }
+}
+
+void SrsStSocket::zerocopy_abort()
+{
+    int fd = srs_netfd_fileno(stfd_);
+
+    // Reset the connection when close, which discards the unsent data rather than sends it.
+    linger v;
+    v.l_onoff = 1;
+    v.l_linger = 0;
+    if (setsockopt(fd, SOL_SOCKET, SO_LINGER, &v, sizeof(v)) != 0) {
+        srs_warn("zerocopy fd=%d set SO_LINGER failed, errno=%d", fd, errno);
+        return;
+    }
+
+    srs_trace("zerocopy fd=%d abort, sends=%u, completed=%u", fd, zc_next_, zc_completed_);
+}
+
+void SrsStSocket::zerocopy_complete(uint32_t lo, uint32_t hi)
+{
+    zc_pending_.push_back(std::make_pair(lo, hi));
+
+    // Generally TCP completes in order, but we merge the ranges in case of out of order.
+    for (bool merged = true; merged;) {
+        merged = false;
+
+        for (std::vector<std::pair<uint32_t, uint32_t> >::iterator it = zc_pending_.begin(); it != zc_pending_.end(); ++it) {
+            // Ignore the range after the completed sequence, that is, lo > completed.
+            if ((int32_t)(it->first - zc_completed_) > 0) {
+                continue;
+            }
+
+            // Advance to the end of range, ignore if it's stale.
+            if ((int32_t)(it->second + 1 - zc_completed_) > 0) {
+                zc_completed_ = it->second + 1;
+            }
+
+            zc_pending_.erase(it);
+            merged = true;
+            break;
+        }
+    }
 }
 
 void SrsStSocket::set_recv_timeout(srs_utime_t tm)
@@ -542,7 +895,9 @@ srs_error_t SrsStSocket::read(void* buf, size_t size, ssize_t* nread)
     srs_assert(stfd_);
 
     ssize_t nb_read;
-    if (rtm == SRS_UTIME_NO_TIMEOUT) {
+    if (zc_threshold_ > 0) {
+        nb_read = zerocopy_read(buf, size);
+    } else if (rtm == SRS_UTIME_NO_TIMEOUT) {
         nb_read = st_read((st_netfd_t)stfd_, buf, size, ST_UTIME_NO_TIMEOUT);
     } else {
         nb_read = st_read((st_netfd_t)stfd_, buf, size, rtm);
@@ -578,8 +933,17 @@ srs_error_t SrsStSocket::read_fully(void* buf, size_t size, ssize_t* nread)
 
     srs_assert(stfd_);
     
-    ssize_t nb_read;
-    if (rtm == SRS_UTIME_NO_TIMEOUT) {
+    ssize_t nb_read = 0;
+    if (zc_threshold_ > 0) {
+        while (nb_read < (ssize_t)size) {
+            ssize_t nn = zerocopy_read((char*)buf + nb_read, size - nb_read);
+            if (nn <= 0) {
+                nb_read = (nn < 0) ? -1 : nb_read;
+                break;
+            }
+            nb_read += nn;
+        }
+    } else if (rtm == SRS_UTIME_NO_TIMEOUT) {
         nb_read = st_read_fully((st_netfd_t)stfd_, buf, size, ST_UTIME_NO_TIMEOUT);
     } else {
         nb_read = st_read_fully((st_netfd_t)stfd_, buf, size, rtm);
@@ -614,6 +978,14 @@ srs_error_t SrsStSocket::write(void* buf, size_t size, ssize_t* nwrite)
     srs_error_t err = srs_success;
 
     srs_assert(stfd_);
+
+    // Never send it with MSG_ZEROCOPY, but we must drain the error queue when zerocopy enabled.
+    if (zc_threshold_ > 0) {
+        iovec iov;
+        iov.iov_base = buf;
+        iov.iov_len = size;
+        return zerocopy_writev(&iov, 1, false, nwrite);
+    }
     
     ssize_t nb_write;
     if (stm == SRS_UTIME_NO_TIMEOUT) {
@@ -646,6 +1018,15 @@ srs_error_t SrsStSocket::writev(const iovec *iov, int iov_size, ssize_t* nwrite)
     srs_error_t err = srs_success;
 
     srs_assert(stfd_);
+
+    // Send the large writes with MSG_ZEROCOPY, and also the small ones to drain the error queue.
+    if (zc_threshold_ > 0) {
+        size_t nn = 0;
+        for (int i = 0; i < iov_size; i++) {
+            nn += iov[i].iov_len;
+        }
+        return zerocopy_writev(iov, iov_size, !zc_copied_ && nn >= (size_t)zc_threshold_, nwrite);
+    }
     
     ssize_t nb_write;
     if (stm == SRS_UTIME_NO_TIMEOUT) {
@@ -708,6 +1089,18 @@ srs_error_t SrsTcpClient::connect()
     return err;
 }
 
+bool SrsTcpClient::is_alive()
+{
+    if (!stfd_) {
+        return false;
+    }
+
+    // Peek without blocking, EOF means closed by peer, and an idle connection should have nothing to read.
+    char c;
+    ssize_t nn = ::recv(srs_netfd_fileno(stfd_), &c, 1, MSG_PEEK | MSG_DONTWAIT);
+    return nn < 0 && (errno == EAGAIN || errno == EWOULDBLOCK);
+}
+
 void SrsTcpClient::set_recv_timeout(srs_utime_t tm)
 {
     io->set_recv_timeout(tm);
@@ -10,6 +10,8 @@
 #include <srs_core.hpp>
 
 #include <string>
+#include <deque>
+#include <vector>
 
 #include <srs_protocol_io.hpp>
 #include <srs_kernel_error.hpp>
@@ -20,6 +22,8 @@ typedef void* srs_thread_t;
 typedef void* srs_cond_t;
 typedef void* srs_mutex_t;
 
+class SrsSharedPtrMessage;
+
 // Initialize ST, requires epoll for linux.
 extern srs_error_t srs_st_init();
 // Destroy ST, free resources for asan detecting.
@@ -48,6 +52,16 @@ extern int srs_thread_join(srs_thread_t thread, void **retvalp);
 extern void srs_thread_interrupt(srs_thread_t thread);
 extern void srs_thread_yield();
 
+// Setup the stacks of coroutines, see st_set_stack_pool, st_set_stack_guard and st_set_stack_watermark.
+// @param pool The max number of free stacks to cache, -1 for unlimited.
+extern void srs_stack_setup(int pool, bool guard, bool watermark);
+// Get the number of free stacks in pool.
+extern int srs_stack_free_count();
+// Whether guard the stacks, the default is by the build of ST.
+extern bool srs_stack_guard();
+// Get the high-water mark of stack in bytes, -1 if not measured.
+extern int srs_thread_stack_watermark(srs_thread_t thread);
+
 // For utest to mock the thread create.
 typedef void* (*_ST_THREAD_CREATE_PFN)(void *(*start)(void *arg), void *arg, int joinable, int stack_size);
 extern _ST_THREAD_CREATE_PFN _pfn_st_thread_create;
@@ -118,10 +132,37 @@ public:
     }
 };
 
+// The writer supports MSG_ZEROCOPY of linux for large writev, see https://docs.kernel.org/networking/msg_zerocopy.html
+// Because kernel sends the pages of iovs after writev returns, the large buffers written must not be freed or reused
+// until kernel notifies the completion, so the caller must free the sent messages by zerocopy_free.
+class ISrsZerocopyWriter
+{
+public:
+    ISrsZerocopyWriter();
+    virtual ~ISrsZerocopyWriter();
+public:
+    // Enable MSG_ZEROCOPY for writev which is no less than threshold bytes.
+    // @remark Only the large iovs are sent without copy, the small ones like chunk headers are copied.
+    virtual srs_error_t set_zerocopy(int threshold) = 0;
+    // Free the sent message, which is retained until kernel completes all the zerocopy sends so far.
+    // @remark Directly free it if zerocopy is disabled or nothing in flight.
+    virtual void zerocopy_free(SrsSharedPtrMessage* msg) = 0;
+};
+
 // the socket provides TCP socket over st,
 // that is, the sync socket mechanism.
-class SrsStSocket : public ISrsProtocolReadWriter
+class SrsStSocket : public ISrsProtocolReadWriter, public ISrsZerocopyWriter
 {
+private:
+    // The message or copied buffer retained until the zerocopy sends before it completes.
+    class ZerocopyRetained
+    {
+    public:
+        // The number of zerocopy sends to complete, which is the sequence of next send when retain it.
+        uint32_t sends;
+        SrsSharedPtrMessage* msg;
+        char* copied;
+    };
 private:
     // The recv/send timeout in srs_utime_t.
     // @remark Use SRS_UTIME_NO_TIMEOUT for never timeout.
@@ -132,12 +173,39 @@ private:
     int64_t sbytes;
     // The underlayer st fd.
     srs_netfd_t stfd_;
+private:
+    // The threshold in bytes of writev to use MSG_ZEROCOPY, 0 to disable it.
+    int zc_threshold_;
+    // Whether kernel copies the data, for example, for loopback, so we stop to send with MSG_ZEROCOPY.
+    bool zc_copied_;
+    // The sequence of next zerocopy send, and the number of sends completed by kernel, both wrap around.
+    uint32_t zc_next_;
+    uint32_t zc_completed_;
+    // The completions notified by kernel out of order, in [lo, hi] ranges.
+    std::vector<std::pair<uint32_t, uint32_t> > zc_pending_;
+    // The messages and buffers retained until kernel completes the sends, in order of sends.
+    std::deque<ZerocopyRetained> zc_retained_;
 public:
     SrsStSocket();
     SrsStSocket(srs_netfd_t fd);
     virtual ~SrsStSocket();
 private:
     void init(srs_netfd_t fd);
+// Interface ISrsZerocopyWriter
+public:
+    virtual srs_error_t set_zerocopy(int threshold);
+    virtual void zerocopy_free(SrsSharedPtrMessage* msg);
+private:
+    // Read from fd and drain the error queue when wakeup, because the completions in error queue make the fd always
+    // readable with POLLERR, so we couldn't use st_read which will spin on it.
+    ssize_t zerocopy_read(void* buf, size_t size);
+    // Send all iovs in a loop, with MSG_ZEROCOPY if zerocopy is true.
+    srs_error_t zerocopy_writev(const iovec *iov, int iov_size, bool zerocopy, ssize_t* nwrite);
+    // Drain the completions from error queue, and free the retained messages of completed sends.
+    void zerocopy_reap();
+    // Set SO_LINGER to reset the connection when close, for the sends in flight.
+    void zerocopy_abort();
+    void zerocopy_complete(uint32_t lo, uint32_t hi);
 public:
     virtual void set_recv_timeout(srs_utime_t tm);
     virtual srs_utime_t get_recv_timeout();
@@ -183,6 +251,9 @@ public:
     // Connect to server over TCP.
     // @remark We will close the exists connection before do connect.
     virtual srs_error_t connect();
+    // Whether the idle connection is still usable, false if closed or reset by peer, or
+    // there is unexpected data to read. It never blocks.
+    virtual bool is_alive();
 // Interface ISrsProtocolReadWriter
 public:
     virtual void set_recv_timeout(srs_utime_t tm);
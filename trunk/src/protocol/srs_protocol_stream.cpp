@@ -7,6 +7,7 @@
 #include <srs_protocol_stream.hpp>
 
 #include <stdlib.h>
+#include <string.h>
 
 #include <srs_kernel_error.hpp>
 #include <srs_kernel_log.hpp>
@@ -25,6 +26,110 @@
 // @see SrsProtocol::read_message_header().
 #define SRS_RTMP_MAX_MESSAGE_HEADER 11
 
+// The min size of adaptive buffer, 4KB, which is enough for most players.
+#define SRS_FAST_STREAM_MIN 4096
+
+// Shrink the adaptive buffer, if the peak read is small in the window of reads.
+#define SRS_FAST_STREAM_WINDOW 128
+
+// The max bytes of free buffers in pool, 16MB.
+#define SRS_FAST_STREAM_POOL_SIZE (16 * 1024 * 1024)
+
+// Get the size class of adaptive buffer, the power of 2 which is not less than size.
+static int srs_fast_stream_size(int size)
+{
+    int v = SRS_FAST_STREAM_MIN;
+    while (v < size) {
+        v <<= 1;
+    }
+    return v;
+}
+
+SrsFastStreamPool* SrsFastStreamPool::_instance = NULL;
+
+SrsFastStreamPool::SrsFastStreamPool()
+{
+    nb_max_free = SRS_FAST_STREAM_POOL_SIZE;
+    nb_free = 0;
+
+    nn_streams = 0;
+    nb_bytes = 0;
+    nn_grows = 0;
+    nn_shrinks = 0;
+}
+
+SrsFastStreamPool::~SrsFastStreamPool()
+{
+    set_max_free(0);
+}
+
+SrsFastStreamPool* SrsFastStreamPool::instance()
+{
+    if (!_instance) {
+        _instance = new SrsFastStreamPool();
+    }
+    return _instance;
+}
+
+void SrsFastStreamPool::set_max_free(int64_t v)
+{
+    nb_max_free = v;
+
+    // Free the buffers exceed the pool, the large buffers first.
+    for (int i = SRS_FAST_STREAM_CLASSES - 1; i >= 0 && nb_free > nb_max_free; i--) {
+        std::vector<char*>& free_blocks = blocks[i];
+        while (!free_blocks.empty() && nb_free > nb_max_free) {
+            free(free_blocks.back());
+            free_blocks.pop_back();
+            nb_free -= SRS_FAST_STREAM_MIN << i;
+        }
+    }
+}
+
+int64_t SrsFastStreamPool::free_bytes()
+{
+    return nb_free;
+}
+
+char* SrsFastStreamPool::allocate(int size)
+{
+    nb_bytes += size;
+
+    int i = size_class(size);
+    if (i >= 0 && !blocks[i].empty()) {
+        char* buf = blocks[i].back();
+        blocks[i].pop_back();
+        nb_free -= size;
+        return buf;
+    }
+
+    return (char*)malloc(size);
+}
+
+void SrsFastStreamPool::release(char* buf, int size)
+{
+    nb_bytes -= size;
+
+    int i = size_class(size);
+    if (i >= 0 && nb_free + size <= nb_max_free) {
+        blocks[i].push_back(buf);
+        nb_free += size;
+        return;
+    }
+
+    free(buf);
+}
+
+int SrsFastStreamPool::size_class(int size)
+{
+    for (int i = 0; i < SRS_FAST_STREAM_CLASSES; i++) {
+        if (size == (SRS_FAST_STREAM_MIN << i)) {
+            return i;
+        }
+    }
+    return -1;
+}
+
 #ifdef SRS_PERF_MERGED_READ
 IMergeReadHandler::IMergeReadHandler()
 {
@@ -42,14 +147,25 @@ SrsFastStream::SrsFastStream(int size)
     _handler = NULL;
 #endif
     
-    nb_buffer = size? size:SRS_DEFAULT_RECV_BUFFER_SIZE;
-    buffer = (char*)malloc(nb_buffer);
+    // The adaptive buffer starts small, and grows to the default size.
+    adaptive = !size;
+    nb_max_buffer = size? size:SRS_DEFAULT_RECV_BUFFER_SIZE;
+    nn_reads = nb_peak_read = 0;
+
+    SrsFastStreamPool* pool = SrsFastStreamPool::instance();
+    pool->nn_streams++;
+
+    nb_buffer = adaptive? SRS_FAST_STREAM_MIN:size;
+    buffer = pool->allocate(nb_buffer);
     p = end = buffer;
 }
 
 SrsFastStream::~SrsFastStream()
 {
-    free(buffer);
+    SrsFastStreamPool* pool = SrsFastStreamPool::instance();
+    pool->nn_streams--;
+
+    pool->release(buffer, nb_buffer);
     buffer = NULL;
 }
 
@@ -74,18 +190,22 @@ void SrsFastStream::set_buffer(int buffer_size)
     int nb_resize_buf = srs_min(buffer_size, SRS_MAX_SOCKET_BUFFER);
     
     // only realloc when buffer changed bigger
-    if (nb_resize_buf <= nb_buffer) {
+    if (nb_resize_buf <= nb_max_buffer) {
+        return;
+    }
+    nb_max_buffer = nb_resize_buf;
+
+    // For adaptive buffer, grow when read, see grow().
+    if (adaptive) {
         return;
     }
     
-    // realloc for buffer change bigger.
-    int start = (int)(p - buffer);
-    int nb_bytes = (int)(end - p);
-    
-    buffer = (char*)realloc(buffer, nb_resize_buf);
-    nb_buffer = nb_resize_buf;
-    p = buffer + start;
-    end = p + nb_bytes;
+    resize(nb_resize_buf);
+}
+
+int SrsFastStream::capacity()
+{
+    return nb_buffer;
 }
 
 char SrsFastStream::read_1byte()
@@ -124,6 +244,18 @@ srs_error_t SrsFastStream::grow(ISrsReader* reader, int required_size)
     
     // must be positive.
     srs_assert(required_size > 0);
+
+    SrsFastStreamPool* pool = SrsFastStreamPool::instance();
+
+    // Shrink the adaptive buffer when it's empty, if the peak read is small in the window.
+    if (adaptive && p == end && nn_reads >= SRS_FAST_STREAM_WINDOW) {
+        int nb_shrink_buf = srs_fast_stream_size(srs_max(nb_peak_read * 2, required_size));
+        if (nb_shrink_buf < nb_buffer) {
+            resize(nb_shrink_buf);
+            pool->nn_shrinks++;
+        }
+        nn_reads = nb_peak_read = 0;
+    }
     
     // the free space of buffer,
     //      buffer = consumed_bytes + exists_bytes + free_space.
@@ -147,6 +279,13 @@ srs_error_t SrsFastStream::grow(ISrsReader* reader, int required_size)
             p = buffer;
             end = p + nb_exists_bytes;
         }
+
+        // Grow the adaptive buffer only when the unconsumed bytes need more space after compacted,
+        // never exceed the max size.
+        if (adaptive && required_size > nb_buffer && required_size <= nb_max_buffer) {
+            resize(srs_min(nb_max_buffer, srs_fast_stream_size(required_size)));
+            pool->nn_grows++;
+        }
         
         // check whether enough free space in buffer.
         nb_free_space = (int)(buffer + nb_buffer - end);
@@ -161,6 +300,10 @@ srs_error_t SrsFastStream::grow(ISrsReader* reader, int required_size)
         if ((err = reader->read(end, nb_free_space, &nread)) != srs_success) {
             return srs_error_wrap(err, "read bytes");
         }
+
+        // Stat the read size, to grow or shrink the adaptive buffer.
+        nn_reads++;
+        nb_peak_read = srs_max(nb_peak_read, (int)nread);
         
 #ifdef SRS_PERF_MERGED_READ
         /**
@@ -182,6 +325,29 @@ srs_error_t SrsFastStream::grow(ISrsReader* reader, int required_size)
     return err;
 }
 
+void SrsFastStream::resize(int size)
+{
+    int nb_bytes = (int)(end - p);
+    srs_assert(size >= nb_bytes);
+
+    if (size == nb_buffer) {
+        return;
+    }
+
+    // Move the left bytes to the new buffer.
+    SrsFastStreamPool* pool = SrsFastStreamPool::instance();
+    char* buf = pool->allocate(size);
+    if (nb_bytes) {
+        memcpy(buf, p, nb_bytes);
+    }
+    pool->release(buffer, nb_buffer);
+
+    buffer = buf;
+    nb_buffer = size;
+    p = buffer;
+    end = p + nb_bytes;
+}
+
 #ifdef SRS_PERF_MERGED_READ
 void SrsFastStream::set_merge_read(bool v, IMergeReadHandler* handler)
 {
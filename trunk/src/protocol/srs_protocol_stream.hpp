@@ -9,6 +9,8 @@
 
 #include <srs_core.hpp>
 
+#include <vector>
+
 #include <srs_protocol_io.hpp>
 #include <srs_core_performance.hpp>
 #include <srs_kernel_stream.hpp>
@@ -35,6 +37,49 @@ public:
 };
 #endif
 
+// The number of size classes of pool, from 4KB to 256KB.
+#define SRS_FAST_STREAM_CLASSES 7
+
+/**
+ * The shared pool of buffers for SrsFastStream, by size class of power of 2, so that a burst
+ * of connection borrows the large buffer from pool, and returns it when the burst is over.
+ * @remark It's not thread-safe, should only be used in one thread.
+ */
+class SrsFastStreamPool
+{
+private:
+    static SrsFastStreamPool* _instance;
+private:
+    // The free buffers by size class, the class i is 4KB << i.
+    std::vector<char*> blocks[SRS_FAST_STREAM_CLASSES];
+    // The max bytes of free buffers in pool.
+    int64_t nb_max_free;
+    int64_t nb_free;
+public:
+    // The stat of all streams, the number of streams and the bytes of their buffers.
+    int nn_streams;
+    int64_t nb_bytes;
+    // The stat of adaptive streams, the number of grows and shrinks.
+    int64_t nn_grows;
+    int64_t nn_shrinks;
+public:
+    SrsFastStreamPool();
+    virtual ~SrsFastStreamPool();
+public:
+    static SrsFastStreamPool* instance();
+public:
+    // Set the max bytes of free buffers in pool, 0 to disable pool.
+    void set_max_free(int64_t v);
+    // Get the bytes of free buffers in pool.
+    int64_t free_bytes();
+    // Allocate a buffer of size, which is from pool if it's a size class.
+    char* allocate(int size);
+    // Release the buffer of size, which is cached in pool if it's a size class.
+    void release(char* buf, int size);
+private:
+    int size_class(int size);
+};
+
 /**
  * the buffer provices bytes cache for protocol. generally,
  * protocol recv data from socket, put into buffer, decode to RTMP message.
@@ -65,8 +110,17 @@ private:
     char* buffer;
     // the size of buffer.
     int nb_buffer;
+private:
+    // Whether the buffer is adaptive, which starts small, then grows by the required size and shrinks by the read size.
+    bool adaptive;
+    // The max size of buffer, never grow over it.
+    int nb_max_buffer;
+    // The number of reads and the peak read size in the window, to shrink the buffer.
+    int nn_reads;
+    int nb_peak_read;
 public:
-    // If buffer is 0, use default size.
+    // If buffer is 0, use adaptive buffer, which starts small and grows to default size;
+    // otherwise, use fixed size buffer.
     SrsFastStream(int size=0);
     virtual ~SrsFastStream();
 public:
@@ -81,13 +135,18 @@ public:
      */
     virtual char* bytes();
     /**
-     * create buffer with specifeid size.
+     * set the max size of buffer, the adaptive buffer grows to it when read, while the fixed
+     * buffer is resized immediately.
      * @param buffer the size of buffer. ignore when smaller than SRS_MAX_SOCKET_BUFFER.
      * @remark when MR(SRS_PERF_MERGED_READ) disabled, always set to 8K.
      * @remark when buffer changed, the previous ptr maybe invalid.
      * @see https://github.com/ossrs/srs/issues/241
      */
     virtual void set_buffer(int buffer_size);
+    /**
+     * get the size of buffer in bytes, that is the memory used.
+     */
+    virtual int capacity();
 public:
     /**
      * read 1byte from buffer, move to next bytes.
@@ -118,6 +177,9 @@ public:
      * @remark, we actually maybe read more than required_size, maybe 4k for example.
      */
     virtual srs_error_t grow(ISrsReader* reader, int required_size);
+private:
+    // Resize the buffer to size, keep the bytes in buffer.
+    void resize(int size);
 public:
 #ifdef SRS_PERF_MERGED_READ
     /**
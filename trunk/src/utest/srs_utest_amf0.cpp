@@ -2833,6 +2833,90 @@ VOID TEST(ProtocolJSONTest, ArrayAPI)
     srs_freep(a);
 }
 
+MockJsonStreamWriter::MockJsonStreamWriter()
+{
+    nn_writes = 0;
+}
+
+MockJsonStreamWriter::~MockJsonStreamWriter()
+{
+}
+
+srs_error_t MockJsonStreamWriter::write(void* buf, size_t size, ssize_t* nwrite)
+{
+    data.append((char*)buf, size);
+    nn_writes++;
+    if (nwrite) {
+        *nwrite = size;
+    }
+    return srs_success;
+}
+
+VOID TEST(ProtocolJSONTest, StreamingWriter)
+{
+    srs_error_t err;
+
+    // Same to the dumps of JSON tree.
+    if (true) {
+        MockJsonStreamWriter w;
+        SrsJsonWriter jw(&w);
+
+        HELPER_EXPECT_SUCCESS(jw.object_start());
+        HELPER_EXPECT_SUCCESS(jw.key("code"));
+        HELPER_EXPECT_SUCCESS(jw.integer(0));
+        HELPER_EXPECT_SUCCESS(jw.key("name"));
+        HELPER_EXPECT_SUCCESS(jw.str("srs\"\n"));
+        HELPER_EXPECT_SUCCESS(jw.key("ok"));
+        HELPER_EXPECT_SUCCESS(jw.boolean(true));
+        HELPER_EXPECT_SUCCESS(jw.key("kbps"));
+        HELPER_EXPECT_SUCCESS(jw.number(1.5));
+        HELPER_EXPECT_SUCCESS(jw.key("none"));
+        HELPER_EXPECT_SUCCESS(jw.null());
+        HELPER_EXPECT_SUCCESS(jw.key("empty"));
+        HELPER_EXPECT_SUCCESS(jw.array_start());
+        HELPER_EXPECT_SUCCESS(jw.array_end());
+        HELPER_EXPECT_SUCCESS(jw.key("data"));
+        HELPER_EXPECT_SUCCESS(jw.array_start());
+        HELPER_EXPECT_SUCCESS(jw.integer(1));
+        HELPER_EXPECT_SUCCESS(jw.object_start());
+        HELPER_EXPECT_SUCCESS(jw.object_end());
+        SrsUniquePtr<SrsJsonObject> obj(SrsJsonAny::object());
+        obj->set("id", SrsJsonAny::integer(3));
+        HELPER_EXPECT_SUCCESS(jw.any(obj.get()));
+        HELPER_EXPECT_SUCCESS(jw.array_end());
+        HELPER_EXPECT_SUCCESS(jw.object_end());
+
+        // Never write before flush, for small JSON.
+        EXPECT_EQ(0, w.nn_writes);
+        HELPER_EXPECT_SUCCESS(jw.flush());
+        EXPECT_EQ(1, w.nn_writes);
+        EXPECT_STREQ("{\"code\":0,\"name\":\"srs\\\"\\n\",\"ok\":true,\"kbps\":1.50,\"none\":null,\"empty\":[],\"data\":[1,{},{\"id\":3}]}", w.data.c_str());
+
+        SrsJsonAny* p = SrsJsonAny::loads(w.data);
+        SrsUniquePtr<SrsJsonAny> p_uptr(p);
+        ASSERT_TRUE(p && p->is_object());
+    }
+
+    // Flush in chunks.
+    if (true) {
+        MockJsonStreamWriter w;
+        SrsJsonWriter jw(&w, 16);
+
+        HELPER_EXPECT_SUCCESS(jw.array_start());
+        for (int i = 0; i < 100; i++) {
+            HELPER_EXPECT_SUCCESS(jw.str("livestream"));
+        }
+        HELPER_EXPECT_SUCCESS(jw.array_end());
+        HELPER_EXPECT_SUCCESS(jw.flush());
+        EXPECT_GT(w.nn_writes, 50);
+
+        SrsJsonAny* p = SrsJsonAny::loads(w.data);
+        SrsUniquePtr<SrsJsonAny> p_uptr(p);
+        ASSERT_TRUE(p && p->is_array());
+        EXPECT_EQ(100, p->to_array()->count());
+    }
+}
+
 VOID TEST(ProtocolJSONTest, ParseSpecial)
 {
     if (true) {
@@ -13,6 +13,21 @@
 #include <srs_utest.hpp>
 
 #include <srs_protocol_amf0.hpp>
+#include <srs_kernel_io.hpp>
+
+#include <string>
+
+class MockJsonStreamWriter : public ISrsStreamWriter
+{
+public:
+    std::string data;
+    int nn_writes;
+public:
+    MockJsonStreamWriter();
+    virtual ~MockJsonStreamWriter();
+public:
+    virtual srs_error_t write(void* buf, size_t size, ssize_t* nwrite);
+};
 
 #endif
 
@@ -15,6 +15,27 @@ using namespace std;
 #include <srs_app_st.hpp>
 #include <srs_protocol_conn.hpp>
 #include <srs_app_conn.hpp>
+#include <srs_app_http_hooks.hpp>
+#include <srs_protocol_rtmp_stack.hpp>
+#include <srs_kernel_utility.hpp>
+#include <srs_app_async_call.hpp>
+#include <srs_app_coworkers.hpp>
+#include <srs_app_http_static.hpp>
+#include <srs_app_heartbeat.hpp>
+#include <srs_protocol_json.hpp>
+#include <srs_app_threads.hpp>
+#include <srs_app_hybrid.hpp>
+#include <srs_app_hourglass.hpp>
+#include <srs_app_source.hpp>
+#include <srs_protocol_rtmp_msg_array.hpp>
+#include <srs_utest_config.hpp>
+#include <srs_app_statistic.hpp>
+#include <srs_utest_http.hpp>
+#include <srs_protocol_http_stack.hpp>
+#include <srs_protocol_http_conn.hpp>
+#include <srs_protocol_http_client.hpp>
+#include <srs_app_edge.hpp>
+#include <srs_kernel_balance.hpp>
 
 class MockIDResource : public ISrsResource
 {
@@ -783,3 +804,1127 @@ VOID TEST(AppSecurity, CheckSecurity)
     //       4. deny if matches deny strategy.
 }
 
+VOID TEST(AppHttpHooksTest, DecisionKeyAndCache)
+{
+    // The key is identified by the default cache_key fields: app, stream and param.
+    if (true) {
+        SrsRequest req;
+        req.vhost = "__defaultVhost__";
+        req.app = "live";
+        req.stream = "livestream";
+        req.param = "?token=abc";
+        req.ip = "10.0.0.1";
+
+        string k0 = SrsHttpHooks::decision_key("on_play", "http://127.0.0.1:8085/api/v1/sessions", &req);
+        req.ip = "10.0.0.2";
+        EXPECT_STREQ(k0.c_str(), SrsHttpHooks::decision_key("on_play", "http://127.0.0.1:8085/api/v1/sessions", &req).c_str());
+        EXPECT_STRNE(k0.c_str(), SrsHttpHooks::decision_key("on_publish", "http://127.0.0.1:8085/api/v1/sessions", &req).c_str());
+        EXPECT_STRNE(k0.c_str(), SrsHttpHooks::decision_key("on_play", "http://127.0.0.1:8086/api/v1/sessions", &req).c_str());
+
+        req.param = "?token=xyz";
+        EXPECT_STRNE(k0.c_str(), SrsHttpHooks::decision_key("on_play", "http://127.0.0.1:8085/api/v1/sessions", &req).c_str());
+    }
+
+    // The pending decision never expire, the done one expire by TTL.
+    if (true) {
+        SrsHttpHooksPool pool;
+        SrsSharedPtr<SrsHttpHooksDecision> d(new SrsHttpHooksDecision());
+        pool.set("k0", d);
+        EXPECT_TRUE(pool.find("k0").get() == d.get());
+        EXPECT_TRUE(pool.find("k1").get() == NULL);
+
+        d->done = true;
+        d->expire = srs_get_system_time() + 10 * SRS_UTIME_SECONDS;
+        EXPECT_TRUE(pool.find("k0").get() == d.get());
+
+        d->expire = 1;
+        EXPECT_TRUE(pool.find("k0").get() == NULL);
+        EXPECT_EQ(0, pool.size());
+    }
+
+    // Only remove the same decision.
+    if (true) {
+        SrsHttpHooksPool pool;
+        SrsSharedPtr<SrsHttpHooksDecision> d0(new SrsHttpHooksDecision());
+        SrsSharedPtr<SrsHttpHooksDecision> d1(new SrsHttpHooksDecision());
+        pool.set("k0", d0);
+        pool.remove("k0", d1.get());
+        EXPECT_EQ(1, pool.size());
+        pool.remove("k0", d0.get());
+        EXPECT_EQ(0, pool.size());
+    }
+}
+
+// The mock hook server, which reads the request and closes the connection without response.
+class MockHttpHooksServer : public ISrsCoroutineHandler
+{
+public:
+    srs_netfd_t lfd;
+    int nn_requests;
+    SrsSTCoroutine* trd;
+public:
+    MockHttpHooksServer(srs_netfd_t fd) {
+        lfd = fd;
+        nn_requests = 0;
+        trd = new SrsSTCoroutine("hooks", this);
+    }
+    virtual ~MockHttpHooksServer() {
+        srs_freep(trd);
+    }
+public:
+    virtual srs_error_t cycle() {
+        srs_error_t err = srs_success;
+
+        while (true) {
+            if ((err = trd->pull()) != srs_success) {
+                return err;
+            }
+
+            srs_netfd_t cfd = srs_accept(lfd, NULL, NULL, 10 * SRS_UTIME_MILLISECONDS);
+            if (!cfd) {
+                continue;
+            }
+
+            if (true) {
+                SrsStSocket skt(cfd);
+                skt.set_recv_timeout(1 * SRS_UTIME_SECONDS);
+
+                char buf[1024];
+                if ((err = skt.read(buf, sizeof(buf), NULL)) == srs_success) {
+                    nn_requests++;
+                }
+                srs_freep(err);
+            }
+
+            srs_close_stfd(cfd);
+        }
+
+        return err;
+    }
+};
+
+VOID TEST(AppHttpHooksTest, PoolAcquireRelease)
+{
+    srs_error_t err;
+
+    string url = srs_fmt("http://%s:%d/api/v1/streams", _srs_tmp_host.c_str(), _srs_tmp_port);
+    SrsHttpUri uri;
+    HELPER_ASSERT_SUCCESS(uri.initialize(url));
+    string key = srs_fmt("http://%s:%d", _srs_tmp_host.c_str(), _srs_tmp_port);
+
+    // Create new client if no idle one, and free it if not keep alive.
+    if (true) {
+        SrsHttpHooksPool pool;
+        SrsHttpClient* hc = NULL;
+        bool reused = true;
+        HELPER_EXPECT_SUCCESS(pool.acquire(&uri, &hc, &reused));
+        EXPECT_TRUE(hc != NULL);
+        EXPECT_FALSE(reused);
+
+        pool.release(&uri, hc, false);
+        EXPECT_EQ(0, (int)pool.idles_[key].size());
+    }
+
+    // Drop the idle client which is not connected, never reuse it.
+    if (true) {
+        SrsHttpHooksPool pool;
+        SrsHttpClient* hc = NULL;
+        bool reused = false;
+        HELPER_EXPECT_SUCCESS(pool.acquire(&uri, &hc, &reused));
+        EXPECT_FALSE(hc->is_alive());
+
+        pool.release(&uri, hc, true);
+        EXPECT_EQ(1, (int)pool.idles_[key].size());
+
+        HELPER_EXPECT_SUCCESS(pool.acquire(&uri, &hc, &reused));
+        EXPECT_FALSE(reused);
+        EXPECT_EQ(0, (int)pool.idles_[key].size());
+        pool.release(&uri, hc, false);
+    }
+
+    // Reuse the alive client, and drop it when closed by server.
+    if (true) {
+        srs_netfd_t lfd = NULL;
+        HELPER_ASSERT_SUCCESS(srs_tcp_listen(_srs_tmp_host, _srs_tmp_port, &lfd));
+
+        SrsHttpHooksPool pool;
+        SrsHttpClient* hc = NULL;
+        bool reused = false;
+        HELPER_EXPECT_SUCCESS(pool.acquire(&uri, &hc, &reused));
+        HELPER_EXPECT_SUCCESS(hc->connect());
+
+        srs_netfd_t cfd = srs_accept(lfd, NULL, NULL, _srs_tmp_timeout);
+        EXPECT_TRUE(cfd != NULL);
+        EXPECT_TRUE(hc->is_alive());
+
+        SrsHttpClient* hc0 = hc;
+        pool.release(&uri, hc, true);
+        HELPER_EXPECT_SUCCESS(pool.acquire(&uri, &hc, &reused));
+        EXPECT_TRUE(reused);
+        EXPECT_TRUE(hc == hc0);
+
+        // The server closes the idle connection, so never reuse it.
+        pool.release(&uri, hc, true);
+        srs_close_stfd(cfd);
+        srs_usleep(10 * SRS_UTIME_MILLISECONDS);
+
+        HELPER_EXPECT_SUCCESS(pool.acquire(&uri, &hc, &reused));
+        EXPECT_FALSE(reused);
+        EXPECT_EQ(0, (int)pool.idles_[key].size());
+        pool.release(&uri, hc, false);
+
+        srs_close_stfd(lfd);
+    }
+}
+
+VOID TEST(AppHttpHooksTest, PoolNeverRetryPost)
+{
+    srs_error_t err;
+
+    string url = srs_fmt("http://%s:%d/api/v1/streams", _srs_tmp_host.c_str(), _srs_tmp_port);
+    SrsHttpUri uri;
+    HELPER_ASSERT_SUCCESS(uri.initialize(url));
+
+    srs_netfd_t lfd = NULL;
+    HELPER_ASSERT_SUCCESS(srs_tcp_listen(_srs_tmp_host, _srs_tmp_port, &lfd));
+
+    MockHttpHooksServer server(lfd);
+    HELPER_ASSERT_SUCCESS(server.trd->start());
+
+    SrsHttpHooksPool pool;
+    SrsHttpHooksPool* global = _srs_hooks_pool;
+    _srs_hooks_pool = &pool;
+
+    // Put an idle client, which is accepted by server.
+    if (true) {
+        SrsHttpClient* hc = NULL;
+        bool reused = false;
+        HELPER_EXPECT_SUCCESS(pool.acquire(&uri, &hc, &reused));
+        HELPER_EXPECT_SUCCESS(hc->connect());
+        pool.release(&uri, hc, true);
+        srs_usleep(30 * SRS_UTIME_MILLISECONDS);
+    }
+
+    // The server closes the reused connection after got the request, which must not be posted again.
+    int code = 0;
+    string res;
+    HELPER_EXPECT_FAILED(SrsHttpHooks::do_post(url, "{}", code, res));
+    srs_usleep(30 * SRS_UTIME_MILLISECONDS);
+    EXPECT_EQ(1, server.nn_requests);
+
+    _srs_hooks_pool = global;
+    server.trd->stop();
+    srs_close_stfd(lfd);
+}
+
+class MockAsyncCallTask : public ISrsAsyncCallTask
+{
+public:
+    int id;
+    std::string dest;
+    std::vector<int>* calls;
+public:
+    MockAsyncCallTask(int i, std::string d, std::vector<int>* c) {
+        id = i;
+        dest = d;
+        calls = c;
+    }
+    virtual ~MockAsyncCallTask() {
+    }
+public:
+    virtual srs_error_t call() {
+        calls->push_back(id);
+        srs_usleep(50 * SRS_UTIME_MILLISECONDS);
+        return srs_success;
+    }
+    virtual std::string to_string() {
+        return "mock";
+    }
+    virtual std::string destination() {
+        return dest;
+    }
+};
+
+VOID TEST(AppAsyncCallTest, ExecutorsAndDestination)
+{
+    srs_error_t err = srs_success;
+
+    // The tasks are called concurrently by executors.
+    if (true) {
+        std::vector<int> calls;
+        SrsAsyncCallWorker worker;
+        worker.set_executors(2);
+        HELPER_EXPECT_SUCCESS(worker.start());
+
+        for (int i = 0; i < 4; i++) {
+            HELPER_EXPECT_SUCCESS(worker.execute(new MockAsyncCallTask(i, "", &calls)));
+        }
+        srs_usleep(1 * SRS_UTIME_MILLISECONDS);
+        EXPECT_EQ(2, worker.nn_running());
+        EXPECT_EQ(2, worker.count());
+
+        worker.stop();
+        EXPECT_EQ(4, (int)calls.size());
+        EXPECT_EQ(0, worker.count());
+    }
+
+    // The busy destination never blocks others.
+    if (true) {
+        SrsSetEnvConfig(max_per_destination, "SRS_ASYNC_CALL_MAX_PER_DESTINATION", "1");
+
+        std::vector<int> calls;
+        SrsAsyncCallWorker worker;
+        worker.set_executors(3);
+        HELPER_EXPECT_SUCCESS(worker.start());
+
+        HELPER_EXPECT_SUCCESS(worker.execute(new MockAsyncCallTask(0, "http://a", &calls)));
+        HELPER_EXPECT_SUCCESS(worker.execute(new MockAsyncCallTask(1, "http://a", &calls)));
+        HELPER_EXPECT_SUCCESS(worker.execute(new MockAsyncCallTask(2, "http://b", &calls)));
+        srs_usleep(1 * SRS_UTIME_MILLISECONDS);
+        EXPECT_EQ(2, worker.nn_running());
+        EXPECT_EQ(1, worker.count());
+        ASSERT_EQ(2, (int)calls.size());
+        EXPECT_EQ(0, calls.at(0));
+        EXPECT_EQ(2, calls.at(1));
+
+        worker.stop();
+        EXPECT_EQ(3, (int)calls.size());
+    }
+}
+
+VOID TEST(AppAsyncCallTest, BoundedQueue)
+{
+    srs_error_t err = srs_success;
+
+    // Never drop task by default, and call tasks one by one in order.
+    if (true) {
+        EXPECT_EQ(1, _srs_config->get_async_call_executors());
+        EXPECT_EQ(0, _srs_config->get_async_call_max_per_destination());
+        EXPECT_EQ(0, _srs_config->get_async_call_max_tasks());
+
+        std::vector<int> calls;
+        SrsAsyncCallWorker worker;
+        HELPER_EXPECT_SUCCESS(worker.start());
+
+        for (int i = 0; i < 10; i++) {
+            HELPER_EXPECT_SUCCESS(worker.execute(new MockAsyncCallTask(i, "", &calls)));
+        }
+        srs_usleep(1 * SRS_UTIME_MILLISECONDS);
+        EXPECT_EQ(1, worker.nn_running());
+        EXPECT_EQ(9, worker.count());
+
+        worker.stop();
+        ASSERT_EQ(10, (int)calls.size());
+        for (int i = 0; i < 10; i++) {
+            EXPECT_EQ(i, calls.at(i));
+        }
+    }
+
+    // Drop the oldest task when queue is full.
+    if (true) {
+        SrsSetEnvConfig(max_tasks, "SRS_ASYNC_CALL_MAX_TASKS", "2");
+
+        std::vector<int> calls;
+        SrsAsyncCallWorker worker;
+        HELPER_EXPECT_SUCCESS(worker.start());
+
+        HELPER_EXPECT_SUCCESS(worker.execute(new MockAsyncCallTask(0, "", &calls)));
+        srs_usleep(1 * SRS_UTIME_MILLISECONDS);
+        for (int i = 1; i < 4; i++) {
+            HELPER_EXPECT_SUCCESS(worker.execute(new MockAsyncCallTask(i, "", &calls)));
+        }
+        EXPECT_EQ(2, worker.count());
+
+        worker.stop();
+        ASSERT_EQ(3, (int)calls.size());
+        EXPECT_EQ(0, calls.at(0));
+        EXPECT_EQ(2, calls.at(1));
+        EXPECT_EQ(3, calls.at(2));
+    }
+
+    // Drop the newest task when queue is full.
+    if (true) {
+        SrsSetEnvConfig(max_tasks, "SRS_ASYNC_CALL_MAX_TASKS", "2");
+        SrsSetEnvConfig(overflow, "SRS_ASYNC_CALL_OVERFLOW", "drop_newest");
+
+        std::vector<int> calls;
+        SrsAsyncCallWorker worker;
+        HELPER_EXPECT_SUCCESS(worker.start());
+
+        HELPER_EXPECT_SUCCESS(worker.execute(new MockAsyncCallTask(0, "", &calls)));
+        srs_usleep(1 * SRS_UTIME_MILLISECONDS);
+        for (int i = 1; i < 4; i++) {
+            HELPER_EXPECT_SUCCESS(worker.execute(new MockAsyncCallTask(i, "", &calls)));
+        }
+        EXPECT_EQ(2, worker.count());
+
+        worker.stop();
+        ASSERT_EQ(3, (int)calls.size());
+        EXPECT_EQ(0, calls.at(0));
+        EXPECT_EQ(1, calls.at(1));
+        EXPECT_EQ(2, calls.at(2));
+    }
+}
+
+VOID TEST(AppCoWorkersTest, DirectoryVersionAndTTL)
+{
+    SrsCoWorkers* coworkers = SrsCoWorkers::instance();
+    int nn = coworkers->nn_directory();
+
+    string ip; int port = 0;
+    EXPECT_FALSE(coworkers->find_origin("test.dir.com", "live", "s0", ip, port));
+
+    // Add stream by publish event.
+    coworkers->update("on_publish", "test.dir.com", "live", "s0", "o1", "10.0.0.1", 1935, 100, 30 * SRS_UTIME_SECONDS);
+    EXPECT_EQ(nn + 1, coworkers->nn_directory());
+    EXPECT_TRUE(coworkers->find_origin("test.dir.com", "live", "s0", ip, port));
+    EXPECT_STREQ("10.0.0.1", ip.c_str());
+    EXPECT_EQ(1935, port);
+
+    // The new publisher of other origin wins, even its version is smaller.
+    coworkers->update("on_publish", "test.dir.com", "live", "s0", "o2", "10.0.0.2", 19350, 1, 30 * SRS_UTIME_SECONDS);
+    EXPECT_TRUE(coworkers->find_origin("test.dir.com", "live", "s0", ip, port));
+    EXPECT_STREQ("10.0.0.2", ip.c_str());
+    EXPECT_EQ(19350, port);
+
+    // Ignore the delayed refresh and unpublish of previous origin.
+    coworkers->update("on_refresh", "test.dir.com", "live", "s0", "o1", "10.0.0.1", 1935, 100, 30 * SRS_UTIME_SECONDS);
+    coworkers->update("on_unpublish", "test.dir.com", "live", "s0", "o1", "10.0.0.1", 1935, 100, 30 * SRS_UTIME_SECONDS);
+    EXPECT_TRUE(coworkers->find_origin("test.dir.com", "live", "s0", ip, port));
+    EXPECT_STREQ("10.0.0.2", ip.c_str());
+
+    // Ignore the stale event of the same origin.
+    coworkers->update("on_publish", "test.dir.com", "live", "s0", "o2", "10.0.0.2", 19350, 2, 30 * SRS_UTIME_SECONDS);
+    coworkers->update("on_unpublish", "test.dir.com", "live", "s0", "o2", "10.0.0.2", 19350, 1, 30 * SRS_UTIME_SECONDS);
+    EXPECT_TRUE(coworkers->find_origin("test.dir.com", "live", "s0", ip, port));
+
+    // Remove by unpublish of current publisher.
+    coworkers->update("on_unpublish", "test.dir.com", "live", "s0", "o2", "10.0.0.2", 19350, 2, 30 * SRS_UTIME_SECONDS);
+    EXPECT_FALSE(coworkers->find_origin("test.dir.com", "live", "s0", ip, port));
+    EXPECT_EQ(nn, coworkers->nn_directory());
+
+    // The expired stream is not found, and taken over by refresh of other origin.
+    coworkers->update("on_publish", "test.dir.com", "live", "s1", "o1", "10.0.0.1", 1935, 100, -1 * SRS_UTIME_SECONDS);
+    EXPECT_FALSE(coworkers->find_origin("test.dir.com", "live", "s1", ip, port));
+    coworkers->update("on_refresh", "test.dir.com", "live", "s1", "o2", "10.0.0.2", 1935, 1, 30 * SRS_UTIME_SECONDS);
+    EXPECT_TRUE(coworkers->find_origin("test.dir.com", "live", "s1", ip, port));
+    EXPECT_STREQ("10.0.0.2", ip.c_str());
+    coworkers->update("on_unpublish", "test.dir.com", "live", "s1", "o2", "10.0.0.2", 1935, 1, 0);
+    EXPECT_EQ(nn, coworkers->nn_directory());
+}
+
+VOID TEST(AppCoWorkersTest, AcceptCoworkersOnly)
+{
+    srs_error_t err;
+
+    MockSrsConfig conf;
+    HELPER_ASSERT_SUCCESS(conf.parse(_MIN_OK_CONF "http_api{listen 1985;} vhost test.peer.com{cluster{coworkers 10.0.0.1:1985 127.0.0.1:1985 127.0.0.1:1986;}}"));
+    MockSrsConfigGuard guard(&conf);
+
+    SrsCoWorkers* coworkers = SrsCoWorkers::instance();
+    int nn = coworkers->nn_directory();
+
+    SrsUniquePtr<SrsJsonObject> event(SrsJsonAny::object());
+    event->set("action", SrsJsonAny::str("on_publish"))
+        ->set("vhost", SrsJsonAny::str("test.peer.com"))
+        ->set("app", SrsJsonAny::str("live"))
+        ->set("stream", SrsJsonAny::str("s0"))
+        ->set("origin", SrsJsonAny::str("o1"))
+        ->set("port", SrsJsonAny::integer(1935))
+        ->set("version", SrsJsonAny::integer(1));
+
+    // Reject the event from unknown peer.
+    err = coworkers->on_event(event.get(), "10.0.0.9");
+    EXPECT_EQ(ERROR_HTTP_PEER_FORBIDDEN, srs_error_code(err));
+    srs_freep(err);
+    EXPECT_EQ(nn, coworkers->nn_directory());
+
+    // Accept the event from coworker, and use the ip of peer.
+    HELPER_EXPECT_SUCCESS(coworkers->on_event(event.get(), "10.0.0.1"));
+    EXPECT_EQ(nn + 1, coworkers->nn_directory());
+
+    string ip; int port = 0;
+    EXPECT_TRUE(coworkers->find_origin("test.peer.com", "live", "s0", ip, port));
+    EXPECT_STREQ("10.0.0.1", ip.c_str());
+
+    // Ignore the event of this origin itself.
+    event->set("action", SrsJsonAny::str("on_unpublish"));
+    event->set("origin", SrsJsonAny::str(SrsStatistic::instance()->service_id().c_str()));
+    HELPER_EXPECT_SUCCESS(coworkers->on_event(event.get(), "10.0.0.1"));
+    EXPECT_EQ(nn + 1, coworkers->nn_directory());
+
+    event->set("origin", SrsJsonAny::str("o1"));
+    HELPER_EXPECT_SUCCESS(coworkers->on_event(event.get(), "10.0.0.1"));
+    EXPECT_EQ(nn, coworkers->nn_directory());
+
+    // Never push events to this origin itself, which listens at 1985.
+    EXPECT_TRUE(coworkers->is_self("127.0.0.1:1985"));
+    EXPECT_TRUE(coworkers->is_self("localhost:1985"));
+    EXPECT_FALSE(coworkers->is_self("127.0.0.1:1986"));
+    EXPECT_FALSE(coworkers->is_self("10.0.0.1:1985"));
+}
+
+VOID TEST(AppEdgeTest, LeastLoadedRelease)
+{
+    vector<string> servers;
+    servers.push_back("s0");
+    servers.push_back("s1");
+
+    SrsLbLoads loads;
+
+    // The load of origin is released when ingester stop, and acquired again when restart.
+    if (true) {
+        SrsEdgeIngester ingester;
+        srs_freep(ingester.lb);
+        ingester.lb = new SrsLbLeastLoaded(&loads, "vhost/live/livestream");
+
+        for (int i = 0; i < 3; i++) {
+            string v = ingester.lb->select(servers);
+            EXPECT_EQ(1, loads.load(v));
+
+            ingester.stop();
+            EXPECT_EQ(0, loads.load("s0"));
+            EXPECT_EQ(0, loads.load("s1"));
+        }
+    }
+
+    // The load of origin is released when forwarder stop, and acquired again when restart.
+    if (true) {
+        SrsEdgeForwarder forwarder;
+        srs_freep(forwarder.lb);
+        forwarder.lb = new SrsLbLeastLoaded(&loads, "vhost/live/livestream");
+
+        for (int i = 0; i < 3; i++) {
+            string v = forwarder.lb->select(servers);
+            EXPECT_EQ(1, loads.load(v));
+
+            forwarder.stop();
+            EXPECT_EQ(0, loads.load("s0"));
+            EXPECT_EQ(0, loads.load("s1"));
+        }
+    }
+}
+
+VOID TEST(AppHttpEdgeCacheTest, LargeCacheSize)
+{
+    srs_error_t err;
+
+    MockSrsConfig conf;
+    HELPER_ASSERT_SUCCESS(conf.parse(_MIN_OK_CONF "vhost v{cluster{http_cache_size 4096;}}"));
+    MockSrsConfigGuard guard(&conf);
+
+    // The size in MB never overflow the int.
+    SrsHttpEdgeStream stream("v");
+    EXPECT_EQ(4096LL * 1024 * 1024, stream.cache->max_size);
+}
+
+VOID TEST(AppHttpEdgeCacheTest, LRUAndExpire)
+{
+    SrsHttpEdgeCache cache(10);
+
+    SrsSharedPtr<SrsHttpEdgeObject> a(new SrsHttpEdgeObject());
+    a->body = "aaaa";
+    a->expire = srs_get_system_time() + 10 * SRS_UTIME_SECONDS;
+
+    // The pending object is found before fetched.
+    cache.set_pending("/a.ts", a);
+    EXPECT_TRUE(cache.find("/a.ts").get() == a.get());
+    EXPECT_EQ(0, cache.count());
+
+    // Put the fetched object, which is removed from pending.
+    cache.put("/a.ts", a);
+    EXPECT_TRUE(cache.find("/a.ts").get() == a.get());
+    EXPECT_EQ(1, cache.count());
+    EXPECT_EQ(4, cache.size());
+
+    SrsSharedPtr<SrsHttpEdgeObject> b(new SrsHttpEdgeObject());
+    b->body = "bbbb";
+    b->expire = a->expire;
+    cache.put("/b.ts", b);
+    EXPECT_EQ(8, cache.size());
+
+    // Access a, so b is the least recently used, and evicted by c.
+    EXPECT_TRUE(cache.find("/a.ts").get());
+    SrsSharedPtr<SrsHttpEdgeObject> c(new SrsHttpEdgeObject());
+    c->body = "cccc";
+    c->expire = a->expire;
+    cache.put("/c.ts", c);
+    EXPECT_EQ(2, cache.count());
+    EXPECT_EQ(8, cache.size());
+    EXPECT_TRUE(cache.find("/a.ts").get());
+    EXPECT_FALSE(cache.find("/b.ts").get());
+    EXPECT_TRUE(cache.find("/c.ts").get());
+
+    // Never cache the object larger than cache.
+    SrsSharedPtr<SrsHttpEdgeObject> d(new SrsHttpEdgeObject());
+    d->body = "ddddddddddddddd";
+    d->expire = a->expire;
+    cache.put("/d.ts", d);
+    EXPECT_FALSE(cache.find("/d.ts").get());
+    EXPECT_EQ(2, cache.count());
+
+    // The expired object is removed.
+    c->expire = srs_get_system_time() - 1;
+    EXPECT_FALSE(cache.find("/c.ts").get());
+    EXPECT_EQ(1, cache.count());
+    EXPECT_EQ(4, cache.size());
+}
+
+VOID TEST(AppLoadRedirectTest, SelectPeer)
+{
+    srs_error_t err;
+
+    SrsSetEnvConfig(enabled, "SRS_LOAD_REDIRECT_ENABLED", "on");
+    SrsSetEnvConfig(ip, "SRS_LOAD_REDIRECT_IP", "10.0.0.1");
+    SrsSetEnvConfig(cpu, "SRS_LOAD_REDIRECT_CPU", "80");
+    SrsSetEnvConfig(conns, "SRS_LOAD_REDIRECT_CONNECTIONS", "1000");
+    SrsSetEnvConfig(peers, "SRS_LOAD_REDIRECT_PEERS", "10.0.0.4:1985 10.0.0.5:1985");
+
+    SrsLoadRedirect lr;
+    HELPER_EXPECT_SUCCESS(lr.initialize());
+
+    // Never redirect if not overloaded.
+    lr.sample(40, 100, 0);
+    EXPECT_TRUE(lr.select(false) == NULL);
+
+    // Never redirect if no peer.
+    lr.sample(90, 100, 0);
+    EXPECT_TRUE(lr.select(false) == NULL);
+
+    // Ignore the overloaded peer.
+    SrsLoadReport* r0 = new SrsLoadReport();
+    r0->ip = "10.0.0.2"; r0->api_port = 1985; r0->rtmp_port = 1935; r0->load = 120;
+    r0->expire = srs_get_system_time() + 10 * SRS_UTIME_SECONDS;
+    lr.update(r0);
+    EXPECT_TRUE(lr.select(false) == NULL);
+
+    // Ignore the expired peer.
+    SrsLoadReport* r1 = new SrsLoadReport();
+    r1->ip = "10.0.0.3"; r1->api_port = 1985; r1->rtmp_port = 1935; r1->load = 10;
+    r1->expire = srs_get_system_time() - 1;
+    lr.update(r1);
+    EXPECT_TRUE(lr.select(false) == NULL);
+
+    // Select the less-loaded peer, for player only.
+    SrsLoadReport* r2 = new SrsLoadReport();
+    r2->ip = "10.0.0.4"; r2->api_port = 1985; r2->rtmp_port = 1935; r2->load = 50;
+    r2->expire = srs_get_system_time() + 10 * SRS_UTIME_SECONDS;
+    lr.update(r2);
+    EXPECT_TRUE(lr.select(false) == r2);
+    EXPECT_TRUE(lr.select(true) == NULL);
+
+    // Overloaded by connections, and the report of peer is updated by id.
+    lr.sample(10, 2000, 0);
+    SrsUniquePtr<SrsJsonObject> obj(SrsJsonAny::object());
+    obj->set("api", SrsJsonAny::integer(1985));
+    obj->set("load", SrsJsonAny::integer(30));
+    HELPER_EXPECT_SUCCESS(lr.on_report(obj.get(), "10.0.0.4"));
+    SrsLoadReport* peer = lr.select(false);
+    ASSERT_TRUE(peer != NULL);
+    EXPECT_STREQ("10.0.0.4", peer->ip.c_str());
+    EXPECT_EQ(30, peer->load);
+
+    // Invalid report without load.
+    SrsUniquePtr<SrsJsonObject> invalid(SrsJsonAny::object());
+    invalid->set("api", SrsJsonAny::integer(1985));
+    HELPER_EXPECT_FAILED(lr.on_report(invalid.get(), "10.0.0.5"));
+
+    // Reject the report from unknown peer.
+    SrsUniquePtr<SrsJsonObject> unknown(SrsJsonAny::object());
+    unknown->set("api", SrsJsonAny::integer(1985));
+    unknown->set("load", SrsJsonAny::integer(0));
+    err = lr.on_report(unknown.get(), "10.0.0.6");
+    EXPECT_EQ(ERROR_HTTP_PEER_FORBIDDEN, srs_error_code(err));
+    srs_freep(err);
+    HELPER_EXPECT_FAILED(lr.on_report(unknown.get(), ""));
+}
+
+VOID TEST(AppLoadRedirectTest, RedirectWithQuery)
+{
+    srs_error_t err;
+
+    SrsLoadReport peer;
+    peer.ip = "10.0.0.4";
+
+    // The app, stream and token of WHIP are in query.
+    if (true) {
+        MockResponseWriter w;
+        w.w->set_header_filter(NULL); // Keep the Location header.
+        SrsHttpMessage r(NULL, NULL);
+        HELPER_ASSERT_SUCCESS(r.set_url("/rtc/v1/whip/?app=live&stream=livestream&token=xxx", false));
+
+        HELPER_ASSERT_SUCCESS(srs_load_redirect_http(&w, &r, &peer, 1985, SRS_CONSTS_HTTP_TemporaryRedirect));
+        EXPECT_EQ(SRS_CONSTS_HTTP_TemporaryRedirect, w.w->status);
+        EXPECT_STREQ("http://10.0.0.4:1985/rtc/v1/whip/?app=live&stream=livestream&token=xxx",
+            w.header()->get("Location").c_str());
+    }
+
+    // The HTTP-FLV without query.
+    if (true) {
+        MockResponseWriter w;
+        w.w->set_header_filter(NULL); // Keep the Location header.
+        SrsHttpMessage r(NULL, NULL);
+        HELPER_ASSERT_SUCCESS(r.set_url("/live/livestream.flv", false));
+
+        HELPER_ASSERT_SUCCESS(srs_load_redirect_http(&w, &r, &peer, 8080, SRS_CONSTS_HTTP_Found));
+        EXPECT_EQ(SRS_CONSTS_HTTP_Found, w.w->status);
+        EXPECT_STREQ("http://10.0.0.4:8080/live/livestream.flv", w.header()->get("Location").c_str());
+    }
+}
+
+VOID TEST(AppCircuitBreakerTest, LowPriority)
+{
+    srs_error_t err;
+
+    // Disabled by default.
+    if (true) {
+        SrsCircuitBreaker cb;
+        HELPER_EXPECT_SUCCESS(cb.initialize());
+        _srs_hybrid->timer1s()->unsubscribe(&cb);
+
+        EXPECT_FALSE(cb.is_low_priority("test.com"));
+        EXPECT_FALSE(cb.should_reject_player("test.com"));
+    }
+
+    // The vhost with lower priority is low-priority.
+    if (true) {
+        SrsSetEnvConfig(shed, "SRS_CIRCUIT_BREAKER_SHED_PRIORITY", "60");
+        SrsCircuitBreaker cb;
+        HELPER_EXPECT_SUCCESS(cb.initialize());
+        _srs_hybrid->timer1s()->unsubscribe(&cb);
+
+        EXPECT_TRUE(cb.is_low_priority("test.com"));
+
+        // The priority of vhost is in the snapshot, so parse a new config.
+        MockSrsConfig conf;
+        HELPER_EXPECT_SUCCESS(conf.parse(_MIN_OK_CONF "vhost test.com {priority 100;}"));
+        MockSrsConfigGuard guard(&conf);
+        EXPECT_FALSE(cb.is_low_priority("test.com"));
+
+        // Never reject player if not overloaded.
+        EXPECT_FALSE(cb.should_reject_player("test.com"));
+    }
+}
+
+class MockLiveSourceHandler : public ISrsLiveSourceHandler
+{
+public:
+    MockLiveSourceHandler() {
+    }
+    virtual ~MockLiveSourceHandler() {
+    }
+public:
+    virtual srs_error_t on_publish(SrsRequest* /*r*/) {
+        return srs_success;
+    }
+    virtual void on_unpublish(SrsRequest* /*r*/) {
+    }
+};
+
+// Create a mock FLV audio or video message.
+static SrsSharedPtrMessage* mock_flv_message(bool video, uint32_t time, uint8_t* data, int size)
+{
+    SrsMessageHeader h;
+    if (video) {
+        h.initialize_video(size, time, 1);
+    } else {
+        h.initialize_audio(size, time, 1);
+    }
+
+    char* payload = new char[size];
+    memcpy(payload, data, size);
+
+    SrsSharedPtrMessage* msg = new SrsSharedPtrMessage();
+    srs_error_t err = msg->create(&h, payload, size);
+    srs_freep(err);
+
+    return msg;
+}
+
+// Enqueue a mock FLV audio or video message to consumer.
+static srs_error_t mock_consumer_enqueue(SrsLiveConsumer* consumer, bool video, uint32_t time, uint8_t* data, int size)
+{
+    SrsUniquePtr<SrsSharedPtrMessage> msg(mock_flv_message(video, time, data, size));
+    return consumer->enqueue(msg.get(), true, SrsRtmpJitterAlgorithmOFF);
+}
+
+VOID TEST(AppLiveConsumerTest, AdaptiveDrop)
+{
+    srs_error_t err;
+
+    uint8_t a[] = {0xaf, 0x01, 0x21};
+    uint8_t k[] = {0x17, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x05, 0x88};
+    uint8_t p[] = {0x27, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x41, 0x9a};
+    uint8_t b[] = {0x27, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x01, 0x9e};
+
+    MockLiveSourceHandler handler;
+    SrsRequest req;
+    req.vhost = "test.com";
+    req.app = "live";
+    req.stream = "livestream";
+    SrsSharedPtr<SrsLiveSource> source(new SrsLiveSource());
+    HELPER_EXPECT_SUCCESS(source->initialize(source, &req, &handler));
+
+    SrsLiveConsumer* consumer = new SrsLiveConsumer(source.get());
+    SrsUniquePtr<SrsLiveConsumer> consumer_uptr(consumer);
+    consumer->set_queue_size(10 * SRS_UTIME_SECONDS);
+    consumer->set_adaptive_drop(true);
+
+    int64_t nn_disposable = 0, nn_video = 0, nn_shrink = 0;
+
+    // Never drop when the queue is not congested.
+    HELPER_EXPECT_SUCCESS(mock_consumer_enqueue(consumer, false, 1000, a, sizeof(a)));
+    HELPER_EXPECT_SUCCESS(mock_consumer_enqueue(consumer, true, 1000, k, sizeof(k)));
+    HELPER_EXPECT_SUCCESS(mock_consumer_enqueue(consumer, true, 1000, b, sizeof(b)));
+    consumer->drop_stat(nn_disposable, nn_video, nn_shrink);
+    EXPECT_EQ(0, nn_disposable); EXPECT_EQ(0, nn_video); EXPECT_EQ(0, nn_shrink);
+
+    // Drop the non-reference frames when queue exceed 1/2.
+    HELPER_EXPECT_SUCCESS(mock_consumer_enqueue(consumer, false, 7000, a, sizeof(a)));
+    HELPER_EXPECT_SUCCESS(mock_consumer_enqueue(consumer, true, 7000, b, sizeof(b)));
+    HELPER_EXPECT_SUCCESS(mock_consumer_enqueue(consumer, true, 7000, p, sizeof(p)));
+    consumer->drop_stat(nn_disposable, nn_video, nn_shrink);
+    EXPECT_EQ(1, nn_disposable); EXPECT_EQ(0, nn_video); EXPECT_EQ(0, nn_shrink);
+
+    // Drop all video frames when queue exceed 3/4, even the keyframe.
+    HELPER_EXPECT_SUCCESS(mock_consumer_enqueue(consumer, false, 9000, a, sizeof(a)));
+    HELPER_EXPECT_SUCCESS(mock_consumer_enqueue(consumer, true, 9000, p, sizeof(p)));
+    HELPER_EXPECT_SUCCESS(mock_consumer_enqueue(consumer, true, 9000, k, sizeof(k)));
+    consumer->drop_stat(nn_disposable, nn_video, nn_shrink);
+    EXPECT_EQ(1, nn_disposable); EXPECT_EQ(2, nn_video); EXPECT_EQ(0, nn_shrink);
+
+    // Shrink the queue as the last resort, then resume video at keyframe.
+    HELPER_EXPECT_SUCCESS(mock_consumer_enqueue(consumer, false, 12000, a, sizeof(a)));
+    HELPER_EXPECT_SUCCESS(mock_consumer_enqueue(consumer, true, 12000, p, sizeof(p)));
+    HELPER_EXPECT_SUCCESS(mock_consumer_enqueue(consumer, true, 12000, k, sizeof(k)));
+    HELPER_EXPECT_SUCCESS(mock_consumer_enqueue(consumer, true, 12000, p, sizeof(p)));
+    consumer->drop_stat(nn_disposable, nn_video, nn_shrink);
+    EXPECT_EQ(1, nn_disposable); EXPECT_EQ(3, nn_video); EXPECT_EQ(1, nn_shrink);
+}
+
+VOID TEST(AppGopCacheTest, FastDump)
+{
+    srs_error_t err;
+
+    uint8_t a[] = {0xaf, 0x01, 0x21};
+    uint8_t k[] = {0x17, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x05, 0x88};
+    uint8_t p[] = {0x27, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x41, 0x9a};
+    uint8_t b[] = {0x27, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x01, 0x9e};
+
+    MockLiveSourceHandler handler;
+    SrsRequest req;
+    req.vhost = "test.com";
+    req.app = "live";
+    req.stream = "livestream";
+    SrsSharedPtr<SrsLiveSource> source(new SrsLiveSource());
+    HELPER_EXPECT_SUCCESS(source->initialize(source, &req, &handler));
+
+    // The gop: K(1000) A(1000) B(2000) P(3000) A(3000) P(5000).
+    SrsGopCache gop;
+    gop.set_gop_cache_max_frames(2500);
+    SrsUniquePtr<SrsSharedPtrMessage> m0(mock_flv_message(true, 1000, k, sizeof(k)));
+    SrsUniquePtr<SrsSharedPtrMessage> m1(mock_flv_message(false, 1000, a, sizeof(a)));
+    SrsUniquePtr<SrsSharedPtrMessage> m2(mock_flv_message(true, 2000, b, sizeof(b)));
+    SrsUniquePtr<SrsSharedPtrMessage> m3(mock_flv_message(true, 3000, p, sizeof(p)));
+    SrsUniquePtr<SrsSharedPtrMessage> m4(mock_flv_message(false, 3000, a, sizeof(a)));
+    SrsUniquePtr<SrsSharedPtrMessage> m5(mock_flv_message(true, 5000, p, sizeof(p)));
+    HELPER_EXPECT_SUCCESS(gop.cache(m0.get()));
+    HELPER_EXPECT_SUCCESS(gop.cache(m1.get()));
+    HELPER_EXPECT_SUCCESS(gop.cache(m2.get()));
+    HELPER_EXPECT_SUCCESS(gop.cache(m3.get()));
+    HELPER_EXPECT_SUCCESS(gop.cache(m4.get()));
+    HELPER_EXPECT_SUCCESS(gop.cache(m5.get()));
+
+    // Skip the disposable frames.
+    if (true) {
+        SrsUniquePtr<SrsLiveConsumer> consumer(new SrsLiveConsumer(source.get()));
+        HELPER_EXPECT_SUCCESS(gop.fast_dump(consumer.get(), true, SrsRtmpJitterAlgorithmOFF, 0));
+
+        SrsMessageArray msgs(16);
+        int count = 0;
+        HELPER_EXPECT_SUCCESS(consumer->dump_packets(&msgs, count));
+        ASSERT_EQ(5, count);
+        EXPECT_EQ(1000, msgs.msgs[0]->timestamp);
+        EXPECT_EQ(3000, msgs.msgs[2]->timestamp);
+        EXPECT_EQ(5000, msgs.msgs[4]->timestamp);
+        msgs.free(count);
+    }
+
+    // Compress the backlog of 4s to 1s, and drop the audio.
+    if (true) {
+        SrsUniquePtr<SrsLiveConsumer> consumer(new SrsLiveConsumer(source.get()));
+        HELPER_EXPECT_SUCCESS(gop.fast_dump(consumer.get(), true, SrsRtmpJitterAlgorithmOFF, 1 * SRS_UTIME_SECONDS));
+
+        SrsMessageArray msgs(16);
+        int count = 0;
+        HELPER_EXPECT_SUCCESS(consumer->dump_packets(&msgs, count));
+        ASSERT_EQ(3, count);
+        EXPECT_TRUE(msgs.msgs[0]->is_video());
+        EXPECT_EQ(4000, msgs.msgs[0]->timestamp);
+        EXPECT_EQ(4500, msgs.msgs[1]->timestamp);
+        EXPECT_EQ(5000, msgs.msgs[2]->timestamp);
+        msgs.free(count);
+    }
+
+    // Start at the newest keyframe.
+    if (true) {
+        SrsUniquePtr<SrsSharedPtrMessage> m6(mock_flv_message(true, 6000, k, sizeof(k)));
+        HELPER_EXPECT_SUCCESS(gop.cache(m6.get()));
+
+        SrsUniquePtr<SrsLiveConsumer> consumer(new SrsLiveConsumer(source.get()));
+        HELPER_EXPECT_SUCCESS(gop.fast_dump(consumer.get(), true, SrsRtmpJitterAlgorithmOFF, 1 * SRS_UTIME_SECONDS));
+
+        SrsMessageArray msgs(16);
+        int count = 0;
+        HELPER_EXPECT_SUCCESS(consumer->dump_packets(&msgs, count));
+        ASSERT_EQ(1, count);
+        EXPECT_EQ(6000, msgs.msgs[0]->timestamp);
+        msgs.free(count);
+    }
+}
+
+class MockFastTimer : public ISrsFastTimer
+{
+public:
+    int nn_fired;
+    SrsFastTimer* unsubscribe_;
+public:
+    MockFastTimer() {
+        nn_fired = 0;
+        unsubscribe_ = NULL;
+    }
+    virtual ~MockFastTimer() {
+    }
+    virtual srs_error_t on_timer(srs_utime_t /*interval*/) {
+        nn_fired++;
+        if (unsubscribe_) {
+            unsubscribe_->unsubscribe(this);
+        }
+        return srs_success;
+    }
+};
+
+VOID TEST(AppTimingWheelTest, Cascade)
+{
+    SrsTimingWheel wheel;
+
+    // The entries in level 0, 1, 2, 3 and out of range.
+    uint64_t expires[] = {1, 63, 64, 65, 4095, 4096, 300000, 20000000};
+    int nn = (int)(sizeof(expires) / sizeof(uint64_t));
+
+    SrsTimerEntry entries[8];
+    for (int i = 0; i < nn; i++) {
+        entries[i].expire = expires[i];
+        wheel.add(&entries[i]);
+    }
+    EXPECT_EQ(0, entries[0].level);
+    EXPECT_EQ(0, entries[1].level);
+    EXPECT_EQ(1, entries[2].level);
+    EXPECT_EQ(1, entries[4].level);
+    EXPECT_EQ(2, entries[5].level);
+    EXPECT_EQ(3, entries[6].level);
+    EXPECT_EQ(3, entries[7].level);
+
+    // Each entry expires exactly at its tick.
+    int fired = 0;
+    while (fired < nn) {
+        wheel.advance();
+
+        SrsTimerEntry* entry = NULL;
+        while ((entry = wheel.pop()) != NULL) {
+            EXPECT_EQ(wheel.now(), entry->expire);
+            EXPECT_EQ(-1, entry->level);
+            fired++;
+        }
+
+        ASSERT_TRUE(wheel.now() <= 20000000);
+    }
+    EXPECT_EQ(20000000, (int)wheel.now());
+}
+
+VOID TEST(AppTimingWheelTest, Remove)
+{
+    SrsTimingWheel wheel;
+
+    SrsTimerEntry a, b, c;
+    a.expire = b.expire = c.expire = 10;
+    wheel.add(&a);
+    wheel.add(&b);
+    wheel.add(&c);
+
+    // Remove the middle one, and remove twice is ok.
+    wheel.remove(&b);
+    wheel.remove(&b);
+    EXPECT_EQ(-1, b.level);
+
+    // The expired entry is scheduled at the next tick.
+    SrsTimerEntry d;
+    d.expire = 0;
+    wheel.add(&d);
+    EXPECT_EQ(1, (int)d.expire);
+
+    for (int i = 0; i < 10; i++) {
+        wheel.advance();
+    }
+    EXPECT_EQ(&c, wheel.pop());
+    EXPECT_EQ(&a, wheel.pop());
+    EXPECT_TRUE(wheel.pop() == NULL);
+}
+
+VOID TEST(AppFastTimerTest, ScheduleAndCoalesce)
+{
+    SrsFastTimer timer("utest", 20 * SRS_UTIME_MILLISECONDS);
+
+    // Periodic timer fires every tick.
+    MockFastTimer periodic;
+    timer.subscribe(&periodic);
+    timer.subscribe(&periodic);
+    for (int i = 1; i <= 3; i++) {
+        timer.on_ticks(i);
+    }
+    EXPECT_EQ(3, periodic.nn_fired);
+
+    // Coalesce the missed ticks to only one callback.
+    timer.on_ticks(100);
+    EXPECT_EQ(4, periodic.nn_fired);
+
+    // Defer the periodic timer, then it fires every tick again.
+    timer.schedule(&periodic, 1 * SRS_UTIME_SECONDS);
+    timer.on_ticks(149);
+    EXPECT_EQ(4, periodic.nn_fired);
+    timer.on_ticks(150);
+    EXPECT_EQ(5, periodic.nn_fired);
+    timer.on_ticks(151);
+    timer.on_ticks(152);
+    EXPECT_EQ(7, periodic.nn_fired);
+
+    // One-shot timer fires only once.
+    MockFastTimer oneshot;
+    timer.schedule(&oneshot, 100 * SRS_UTIME_MILLISECONDS);
+    EXPECT_EQ(2, (int)timer.handlers_.size());
+    timer.on_ticks(156);
+    EXPECT_EQ(0, oneshot.nn_fired);
+    EXPECT_EQ(8, periodic.nn_fired);
+    timer.on_ticks(200);
+    EXPECT_EQ(1, oneshot.nn_fired);
+    EXPECT_EQ(9, periodic.nn_fired);
+    EXPECT_EQ(1, (int)timer.handlers_.size());
+
+    // Cancel the timer.
+    timer.unsubscribe(&periodic);
+    timer.on_ticks(300);
+    EXPECT_EQ(9, periodic.nn_fired);
+    EXPECT_EQ(0, (int)timer.handlers_.size());
+}
+
+VOID TEST(AppFastTimerTest, WakeupDeferred)
+{
+    SrsFastTimer timer("utest", 20 * SRS_UTIME_MILLISECONDS);
+
+    // The idle timer defers itself for a long time.
+    MockFastTimer idle;
+    timer.subscribe(&idle);
+    timer.schedule(&idle, 1 * SRS_UTIME_SECONDS);
+    timer.on_ticks(10);
+    EXPECT_EQ(0, idle.nn_fired);
+
+    // Wakeup it, for example, when publisher starts, it fires at the next tick.
+    timer.schedule(&idle, 0);
+    timer.on_ticks(11);
+    EXPECT_EQ(1, idle.nn_fired);
+
+    // Keep subscribed, so it fires every tick again.
+    timer.on_ticks(12);
+    EXPECT_EQ(2, idle.nn_fired);
+    EXPECT_EQ(1, (int)timer.handlers_.size());
+}
+
+VOID TEST(AppFastTimerTest, UnsubscribeInCallback)
+{
+    SrsFastTimer timer("utest", 20 * SRS_UTIME_MILLISECONDS);
+
+    MockFastTimer a, b;
+    a.unsubscribe_ = &timer;
+    timer.subscribe(&a);
+    timer.subscribe(&b);
+
+    for (int i = 1; i <= 5; i++) {
+        timer.on_ticks(i);
+    }
+    EXPECT_EQ(1, a.nn_fired);
+    EXPECT_EQ(5, b.nn_fired);
+    EXPECT_EQ(1, (int)timer.handlers_.size());
+}
+
+class MockStackCoroutine : public ISrsCoroutineHandler
+{
+public:
+    int watermark;
+    int depth;
+public:
+    MockStackCoroutine(int d) {
+        watermark = -1;
+        depth = d;
+    }
+    virtual ~MockStackCoroutine() {
+    }
+    virtual srs_error_t cycle() {
+        // Touch the stack of depth bytes.
+        char* buf = (char*)alloca(depth);
+        memset(buf, 0, depth);
+        watermark = srs_thread_stack_watermark(srs_thread_self());
+        return srs_success;
+    }
+};
+
+VOID TEST(AppCoroutineStackTest, PoolAndWatermark)
+{
+    srs_error_t err;
+
+    SrsSetEnvConfig(pool, "SRS_STACK_POOL", "2");
+    SrsSetEnvConfig(watermark, "SRS_STACK_WATERMARK", "on");
+    SrsSetEnvConfig(sizes, "SRS_STACK_SIZES", "utest-big:262144 utest-small:65536");
+
+    bool guard = srs_stack_guard();
+    SrsCoroutineStacks stacks;
+    HELPER_EXPECT_SUCCESS(stacks.initialize());
+
+    // Keep the guard of ST build if not configured.
+    EXPECT_EQ(guard, srs_stack_guard());
+
+    // The size of config is prefered, then the size of code, then the default.
+    EXPECT_EQ(262144, stacks.stack_size("utest-big", 0));
+    EXPECT_EQ(65536, stacks.stack_size("utest-small", 131072));
+    EXPECT_EQ(131072, stacks.stack_size("utest", 131072));
+    EXPECT_EQ(0, stacks.stack_size("utest", 0));
+
+    // Measure the high-water mark of stack.
+    if (true) {
+        MockStackCoroutine h(32 * 1024);
+        SrsFastCoroutine trd("utest", &h);
+        trd.set_stack_size(65536);
+        HELPER_EXPECT_SUCCESS(trd.start());
+        trd.stop();
+
+        EXPECT_GE(h.watermark, 32 * 1024);
+        EXPECT_LT(h.watermark, 65536);
+
+        stacks.on_exit("utest", 65536, h.watermark);
+        stacks.on_exit("utest", 65536, 1024);
+        stacks.on_exit("utest", 65536, -1);
+        EXPECT_EQ(2, stacks.stats_["utest"].count);
+        EXPECT_EQ(h.watermark, stacks.stats_["utest"].watermark);
+    }
+
+    // The free stacks never exceed the pool, after coroutine created.
+    for (int i = 0; i < 5; i++) {
+        MockStackCoroutine h(1024);
+        SrsFastCoroutine trd("utest", &h);
+        HELPER_EXPECT_SUCCESS(trd.start());
+        trd.stop();
+        EXPECT_LE(srs_stack_free_count(), 3);
+    }
+
+    // Restore the default of ST.
+    srs_stack_setup(0, guard, false);
+}
@@ -1374,6 +1374,17 @@ VOID TEST(ConfigMainTest, CheckConf_vhost_edge)
         MockSrsConfig conf;
         HELPER_ASSERT_FAILED(conf.parse(_MIN_OK_CONF "vhost v{token_traverses off;}"));
     }
+
+    if (true) {
+        MockSrsConfig conf;
+        HELPER_ASSERT_SUCCESS(conf.parse(_MIN_OK_CONF "vhost v{cluster{http_cache_size 4096;}}"));
+        EXPECT_EQ(4096, conf.get_vhost_edge_http_cache_size("v"));
+    }
+
+    if (true) {
+        MockSrsConfig conf;
+        HELPER_ASSERT_FAILED(conf.parse(_MIN_OK_CONF "vhost v{cluster{http_cache_size -1;}}"));
+    }
 }
 
 VOID TEST(ConfigMainTest, CheckConf_vhost_dvr)
@@ -2106,6 +2117,43 @@ VOID TEST(ConfigMainTest, CheckConf_pithy_print)
     }
 }
 
+VOID TEST(ConfigMainTest, CheckConf_stack)
+{
+    srs_error_t err;
+
+    if (true) {
+        MockSrsConfig conf;
+        HELPER_ASSERT_SUCCESS(conf.parse(_MIN_OK_CONF "stack{pool -1; size 0; sizes{recv 262144;}}"));
+        HELPER_ASSERT_SUCCESS(conf.parse(_MIN_OK_CONF "stack{size 65536;}"));
+        EXPECT_TRUE(conf.get_stack_guard(true));
+        EXPECT_FALSE(conf.get_stack_guard(false));
+        HELPER_ASSERT_SUCCESS(conf.parse(_MIN_OK_CONF "stack{guard off;}"));
+        EXPECT_FALSE(conf.get_stack_guard(true));
+    }
+
+    if (true) {
+        MockSrsConfig conf;
+        HELPER_ASSERT_FAILED(conf.parse(_MIN_OK_CONF "stack{pool -2;}"));
+        HELPER_ASSERT_FAILED(conf.parse(_MIN_OK_CONF "stack{size 1024;}"));
+        HELPER_ASSERT_FAILED(conf.parse(_MIN_OK_CONF "stack{size -1;}"));
+        HELPER_ASSERT_FAILED(conf.parse(_MIN_OK_CONF "stack{size 134217728;}"));
+        HELPER_ASSERT_FAILED(conf.parse(_MIN_OK_CONF "stack{sizes{recv 0;}}"));
+        HELPER_ASSERT_FAILED(conf.parse(_MIN_OK_CONF "stack{sizes{recv;}}"));
+    }
+
+    // The env is also checked, and the malformed pair is rejected.
+    if (true) {
+        SrsSetEnvConfig(sizes, "SRS_STACK_SIZES", "recv:65536 rtmp");
+        MockSrsConfig conf;
+        HELPER_ASSERT_FAILED(conf.parse(_MIN_OK_CONF));
+    }
+    if (true) {
+        SrsSetEnvConfig(size, "SRS_STACK_SIZE", "100");
+        MockSrsConfig conf;
+        HELPER_ASSERT_FAILED(conf.parse(_MIN_OK_CONF));
+    }
+}
+
 VOID TEST(ConfigMainTest, CheckConf_vhost_ingest_id)
 {
     srs_error_t err;
@@ -3109,6 +3157,15 @@ VOID TEST(ConfigMainTest, CheckVhostConfig2)
         EXPECT_TRUE(conf.get_tcp_nodelay("ossrs.net"));
     }
 
+    if (true) {
+        MockSrsConfig conf;
+        HELPER_ASSERT_SUCCESS(conf.parse(_MIN_OK_CONF "vhost ossrs.net{play{zerocopy on; zerocopy_threshold 65536;}}"));
+        EXPECT_TRUE(conf.get_zerocopy("ossrs.net"));
+        EXPECT_EQ(65536, conf.get_zerocopy_threshold("ossrs.net"));
+        EXPECT_FALSE(conf.get_zerocopy("__defaultVhost__"));
+        EXPECT_EQ(16384, conf.get_zerocopy_threshold("__defaultVhost__"));
+    }
+
     if (true) {
         MockSrsConfig conf;
         HELPER_ASSERT_SUCCESS(conf.parse(_MIN_OK_CONF "vhost ossrs.net{min_latency on;}"));
@@ -4535,6 +4592,16 @@ VOID TEST(ConfigEnvTest, CheckEnvValuesVhostRtc)
 
 VOID TEST(ConfigEnvTest, CheckEnvValuesVhostPlay)
 {
+    if (true) {
+        MockSrsConfig conf;
+
+        SrsSetEnvConfig(zerocopy, "SRS_VHOST_PLAY_ZEROCOPY", "on");
+        EXPECT_TRUE(conf.get_zerocopy("__defaultVhost__"));
+
+        SrsSetEnvConfig(zerocopy_threshold, "SRS_VHOST_PLAY_ZEROCOPY_THRESHOLD", "32768");
+        EXPECT_EQ(32768, conf.get_zerocopy_threshold("__defaultVhost__"));
+    }
+
     if (true) {
         MockSrsConfig conf;
 
@@ -63,5 +63,20 @@ private:
 #define SrsSetEnvConfig(instance, key, value) \
     ISrsSetEnvConfig _SRS_free_##instance(key, value, true)
 
+// Use the config as global object, restore when test done.
+class MockSrsConfigGuard
+{
+private:
+    SrsConfig* origin_;
+public:
+    MockSrsConfigGuard(SrsConfig* conf) {
+        origin_ = _srs_config;
+        _srs_config = conf;
+    }
+    virtual ~MockSrsConfigGuard() {
+        _srs_config = origin_;
+    }
+};
+
 #endif
 
@@ -18,6 +18,8 @@ using namespace std;
 #include <srs_app_http_static.hpp>
 #include <srs_protocol_utility.hpp>
 #include <srs_core_autofree.hpp>
+#include <srs_utest_amf0.hpp>
+#include <srs_app_statistic.hpp>
 
 MockMSegmentsReader::MockMSegmentsReader()
 {
@@ -788,6 +790,305 @@ VOID TEST(ProtocolHTTPTest, HTTPServerMuxerImplicitHandler)
     }
 }
 
+VOID TEST(ProtocolHTTPTest, HTTPServerMuxerRadixTree)
+{
+    // Longest prefix and exactly match.
+    if (true) {
+        SrsHttpRadixTree t;
+        SrsHttpMuxEntry root, api, v1, v2, exact;
+        root.pattern = "/"; api.pattern = "/api/"; v1.pattern = "/api/v1/"; v2.pattern = "/api/v2/"; exact.pattern = "/api/v1";
+        t.insert(root.pattern, &root); t.insert(api.pattern, &api); t.insert(v1.pattern, &v1);
+        t.insert(v2.pattern, &v2); t.insert(exact.pattern, &exact);
+
+        EXPECT_TRUE(&root == t.match("/"));
+        EXPECT_TRUE(&root == t.match("/index.html"));
+        EXPECT_TRUE(&root == t.match("/ap"));
+        EXPECT_TRUE(&api == t.match("/api/"));
+        EXPECT_TRUE(&api == t.match("/api/v3/streams"));
+        EXPECT_TRUE(&api == t.match("/api/v"));
+        EXPECT_TRUE(&exact == t.match("/api/v1"));
+        EXPECT_TRUE(&v1 == t.match("/api/v1/streams"));
+        EXPECT_TRUE(&v2 == t.match("/api/v2/"));
+        EXPECT_TRUE(&api == t.match("/api/v1x"));
+        EXPECT_TRUE(NULL == t.match("ossrs.net/api/"));
+
+        // Fallback to the shorter pattern when disabled.
+        v1.enabled = false;
+        EXPECT_TRUE(&api == t.match("/api/v1/streams"));
+        v1.enabled = true;
+
+        // Unmount and merge nodes.
+        t.remove("/api/v1/");
+        EXPECT_TRUE(&api == t.match("/api/v1/streams"));
+        EXPECT_TRUE(&exact == t.match("/api/v1"));
+        t.remove("/api/v1");
+        EXPECT_TRUE(&api == t.match("/api/v1"));
+        EXPECT_TRUE(&v2 == t.match("/api/v2/streams"));
+        t.remove("/api/");
+        EXPECT_TRUE(&root == t.match("/api/v1"));
+        EXPECT_TRUE(&v2 == t.match("/api/v2/streams"));
+
+        // Remove not exists pattern.
+        t.remove("/api/v3/");
+        t.remove("/ap");
+        EXPECT_TRUE(&v2 == t.match("/api/v2/streams"));
+
+        // Overwrite the entry.
+        t.insert("/api/v2/", &v1);
+        EXPECT_TRUE(&v1 == t.match("/api/v2/streams"));
+    }
+
+    // Vhost pattern in a different subtree.
+    if (true) {
+        SrsHttpRadixTree t;
+        SrsHttpMuxEntry live, vlive;
+        t.insert("/live/", &live);
+        t.insert("ossrs.net/live/", &vlive);
+
+        EXPECT_TRUE(&live == t.match("/live/livestream.flv"));
+        EXPECT_TRUE(&vlive == t.match("ossrs.net/live/livestream.flv"));
+        EXPECT_TRUE(NULL == t.match("ossrs.io/live/livestream.flv"));
+    }
+}
+
+VOID TEST(ProtocolHTTPTest, HTTPServerMuxerManyStreams)
+{
+    srs_error_t err;
+
+    // The match cost should not grow with the number of mounted streams.
+    srs_utime_t costs[3];
+    int nn_streams[3] = {100, 1000, 20000};
+    for (int i = 0; i < 3; i++) {
+        SrsHttpServeMux s;
+        HELPER_ASSERT_SUCCESS(s.initialize());
+
+        HELPER_ASSERT_SUCCESS(s.handle("/", new MockHttpHandler("Root")));
+        HELPER_ASSERT_SUCCESS(s.handle("/api/v1/", new MockHttpHandler("API")));
+        for (int j = 0; j < nn_streams[i]; j++) {
+            HELPER_ASSERT_SUCCESS(s.handle(srs_fmt("/live/stream%d.flv", j), new MockHttpHandler("FLV")));
+        }
+
+        SrsHttpMessage r(NULL, NULL);
+        HELPER_ASSERT_SUCCESS(r.set_url(srs_fmt("/live/stream%d.flv", nn_streams[i] / 2), false));
+
+        srs_utime_t starttime = srs_update_system_time();
+        for (int j = 0; j < 100000; j++) {
+            ISrsHttpHandler* h = NULL;
+            HELPER_ASSERT_SUCCESS(s.find_handler(&r, &h));
+            ASSERT_TRUE(h != NULL);
+        }
+        costs[i] = srs_update_system_time() - starttime;
+        srs_trace("HTTP mux match %d streams, cost %dns/op", nn_streams[i], (int)(costs[i] * 1000 / 100000));
+
+        // Unmount all streams.
+        for (int j = 0; j < nn_streams[i]; j++) {
+            s.unhandle(srs_fmt("/live/stream%d.flv", j), NULL);
+        }
+        ISrsHttpHandler* h = NULL;
+        HELPER_ASSERT_SUCCESS(s.find_handler(&r, &h));
+        MockHttpHandler* mh = dynamic_cast<MockHttpHandler*>(h);
+        ASSERT_TRUE(mh != NULL);
+        EXPECT_STREQ("Root", mh->bytes.c_str());
+    }
+
+    // Loose bound to avoid flaky, the linear scan is about 200x slower for 20k streams.
+    EXPECT_LT(costs[2], srs_max(costs[0], 10 * SRS_UTIME_MILLISECONDS) * 8);
+}
+
+VOID TEST(ProtocolHTTPTest, StatisticClientsCursor)
+{
+    srs_error_t err;
+
+    SrsStatistic* stat = SrsStatistic::instance();
+
+    SrsRequest req;
+    req.vhost = "__defaultVhost__"; req.app = "live"; req.stream = "livestream";
+    for (int i = 0; i < 25; i++) {
+        HELPER_ASSERT_SUCCESS(stat->on_client(srs_fmt("utest-cursor-%02d", i), &req, NULL, SrsRtmpConnPlay));
+    }
+
+    // Fetch pages by cursor, each page should continue the previous one.
+    string cursor = "utest-cursor-";
+    for (int page = 0; page < 3; page++) {
+        MockJsonStreamWriter w;
+        SrsJsonWriter jw(&w);
+
+        string next;
+        HELPER_ASSERT_SUCCESS(jw.array_start());
+        HELPER_ASSERT_SUCCESS(stat->dumps_clients(&jw, 0, cursor, 10, next));
+        HELPER_ASSERT_SUCCESS(jw.array_end());
+        HELPER_ASSERT_SUCCESS(jw.flush());
+
+        SrsJsonAny* p = SrsJsonAny::loads(w.data);
+        SrsUniquePtr<SrsJsonAny> p_uptr(p);
+        ASSERT_TRUE(p && p->is_array());
+
+        SrsJsonArray* arr = p->to_array();
+        int expect = page < 2 ? 10 : 5;
+        ASSERT_LE(expect, arr->count());
+        for (int i = 0; i < expect; i++) {
+            SrsJsonAny* id = arr->at(i)->to_object()->get_property("id");
+            ASSERT_TRUE(id != NULL);
+            EXPECT_STREQ(srs_fmt("utest-cursor-%02d", page * 10 + i).c_str(), id->to_str().c_str());
+        }
+
+        if (page < 2) {
+            EXPECT_STREQ(srs_fmt("utest-cursor-%02d", page * 10 + 9).c_str(), next.c_str());
+        }
+        cursor = next;
+
+        // Remove the clients of previous page, which should not change the next page.
+        for (int i = 0; i < expect; i++) {
+            stat->on_disconnect(srs_fmt("utest-cursor-%02d", page * 10 + i), srs_success);
+        }
+    }
+}
+
+VOID TEST(ProtocolHTTPTest, StatisticEvents)
+{
+    srs_error_t err;
+
+    SrsStatistic* stat = SrsStatistic::instance();
+    stat->subscribe();
+
+    uint64_t seq = stat->event_seq();
+
+    SrsRequest req;
+    req.vhost = "utest.events"; req.app = "live"; req.stream = "livestream";
+    HELPER_ASSERT_SUCCESS(stat->on_client("utest-events-0", &req, NULL, SrsRtmpConnPlay));
+
+    SrsRequest req2;
+    req2.vhost = "utest.events"; req2.app = "game"; req2.stream = "livestream";
+    HELPER_ASSERT_SUCCESS(stat->on_client("utest-events-1", &req2, NULL, SrsRtmpConnPlay));
+
+    // The stream is added, then clients changed.
+    if (true) {
+        std::vector< SrsSharedPtr<SrsStatisticEvent> > events;
+        EXPECT_TRUE(stat->fetch_events(seq, "utest.events", "", events));
+        ASSERT_EQ(4, (int)events.size());
+        EXPECT_EQ(SrsStatisticEventAdded, events.at(0)->type);
+        EXPECT_EQ(SrsStatisticEventChanged, events.at(1)->type);
+        EXPECT_EQ(seq + 1, events.at(0)->seq);
+        EXPECT_TRUE(events.at(1)->data.find("\"clients\":1") != string::npos);
+    }
+
+    // Filter by app.
+    if (true) {
+        std::vector< SrsSharedPtr<SrsStatisticEvent> > events;
+        EXPECT_TRUE(stat->fetch_events(seq, "utest.events", "game", events));
+        ASSERT_EQ(2, (int)events.size());
+        EXPECT_STREQ("game", events.at(0)->app.c_str());
+    }
+
+    // The snapshot of streams.
+    if (true) {
+        std::vector< SrsSharedPtr<SrsStatisticEvent> > events;
+        stat->snapshot_events("utest.events", "", events);
+        ASSERT_EQ(2, (int)events.size());
+        EXPECT_EQ(stat->event_seq(), events.at(0)->seq);
+    }
+
+    // The stream is removed when the last client disconnected.
+    seq = stat->event_seq();
+    stat->on_disconnect("utest-events-0", srs_success);
+    if (true) {
+        std::vector< SrsSharedPtr<SrsStatisticEvent> > events;
+        EXPECT_TRUE(stat->fetch_events(seq, "", "live", events));
+        ASSERT_EQ(2, (int)events.size());
+        EXPECT_EQ(SrsStatisticEventRemoved, events.at(1)->type);
+        EXPECT_STREQ("removed", srs_stat_event_type_str(events.at(1)->type).c_str());
+    }
+
+    // No more events.
+    if (true) {
+        std::vector< SrsSharedPtr<SrsStatisticEvent> > events;
+        EXPECT_TRUE(stat->fetch_events(stat->event_seq(), "", "", events));
+        EXPECT_TRUE(events.empty());
+    }
+
+    // Aggregate the kbps of changed streams of app to one event.
+    SrsRequest req3;
+    req3.vhost = "utest.events"; req3.app = "game"; req3.stream = "livestream2";
+    HELPER_ASSERT_SUCCESS(stat->on_client("utest-events-2", &req3, NULL, SrsRtmpConnPlay));
+    if (true) {
+        stat->kbps_sample();
+        seq = stat->event_seq();
+
+        SrsEphemeralDelta d1, d2;
+        d1.add_delta(100, 200);
+        d2.add_delta(300, 400);
+        stat->kbps_add_delta("utest-events-1", &d1);
+        stat->kbps_add_delta("utest-events-2", &d2);
+        stat->kbps_sample();
+
+        std::vector< SrsSharedPtr<SrsStatisticEvent> > events;
+        EXPECT_TRUE(stat->fetch_events(seq, "utest.events", "", events));
+        ASSERT_EQ(1, (int)events.size());
+        EXPECT_EQ(SrsStatisticEventKbps, events.at(0)->type);
+        EXPECT_STREQ("game", events.at(0)->app.c_str());
+        EXPECT_TRUE(events.at(0)->data.find("\"name\":\"livestream\"") != string::npos);
+        EXPECT_TRUE(events.at(0)->data.find("\"name\":\"livestream2\"") != string::npos);
+
+        // No kbps event if no data transferred.
+        seq = stat->event_seq();
+        stat->kbps_sample();
+        events.clear();
+        EXPECT_TRUE(stat->fetch_events(seq, "utest.events", "", events));
+        EXPECT_TRUE(events.empty());
+    }
+    stat->on_disconnect("utest-events-2", srs_success);
+
+    // Resume by the id of event in the same epoch.
+    if (true) {
+        seq = 0;
+        EXPECT_TRUE(stat->parse_event_id(stat->event_id(stat->event_seq()), seq));
+        EXPECT_EQ(stat->event_seq(), seq);
+
+        // The id without epoch, for example, from the previous version, or malformed.
+        EXPECT_FALSE(stat->parse_event_id(srs_fmt("%" PRIu64, stat->event_seq()), seq));
+        EXPECT_FALSE(stat->parse_event_id(stat->event_id(0) + "x", seq));
+        EXPECT_FALSE(stat->parse_event_id("", seq));
+    }
+
+    // Reset the subscriber which reconnects after an idle gap, during which the events are missed.
+    if (true) {
+        string last_id = stat->event_id(stat->event_seq());
+        stat->unsubscribe();
+        HELPER_ASSERT_SUCCESS(stat->on_audio_info(&req2, SrsAudioCodecIdAAC, SrsAudioSampleRate44100, SrsAudioChannelsStereo, SrsAacObjectTypeAacLC));
+
+        stat->subscribe();
+        EXPECT_FALSE(stat->parse_event_id(last_id, seq));
+
+        // The resumed one got the new events.
+        seq = stat->event_seq();
+        HELPER_ASSERT_SUCCESS(stat->on_audio_info(&req2, SrsAudioCodecIdAAC, SrsAudioSampleRate44100, SrsAudioChannelsStereo, SrsAacObjectTypeAacLC));
+        EXPECT_EQ(seq + 1, stat->event_seq());
+
+        std::vector< SrsSharedPtr<SrsStatisticEvent> > events;
+        EXPECT_TRUE(stat->fetch_events(seq, "", "", events));
+        ASSERT_EQ(1, (int)events.size());
+        EXPECT_EQ(seq + 1, events.at(0)->seq);
+    }
+
+    // Reset the subscriber whose seq is newer than the last event.
+    if (true) {
+        std::vector< SrsSharedPtr<SrsStatisticEvent> > events;
+        EXPECT_FALSE(stat->fetch_events(stat->event_seq() + 1, "", "", events));
+    }
+
+    // The slow subscriber should reload the snapshot.
+    for (int i = 0; i < SRS_STAT_EVENTS_MAX; i++) {
+        HELPER_ASSERT_SUCCESS(stat->on_audio_info(&req2, SrsAudioCodecIdAAC, SrsAudioSampleRate44100, SrsAudioChannelsStereo, SrsAacObjectTypeAacLC));
+    }
+    if (true) {
+        std::vector< SrsSharedPtr<SrsStatisticEvent> > events;
+        EXPECT_FALSE(stat->fetch_events(seq, "", "", events));
+    }
+
+    stat->on_disconnect("utest-events-1", srs_success);
+    stat->unsubscribe();
+}
+
 VOID TEST(ProtocolHTTPTest, HTTPServerMuxerHijack)
 {
     srs_error_t err;
@@ -608,6 +608,99 @@ VOID TEST(KernelFastBufferTest, Grow)
     }
 }
 
+VOID TEST(KernelFastBufferTest, Adaptive)
+{
+    srs_error_t err;
+
+    SrsFastStreamPool* pool = SrsFastStreamPool::instance();
+    int nn_streams = pool->nn_streams;
+
+    // Never grow when read fills the buffer, if the required size fits the buffer.
+    if (true) {
+        SrsFastStream b;
+        EXPECT_EQ(4096, b.capacity());
+        EXPECT_EQ(nn_streams + 1, pool->nn_streams);
+
+        int64_t nn_grows = pool->nn_grows;
+        MockBufferReader r("");
+        r.str = string(1024 * 1024, 'x');
+        for (int i = 0; i < 10; i++) {
+            HELPER_ASSERT_SUCCESS(b.grow(&r, 1));
+            b.skip(b.size());
+        }
+        EXPECT_EQ(4096, b.capacity());
+
+        // Keep some unconsumed bytes, which fit the buffer after compacted.
+        for (int i = 0; i < 10; i++) {
+            HELPER_ASSERT_SUCCESS(b.grow(&r, 4000));
+            b.skip(b.size() - 100);
+        }
+        EXPECT_EQ(4096, b.capacity());
+        EXPECT_EQ(nn_grows, pool->nn_grows);
+
+        // Grow when the unconsumed bytes need more space, never exceed the max size.
+        HELPER_ASSERT_SUCCESS(b.grow(&r, 100000));
+        EXPECT_EQ(131072, b.capacity());
+        EXPECT_EQ(nn_grows + 1, pool->nn_grows);
+        b.skip(b.size());
+
+        // Shrink when the reads are small in the window, which includes the large reads.
+        for (int i = 0; i < 128; i++) {
+            r.str = "a";
+            HELPER_ASSERT_SUCCESS(b.grow(&r, 1));
+            EXPECT_EQ('a', b.read_1byte());
+        }
+        EXPECT_EQ(131072, b.capacity());
+
+        for (int i = 0; i < 128; i++) {
+            r.str = "a";
+            HELPER_ASSERT_SUCCESS(b.grow(&r, 1));
+            EXPECT_EQ('a', b.read_1byte());
+        }
+        EXPECT_EQ(4096, b.capacity());
+    }
+    EXPECT_EQ(nn_streams, pool->nn_streams);
+
+    // Grow for the required size, and keep the bytes in buffer.
+    if (true) {
+        SrsFastStream b;
+        MockBufferReader r("Hello");
+        HELPER_ASSERT_SUCCESS(b.grow(&r, 5));
+        EXPECT_EQ('H', b.read_1byte());
+
+        r.str = string(20000, 'x');
+        HELPER_ASSERT_SUCCESS(b.grow(&r, 20000));
+        EXPECT_EQ(32768, b.capacity());
+        EXPECT_EQ('e', b.read_1byte());
+        EXPECT_EQ(20003, b.size());
+
+        // Overflow if exceed the max size.
+        b.skip(b.size());
+        r.str = string(131073, 'x');
+        HELPER_ASSERT_FAILED(b.grow(&r, 131073));
+
+        // The max size is changed by set_buffer.
+        b.set_buffer(131073);
+        HELPER_ASSERT_SUCCESS(b.grow(&r, 131073));
+        EXPECT_EQ(131073, b.capacity());
+    }
+
+    // The size class of buffer is reused from pool.
+    if (true) {
+        pool->set_max_free(0);
+        EXPECT_EQ(0, pool->free_bytes());
+        pool->set_max_free(16 * 1024 * 1024);
+
+        if (true) {
+            SrsFastStream b(131072);
+        }
+        EXPECT_EQ(131072, pool->free_bytes());
+
+        SrsFastStream b(131072);
+        EXPECT_EQ(0, pool->free_bytes());
+    }
+}
+
 /**
 * test the codec,
 * whether H.264 keyframe
@@ -624,6 +717,38 @@ VOID TEST(KernelCodecTest, IsKeyFrame)
     EXPECT_FALSE(SrsFlvVideo::keyframe(&data, 1));
 }
 
+/**
+* test the codec,
+* whether H.264 frame is disposable
+*/
+VOID TEST(KernelCodecTest, IsDisposable)
+{
+    // The B frame, nal_ref_idc is 0.
+    uint8_t b[] = {0x27, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x01, 0x9e};
+    EXPECT_TRUE(SrsFlvVideo::disposable((char*)b, sizeof(b)));
+
+    // The P frame, nal_ref_idc is 2.
+    uint8_t p[] = {0x27, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x41, 0x9a};
+    EXPECT_FALSE(SrsFlvVideo::disposable((char*)p, sizeof(p)));
+
+    // The keyframe is never disposable.
+    uint8_t k[] = {0x17, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x05, 0x88};
+    EXPECT_FALSE(SrsFlvVideo::disposable((char*)k, sizeof(k)));
+
+    // The B frame with SEI, nal_ref_idc of slice is 0.
+    uint8_t s[] = {0x27, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x06, 0x05, 0x00, 0x00, 0x00, 0x02, 0x01, 0x9e};
+    EXPECT_TRUE(SrsFlvVideo::disposable((char*)s, sizeof(s)));
+
+    // The NALU size overflow.
+    uint8_t o[] = {0x27, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x01, 0x9e};
+    EXPECT_FALSE(SrsFlvVideo::disposable((char*)o, sizeof(o)));
+
+    // The disposable inter frame of H.263.
+    uint8_t d[] = {0x32, 0x00, 0x00, 0x00, 0x00};
+    EXPECT_TRUE(SrsFlvVideo::disposable((char*)d, sizeof(d)));
+    EXPECT_FALSE(SrsFlvVideo::disposable((char*)d, 4));
+}
+
 /**
 * test the codec,
 * check whether H.264 video
@@ -3286,6 +3411,136 @@ VOID TEST(KernelLBRRTest, CoverAll)
     }
 }
 
+VOID TEST(KernelLBRRTest, ConsistentHash)
+{
+    vector<string> servers;
+    servers.push_back("s0");
+    servers.push_back("s1");
+    servers.push_back("s2");
+
+    // The same key always selects the same server.
+    string primary;
+    if (true) {
+        SrsLbConsistentHash lb("vhost/live/livestream");
+        primary = lb.select(servers);
+        EXPECT_TRUE(primary == lb.select(servers));
+
+        SrsLbConsistentHash lb2("vhost/live/livestream");
+        EXPECT_TRUE(primary == lb2.select(servers));
+
+        // The order of servers does not matter.
+        vector<string> reversed(servers.rbegin(), servers.rend());
+        SrsLbConsistentHash lb3("vhost/live/livestream");
+        EXPECT_TRUE(primary == lb3.select(reversed));
+    }
+
+    // Failover to another server, and stick to it.
+    if (true) {
+        SrsLbConsistentHash lb("vhost/live/livestream");
+        EXPECT_TRUE(primary == lb.select(servers));
+
+        lb.feedback(primary, false);
+        string backup = lb.select(servers);
+        EXPECT_TRUE(primary != backup);
+
+        lb.feedback(primary, true);
+        EXPECT_TRUE(backup == lb.select(servers));
+
+        // Retry from the highest weight when all failed.
+        lb.feedback(servers.at(0), false);
+        lb.feedback(servers.at(1), false);
+        lb.feedback(servers.at(2), false);
+        EXPECT_TRUE(primary == lb.select(servers));
+    }
+
+    // The streams are distributed to all servers.
+    if (true) {
+        map<string, int> hits;
+        for (int i = 0; i < 300; i++) {
+            SrsLbConsistentHash lb("vhost/live/stream" + srs_int2str(i));
+            hits[lb.select(servers)]++;
+        }
+        EXPECT_EQ(3, (int)hits.size());
+        EXPECT_GT(hits["s0"], 50);
+        EXPECT_GT(hits["s1"], 50);
+        EXPECT_GT(hits["s2"], 50);
+    }
+}
+
+VOID TEST(KernelLBRRTest, LeastLoaded)
+{
+    vector<string> servers;
+    servers.push_back("s0");
+    servers.push_back("s1");
+
+    SrsLbLoads loads;
+
+    // Select the least loaded server.
+    if (true) {
+        SrsLbLeastLoaded lb0(&loads, "stream0");
+        SrsLbLeastLoaded lb1(&loads, "stream1");
+        string v0 = lb0.select(servers);
+        string v1 = lb1.select(servers);
+        EXPECT_TRUE(v0 != v1);
+        EXPECT_EQ(1, loads.load(v0));
+        EXPECT_EQ(1, loads.load(v1));
+
+        // Stick to the selected server.
+        EXPECT_TRUE(v0 == lb0.select(servers));
+        EXPECT_EQ(1, loads.load(v0));
+    }
+    EXPECT_EQ(0, loads.load("s0"));
+    EXPECT_EQ(0, loads.load("s1"));
+
+    // Avoid the failed server.
+    if (true) {
+        SrsLbLeastLoaded lb0(&loads, "stream0");
+        string v0 = lb0.select(servers);
+        lb0.feedback(v0, false);
+
+        string v1 = lb0.select(servers);
+        EXPECT_TRUE(v0 != v1);
+        EXPECT_EQ(1, loads.load(v1));
+
+        SrsLbLeastLoaded lb1(&loads, "stream1");
+        EXPECT_TRUE(v1 == lb1.select(servers));
+
+        lb0.feedback(v0, true);
+        EXPECT_EQ(0, loads.load(v0));
+    }
+
+    // Release the load when stop, and acquire again when restart.
+    if (true) {
+        SrsLbLeastLoaded lb0(&loads, "stream0");
+        string v0 = lb0.select(servers);
+        EXPECT_EQ(1, loads.load(v0));
+
+        for (int i = 0; i < 3; i++) {
+            lb0.release();
+            EXPECT_EQ(0, loads.load(v0));
+
+            // Release again is ignored.
+            lb0.release();
+            EXPECT_EQ(0, loads.load(v0));
+
+            // Stick to the same server when restart.
+            EXPECT_TRUE(v0 == lb0.select(servers));
+            EXPECT_EQ(1, loads.load(v0));
+        }
+
+        // Select another server when failed, after released.
+        lb0.release();
+        lb0.feedback(v0, false);
+        string v1 = lb0.select(servers);
+        EXPECT_TRUE(v0 != v1);
+        EXPECT_EQ(1, loads.load(v1));
+        lb0.feedback(v0, true);
+        EXPECT_EQ(0, loads.load(v0));
+    }
+    EXPECT_EQ(0, loads.load("s0"));
+    EXPECT_EQ(0, loads.load("s1"));
+}
+
 VOID TEST(KernelCodecTest, CoverAll)
 {
     if (true) {
@@ -3738,6 +3993,65 @@ VOID TEST(KernelCodecTest, AudioFormat)
     }
 }
 
+VOID TEST(KernelCodecTest, OpusAudioFormat)
+{
+    srs_error_t err;
+
+    // The enhanced RTMP header, 0x90 is ExHeader with SequenceStart, 0x91 with CodedFrames.
+    if (true) {
+        EXPECT_FALSE(SrsFlvAudio::opus((char*)"\x90Opu", 4));
+        EXPECT_FALSE(SrsFlvAudio::opus((char*)"\x90Opxs", 5));
+        EXPECT_FALSE(SrsFlvAudio::opus((char*)"\xa0Opus", 5));
+        EXPECT_TRUE(SrsFlvAudio::opus((char*)"\x90Opus", 5));
+        EXPECT_TRUE(SrsFlvAudio::sh((char*)"\x90Opus", 5));
+        EXPECT_FALSE(SrsFlvAudio::sh((char*)"\x91Opus", 5));
+        EXPECT_FALSE(SrsFlvAudio::aac((char*)"\x90Opus", 5));
+    }
+
+    // Ignore the unknown FourCC.
+    if (true) {
+        SrsFormat f;
+        HELPER_EXPECT_SUCCESS(f.initialize());
+        HELPER_EXPECT_SUCCESS(f.on_audio(0, (char*)"\x91" "fLaC\x00", 6));
+        EXPECT_TRUE(f.acodec == NULL);
+    }
+
+    // Require the OpusHead for sequence start.
+    if (true) {
+        SrsFormat f;
+        HELPER_EXPECT_SUCCESS(f.initialize());
+        HELPER_EXPECT_FAILED(f.on_audio(0, (char*)"\x90OpusOpusHead", 13));
+    }
+
+    if (true) {
+        SrsFormat f;
+        HELPER_EXPECT_SUCCESS(f.initialize());
+
+        // OpusHead, version 1, mono, pre-skip 0, 48KHz, gain 0, family 0.
+        uint8_t sh[] = {
+            0x90, 'O', 'p', 'u', 's',
+            'O', 'p', 'u', 's', 'H', 'e', 'a', 'd', 0x01, 0x01, 0x00, 0x00,
+            0x80, 0xbb, 0x00, 0x00, 0x00, 0x00, 0x00
+        };
+        HELPER_EXPECT_SUCCESS(f.on_audio(0, (char*)sh, sizeof(sh)));
+        EXPECT_TRUE(f.is_opus_sequence_header());
+        EXPECT_FALSE(f.is_aac_sequence_header());
+        EXPECT_EQ(SrsAudioCodecIdOpus, f.acodec->id);
+        EXPECT_EQ(SrsAudioChannelsMono, f.acodec->sound_type);
+        EXPECT_EQ(1, f.acodec->aac_channels);
+        EXPECT_EQ(SrsAudioSampleRate48000, f.acodec->sound_rate);
+        EXPECT_EQ(19, (int)f.acodec->aac_extra_data.size());
+
+        HELPER_EXPECT_SUCCESS(f.on_audio(20, (char*)"\x91Opus\xf8\xff\xfe", 8));
+        EXPECT_FALSE(f.is_opus_sequence_header());
+        EXPECT_EQ(SrsAudioOpusFrameTraitRaw, f.audio->aac_packet_type);
+        EXPECT_EQ(20, f.audio->dts);
+        EXPECT_EQ(3, f.nb_raw);
+        EXPECT_EQ(1, f.audio->nb_samples);
+        EXPECT_EQ(3, f.audio->samples[0].size);
+    }
+}
+
 VOID TEST(KernelCodecTest, VideoFormatSepcial)
 {
 	srs_error_t err;
@@ -501,6 +501,140 @@ VOID TEST(ProtocolHandshakeTest, ComplexHandshake)
         SrsRtmpServer r(&io);
         HELPER_EXPECT_SUCCESS(r.handshake());
     }
+
+    // Use the pre-generated DH keypair from pool.
+    if (true) {
+        SrsHandshakeKeyPool pool;
+        HELPER_EXPECT_SUCCESS(pool.initialize(1, 1));
+        HELPER_EXPECT_SUCCESS(pool.refill(1));
+        EXPECT_EQ(1, pool.size());
+
+        SrsHandshakeKeyPool* origin = _srs_handshake_pool;
+        _srs_handshake_pool = &pool;
+
+        MockBufferIO io;
+        io.append(c0c1, 1537);
+        io.append(c2, 1536);
+
+        SrsRtmpServer r(&io);
+        HELPER_EXPECT_SUCCESS(r.handshake());
+        EXPECT_EQ(0, pool.size());
+        EXPECT_EQ(0, pool.concurrency());
+        EXPECT_EQ(1, pool.peak_concurrency());
+
+        _srs_handshake_pool = origin;
+    }
+
+    // Degrade to simple handshake, when exceed the max concurrency.
+    if (true) {
+        SrsHandshakeKeyPool pool;
+        HELPER_EXPECT_SUCCESS(pool.initialize(1, 1));
+        HELPER_EXPECT_SUCCESS(pool.refill(1));
+
+        SrsHandshakeKeyPool* origin = _srs_handshake_pool;
+        _srs_handshake_pool = &pool;
+
+        SrsHandshakeSlot slot(&pool);
+        EXPECT_TRUE(slot.acquired());
+
+        MockBufferIO io;
+        io.append(c0c1, 1537);
+
+        SrsHandshakeBytes bytes;
+        SrsComplexHandshake hs;
+        err = hs.handshake_with_client(&bytes, &io);
+        EXPECT_EQ(ERROR_RTMP_TRY_SIMPLE_HS, srs_error_code(err));
+        srs_freep(err);
+
+        // The DH keypair should not be consumed.
+        EXPECT_EQ(1, pool.size());
+        EXPECT_EQ(1, pool.concurrency());
+
+        _srs_handshake_pool = origin;
+    }
+}
+
+VOID TEST(ProtocolHandshakeTest, HandshakeKeyPool)
+{
+    srs_error_t err;
+
+    if (true) {
+        SrsHandshakeKeyPool pool;
+        HELPER_EXPECT_SUCCESS(pool.initialize(2, 0));
+        EXPECT_EQ(0, pool.size());
+        EXPECT_EQ(2, pool.capacity());
+        EXPECT_TRUE(pool.fetch() == NULL);
+
+        HELPER_EXPECT_SUCCESS(pool.refill(1));
+        EXPECT_EQ(1, pool.size());
+
+        // Never exceed the capacity.
+        HELPER_EXPECT_SUCCESS(pool.refill(10));
+        EXPECT_EQ(2, pool.size());
+
+        // The keypair is ready to compute shared key.
+        srs_internal::SrsDH* dh = pool.fetch();
+        ASSERT_TRUE(dh != NULL);
+        SrsUniquePtr<srs_internal::SrsDH> dh_uptr(dh);
+        EXPECT_EQ(1, pool.size());
+
+        char pkey[128];
+        int pkey_size = 128;
+        HELPER_EXPECT_SUCCESS(dh->copy_public_key(pkey, pkey_size));
+        EXPECT_EQ(128, pkey_size);
+
+        // Shrink the pool when reinitialize.
+        HELPER_EXPECT_SUCCESS(pool.initialize(0, 0));
+        EXPECT_EQ(0, pool.size());
+        HELPER_EXPECT_SUCCESS(pool.refill(1));
+        EXPECT_EQ(0, pool.size());
+    }
+
+    // Limit the concurrency.
+    if (true) {
+        SrsHandshakeKeyPool pool;
+        HELPER_EXPECT_SUCCESS(pool.initialize(0, 2));
+
+        EXPECT_TRUE(pool.acquire());
+        if (true) {
+            SrsHandshakeSlot slot(&pool);
+            EXPECT_TRUE(slot.acquired());
+            EXPECT_EQ(2, pool.concurrency());
+
+            SrsHandshakeSlot slot2(&pool);
+            EXPECT_FALSE(slot2.acquired());
+        }
+        EXPECT_EQ(1, pool.concurrency());
+        EXPECT_EQ(2, pool.peak_concurrency());
+
+        pool.release();
+        EXPECT_EQ(0, pool.concurrency());
+    }
+
+    // No limit if no pool.
+    if (true) {
+        SrsHandshakeSlot slot(NULL);
+        EXPECT_TRUE(slot.acquired());
+    }
+
+    // The initialized HMAC context should generate the same digest.
+    if (true) {
+        SrsHandshakeKeyPool pool;
+        HELPER_EXPECT_SUCCESS(pool.initialize(0, 0));
+
+        char data[1504];
+        srs_random_generate(data, sizeof(data));
+
+        uint8_t* keys[] = {srs_internal::SrsGenuineFPKey, srs_internal::SrsGenuineFMSKey,
+            srs_internal::SrsGenuineFPKey, srs_internal::SrsGenuineFMSKey, srs_internal::SrsGenuineFPKey};
+        int sizes[] = {30, 36, 62, 68, 16};
+        for (int i = 0; i < (int)(sizeof(sizes) / sizeof(int)); i++) {
+            char expect[SRS_OpensslHashSize], actual[SRS_OpensslHashSize];
+            HELPER_EXPECT_SUCCESS(srs_internal::openssl_HMACsha256(keys[i], sizes[i], data, sizeof(data), expect));
+            HELPER_EXPECT_SUCCESS(pool.hmac_sha256(keys[i], sizes[i], data, sizeof(data), actual));
+            EXPECT_TRUE(srs_bytes_equals(expect, actual, 32));
+        }
+    }
 }
 
 VOID TEST(ProtocolHandshakeTest, SimpleHandshake)
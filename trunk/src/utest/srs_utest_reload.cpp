@@ -639,3 +639,63 @@ VOID TEST(ConfigReloadTest, ReloadVhostIngestUpdated)
     handler.reset();
 }
 
+
+VOID TEST(ConfigReloadTest, ReloadVhostSnapshot)
+{
+    srs_error_t err = srs_success;
+
+    MockSrsReloadConfig conf;
+    HELPER_EXPECT_SUCCESS(conf.parse(_MIN_OK_CONF"vhost a{play {queue_length 5; gop_cache off;}}"));
+
+    SrsSharedPtr<SrsVhostConfig> a = conf.get_vhost_snapshot("a");
+    EXPECT_STREQ("a", a->vhost.c_str());
+    EXPECT_EQ(5 * SRS_UTIME_SECONDS, a->queue_length);
+    EXPECT_FALSE(a->gop_cache);
+
+    // Reuse the snapshot until reload.
+    SrsSharedPtr<SrsVhostConfig> b = conf.get_vhost_snapshot("a");
+    EXPECT_TRUE(a.get() == b.get());
+
+    // The unknown vhosts share the same snapshot, with default values.
+    SrsSharedPtr<SrsVhostConfig> d = conf.get_vhost_snapshot("unknown.com");
+    EXPECT_TRUE(d->vhost.empty());
+    EXPECT_TRUE(d->gop_cache);
+    EXPECT_TRUE(d.get() == conf.get_vhost_snapshot("unknown2.com").get());
+
+    // Rebuild the snapshot when reload, while the old one is still available.
+    HELPER_EXPECT_SUCCESS(conf.do_reload(_MIN_OK_CONF"vhost a{play {queue_length 10;}}"));
+    SrsSharedPtr<SrsVhostConfig> c = conf.get_vhost_snapshot("a");
+    EXPECT_TRUE(a.get() != c.get());
+    EXPECT_EQ(10 * SRS_UTIME_SECONDS, c->queue_length);
+    EXPECT_TRUE(c->gop_cache);
+    EXPECT_EQ(5 * SRS_UTIME_SECONDS, a->queue_length);
+}
+
+VOID TEST(ConfigReloadTest, ReloadVhostSnapshotEnv)
+{
+    srs_error_t err = srs_success;
+
+    MockSrsReloadConfig conf;
+    HELPER_EXPECT_SUCCESS(conf.parse(_MIN_OK_CONF"vhost a{play {gop_cache on;}}"));
+
+    if (true) {
+        SrsSetEnvConfig(gop_cache, "SRS_VHOST_PLAY_GOP_CACHE", "off");
+
+        // The env overwrites are applied when building the snapshot.
+        SrsSharedPtr<SrsVhostConfig> a = conf.get_vhost_snapshot("a");
+        EXPECT_FALSE(a->gop_cache);
+        EXPECT_FALSE(conf.get_gop_cache("a"));
+    }
+
+    // The env changes take effect only after reload, while the getter reads env every time.
+    EXPECT_TRUE(conf.get_gop_cache("a"));
+    EXPECT_FALSE(conf.get_vhost_snapshot("a")->gop_cache);
+
+    HELPER_EXPECT_SUCCESS(conf.do_reload(_MIN_OK_CONF"vhost a{play {gop_cache on;}}"));
+    EXPECT_TRUE(conf.get_vhost_snapshot("a")->gop_cache);
+
+    // Also rebuilt when parse again.
+    SrsSetEnvConfig(gop_cache2, "SRS_VHOST_PLAY_GOP_CACHE", "off");
+    HELPER_EXPECT_SUCCESS(conf.parse(_MIN_OK_CONF"vhost a{play {gop_cache on;}}"));
+    EXPECT_FALSE(conf.get_vhost_snapshot("a")->gop_cache);
+}
@@ -16,8 +16,13 @@
 #include <srs_app_conn.hpp>
 
 #include <srs_utest_service.hpp>
+#include <srs_utest_config.hpp>
+#ifdef SRS_FFMPEG_FIT
+#include <srs_app_rtc_codec.hpp>
+#endif
 
 #include <vector>
+#include <set>
 using namespace std;
 
 VOID TEST(KernelRTCTest, RtpSTAPPayloadException)
@@ -480,6 +485,109 @@ VOID TEST(KernelRTCTest, ConnectionManagerTest)
     }
 }
 
+class MockDisposingCounter : public ISrsDisposingHandler
+{
+public:
+    int nn_disposing;
+    MockDisposingCounter() {
+        nn_disposing = 0;
+    }
+    virtual ~MockDisposingCounter() {
+    }
+    virtual void on_before_dispose(ISrsResource* c) {
+    }
+    virtual void on_disposing(ISrsResource* c) {
+        nn_disposing++;
+    }
+};
+
+VOID TEST(KernelRTCTest, ConnectionManagerDisposeAllZombies)
+{
+    MockDisposingCounter counter;
+
+    // Free all zombies when manager is freed, even more than a batch.
+    SrsResourceManager* manager = new SrsResourceManager("mgr");
+    manager->subscribe(&counter);
+
+    int nn = SRS_RESOURCE_DISPOSE_BATCH * 5 / 2;
+    for (int i = 0; i < nn; i++) {
+        MockSrsConnection* conn = new MockSrsConnection();
+        manager->add(conn);
+        manager->remove(conn);
+    }
+    EXPECT_EQ(nn, (int)manager->zombies_.size());
+
+    srs_freep(manager);
+    EXPECT_EQ(nn, counter.nn_disposing);
+}
+
+VOID TEST(KernelRTCTest, ConnectionManagerIndexTest)
+{
+    srs_error_t err;
+
+    // Remove lots of resources, in batches.
+    if (true) {
+        SrsResourceManager manager("mgr");
+        HELPER_EXPECT_SUCCESS(manager.start());
+
+        std::vector<ISrsResource*> conns;
+        for (int i = 0; i < 3 * SRS_RESOURCE_DISPOSE_BATCH; i++) {
+            MockSrsConnection* conn = new MockSrsConnection();
+            manager.add_with_id(srs_fmt("id-%d", i), conn);
+            manager.add_with_fast_id(i + 1, conn);
+            manager.add_with_name(srs_fmt("name-%d", i), conn);
+            conns.push_back(conn);
+        }
+        ASSERT_EQ(3 * SRS_RESOURCE_DISPOSE_BATCH, (int)manager.size());
+
+        // Remove the even ones, the others are still available.
+        for (int i = 0; i < (int)conns.size(); i += 2) {
+            manager.remove(conns.at(i));
+        }
+        for (int i = 0; i < 3; i++) {
+            srs_usleep(0);
+        }
+        ASSERT_EQ(3 * SRS_RESOURCE_DISPOSE_BATCH / 2, (int)manager.size());
+
+        for (int i = 0; i < (int)conns.size(); i++) {
+            ISrsResource* expect = (i % 2) ? conns.at(i) : NULL;
+            EXPECT_TRUE(expect == manager.find_by_id(srs_fmt("id-%d", i)));
+            EXPECT_TRUE(expect == manager.find_by_fast_id(i + 1));
+            EXPECT_TRUE(expect == manager.find_by_name(srs_fmt("name-%d", i)));
+        }
+
+        // All the left resources are accessible by index.
+        std::set<ISrsResource*> left;
+        for (int i = 0; i < (int)manager.size(); i++) {
+            left.insert(manager.at(i));
+        }
+        EXPECT_EQ(3 * SRS_RESOURCE_DISPOSE_BATCH / 2, (int)left.size());
+        EXPECT_TRUE(left.find(conns.at(1)) != left.end());
+        EXPECT_TRUE(left.find(conns.at(0)) == left.end());
+    }
+
+    // The id is overwrote by other resource, which should not be removed.
+    if (true) {
+        SrsResourceManager manager("mgr");
+        HELPER_EXPECT_SUCCESS(manager.start());
+
+        MockSrsConnection* conn0 = new MockSrsConnection();
+        MockSrsConnection* conn1 = new MockSrsConnection();
+        manager.add_with_id("100", conn0);
+        manager.add_with_name("srs", conn0);
+        manager.add_with_id("100", conn1);
+        manager.add_with_name("srs", conn1);
+        EXPECT_EQ(2, (int)manager.size());
+
+        manager.remove(conn0);
+        srs_usleep(0);
+        ASSERT_EQ(1, (int)manager.size());
+        EXPECT_TRUE(conn1 == manager.find_by_id("100"));
+        EXPECT_TRUE(conn1 == manager.find_by_name("srs"));
+        EXPECT_TRUE(conn1 == manager.at(0));
+    }
+}
+
 VOID TEST(KernelRTCTest, StringDumpHexTest)
 {
     // Typical normal case.
@@ -745,6 +853,140 @@ VOID TEST(KernelRTCTest, NACKFetchRTPPacket)
     }
 }
 
+VOID TEST(KernelRTCTest, NACKReceiverBitmap)
+{
+    // Insert, find and remove seqs in window.
+    if (true) {
+        SrsRtpRingBuffer rtp(1000);
+        SrsRtpNackForReceiver nack(&rtp, 1000 * 2 / 3);
+
+        nack.insert(100, 110);
+        EXPECT_EQ(10, (int)nack.size());
+        EXPECT_TRUE(nack.find(100) != NULL);
+        EXPECT_TRUE(nack.find(109) != NULL);
+        EXPECT_TRUE(nack.find(99) == NULL);
+        EXPECT_TRUE(nack.find(110) == NULL);
+
+        // Share the slot with seq 100, but not in window.
+        EXPECT_TRUE(nack.find(100 + 1024) == NULL);
+
+        nack.remove(105);
+        nack.remove(105);
+        nack.remove(200);
+        EXPECT_EQ(9, (int)nack.size());
+        EXPECT_TRUE(nack.find(105) == NULL);
+
+        // Insert again, should not duplicate.
+        nack.insert(108, 112);
+        EXPECT_EQ(11, (int)nack.size());
+    }
+
+    // Drop the seqs out of window.
+    if (true) {
+        SrsRtpRingBuffer rtp(1000);
+        SrsRtpNackForReceiver nack(&rtp, 1000 * 2 / 3);
+
+        nack.insert(0, 2);
+        nack.insert(1024, 1025);
+        EXPECT_EQ(2, (int)nack.size());
+        EXPECT_TRUE(nack.find(0) == NULL);
+        EXPECT_TRUE(nack.find(1) != NULL);
+        EXPECT_TRUE(nack.find(1024) != NULL);
+
+        // Too old to fit in window, ignore it.
+        nack.insert(0, 1);
+        EXPECT_TRUE(nack.find(0) == NULL);
+
+        // Jump far away, drop all.
+        nack.insert(30000, 30001);
+        EXPECT_EQ(1, (int)nack.size());
+        EXPECT_TRUE(nack.find(30000) != NULL);
+    }
+
+    // Report the seqs dropped out of window, like timeout.
+    if (true) {
+        SrsRtpRingBuffer rtp(1000);
+        SrsRtpNackForReceiver nack(&rtp, 1000 * 2 / 3);
+
+        nack.insert(10, 12);
+        nack.insert(1100, 1101);
+        EXPECT_EQ(1, (int)nack.size());
+        EXPECT_EQ(12, rtp.begin);
+
+        SrsRtcpNack seqs(0);
+        uint32_t timeout_nacks = 0;
+        nack.get_nack_seqs(seqs, timeout_nacks);
+        EXPECT_EQ(2, (int)timeout_nacks);
+
+        // Only count once.
+        nack.get_nack_seqs(seqs, timeout_nacks);
+        EXPECT_EQ(2, (int)timeout_nacks);
+
+        // The seqs in window are dropped before the ones never fit in window.
+        nack.insert(2000, 2000 + 1030);
+        EXPECT_EQ(1024, (int)nack.size());
+        EXPECT_TRUE(nack.find(1100) == NULL);
+        EXPECT_TRUE(nack.find(2006) != NULL);
+        EXPECT_EQ(2006, rtp.begin);
+
+        timeout_nacks = 0;
+        nack.get_nack_seqs(seqs, timeout_nacks);
+        EXPECT_EQ(7, (int)timeout_nacks);
+    }
+
+    // Clear the list when full.
+    if (true) {
+        SrsRtpRingBuffer rtp(100);
+        SrsRtpNackForReceiver nack(&rtp, 100 * 2 / 3);
+
+        nack.insert(0, 65);
+        nack.check_queue_size();
+        EXPECT_EQ(65, (int)nack.size());
+
+        nack.insert(65, 66);
+        nack.check_queue_size();
+        EXPECT_EQ(0, (int)nack.size());
+        EXPECT_TRUE(nack.find(0) == NULL);
+    }
+
+    // Generate NACK in seq order, wrap around.
+    if (true) {
+        SrsRtpRingBuffer rtp(100);
+        SrsRtpNackForReceiver nack(&rtp, 100 * 2 / 3);
+
+        nack.insert(65530, 4);
+        nack.remove(65535);
+        nack.remove(2);
+
+        // Not reach the first nack interval.
+        SrsRtcpNack seqs(0);
+        uint32_t timeout_nacks = 0;
+        nack.get_nack_seqs(seqs, timeout_nacks);
+        EXPECT_TRUE(seqs.empty());
+
+        // Wait for the first nack interval and the check interval.
+        srs_utime_t starttime = srs_get_system_time();
+        while (srs_update_system_time() - starttime < 30 * SRS_UTIME_MILLISECONDS) {
+            srs_usleep(10 * SRS_UTIME_MILLISECONDS);
+        }
+
+        nack.get_nack_seqs(seqs, timeout_nacks);
+        EXPECT_EQ(0, (int)timeout_nacks);
+
+        vector<uint16_t> sns = seqs.get_lost_sns();
+        ASSERT_EQ(8, (int)sns.size());
+        EXPECT_EQ(65530, sns.at(0));
+        EXPECT_EQ(65534, sns.at(4));
+        EXPECT_EQ(0, sns.at(5));
+        EXPECT_EQ(1, sns.at(6));
+        EXPECT_EQ(3, sns.at(7));
+
+        SrsRtpNackInfo* info = nack.find(65530);
+        ASSERT_TRUE(info != NULL);
+        EXPECT_EQ(1, info->req_nack_count_);
+    }
+}
+
 VOID TEST(KernelRTCTest, NACKEncode)
 {
     uint32_t ssrc = 123;
@@ -1197,6 +1439,202 @@ VOID TEST(KernelRTCTest, SrsRtcpNack)
     EXPECT_EQ(actual_lost_sn.size(), req_lost_sns.size());
 }
 
+// Encode all TWCC feedbacks, dumps the size and crc32 of each packet.
+string mock_twcc_feedbacks(SrsRtcpTWCC& twcc, int max_feedbacks = 16)
+{
+    stringstream ss;
+    for (int i = 0; i < max_feedbacks && twcc.need_feedback(); ++i) {
+        char buf[kMaxUDPDataSize];
+        SrsBuffer stream(buf, sizeof(buf));
+
+        twcc.set_feedback_count(i);
+        srs_error_t err = twcc.encode(&stream);
+        if (err != srs_success) {
+            ss << "err" << srs_error_code(err) << ",";
+            srs_freep(err);
+            break;
+        }
+
+        ss << stream.pos() << ":" << hex << srs_crc32_ieee(buf, stream.pos()) << dec << ",";
+    }
+    return ss.str();
+}
+
+VOID TEST(KernelRTCTest, TWCCEncodeFeedback)
+{
+    srs_error_t err = srs_success;
+    srs_utime_t base = 1000 * SRS_UTIME_SECONDS;
+
+    // All received, small deltas, run length chunk.
+    if (true) {
+        SrsRtcpTWCC twcc(0x0A);
+        twcc.set_media_ssrc(0x0B);
+        for (int i = 0; i < 20; i++) {
+            HELPER_EXPECT_SUCCESS(twcc.recv_packet(100 + i, base + i * 1000));
+        }
+        HELPER_EXPECT_FAILED(twcc.recv_packet(100, base));
+        EXPECT_STREQ("44:fdc53d8e,", mock_twcc_feedbacks(twcc).c_str());
+        EXPECT_FALSE(twcc.need_feedback());
+
+        // The next feedback.
+        for (int i = 20; i < 30; i++) {
+            HELPER_EXPECT_SUCCESS(twcc.recv_packet(100 + i, base + i * 1000));
+        }
+        EXPECT_STREQ("32:dd6c9c5b,", mock_twcc_feedbacks(twcc).c_str());
+    }
+
+    // Lost packets, large and negative deltas, two bit chunk.
+    if (true) {
+        SrsRtcpTWCC twcc(0x0A);
+        twcc.set_media_ssrc(0x0B);
+        uint16_t sns[] = {1, 2, 5, 6, 9, 10, 11, 30, 31, 32};
+        srs_utime_t tss[] = {0, 500, 120000, 119000, 125000, 125250, 126000, 200000, 199000, 260000};
+        for (int i = 0; i < (int)(sizeof(sns) / sizeof(uint16_t)); i++) {
+            HELPER_EXPECT_SUCCESS(twcc.recv_packet(sns[i], base + tss[i]));
+        }
+        EXPECT_STREQ("44:4049fb1a,", mock_twcc_feedbacks(twcc).c_str());
+    }
+
+    // Out of order and sequence wrap around.
+    if (true) {
+        SrsRtcpTWCC twcc(0x0A);
+        twcc.set_media_ssrc(0x0B);
+        uint16_t sns[] = {65533, 65530, 65531, 65535, 1, 0, 4, 3, 7};
+        for (int i = 0; i < (int)(sizeof(sns) / sizeof(uint16_t)); i++) {
+            HELPER_EXPECT_SUCCESS(twcc.recv_packet(sns[i], base + i * 3000));
+        }
+        EXPECT_STREQ("36:b8537dc8,", mock_twcc_feedbacks(twcc).c_str());
+    }
+
+    // The delta exceeds 16bits.
+    if (true) {
+        SrsRtcpTWCC twcc(0x0A);
+        HELPER_EXPECT_SUCCESS(twcc.recv_packet(10, base));
+        HELPER_EXPECT_SUCCESS(twcc.recv_packet(11, base + 10 * SRS_UTIME_SECONDS));
+        EXPECT_STREQ("err5007,", mock_twcc_feedbacks(twcc).c_str());
+        EXPECT_FALSE(twcc.need_feedback());
+    }
+
+    // Many packets, with lost packets and mixed deltas.
+    if (true) {
+        SrsRtcpTWCC twcc(0x0A);
+        twcc.set_media_ssrc(0x0B);
+        for (int i = 0; i < 300; i++) {
+            if ((i % 7) == 3 || (i % 31) == 5) {
+                continue;
+            }
+            srs_utime_t ts = base + i * 1000 + (i % 3) * 300 + ((i % 101) == 0 ? 80000 : 0);
+            HELPER_EXPECT_SUCCESS(twcc.recv_packet(1000 + i, ts));
+        }
+        EXPECT_STREQ("320:86ca2a5,", mock_twcc_feedbacks(twcc).c_str());
+    }
+}
+
+VOID TEST(KernelRTCTest, TWCCEncodeMultipleFeedbacks)
+{
+    srs_error_t err = srs_success;
+    srs_utime_t base = 1000 * SRS_UTIME_SECONDS;
+
+    // Many packets, split to multiple feedbacks, with late packets.
+    if (true) {
+        SrsRtcpTWCC twcc(0x0A);
+        twcc.set_media_ssrc(0x0B);
+        for (int i = 0; i < 2000; i++) {
+            if ((i % 7) == 3) {
+                continue;
+            }
+            HELPER_EXPECT_SUCCESS(twcc.recv_packet(1000 + i, base + i * 1000 + (i % 3) * 300));
+        }
+
+        int nn_packets = 0;
+        uint16_t next_sn = 1000;
+        for (int i = 0; i < 16 && twcc.need_feedback(); ++i) {
+            char buf[kMaxUDPDataSize];
+            SrsBuffer stream(buf, sizeof(buf));
+            HELPER_ASSERT_SUCCESS(twcc.encode(&stream));
+            EXPECT_LE(stream.pos(), kMaxUDPDataSize);
+            EXPECT_EQ(0, stream.pos() % 4);
+
+            // The base sn follows the last feedback.
+            SrsBuffer b(buf, stream.pos());
+            b.skip(12);
+            EXPECT_EQ(next_sn, b.read_2bytes());
+            uint16_t count = b.read_2bytes();
+            next_sn += count;
+            nn_packets += count;
+
+            // The late packet, before the next base, should be ignored.
+            if (i == 0) {
+                HELPER_EXPECT_SUCCESS(twcc.recv_packet(1003, base + 2000 * 1000));
+            }
+        }
+        // The status count includes the lost packets.
+        EXPECT_EQ(2000, nn_packets);
+        EXPECT_FALSE(twcc.need_feedback());
+    }
+
+    // The packets out of window.
+    if (true) {
+        SrsRtcpTWCC twcc(0x0A);
+        HELPER_EXPECT_SUCCESS(twcc.recv_packet(10, base));
+        HELPER_EXPECT_SUCCESS(twcc.recv_packet(10 + kTwccFbRecvWindow, base + 1000));
+        HELPER_EXPECT_FAILED(twcc.recv_packet(5, base));
+        EXPECT_STREQ("24:f5417ba2,", mock_twcc_feedbacks(twcc).c_str());
+    }
+}
+
+VOID TEST(KernelRTCTest, TWCCEncodeCost)
+{
+    srs_error_t err = srs_success;
+    srs_utime_t base = 1000 * SRS_UTIME_SECONDS;
+
+    // About 100 packets per feedback, for 8Mbps video with 100ms feedback interval.
+    SrsRtcpTWCC twcc(0x0A);
+    srs_utime_t cost = 0;
+    for (int i = 0; i < 1000; i++) {
+        for (int j = 0; j < 100; j++) {
+            int k = i * 100 + j;
+            if ((k % 37) == 3) {
+                continue;
+            }
+            HELPER_EXPECT_SUCCESS(twcc.recv_packet((uint16_t)k, base + k * 1000 + (k % 3) * 300));
+        }
+
+        char buf[kMaxUDPDataSize];
+        SrsBuffer stream(buf, sizeof(buf));
+
+        // Only measure the encode, which is done when feedback.
+        srs_utime_t starttime = srs_update_system_time();
+        HELPER_ASSERT_SUCCESS(twcc.encode(&stream));
+        cost += srs_update_system_time() - starttime;
+
+        EXPECT_FALSE(twcc.need_feedback());
+    }
+    srs_trace("TWCC encode 100 packets, cost %dns/feedback", (int)(cost * 1000 / 1000));
+
+    // Loose bound to avoid flaky, it costs less than 20us per feedback for debug build with ASAN.
+    EXPECT_LT(cost, 1000 * SRS_UTIME_MILLISECONDS);
+}
+
+VOID TEST(KernelRTCTest, TWCCChunksOverflow)
+{
+    srs_error_t err = srs_success;
+
+    // Never truncate the chunks or deltas silently, which are limited by the packet size.
+    SrsRtcpTWCC twcc(0x0A);
+    for (int i = 0; i < kTwccFbMaxChunks; i++) {
+        HELPER_EXPECT_SUCCESS(twcc.add_packet_chuck(0x2001));
+    }
+    HELPER_EXPECT_FAILED(twcc.add_packet_chuck(0x2001));
+    EXPECT_EQ(kTwccFbMaxChunks, (int)twcc.get_packet_chucks().size());
+
+    for (int i = 0; i < kTwccFbMaxDeltas; i++) {
+        HELPER_EXPECT_SUCCESS(twcc.add_recv_delta(1));
+    }
+    HELPER_EXPECT_FAILED(twcc.add_recv_delta(1));
+    EXPECT_EQ(kTwccFbMaxDeltas, (int)twcc.get_recv_deltas().size());
+}
+
 VOID TEST(KernelRTCTest, SyncTimestampBySenderReportDuplicated)
 {
     SrsRtcConnection s(NULL, SrsContextId()); 
@@ -1365,3 +1803,350 @@ VOID TEST(KernelRTCTest, JitterSequence)
     EXPECT_EQ((uint32_t)11, jitter.correct(11));
 }
 
+
+VOID TEST(KernelRTCTest, RtcGopCache)
+{
+    srs_error_t err;
+
+    SrsSetEnvConfig(gop_cache, "SRS_VHOST_RTC_GOP_CACHE", "on");
+
+    SrsRequest req;
+    req.vhost = "test.com";
+    req.app = "live";
+    req.stream = "gop";
+
+    SrsSharedPtr<SrsRtcSource> source(new SrsRtcSource());
+    HELPER_EXPECT_SUCCESS(source->initialize(&req));
+    HELPER_EXPECT_SUCCESS(source->on_publish());
+
+    // The packets before the first keyframe are ignored.
+    uint32_t ts[] = {100, 200, 200, 200, 300, 400, 400, 500};
+    SrsAvcNaluType nt[] = {SrsAvcNaluTypeNonIDR, SrsAvcNaluTypeSPS, SrsAvcNaluTypePPS, SrsAvcNaluTypeIDR,
+        SrsAvcNaluTypeNonIDR, SrsAvcNaluTypeIDR, SrsAvcNaluTypeIDR, SrsAvcNaluTypeNonIDR};
+    for (int i = 0; i < 5; i++) {
+        SrsUniquePtr<SrsRtpPacket> pkt(new SrsRtpPacket());
+        pkt->frame_type = SrsFrameTypeVideo;
+        pkt->nalu_type = nt[i];
+        pkt->header.set_timestamp(ts[i]);
+        HELPER_EXPECT_SUCCESS(source->on_rtp(pkt.get()));
+    }
+
+    // Prime new consumer from the keyframe, with SPS/PPS.
+    if (true) {
+        SrsRtcConsumer* consumer_raw = NULL;
+        HELPER_EXPECT_SUCCESS(source->create_consumer(consumer_raw));
+        SrsUniquePtr<SrsRtcConsumer> consumer(consumer_raw);
+        HELPER_EXPECT_SUCCESS(source->consumer_dumps(consumer.get()));
+
+        int count = 0;
+        for (SrsRtpPacket* pkt = NULL; ; count++) {
+            consumer->dump_packet(&pkt);
+            if (!pkt) break;
+            if (count == 0) {
+                EXPECT_EQ(SrsAvcNaluTypeSPS, pkt->nalu_type);
+            }
+            srs_freep(pkt);
+        }
+        EXPECT_EQ(4, count);
+    }
+
+    // Restart the cache when got a new keyframe, which is several packets.
+    for (int i = 5; i < 8; i++) {
+        SrsUniquePtr<SrsRtpPacket> pkt(new SrsRtpPacket());
+        pkt->frame_type = SrsFrameTypeVideo;
+        pkt->nalu_type = nt[i];
+        pkt->header.set_timestamp(ts[i]);
+        HELPER_EXPECT_SUCCESS(source->on_rtp(pkt.get()));
+    }
+
+    if (true) {
+        SrsRtcConsumer* consumer_raw = NULL;
+        HELPER_EXPECT_SUCCESS(source->create_consumer(consumer_raw));
+        SrsUniquePtr<SrsRtcConsumer> consumer(consumer_raw);
+        HELPER_EXPECT_SUCCESS(source->consumer_dumps(consumer.get()));
+
+        int count = 0;
+        for (SrsRtpPacket* pkt = NULL; ; count++) {
+            consumer->dump_packet(&pkt);
+            if (!pkt) break;
+            srs_freep(pkt);
+        }
+        EXPECT_EQ(3, count);
+    }
+
+    // Drop the cache when unpublish, never deliver the stale packets to new players.
+    source->on_unpublish();
+    EXPECT_TRUE(source->gop_cache_.empty());
+    EXPECT_EQ(0, source->gop_cache_size_);
+}
+
+#ifdef SRS_FFMPEG_FIT
+class MockRtcStreamBridge : public ISrsStreamBridge
+{
+public:
+    std::vector<SrsSharedPtrMessage*> msgs;
+public:
+    MockRtcStreamBridge() {
+    }
+    virtual ~MockRtcStreamBridge() {
+        for (int i = 0; i < (int)msgs.size(); i++) {
+            srs_freep(msgs[i]);
+        }
+    }
+public:
+    virtual srs_error_t initialize(SrsRequest* r) {
+        return srs_success;
+    }
+    virtual srs_error_t on_publish() {
+        return srs_success;
+    }
+    virtual srs_error_t on_frame(SrsSharedPtrMessage* frame) {
+        msgs.push_back(frame->copy());
+        return srs_success;
+    }
+    virtual void on_unpublish() {
+    }
+};
+
+VOID TEST(KernelRTCTest, OpusPassthroughChannels)
+{
+    srs_error_t err;
+
+    // The channels of OpusHead is the stereo flag of TOC.
+    uint8_t tocs[] = {0xf8, 0xfc};
+    int channels[] = {1, 2};
+    for (int i = 0; i < 2; i++) {
+        MockRtcStreamBridge bridge;
+        SrsRtcFrameBuilder builder(&bridge);
+        builder.keep_opus_ = true;
+
+        char data[] = {(char)tocs[i], (char)0xff, (char)0xfe};
+        SrsRtpPacket pkt;
+        SrsRtpRawPayload* raw = new SrsRtpRawPayload();
+        raw->payload = data;
+        raw->nn_payload = sizeof(data);
+        pkt.set_payload(raw, SrsRtspPacketPayloadTypeRaw);
+
+        HELPER_EXPECT_SUCCESS(builder.passthrough_audio(&pkt));
+        ASSERT_EQ(2, (int)bridge.msgs.size());
+
+        // The ExHeader(5B), then OpusHead(8B), version(1B) and channels(1B).
+        SrsSharedPtrMessage* sh = bridge.msgs.at(0);
+        ASSERT_EQ(5 + 19, sh->size);
+        EXPECT_EQ(0, memcmp(sh->payload + 5, "OpusHead", 8));
+        EXPECT_EQ(channels[i], (int)(uint8_t)sh->payload[5 + 9]);
+
+        // Parse the channels by format.
+        SrsFormat f;
+        HELPER_ASSERT_SUCCESS(f.initialize());
+        HELPER_ASSERT_SUCCESS(f.on_audio(0, sh->payload, sh->size));
+        EXPECT_EQ(channels[i], f.acodec->aac_channels);
+    }
+}
+
+class MockAudioTranscodeHandler : public ISrsAudioTranscodeHandler
+{
+public:
+    std::vector<int64_t> dts;
+    int nn_errors;
+public:
+    MockAudioTranscodeHandler() {
+        nn_errors = 0;
+    }
+    virtual ~MockAudioTranscodeHandler() {
+    }
+public:
+    virtual srs_error_t on_audio_transcoded(SrsAudioFrame* in, std::vector<SrsAudioFrame*>& outs) {
+        dts.push_back(in->dts);
+        return srs_success;
+    }
+};
+
+// Use the workers as global object, restore when test done.
+class MockAudioTranscodeWorkersGuard
+{
+private:
+    SrsAudioTranscodeWorkers* origin_;
+public:
+    MockAudioTranscodeWorkersGuard(SrsAudioTranscodeWorkers* workers) {
+        origin_ = _srs_audio_transcode_workers;
+        _srs_audio_transcode_workers = workers;
+    }
+    virtual ~MockAudioTranscodeWorkersGuard() {
+        _srs_audio_transcode_workers = origin_;
+    }
+};
+
+// Mock the started workers, without the worker threads, which are driven by utest.
+void mock_audio_transcode_workers_start(SrsAudioTranscodeWorkers* workers, int nn, int max_queue)
+{
+    workers->nn_workers_ = nn;
+    workers->nn_running_ = nn;
+    workers->max_queue_ = max_queue;
+}
+
+// Mock the workers quit, like the worker threads when stopping.
+void mock_audio_transcode_workers_quit(SrsAudioTranscodeWorkers* workers)
+{
+    workers->stopping_ = true;
+
+    SrsAudioTranscodeQueue* queue = NULL;
+    SrsAudioTranscodeTask* task = NULL;
+    while (workers->nn_running_ > 0) {
+        EXPECT_FALSE(workers->wait_task(&queue, &task));
+    }
+}
+
+// The opus packet with TOC only, CELT FB 20ms stereo.
+srs_error_t mock_audio_transcode_opus(SrsAsyncAudioTranscoder* codec, int64_t dts)
+{
+    srs_error_t err = srs_success;
+
+    char opus[] = {(char)0xfc};
+    SrsAudioFrame frame;
+    frame.dts = dts;
+    if ((err = frame.add_sample(opus, sizeof(opus))) != srs_success) {
+        return srs_error_wrap(err, "add sample");
+    }
+
+    return codec->transcode(&frame);
+}
+
+VOID TEST(AudioTranscodeWorkersTest, SubmitAndResult)
+{
+    srs_error_t err;
+
+    SrsAudioTranscodeWorkers workers;
+    MockAudioTranscodeWorkersGuard guard(&workers);
+    mock_audio_transcode_workers_start(&workers, 2, 16);
+    EXPECT_TRUE(workers.enabled());
+
+    MockAudioTranscodeHandler handler;
+    if (true) {
+        SrsAsyncAudioTranscoder codec(&handler);
+        HELPER_ASSERT_SUCCESS(codec.initialize(SrsAudioCodecIdOpus, SrsAudioCodecIdAAC, 2, 44100, 48000));
+        EXPECT_TRUE(codec.queue_ != NULL);
+
+        for (int i = 0; i < 10; i++) {
+            HELPER_EXPECT_SUCCESS(mock_audio_transcode_opus(&codec, i * 20));
+        }
+
+        // The queue is scheduled once, and transcoded by one worker at a time.
+        EXPECT_EQ(1, (int)workers.ready_.size());
+        EXPECT_EQ(10, (int)codec.queue_->inputs.size());
+
+        SrsAudioTranscodeQueue* queue = NULL;
+        SrsAudioTranscodeTask* task = NULL;
+        while (!workers.ready_.empty()) {
+            ASSERT_TRUE(workers.wait_task(&queue, &task));
+            EXPECT_TRUE(queue == codec.queue_);
+            workers.do_transcode(queue, task);
+        }
+        EXPECT_FALSE(codec.queue_->scheduled);
+        EXPECT_EQ(1, (int)workers.done_.size());
+
+        // Consume the results in order, by hybrid thread.
+        HELPER_EXPECT_SUCCESS(workers.on_timer(20 * SRS_UTIME_MILLISECONDS));
+        EXPECT_TRUE(workers.done_.empty());
+    }
+
+    ASSERT_EQ(10, (int)handler.dts.size());
+    for (int i = 0; i < 10; i++) {
+        EXPECT_EQ(i * 20, handler.dts.at(i));
+    }
+
+    // Drop the frame if queue is full.
+    if (true) {
+        workers.max_queue_ = 2;
+
+        SrsAsyncAudioTranscoder codec(&handler);
+        HELPER_ASSERT_SUCCESS(codec.initialize(SrsAudioCodecIdOpus, SrsAudioCodecIdAAC, 2, 44100, 48000));
+        for (int i = 0; i < 3; i++) {
+            HELPER_EXPECT_SUCCESS(mock_audio_transcode_opus(&codec, i * 20));
+        }
+        EXPECT_EQ(2, (int)codec.queue_->inputs.size());
+        EXPECT_EQ(1, codec.queue_->nn_dropped);
+    }
+
+    mock_audio_transcode_workers_quit(&workers);
+}
+
+VOID TEST(AudioTranscodeWorkersTest, Shutdown)
+{
+    srs_error_t err;
+
+    // Stop is ignored if not started.
+    if (true) {
+        SrsAudioTranscodeWorkers workers;
+        HELPER_ASSERT_SUCCESS(workers.initialize(0, 16));
+        EXPECT_FALSE(workers.enabled());
+        workers.stop();
+    }
+
+    // The workers quit when stopping, and reject the new frames.
+    if (true) {
+        SrsAudioTranscodeWorkers workers;
+        MockAudioTranscodeWorkersGuard guard(&workers);
+        mock_audio_transcode_workers_start(&workers, 3, 16);
+        EXPECT_EQ(3, workers.nn_running_);
+
+        MockAudioTranscodeHandler handler;
+        SrsAsyncAudioTranscoder codec(&handler);
+        HELPER_ASSERT_SUCCESS(codec.initialize(SrsAudioCodecIdOpus, SrsAudioCodecIdAAC, 2, 44100, 48000));
+
+        mock_audio_transcode_workers_quit(&workers);
+        EXPECT_EQ(0, workers.nn_running_);
+
+        workers.stop();
+        EXPECT_FALSE(workers.enabled());
+
+        SrsAudioFrame frame;
+        SrsAudioTranscodeTask* task = new SrsAudioTranscodeTask(&frame);
+        EXPECT_FALSE(workers.push(codec.queue_, task));
+        srs_freep(task);
+
+        // Stop again is ignored.
+        workers.stop();
+    }
+
+    // The worker frees the queue, if the owner is freed when transcoding.
+    if (true) {
+        SrsAudioTranscodeWorkers workers;
+        MockAudioTranscodeWorkersGuard guard(&workers);
+        mock_audio_transcode_workers_start(&workers, 1, 16);
+
+        MockAudioTranscodeHandler handler;
+        SrsAsyncAudioTranscoder* codec = new SrsAsyncAudioTranscoder(&handler);
+        HELPER_ASSERT_SUCCESS(codec->initialize(SrsAudioCodecIdOpus, SrsAudioCodecIdAAC, 2, 44100, 48000));
+        HELPER_EXPECT_SUCCESS(mock_audio_transcode_opus(codec, 0));
+
+        SrsAudioTranscodeQueue* queue = NULL;
+        SrsAudioTranscodeTask* task = NULL;
+        ASSERT_TRUE(workers.wait_task(&queue, &task));
+
+        srs_freep(codec);
+        EXPECT_TRUE(queue->owner == NULL);
+
+        workers.do_transcode(queue, task);
+        EXPECT_TRUE(workers.done_.empty());
+        EXPECT_TRUE(handler.dts.empty());
+
+        mock_audio_transcode_workers_quit(&workers);
+    }
+
+    // The transcoder frees the queue itself, when workers is disposed.
+    if (true) {
+        SrsAudioTranscodeWorkers* workers = new SrsAudioTranscodeWorkers();
+        MockAudioTranscodeWorkersGuard guard(workers);
+        mock_audio_transcode_workers_start(workers, 1, 16);
+
+        MockAudioTranscodeHandler handler;
+        SrsAsyncAudioTranscoder codec(&handler);
+        HELPER_ASSERT_SUCCESS(codec.initialize(SrsAudioCodecIdOpus, SrsAudioCodecIdAAC, 2, 44100, 48000));
+
+        mock_audio_transcode_workers_quit(workers);
+        srs_freep(workers);
+        _srs_audio_transcode_workers = NULL;
+    }
+}
+#endif
@@ -474,6 +474,153 @@ VOID TEST(TCPServerTest, WritevIOVC)
 	}
 }
 
+VOID TEST(TCPServerTest, WritevZerocopy)
+{
+	srs_error_t err;
+
+	// Kernel might notify the completions out of order.
+	if (true) {
+		SrsStSocket skt;
+		skt.zerocopy_complete(2, 3);
+		EXPECT_EQ(0, (int)skt.zc_completed_);
+		EXPECT_EQ(1, (int)skt.zc_pending_.size());
+
+		skt.zerocopy_complete(0, 1);
+		EXPECT_EQ(4, (int)skt.zc_completed_);
+		EXPECT_TRUE(skt.zc_pending_.empty());
+	}
+
+	// The sequence wraps around.
+	if (true) {
+		SrsStSocket skt;
+		skt.zc_completed_ = 0xfffffffe;
+		skt.zerocopy_complete(0xfffffffe, 1);
+		EXPECT_EQ(2, (int)skt.zc_completed_);
+	}
+
+	// The message is retained until the send completes.
+	if (true) {
+		MockTcpHandler h;
+        SrsTcpListener l(&h);
+        l.set_endpoint(_srs_tmp_host, _srs_tmp_port);
+		HELPER_EXPECT_SUCCESS(l.listen());
+
+		SrsTcpClient c(_srs_tmp_host, _srs_tmp_port, _srs_tmp_timeout);
+		HELPER_EXPECT_SUCCESS(c.connect());
+
+		srs_usleep(30 * SRS_UTIME_MILLISECONDS);
+#ifdef SRS_OSX
+		ASSERT_TRUE(h.fd != NULL);
+#endif
+        SrsStSocket skt(h.fd);
+		HELPER_EXPECT_SUCCESS(skt.set_zerocopy(1024));
+
+		SrsCommonMessage pkt;
+		pkt.header.initialize_video(64 * 1024, 0, 1);
+		pkt.create_payload(64 * 1024);
+		pkt.size = 64 * 1024;
+		memset(pkt.payload, 'x', pkt.size);
+
+		SrsSharedPtrMessage* msg = new SrsSharedPtrMessage();
+		HELPER_EXPECT_SUCCESS(msg->create(&pkt));
+
+		iovec iovs[2];
+		iovs[0].iov_base = (void*)"SRS";
+		iovs[0].iov_len = 3;
+		iovs[1].iov_base = msg->payload;
+		iovs[1].iov_len = msg->size;
+
+		ssize_t nn = 0;
+		HELPER_EXPECT_SUCCESS(skt.writev(iovs, 2, &nn));
+		EXPECT_EQ(3 + 64 * 1024, nn);
+		EXPECT_EQ(1, (int)skt.zc_next_);
+
+		// The small iov is copied, and retained with message.
+		skt.zerocopy_free(msg);
+		EXPECT_TRUE(skt.zc_retained_.size() <= 2);
+
+		std::vector<char> buf(3 + 64 * 1024);
+		HELPER_EXPECT_SUCCESS(c.read_fully(&buf[0], buf.size(), NULL));
+		EXPECT_EQ(0, memcmp(&buf[0], "SRS", 3));
+		EXPECT_EQ('x', buf[3]);
+		EXPECT_EQ('x', buf[buf.size() - 1]);
+
+		// Read by zerocopy socket, which also drains the completions.
+		HELPER_EXPECT_SUCCESS(c.write((void*)"Hello", 5, NULL));
+		char rbuf[16] = {0};
+		HELPER_EXPECT_SUCCESS(skt.read(rbuf, 5, NULL));
+		EXPECT_STREQ(rbuf, "Hello");
+
+		srs_usleep(10 * SRS_UTIME_MILLISECONDS);
+		skt.zerocopy_reap();
+		EXPECT_EQ(1, (int)skt.zc_completed_);
+		EXPECT_TRUE(skt.zc_retained_.empty());
+
+		// Kernel copies for loopback, so we fallback to copy.
+		EXPECT_TRUE(skt.zc_copied_);
+	}
+
+	// Abort the connection when destroy the socket with sends in flight.
+	if (true) {
+		MockTcpHandler h;
+        SrsTcpListener l(&h);
+        l.set_endpoint(_srs_tmp_host, _srs_tmp_port);
+		HELPER_EXPECT_SUCCESS(l.listen());
+
+		SrsTcpClient c(_srs_tmp_host, _srs_tmp_port, _srs_tmp_timeout);
+		HELPER_EXPECT_SUCCESS(c.connect());
+
+		srs_usleep(30 * SRS_UTIME_MILLISECONDS);
+#ifdef SRS_OSX
+		ASSERT_TRUE(h.fd != NULL);
+#endif
+		int fd = srs_netfd_fileno(h.fd);
+
+		SrsStSocket* skt = new SrsStSocket(h.fd);
+		HELPER_EXPECT_SUCCESS(skt->set_zerocopy(1024));
+
+		// Mock a send in flight, which is never completed.
+		skt->zc_next_ = 1;
+		SrsSharedPtrMessage* msg = new SrsSharedPtrMessage();
+		skt->zerocopy_free(msg);
+		EXPECT_EQ(1, (int)skt->zc_retained_.size());
+
+		srs_freep(skt);
+
+		linger v;
+		socklen_t nb_v = sizeof(v);
+		EXPECT_EQ(0, getsockopt(fd, SOL_SOCKET, SO_LINGER, &v, &nb_v));
+		EXPECT_EQ(1, v.l_onoff);
+		EXPECT_EQ(0, v.l_linger);
+	}
+
+	// Close gracefully when all sends are completed.
+	if (true) {
+		MockTcpHandler h;
+        SrsTcpListener l(&h);
+        l.set_endpoint(_srs_tmp_host, _srs_tmp_port);
+		HELPER_EXPECT_SUCCESS(l.listen());
+
+		SrsTcpClient c(_srs_tmp_host, _srs_tmp_port, _srs_tmp_timeout);
+		HELPER_EXPECT_SUCCESS(c.connect());
+
+		srs_usleep(30 * SRS_UTIME_MILLISECONDS);
+#ifdef SRS_OSX
+		ASSERT_TRUE(h.fd != NULL);
+#endif
+		int fd = srs_netfd_fileno(h.fd);
+
+		SrsStSocket* skt = new SrsStSocket(h.fd);
+		HELPER_EXPECT_SUCCESS(skt->set_zerocopy(1024));
+		srs_freep(skt);
+
+		linger v;
+		socklen_t nb_v = sizeof(v);
+		EXPECT_EQ(0, getsockopt(fd, SOL_SOCKET, SO_LINGER, &v, &nb_v));
+		EXPECT_EQ(0, v.l_onoff);
+	}
+}
+
 VOID TEST(HTTPServerTest, MessageConnection)
 {
     srs_error_t err;
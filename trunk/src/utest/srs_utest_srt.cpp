@@ -11,7 +11,9 @@
 #include <srs_protocol_rtmp_stack.hpp>
 #include <srs_app_srt_utility.hpp>
 #include <srs_app_srt_server.hpp>
+#include <srs_app_srt_source.hpp>
 #include <srs_core_autofree.hpp>
+#include <srs_utest_reload.hpp>
 
 #include <sstream>
 #include <vector>
@@ -549,6 +551,188 @@ VOID TEST(ServiceSRTTest, Encrypt)
     }
 }
 
+VOID TEST(ServiceSRTTest, FastStartKeyframe)
+{
+    // The video PES with random access indicator.
+    uint8_t k[SRS_TS_PACKET_SIZE];
+    memset(k, 0xff, sizeof(k));
+    uint8_t kh[] = {0x47, 0x41, 0x00, 0x30, 0x07, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xe0};
+    memcpy(k, kh, sizeof(kh));
+    EXPECT_TRUE(srs_srt_packet_is_keyframe((char*)k, sizeof(k)));
+    EXPECT_FALSE(srs_srt_packet_has_pat((char*)k, sizeof(k)));
+
+    // The audio PES with random access indicator.
+    k[15] = 0xc0;
+    EXPECT_FALSE(srs_srt_packet_is_keyframe((char*)k, sizeof(k)));
+
+    // The video PES without random access indicator.
+    k[15] = 0xe0; k[5] = 0x10;
+    EXPECT_FALSE(srs_srt_packet_is_keyframe((char*)k, sizeof(k)));
+
+    // Not a complete TS packet.
+    k[5] = 0x50;
+    EXPECT_FALSE(srs_srt_packet_is_keyframe((char*)k, sizeof(k) - 1));
+
+    // The PAT.
+    uint8_t pat[SRS_TS_PACKET_SIZE];
+    memset(pat, 0xff, sizeof(pat));
+    uint8_t ph[] = {0x47, 0x40, 0x00, 0x10, 0x00};
+    memcpy(pat, ph, sizeof(ph));
+    EXPECT_TRUE(srs_srt_packet_has_pat((char*)pat, sizeof(pat)));
+    EXPECT_FALSE(srs_srt_packet_is_keyframe((char*)pat, sizeof(pat)));
+}
+
+// Build the TS packets of PAT, PMT, video keyframe and video frame, the PMT PID is 0x100 and video PID is 0x101.
+static void mock_srt_ts_packet(uint8_t* p, int type)
+{
+    memset(p, 0xff, SRS_TS_PACKET_SIZE);
+    if (type == 0) {
+        uint8_t h[] = {0x47, 0x40, 0x00, 0x10, 0x00, 0x00, 0xb0, 0x0d, 0x00, 0x01, 0xc1, 0x00, 0x00, 0x00, 0x01, 0xe1, 0x00,
+            0x00, 0x00, 0x00, 0x00};
+        memcpy(p, h, sizeof(h));
+    } else if (type == 1) {
+        uint8_t h[] = {0x47, 0x41, 0x00, 0x10, 0x00, 0x02, 0xb0, 0x12, 0x00, 0x01, 0xc1, 0x00, 0x00, 0xe1, 0x01, 0xf0, 0x00};
+        memcpy(p, h, sizeof(h));
+    } else if (type == 2) {
+        uint8_t h[] = {0x47, 0x41, 0x01, 0x30, 0x07, 0x50, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xe0};
+        memcpy(p, h, sizeof(h));
+    } else {
+        uint8_t h[] = {0x47, 0x01, 0x01, 0x10};
+        memcpy(p, h, sizeof(h));
+    }
+}
+
+VOID TEST(ServiceSRTTest, FastStartPmtPid)
+{
+    uint8_t p[SRS_TS_PACKET_SIZE * 2];
+
+    mock_srt_ts_packet(p, 0);
+    EXPECT_EQ(0x100, srs_srt_packet_pmt_pid((char*)p, SRS_TS_PACKET_SIZE));
+    EXPECT_FALSE(srs_srt_packet_has_pid((char*)p, SRS_TS_PACKET_SIZE, 0x100));
+
+    // The PAT with adaptation field.
+    uint8_t h[] = {0x47, 0x40, 0x00, 0x30, 0x01, 0x00, 0x00, 0x00, 0xb0, 0x0d, 0x00, 0x01, 0xc1, 0x00, 0x00, 0x00, 0x01,
+        0xe2, 0x00, 0x00, 0x00, 0x00, 0x00};
+    memcpy(p, h, sizeof(h));
+    EXPECT_EQ(0x200, srs_srt_packet_pmt_pid((char*)p, SRS_TS_PACKET_SIZE));
+
+    // The PMT is not a PAT.
+    mock_srt_ts_packet(p, 1);
+    EXPECT_EQ(-1, srs_srt_packet_pmt_pid((char*)p, SRS_TS_PACKET_SIZE));
+    EXPECT_TRUE(srs_srt_packet_has_pid((char*)p, SRS_TS_PACKET_SIZE, 0x100));
+
+    // The PAT in the second TS packet.
+    mock_srt_ts_packet(p + SRS_TS_PACKET_SIZE, 0);
+    EXPECT_EQ(0x100, srs_srt_packet_pmt_pid((char*)p, sizeof(p)));
+}
+
+VOID TEST(ServiceSRTTest, FastStartDumpPatPmt)
+{
+    srs_error_t err = srs_success;
+
+    MockSrsReloadConfig conf;
+    HELPER_ASSERT_SUCCESS(conf.parse(_MIN_OK_CONF "vhost __defaultVhost__ {play {fast_start on;}}"));
+    MockSrsConfigGuard guard(&conf);
+
+    SrsRequest req;
+    req.vhost = "__defaultVhost__";
+    req.app = "live";
+    req.stream = "livestream";
+
+    uint8_t pat[SRS_TS_PACKET_SIZE], pmt[SRS_TS_PACKET_SIZE], key[SRS_TS_PACKET_SIZE], frame[SRS_TS_PACKET_SIZE];
+    mock_srt_ts_packet(pat, 0);
+    mock_srt_ts_packet(pmt, 1);
+    mock_srt_ts_packet(key, 2);
+    mock_srt_ts_packet(frame, 3);
+
+    // The PAT and PMT in the same packet, dump it before the cached gop.
+    if (true) {
+        SrsSrtSource source;
+        HELPER_ASSERT_SUCCESS(source.initialize(&req));
+
+        uint8_t patpmt[SRS_TS_PACKET_SIZE * 2];
+        memcpy(patpmt, pat, SRS_TS_PACKET_SIZE);
+        memcpy(patpmt + SRS_TS_PACKET_SIZE, pmt, SRS_TS_PACKET_SIZE);
+
+        SrsSrtPacket p0, p1, p2;
+        p0.wrap((char*)patpmt, sizeof(patpmt));
+        p1.wrap((char*)key, sizeof(key));
+        p2.wrap((char*)frame, sizeof(frame));
+        HELPER_ASSERT_SUCCESS(source.on_packet(&p0));
+        HELPER_ASSERT_SUCCESS(source.on_packet(&p1));
+        HELPER_ASSERT_SUCCESS(source.on_packet(&p2));
+        EXPECT_EQ(2, (int)source.gop_cache_.size());
+        EXPECT_EQ(0x100, source.pmt_pid_);
+
+        SrsSrtConsumer* consumer = NULL;
+        HELPER_ASSERT_SUCCESS(source.create_consumer(consumer));
+        SrsUniquePtr<SrsSrtConsumer> consumer_uptr(consumer);
+        HELPER_ASSERT_SUCCESS(source.consumer_dumps(consumer));
+        ASSERT_EQ(3, (int)consumer->queue.size());
+        EXPECT_EQ(0, memcmp(consumer->queue[0]->data(), patpmt, sizeof(patpmt)));
+        EXPECT_EQ(0, memcmp(consumer->queue[1]->data(), key, sizeof(key)));
+    }
+
+    // The PAT and PMT in different packets, dump both.
+    if (true) {
+        SrsSrtSource source;
+        HELPER_ASSERT_SUCCESS(source.initialize(&req));
+
+        SrsSrtPacket p0, p1, p2, p3;
+        p0.wrap((char*)pat, sizeof(pat));
+        p1.wrap((char*)pmt, sizeof(pmt));
+        p2.wrap((char*)key, sizeof(key));
+        p3.wrap((char*)frame, sizeof(frame));
+        HELPER_ASSERT_SUCCESS(source.on_packet(&p0));
+        HELPER_ASSERT_SUCCESS(source.on_packet(&p1));
+        HELPER_ASSERT_SUCCESS(source.on_packet(&p2));
+        HELPER_ASSERT_SUCCESS(source.on_packet(&p3));
+
+        SrsSrtConsumer* consumer = NULL;
+        HELPER_ASSERT_SUCCESS(source.create_consumer(consumer));
+        SrsUniquePtr<SrsSrtConsumer> consumer_uptr(consumer);
+        HELPER_ASSERT_SUCCESS(source.consumer_dumps(consumer));
+        ASSERT_EQ(4, (int)consumer->queue.size());
+        EXPECT_EQ(0, memcmp(consumer->queue[0]->data(), pat, sizeof(pat)));
+        EXPECT_EQ(0, memcmp(consumer->queue[1]->data(), pmt, sizeof(pmt)));
+        EXPECT_EQ(0, memcmp(consumer->queue[2]->data(), key, sizeof(key)));
+    }
+}
+
+VOID TEST(ServiceSRTTest, FastStartReload)
+{
+    srs_error_t err = srs_success;
+
+    MockSrsReloadConfig conf;
+    HELPER_ASSERT_SUCCESS(conf.parse(_MIN_OK_CONF "vhost __defaultVhost__ {play {fast_start off;}}"));
+    MockSrsConfigGuard guard(&conf);
+
+    SrsRequest req;
+    req.vhost = "__defaultVhost__";
+    req.app = "live";
+    req.stream = "livestream";
+
+    SrsSrtSource source;
+    HELPER_ASSERT_SUCCESS(source.initialize(&req));
+    EXPECT_FALSE(source.fast_start_);
+
+    uint8_t key[SRS_TS_PACKET_SIZE];
+    mock_srt_ts_packet(key, 2);
+    SrsSrtPacket p0;
+    p0.wrap((char*)key, sizeof(key));
+
+    // Enable fast start by reload.
+    HELPER_ASSERT_SUCCESS(conf.do_reload(_MIN_OK_CONF "vhost __defaultVhost__ {play {fast_start on;}}"));
+    EXPECT_TRUE(source.fast_start_);
+    HELPER_ASSERT_SUCCESS(source.on_packet(&p0));
+    EXPECT_EQ(1, (int)source.gop_cache_.size());
+
+    // Disable it by reload, drop the cache.
+    HELPER_ASSERT_SUCCESS(conf.do_reload(_MIN_OK_CONF "vhost __defaultVhost__ {play {fast_start off;}}"));
+    EXPECT_FALSE(source.fast_start_);
+    EXPECT_EQ(0, (int)source.gop_cache_.size());
+}
+
 // TODO: FIXME: add mpegts conn test
 // set srt option, recv srt client, get srt client opt and check.
 